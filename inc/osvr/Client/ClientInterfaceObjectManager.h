@@ -33,17 +33,21 @@
 #include <osvr/Common/PathTree_fwd.h>
 #include <osvr/Common/ClientContext_fwd.h>
 #include <osvr/Client/InterfaceTree.h>
+#include <osvr/Common/PathElementTypes.h>
 
 // Library/third-party includes
-// - none
+#include <boost/optional.hpp>
+#include <json/value.h>
 
 // Standard includes
 #include <string>
+#include <unordered_map>
 
 namespace osvr {
 namespace common {
     class PathTree;
     class PathTreeOwner;
+    class OriginalSource;
 } // namespace common
 namespace client {
     class RemoteHandlerFactory;
@@ -95,6 +99,30 @@ namespace client {
         /// or more interface objects but no remote handler.
         void m_connectNeededCallbacks();
 
+        /// @brief After a path tree update, re-resolves every path with a
+        /// handler, removing or re-creating only those whose source changed.
+        void m_refreshChangedCallbacks();
+
+        /// @brief Everything about a resolved common::OriginalSource that a
+        /// remote handler is constructed from, kept by value so it survives
+        /// the path tree being replaced.
+        struct SourceDescription {
+            std::string devicePath;
+            common::elements::DeviceElement device;
+            std::string interfaceName;
+            boost::optional<int> sensor;
+            Json::Value transform;
+            bool operator==(SourceDescription const &other) const {
+                return devicePath == other.devicePath &&
+                       device == other.device &&
+                       interfaceName == other.interfaceName &&
+                       sensor == other.sensor && transform == other.transform;
+            }
+        };
+
+        static SourceDescription
+        m_describeSource(common::OriginalSource const &source);
+
         /// @brief Access the client context's logger.
         util::log::LoggerPtr const &logger() const;
 
@@ -106,6 +134,10 @@ namespace client {
         /// common::PathTreeOwner passed into constructor.
         common::PathTree &m_pathTree;
 
+        /// @brief The source each current handler was constructed for, by
+        /// path.
+        std::unordered_map<std::string, SourceDescription> m_handlerSources;
+
         /// @brief Path tree "observer" through which we register callbacks on
         /// common::PathTreeOwner events.
         common::PathTreeObserverPtr m_treeObserver;
@@ -28,6 +28,7 @@
 // Internal Includes
 #include <osvr/Client/Export.h>
 #include <osvr/Common/ClientContext_fwd.h>
+#include <osvr/Common/PathTreeOwnerPtr.h>
 
 // Library/third-party includes
 // - none
@@ -46,6 +47,16 @@ namespace client {
     OSVR_CLIENT_EXPORT common::ClientContext *
     createAnalysisClientContext(const char appId[], const char host[],
                                 vrpn_ConnectionPtr const& conn);
+
+    /// @brief Creates an analysis client context that observes the given
+    /// path tree, shared by a server in the same process and updated in the
+    /// thread that updates the context, rather than maintaining its own copy.
+    /// Falls back to the behavior of the overload above if @p sharedTree is
+    /// null.
+    OSVR_CLIENT_EXPORT common::ClientContext *
+    createAnalysisClientContext(const char appId[], const char host[],
+                                vrpn_ConnectionPtr const &conn,
+                                common::PathTreeOwnerPtr const &sharedTree);
 } // namespace client
 } // namespace osvr
 
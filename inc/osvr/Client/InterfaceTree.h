@@ -93,6 +93,16 @@ namespace client {
         /// @brief Removes all handlers
         OSVR_CLIENT_EXPORT void clearHandlers();
 
+        /// @brief Visit all paths that have a handler.
+        template <typename F> void visitPathsWithHandlers(F &&func) {
+            osvr::util::traverseWith(*m_root, [&](node_type &node) {
+                if (node.value().handler) {
+                    func(util::getTreeNodeFullPath(node,
+                                                   common::getPathSeparator()));
+                }
+            });
+        }
+
         /// @brief Visit all paths with interfaces in their list but no handler.
         template <typename F> void visitPathsWithoutHandlers(F &&func) {
             osvr::util::traverseWith(*m_root, [&](node_type &node) {
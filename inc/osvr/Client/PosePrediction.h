@@ -0,0 +1,92 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_PosePrediction_h_GUID_0C5D2E71_8B4A_4F6E_A1D3_7E9F2B6C4A18
+#define INCLUDED_PosePrediction_h_GUID_0C5D2E71_8B4A_4F6E_A1D3_7E9F2B6C4A18
+
+// Internal Includes
+#include <osvr/Client/Export.h>
+#include <osvr/Common/InterfaceState.h>
+#include <osvr/Util/ClientOpaqueTypesC.h>
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+
+namespace osvr {
+namespace client {
+    /// @brief Extrapolates a pose from its timestamp to the target time using
+    /// a constant-velocity process model and whatever parts of the velocity
+    /// state are valid.
+    ///
+    /// The velocities are expected in the same (room) space as the pose, as
+    /// reported to clients.
+    OSVR_CLIENT_EXPORT OSVR_PoseState
+    predictPose(OSVR_PoseState const &pose,
+                util::time::TimeValue const &poseTime,
+                OSVR_VelocityState const &velocity,
+                util::time::TimeValue const &target);
+
+    /// @brief How long (in seconds) before the pose its velocity may have
+    /// been reported and still be used to predict it.
+    static const double MAX_VELOCITY_AGE = 0.1;
+
+    /// @brief Gets the velocity to predict the pose of the given state with:
+    /// none if it has no velocity, or if its velocity was reported more than
+    /// MAX_VELOCITY_AGE before its pose (as when a device has stopped
+    /// reporting velocity).
+    OSVR_CLIENT_EXPORT OSVR_VelocityState
+    getPredictionVelocity(common::PoseVelocityState const &state);
+
+    /// @brief Gets the latest pose of an interface, extrapolated to the target
+    /// time using the latest velocity state it has, if any and not stale.
+    ///
+    /// Like getting state, safe to call from threads other than the one
+    /// updating the context.
+    ///
+    /// @return false if the interface has no pose state.
+    OSVR_CLIENT_EXPORT bool
+    getPredictedPose(OSVR_ClientInterfaceObject const &iface,
+                     util::time::TimeValue const &target,
+                     OSVR_PoseState &pose);
+
+    /// @brief Batch form of getPredictedPose(), predicting all the given
+    /// interfaces to the same target time in one pass.
+    ///
+    /// @param hasPose If not null, an array of @p count flags set to whether
+    /// the corresponding interface had pose state (and thus whether the
+    /// corresponding entry of @p poses was written).
+    /// @return the number of interfaces that had pose state.
+    OSVR_CLIENT_EXPORT std::size_t
+    getPredictedPoses(OSVR_ClientInterfaceObject const *const *ifaces,
+                      std::size_t count, util::time::TimeValue const &target,
+                      OSVR_PoseState *poses, bool *hasPose = nullptr);
+} // namespace client
+} // namespace osvr
+
+#endif // INCLUDED_PosePrediction_h_GUID_0C5D2E71_8B4A_4F6E_A1D3_7E9F2B6C4A18
@@ -32,6 +32,7 @@
 #include <osvr/Common/OriginalSource.h>
 #include <osvr/Common/InterfaceList.h>
 #include <osvr/Common/ClientContext_fwd.h>
+#include <osvr/Common/DirectReportDispatch_fwd.h>
 #include <osvr/Client/RemoteHandler.h>
 
 // Library/third-party includes
@@ -84,6 +85,17 @@ namespace client {
     populateRemoteHandlerFactory(RemoteHandlerFactory &factory,
                                  VRPNConnectionCollection const &conns);
 
+    /// @overload
+    ///
+    /// For a context hosting its own server: handlers for devices on
+    /// @p directHost that support it receive reports directly through
+    /// @p direct (see connection::Connection::setDirectReportDispatch()).
+    OSVR_CLIENT_EXPORT void
+    populateRemoteHandlerFactory(RemoteHandlerFactory &factory,
+                                 VRPNConnectionCollection const &conns,
+                                 common::DirectReportDispatchPtr const &direct,
+                                 std::string const &directHost);
+
 } // namespace client
 } // namespace osvr
 #endif // INCLUDED_RemoteHandlerFactory_h_GUID_3B3394C0_DADA_4BAA_3EDD_6CDA96760D91
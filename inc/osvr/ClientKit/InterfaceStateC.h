@@ -1,6 +1,12 @@
 /** @file
     @brief Header
 
+    The osvrGet*State functions may be called from any thread, including one
+    other than that calling osvrClientUpdate() (for instance, a render thread):
+    state is published and read without locks, and each call returns a
+    consistent state and timestamp for the requested type. Different state
+    types (e.g. pose and velocity) are published individually, though.
+
     Must be c-safe!
 
     @date 2014
@@ -48,7 +54,7 @@ OSVR_EXTERN_C_BEGIN
 
 #define OSVR_CALLBACK_METHODS(TYPE)                                            \
     /** @brief Get TYPE state from an interface, returning failure if none     \
-     * exists */                                                               \
+     * exists. Thread-safe with respect to osvrClientUpdate(). */              \
     OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode osvrGet##TYPE##State(                \
         OSVR_ClientInterface iface, struct OSVR_TimeValue *timestamp,          \
         OSVR_##TYPE##State *state);
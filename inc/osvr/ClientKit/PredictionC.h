@@ -0,0 +1,95 @@
+/** @file
+    @brief Header providing client-side prediction (extrapolation) of tracker
+    pose state.
+
+    Must be c-safe!
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+/*
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#ifndef INCLUDED_PredictionC_h_GUID_2E4B8A61_C3D7_4F95_9A0E_5B1C7D3F8E24
+#define INCLUDED_PredictionC_h_GUID_2E4B8A61_C3D7_4F95_9A0E_5B1C7D3F8E24
+
+/* Internal Includes */
+#include <osvr/ClientKit/Export.h>
+#include <osvr/Util/APIBaseC.h>
+#include <osvr/Util/ReturnCodesC.h>
+#include <osvr/Util/AnnotationMacrosC.h>
+#include <osvr/Util/BoolC.h>
+#include <osvr/Util/ClientOpaqueTypesC.h>
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/TimeValueC.h>
+
+/* Library/third-party includes */
+/* none */
+
+/* Standard includes */
+#include <stddef.h>
+
+OSVR_EXTERN_C_BEGIN
+
+/** @addtogroup ClientKit
+    @{
+*/
+
+/** @brief Gets the pose state of an interface, extrapolated from its timestamp
+    to the given target time (for instance, the expected display scan-out time)
+    using the latest velocity state reported on that interface.
+
+    If no velocity is available, the latest pose is returned unmodified.
+    Prediction quality drops quickly with the prediction interval, so keep the
+    target close to the present. Like the osvrGet*State functions, this may be
+    called from a thread other than the one calling osvrClientUpdate().
+
+    @param iface Interface
+    @param target Time to predict the pose for.
+    @param[out] state Predicted pose.
+    @return OSVR_RETURN_FAILURE if the interface has no pose state.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode osvrGetPredictedPoseState(
+    OSVR_ClientInterface iface, OSVR_IN_PTR struct OSVR_TimeValue const *target,
+    OSVR_OUT OSVR_PoseState *state);
+
+/** @brief Batch form of osvrGetPredictedPoseState(), predicting the poses of
+    a number of interfaces to the same target time with a single call (e.g.
+    once per frame for all tracked interfaces).
+
+    @param ifaces Array of @p count interfaces.
+    @param count Number of interfaces.
+    @param target Time to predict the poses for.
+    @param[out] states Array of @p count predicted poses: entries for
+    interfaces without pose state are left untouched.
+    @param[out] hasPose Optional (may be NULL) array of @p count flags,
+    indicating which interfaces had pose state.
+    @return OSVR_RETURN_FAILURE if any interface had no pose state.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode osvrGetPredictedPoseStates(
+    OSVR_IN_READS(count) OSVR_ClientInterface const *ifaces, size_t count,
+    OSVR_IN_PTR struct OSVR_TimeValue const *target,
+    OSVR_OUT OSVR_PoseState *states,
+    OSVR_OUT_OPT OSVR_CBool *hasPose);
+
+/** @} */
+OSVR_EXTERN_C_END
+
+#endif
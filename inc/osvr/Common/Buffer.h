@@ -237,7 +237,7 @@ namespace common {
             /// Safe to do without violating strict aliasing because ElementType
             /// is a character type.
             ElementType const *src = reinterpret_cast<ElementType const *>(&v);
-            m_buf.insert(m_buf.end(), src, src + sizeof(T));
+            append(src, sizeof(T));
         }
 
         /// @brief Append the binary representation of a value, after adding the
@@ -253,7 +253,9 @@ namespace common {
 
         /// @brief Append a byte-array's contents
         void append(ElementType const *v, size_t const n) {
-            m_buf.insert(m_buf.end(), v, v + n);
+            auto oldSize = m_buf.size();
+            m_buf.resize(oldSize + n);
+            std::copy(v, v + n, m_buf.data() + oldSize);
         }
 
         /// @brief Append a byte-array's contents, after adding the necessary
@@ -273,6 +275,29 @@ namespace common {
             m_buf.insert(m_buf.end(), bytes, '\0');
         }
 
+        /// @brief Empties the buffer, keeping its storage for reuse.
+        void clear() { m_buf.clear(); }
+
+        /// @brief Empties the buffer, keeping its storage for reuse only if
+        /// that is no more than the given number of bytes: a buffer reused
+        /// from message to message then doesn't hold on to the storage of
+        /// the largest it has ever seen.
+        void clearAndTrim(size_t const maxRetained) {
+            if (m_buf.capacity() > maxRetained) {
+                ContainerType().swap(m_buf);
+            } else {
+                m_buf.clear();
+            }
+        }
+
+        /// @brief Gets the number of bytes that can be held without further
+        /// allocation.
+        size_t capacity() const { return m_buf.capacity(); }
+
+        /// @brief Ensures that at least the given number of bytes can be held
+        /// without further allocation.
+        void reserve(size_t const bytes) { m_buf.reserve(bytes); }
+
         /// @brief Returns a reader object, for making a single read pass over
         /// the buffer. Do not modify this buffer during the lifetime of a
         /// reader!
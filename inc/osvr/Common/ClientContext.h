@@ -33,6 +33,7 @@
 #include <osvr/Common/Transform_fwd.h>
 #include <osvr/Common/ClientInterfaceFactory.h>
 #include <osvr/Util/KeyedOwnershipContainer.h>
+#include <osvr/Util/ImagingReportTypesC.h>
 #include <osvr/Util/UniquePtr.h>
 #include <osvr/Util/SharedPtr.h>
 #include <osvr/Util/LogLevel.h>
@@ -101,6 +102,21 @@ struct OSVR_ClientContextObject : boost::noncopyable {
     /// @returns true if the object was found and released.
     OSVR_COMMON_EXPORT bool releaseObject(void *obj);
 
+    /// @brief Takes the given number of references to an image buffer on
+    /// behalf of the client, each to be released by releaseImageBuffer().
+    ///
+    /// Cheaper than calling acquireObject() per reference, which matters at
+    /// camera frame rates.
+    OSVR_COMMON_EXPORT void
+    acquireImageBuffer(osvr::shared_ptr<OSVR_ImageBufferElement> const &buf,
+                       std::size_t refs);
+
+    /// @brief Releases one reference to an image buffer taken by
+    /// acquireImageBuffer().
+    ///
+    /// @returns true if the buffer was found and a reference released.
+    OSVR_COMMON_EXPORT bool releaseImageBuffer(OSVR_ImageBufferElement *buf);
+
     /// @brief Gets the transform from room space to world space.
     OSVR_COMMON_EXPORT osvr::common::Transform const &
     getRoomToWorldTransform() const;
@@ -167,6 +183,8 @@ struct OSVR_ClientContextObject : boost::noncopyable {
     osvr::common::ClientInterfaceFactory m_clientInterfaceFactory;
 
     osvr::util::MultipleKeyedOwnershipContainer m_ownedObjects;
+    osvr::util::KeyedRefCountContainer<OSVR_ImageBufferElement>
+        m_imageBuffers;
     osvr::common::ClientContextDeleter m_deleter;
 
     /// Logger for the use of OSVR libraries on behalf of the client
@@ -67,16 +67,23 @@ struct OSVR_ClientInterfaceObject : boost::noncopyable {
     /// @{
     /// @brief If state exists for the given ReportType on this interface, it
     /// will be returned in the arguments, and true will be returned.
+    ///
+    /// Safe to call from threads other than the one updating the context.
     template <typename ReportType>
     bool
     getState(osvr::util::time::TimeValue &timestamp,
              osvr::common::traits::StateFromReport_t<ReportType> &state) const {
         osvr::common::tracing::markGetState(m_path);
-        if (!m_state.hasState<ReportType>()) {
-            return false;
-        }
-        m_state.getState<ReportType>(timestamp, state);
-        return true;
+        return m_state.getState<ReportType>(timestamp, state);
+    }
+
+    /// @brief Gets the pose and velocity state as of the same update, if
+    /// there is either.
+    ///
+    /// Safe to call from threads other than the one updating the context.
+    bool getPoseVelocityState(osvr::common::PoseVelocityState &state) const {
+        osvr::common::tracing::markGetState(m_path);
+        return m_state.getPoseVelocityState(state);
     }
 
     template <typename ReportType> bool hasStateForReportType() const {
@@ -30,6 +30,7 @@
 #include <osvr/Common/BaseDevicePtr.h>
 #include <osvr/Common/MessageHandler.h>
 #include <osvr/Common/BaseMessageTraits.h>
+#include <osvr/Common/Buffer.h>
 
 // Library/third-party includes
 // - none
@@ -69,6 +70,16 @@ namespace common {
         void m_registerHandler(vrpn_MESSAGEHANDLER handler, void *userdata,
                                RawMessageType const &msgType);
 
+        /// @brief Gets an empty buffer for serializing outgoing messages
+        /// into, kept from send to send so its storage gets reused (see
+        /// serializeReusing()). Sends for a device are already serialized
+        /// with each other, so one per component suffices.
+        ///
+        /// Storage beyond typical report sizes isn't kept: after an oversize
+        /// message (an image, a large JSON descriptor), the next call starts
+        /// afresh.
+        Buffer<> &m_getSendBuffer();
+
         /// @brief Called once when we have a parent
         virtual void m_parentSet() = 0;
 
@@ -79,6 +90,7 @@ namespace common {
       private:
         Parent *m_parent;
         MessageHandlerList<BaseDeviceMessageHandleTraits> m_messageHandlers;
+        Buffer<> m_sendBuffer;
     };
 } // namespace common
 } // namespace osvr
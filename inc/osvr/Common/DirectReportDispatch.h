@@ -0,0 +1,214 @@
+/** @file
+    @brief Header for routing reports from server-side devices straight to
+    client-side handlers when both live in the same process.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_DirectReportDispatch_h_GUID_2C7E91A5_B84D_4F36_9D0E_5A13C8F7B402
+#define INCLUDED_DirectReportDispatch_h_GUID_2C7E91A5_B84D_4F36_9D0E_5A13C8F7B402
+
+// Internal Includes
+#include <osvr/Common/DirectReportDispatch_fwd.h>
+#include <osvr/Common/Export.h>
+#include <osvr/Util/ChannelCountC.h>
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace osvr {
+namespace common {
+    /// @brief Client-side receiver of tracker reports delivered directly,
+    /// bypassing message serialization. The reports carry the same content
+    /// as the tracker messages they replace: full states, with unreported
+    /// parts reset to zero/identity.
+    class TrackerReportSink {
+      public:
+        OSVR_COMMON_EXPORT virtual ~TrackerReportSink();
+        virtual void handleDirectPose(OSVR_ChannelCount sensor,
+                                      OSVR_PoseState const &pose,
+                                      util::time::TimeValue const &tv) = 0;
+        virtual void handleDirectVelocity(OSVR_ChannelCount sensor,
+                                          OSVR_VelocityState const &vel,
+                                          util::time::TimeValue const &tv) = 0;
+        virtual void
+        handleDirectAcceleration(OSVR_ChannelCount sensor,
+                                 OSVR_AccelerationState const &accel,
+                                 util::time::TimeValue const &tv) = 0;
+    };
+
+    /// @brief A tracker report waiting in a DirectReportDispatch queue.
+    struct DirectTrackerReport {
+        enum Kind { Pose, Velocity, Acceleration };
+        DirectTrackerChannel const *channel;
+        Kind kind;
+        OSVR_ChannelCount sensor;
+        util::time::TimeValue timestamp;
+        union {
+            OSVR_PoseState pose;
+            OSVR_VelocityState velocity;
+            OSVR_AccelerationState acceleration;
+        };
+    };
+
+    namespace detail {
+        /// @brief State shared by a dispatch registry and its channels.
+        struct DirectReportState {
+            std::vector<DirectTrackerReport> queue;
+            bool wireRequired = false;
+        };
+        typedef shared_ptr<DirectReportState> DirectReportStatePtr;
+    } // namespace detail
+
+    /// @brief The sinks for a single tracker device: held by the server-side
+    /// device so that sending needs no lookup.
+    class DirectTrackerChannel {
+      public:
+        void addSink(TrackerReportSink &sink) { m_sinks.push_back(&sink); }
+        void removeSink(TrackerReportSink &sink) {
+            for (auto it = m_sinks.begin(); it != m_sinks.end(); ++it) {
+                if (*it == &sink) {
+                    m_sinks.erase(it);
+                    return;
+                }
+            }
+        }
+
+        /// @brief Whether devices must still send their reports over the
+        /// connection as well (see DirectReportDispatch::requireWire()).
+        bool isWireRequired() const { return m_state->wireRequired; }
+
+        /// @name Sending
+        /// Reports are queued, and only reach the sinks when the registry's
+        /// owner calls DirectReportDispatch::deliver(), just as they'd only
+        /// reach client handlers when it ran its connection's mainloop.
+        /// @{
+        void sendPose(OSVR_ChannelCount sensor, OSVR_PoseState const &pose,
+                      util::time::TimeValue const &tv) {
+            m_push(DirectTrackerReport::Pose, sensor, tv).pose = pose;
+        }
+        void sendVelocity(OSVR_ChannelCount sensor,
+                          OSVR_VelocityState const &vel,
+                          util::time::TimeValue const &tv) {
+            m_push(DirectTrackerReport::Velocity, sensor, tv).velocity = vel;
+        }
+        void sendAcceleration(OSVR_ChannelCount sensor,
+                              OSVR_AccelerationState const &accel,
+                              util::time::TimeValue const &tv) {
+            m_push(DirectTrackerReport::Acceleration, sensor, tv)
+                .acceleration = accel;
+        }
+        /// @}
+
+      private:
+        friend class DirectReportDispatch;
+        explicit DirectTrackerChannel(
+            detail::DirectReportStatePtr const &state)
+            : m_state(state) {}
+
+        DirectTrackerReport &m_push(DirectTrackerReport::Kind kind,
+                                    OSVR_ChannelCount sensor,
+                                    util::time::TimeValue const &tv) {
+            m_state->queue.emplace_back();
+            auto &report = m_state->queue.back();
+            report.channel = this;
+            report.kind = kind;
+            report.sensor = sensor;
+            report.timestamp = tv;
+            return report;
+        }
+
+        /// Indexed loop, since a callback may end up removing a sink.
+        void m_deliver(DirectTrackerReport const &report) const {
+            for (std::size_t i = 0; i < m_sinks.size(); ++i) {
+                auto &sink = *m_sinks[i];
+                switch (report.kind) {
+                case DirectTrackerReport::Pose:
+                    sink.handleDirectPose(report.sensor, report.pose,
+                                          report.timestamp);
+                    break;
+                case DirectTrackerReport::Velocity:
+                    sink.handleDirectVelocity(report.sensor, report.velocity,
+                                              report.timestamp);
+                    break;
+                case DirectTrackerReport::Acceleration:
+                    sink.handleDirectAcceleration(
+                        report.sensor, report.acceleration, report.timestamp);
+                    break;
+                }
+            }
+        }
+
+        detail::DirectReportStatePtr m_state;
+        std::vector<TrackerReportSink *> m_sinks;
+    };
+
+    /// @brief Registry, shared between a server connection and a client
+    /// context in the same process (a joint client context), connecting
+    /// server-side devices to client-side handlers by device name.
+    ///
+    /// Not internally synchronized: all use must be serialized by the owner,
+    /// as the joint client context does by running the server from its own
+    /// update (asynchronous devices only send while the server thread waits
+    /// for them).
+    class DirectReportDispatch {
+      public:
+        OSVR_COMMON_EXPORT static DirectReportDispatchPtr create();
+
+        /// @brief Gets the channel for the named device (without host),
+        /// creating it if required.
+        OSVR_COMMON_EXPORT DirectTrackerChannelPtr
+        getTrackerChannel(std::string const &deviceName);
+
+        /// @brief Hands all the reports queued since the last call to the
+        /// sinks registered now, in the order they were sent. Reports sent
+        /// by the sinks' callbacks wait for the next call.
+        OSVR_COMMON_EXPORT void deliver();
+
+        /// @brief Number of reports waiting for deliver().
+        std::size_t numQueued() const { return m_state->queue.size(); }
+
+        /// @brief Notes that something in the process (such as an analysis
+        /// plugin's client context) receives device reports over the
+        /// connection itself, so devices must keep sending them there too.
+        void requireWire() { m_state->wireRequired = true; }
+
+      private:
+        DirectReportDispatch();
+        detail::DirectReportStatePtr m_state;
+        std::unordered_map<std::string, DirectTrackerChannelPtr>
+            m_trackerChannels;
+        /// Reports being delivered, kept to reuse its capacity.
+        std::vector<DirectTrackerReport> m_delivering;
+    };
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_DirectReportDispatch_h_GUID_2C7E91A5_B84D_4F36_9D0E_5A13C8F7B402
@@ -0,0 +1,48 @@
+/** @file
+    @brief Forward declarations for direct (in-process) report dispatch.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_DirectReportDispatch_fwd_h_GUID_8F2B6C14_3E7A_4D19_B5C0_71A9E4D2F6B8
+#define INCLUDED_DirectReportDispatch_fwd_h_GUID_8F2B6C14_3E7A_4D19_B5C0_71A9E4D2F6B8
+
+// Internal Includes
+#include <osvr/Util/SharedPtr.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace common {
+    class DirectReportDispatch;
+    typedef shared_ptr<DirectReportDispatch> DirectReportDispatchPtr;
+    class DirectTrackerChannel;
+    typedef shared_ptr<DirectTrackerChannel> DirectTrackerChannelPtr;
+    class TrackerReportSink;
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_DirectReportDispatch_fwd_h_GUID_8F2B6C14_3E7A_4D19_B5C0_71A9E4D2F6B8
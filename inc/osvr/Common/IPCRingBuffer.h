@@ -62,6 +62,11 @@ namespace common {
     /// segment name and signalling new data, and no guarantee that the data you
     /// were notified about won't be overwritten - just that if you're currently
     /// accessing data, we won't overwrite that.
+    ///
+    /// Optionally (see Options::setLockFree()), the ring buffer may instead be
+    /// created in a lock-free mode, where the producer never waits on readers:
+    /// readers receive a validated private copy of an entry, and simply get an
+    /// invalid proxy if the entry was overwritten while being copied.
     class IPCRingBuffer : public enable_shared_from_this<IPCRingBuffer> {
       public:
         typedef uint8_t BackendType;
@@ -100,9 +105,18 @@ namespace common {
             Options &setEntrySize(entry_size_type entrySize);
             entry_size_type getEntrySize() const { return m_entrySize; }
 
+            /// @brief Sets whether the ring buffer uses the lock-free
+            /// (single-writer, sequence-validated) shared memory layout rather
+            /// than the mutex-based one. Must match between the creator and
+            /// anyone finding the buffer: see getABILevel(bool).
+            /// @return *this for chained method idiom.
+            Options &setLockFree(bool lockFree = true);
+            bool getLockFree() const { return m_lockFree; }
+
           private:
             std::string m_name;
             BackendType m_shmBackend;
+            bool m_lockFree = false;
             alignment_type m_alignment = 16;
             entry_count_type m_entries = 16;
             entry_size_type m_entrySize = 65536;
@@ -114,6 +128,16 @@ namespace common {
         /// succeed and thus should not try.
         OSVR_COMMON_EXPORT static abi_level_type getABILevel();
 
+        /// @brief Gets the ABI level for either the mutex-based (the same as
+        /// getABILevel()) or the lock-free shared memory layout.
+        OSVR_COMMON_EXPORT static abi_level_type getABILevel(bool lockFree);
+
+        /// @brief Checks whether this build can communicate with a ring buffer
+        /// advertised with the given ABI level, and if so, whether it uses the
+        /// lock-free layout.
+        OSVR_COMMON_EXPORT static bool
+        isABILevelSupported(abi_level_type level, bool &lockFree);
+
         /// @brief Named constructor, for use by server processes: creates a
         /// shared memory ring buffer given the options structure.
         ///
@@ -122,8 +146,8 @@ namespace common {
         OSVR_COMMON_EXPORT static IPCRingBufferPtr create(Options const &opts);
 
         /// @brief Named constructor, for use by client processes: accesses an
-        /// IPC ring buffer using the options structure. Only the name field is
-        /// used from the options.
+        /// IPC ring buffer using the options structure. Only the name, backend,
+        /// and lock-free fields are used from the options.
         ///
         /// If the returned pointer is not valid, the named buffer could not be
         /// found.
@@ -143,6 +167,13 @@ namespace common {
         /// this ring buffer.
         OSVR_COMMON_EXPORT uint16_t getEntries() const;
 
+        /// @brief Returns whether this ring buffer uses the lock-free layout.
+        OSVR_COMMON_EXPORT bool getLockFree() const;
+
+        /// @brief Returns the ABI level corresponding to the layout of this
+        /// ring buffer, suitable for advertising to clients.
+        OSVR_COMMON_EXPORT abi_level_type getSegmentABILevel() const;
+
         /// @brief The sequence number is automatically incremented with each
         /// "put" into the buffer. Note that, as an unsigned integer, it does
         /// have (and uses) well-defined overflow semantics.
@@ -166,12 +197,17 @@ namespace common {
             BufferWriteProxy &operator=(BufferWriteProxy const &) = delete;
 
             /// @brief move-constructible
-            BufferWriteProxy(BufferWriteProxy &&other) {
+            BufferWriteProxy(BufferWriteProxy &&other)
+                : m_buf(nullptr), m_seq(0) {
+                std::swap(m_buf, other.m_buf);
+                std::swap(m_seq, other.m_seq);
                 std::swap(m_data, other.m_data);
             }
 
             /// @brief move-assignable
             BufferWriteProxy &operator=(BufferWriteProxy &&other) {
+                std::swap(m_buf, other.m_buf);
+                std::swap(m_seq, other.m_seq);
                 std::swap(m_data, other.m_data);
                 return *this;
             }
@@ -243,6 +279,9 @@ namespace common {
 
         /// @brief Gets access to an element in the buffer by sequence number:
         /// returns a proxy object  that behaves mostly like a smart pointer.
+        ///
+        /// In lock-free mode, the proxy refers to a private copy, and is
+        /// invalid if the element was overwritten before or during copying.
         OSVR_COMMON_EXPORT BufferReadProxy get(sequence_type num);
 
         /// @brief Gets access to the most recent element in the buffer: returns
@@ -33,12 +33,13 @@
 #include <osvr/Util/ImagingReportTypesC.h>
 #include <osvr/Common/IPCRingBuffer.h>
 #include <osvr/Common/ImagingComponentConfig.h>
+#include <osvr/Util/AlignedMemoryUniquePtr.h>
 
 // Library/third-party includes
 #include <vrpn_BaseClass.h>
 
 // Standard includes
-// - none
+#include <vector>
 
 namespace osvr {
 namespace common {
@@ -48,6 +49,44 @@ namespace common {
         OSVR_ImagingMetadata metadata;
         ImageBufferPtr buffer;
     };
+
+    /// @brief How an image is encoded when sent over the network in chunks.
+    enum class ImageWireEncoding : uint8_t {
+        Raw = 0,
+        /// @brief Each byte replaced by its difference from the same byte of
+        /// the pixel to its left, with runs of zero differences collapsed:
+        /// lossless, and cheap enough to run on every frame, but only pays
+        /// off for images with large flat areas.
+        RowDelta = 1
+    };
+
+    /// @brief What to send over the network for an imaging sensor: clients
+    /// that don't need every pixel of every frame can ask for less.
+    ///
+    /// The region of interest is applied first, then the downscaling.
+    struct NetworkImageStreamOptions {
+        ImageWireEncoding encoding = ImageWireEncoding::Raw;
+        /// @brief Keep every nth pixel of every nth row.
+        uint8_t downscale = 1;
+        uint32_t roiX = 0;
+        uint32_t roiY = 0;
+        /// @brief 0 means to the right edge of the image.
+        uint32_t roiWidth = 0;
+        /// @brief 0 means to the bottom edge of the image.
+        uint32_t roiHeight = 0;
+
+        bool isDefault() const {
+            return encoding == ImageWireEncoding::Raw && downscale <= 1 &&
+                   roiX == 0 && roiY == 0 && roiWidth == 0 && roiHeight == 0;
+        }
+    };
+
+    class ImageBufferPool;
+    namespace image_wire {
+        class FrameChunker;
+        class FrameReassembler;
+    } // namespace image_wire
+
     namespace messages {
         class ImageRegion : public MessageRegistration<ImageRegion> {
           public:
@@ -69,6 +108,17 @@ namespace common {
             class MessageSerialization;
             static const char *identifier();
         };
+        class ImageChunk : public MessageRegistration<ImageChunk> {
+          public:
+            class MessageSerialization;
+            static const char *identifier();
+        };
+        class ImageStreamRequest
+            : public MessageRegistration<ImageStreamRequest> {
+          public:
+            class MessageSerialization;
+            static const char *identifier();
+        };
     } // namespace messages
 
     /// @brief BaseDevice component
@@ -94,17 +144,104 @@ namespace common {
         messages::ImagePlacedInProcessMemory imagePlacedInProcessMemory;
 #endif
 
+        /// @brief Message from server to client, containing part of a frame
+        /// too large (or encoded differently) for imageRegion.
+        messages::ImageChunk imageChunk;
+
+        /// @brief Message from client to server, asking for a reduced or
+        /// compressed network stream for a sensor.
+        messages::ImageStreamRequest imageStreamRequest;
+
+        OSVR_COMMON_EXPORT ~ImagingComponent();
+
         OSVR_COMMON_EXPORT void sendImageData(
             OSVR_ImagingMetadata metadata, OSVR_ImageBufferElement *imageData,
             OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp);
 
+        /// @brief Server side: reserves the next frame slot for a sensor and
+        /// returns a pointer to it (directly into the shared memory ring
+        /// buffer entry, unless in-process imaging is configured), so the
+        /// caller can fill the image in place instead of having it copied by
+        /// sendImageData(). Follow up with commitImageFrame() or
+        /// cancelImageFrame() for the same sensor.
+        ///
+        /// Only one reservation per sensor may be outstanding: reserving again
+        /// discards the previous, uncommitted one. Don't interleave with
+        /// sendImageData() for the same sensor while a reservation is held.
+        ///
+        /// Readers aren't held up meanwhile: the reserved slot is taken out of
+        /// what they can read, and they keep getting the frames committed
+        /// before it until it's committed.
+        ///
+        /// @return nullptr if no slot could be reserved.
+        OSVR_COMMON_EXPORT OSVR_ImageBufferElement *
+        reserveImageFrame(OSVR_ImagingMetadata const &metadata,
+                          OSVR_ChannelCount sensor);
+
+        /// @brief Server side: publishes the frame previously reserved with
+        /// reserveImageFrame() for the given sensor.
+        ///
+        /// @return false if there was no outstanding reservation.
+        OSVR_COMMON_EXPORT bool
+        commitImageFrame(OSVR_ChannelCount sensor,
+                         OSVR_TimeValue const &timestamp);
+
+        /// @brief Server side: drops any outstanding reservation for the given
+        /// sensor without notifying clients.
+        OSVR_COMMON_EXPORT void cancelImageFrame(OSVR_ChannelCount sensor);
+
         typedef std::function<void(ImageData const &,
                                    util::time::TimeValue const &)> ImageHandler;
         OSVR_COMMON_EXPORT void registerImageHandler(ImageHandler cb);
 
+        /// @brief Server side: sets whether shared memory ring buffers
+        /// created from now on use the lock-free layout (see
+        /// IPCRingBuffer::Options::setLockFree()). The layout is advertised
+        /// through the ABI level in each message, so clients that don't
+        /// understand it skip the shared memory message instead of
+        /// misreading it.
+        OSVR_COMMON_EXPORT void setLockFreeSharedMemory(bool lockFree);
+
+        /// @brief Server side: sets what gets sent over the network for a
+        /// sensor, turning on the chunked network stream for it. Frames that
+        /// aren't sent as a single imageRegion message (because of the
+        /// options, their size or their depth) are then sent in chunks,
+        /// which clients reassemble.
+        ///
+        /// Until this is called (or a client asks with
+        /// requestNetworkImageStream(), as network clients do on their own
+        /// once they find they can't open the sensor's shared memory),
+        /// frames too large for a single message only go through shared
+        /// memory, so local clients don't also get a copy of every frame
+        /// over the network.
+        OSVR_COMMON_EXPORT void
+        setNetworkImageStream(OSVR_ChannelCount sensor,
+                              NetworkImageStreamOptions const &opts);
+
+        /// @brief Client side: asks the server for a particular network
+        /// stream for a sensor.
+        ///
+        /// The server sends one stream per sensor to all of its network
+        /// clients, so the most recent request from any client wins. Clients
+        /// receiving images through shared memory ignore the chunks.
+        ///
+        /// Clients that can't open a sensor's shared memory ask for its
+        /// stream with the default options by themselves, unless this was
+        /// called for the sensor first.
+        OSVR_COMMON_EXPORT void
+        requestNetworkImageStream(OSVR_ChannelCount sensor,
+                                  NetworkImageStreamOptions const &opts);
+
       private:
         ImagingComponent(OSVR_ChannelCount numChan);
         virtual void m_parentSet();
+        /// @brief Server side: continues sending frames in chunks. Client
+        /// side: sends any stream requests found to be needed.
+        virtual void m_update();
+
+        /// @brief Client side: notes that we can't receive a sensor's frames
+        /// through shared memory, so need its network stream.
+        void m_needNetworkStream(OSVR_ChannelCount sensor);
 
         /// @return true if we could send it.
         bool m_sendImageDataViaSharedMemory(OSVR_ImagingMetadata metadata,
@@ -112,6 +249,19 @@ namespace common {
                                             OSVR_ChannelCount sensor,
                                             OSVR_TimeValue const &timestamp);
 
+        /// @brief Creates or replaces the ring buffer for a sensor if required
+        /// for the given metadata.
+        /// @return true if we have a usable ring buffer.
+        bool m_ensureSharedMemory(OSVR_ImagingMetadata const &metadata,
+                                  OSVR_ChannelCount sensor);
+
+        /// @brief Notifies clients of a frame already placed in the sensor's
+        /// ring buffer.
+        bool m_sendSharedMemoryNotification(OSVR_ImagingMetadata metadata,
+                                            IPCRingBuffer::sequence_type seq,
+                                            OSVR_ChannelCount sensor,
+                                            OSVR_TimeValue const &timestamp);
+
         /// @return true if we could send it.
         bool m_sendImageDataOnTheWire(OSVR_ImagingMetadata metadata,
                                       OSVR_ImageBufferElement *imageData,
@@ -124,6 +274,11 @@ namespace common {
                                                OSVR_ImageBufferElement *imageData,
                                                OSVR_ChannelCount sensor,
                                                OSVR_TimeValue const &timestamp);
+        /// @brief Overload taking ownership of an already-filled buffer.
+        bool m_sendImageDataViaInProcessMemory(
+            OSVR_ImagingMetadata metadata,
+            util::AlignedImageBufferPtr &&imageData, OSVR_ChannelCount sensor,
+            OSVR_TimeValue const &timestamp);
 #endif
 
         static int VRPN_CALLBACK
@@ -132,6 +287,24 @@ namespace common {
         static int VRPN_CALLBACK
         m_handleImagePlacedInSharedMemory(void *userdata, vrpn_HANDLERPARAM p);
 
+        static int VRPN_CALLBACK
+        m_handleImageChunk(void *userdata, vrpn_HANDLERPARAM p);
+
+        static int VRPN_CALLBACK
+        m_handleImageStreamRequest(void *userdata, vrpn_HANDLERPARAM p);
+
+        /// @brief Starts sending a (possibly reduced and encoded) frame as a
+        /// series of imageChunk messages, some now and the rest from
+        /// m_update().
+        bool m_sendImageDataInChunks(OSVR_ImagingMetadata metadata,
+                                     OSVR_ImageBufferElement const *imageData,
+                                     OSVR_ChannelCount sensor,
+                                     OSVR_TimeValue const &timestamp);
+
+        /// @brief Sends up to a fixed number of the pending chunks of a
+        /// sensor's current frame.
+        void m_sendPendingChunks(OSVR_ChannelCount sensor);
+
 #ifdef OSVR_COMMON_IN_PROCESS_IMAGING
         static int VRPN_CALLBACK
         m_handleImagePlacedInProcessMemory(void *userdata, vrpn_HANDLERPARAM p);
@@ -139,12 +312,57 @@ namespace common {
 
         void m_checkFirst(OSVR_ImagingMetadata const &metadata);
         void m_growShmVecIfRequired(OSVR_ChannelCount sensor);
+        void m_growPendingVecIfRequired(OSVR_ChannelCount sensor);
+        void m_growWireStreamVecIfRequired(OSVR_ChannelCount sensor);
+
+        /// @brief A frame slot handed out by reserveImageFrame()
+        struct PendingFrame {
+            OSVR_ImagingMetadata metadata;
+            /// @brief Where the caller is filling in the image, or nullptr
+            /// if there is no outstanding reservation.
+            OSVR_ImageBufferElement *buffer = nullptr;
+            /// @brief Holds the ring buffer entry (shared memory mode)
+            unique_ptr<IPCRingBuffer::BufferWriteProxy> proxy;
+            /// @brief Holds the buffer (in-process mode)
+            util::AlignedImageBufferPtr ownedBuffer;
+        };
 
         OSVR_ChannelCount m_numSensor;
         std::vector<ImageHandler> m_cb;
         bool m_gotOne;
+        bool m_lockFreeShm;
         /// @brief One for each sensor
         std::vector<IPCRingBufferPtr> m_shmBuf;
+        /// @brief One for each sensor
+        std::vector<PendingFrame> m_pendingFrames;
+
+        /// @brief Server side state of the network stream for a sensor.
+        struct WireStream {
+            /// @brief Whether the chunked stream has been turned on.
+            bool requested = false;
+            NetworkImageStreamOptions options;
+            uint32_t frameSeq = 0;
+            /// @brief The frame being sent, created on first use.
+            unique_ptr<image_wire::FrameChunker> chunker;
+            OSVR_TimeValue timestamp;
+        };
+        /// @brief One for each sensor
+        std::vector<WireStream> m_wireStreams;
+        /// @brief Reused between frames when sending in chunks.
+        std::vector<OSVR_ImageBufferElement> m_reducedImage;
+
+        /// @brief Client side, created along with the image handlers:
+        /// recycles the buffers that images received over the network are
+        /// placed in.
+        unique_ptr<ImageBufferPool> m_bufferPool;
+        /// @brief Client side, created along with the chunk handler.
+        unique_ptr<image_wire::FrameReassembler> m_reassembler;
+
+        /// @brief Client side state of our request for the network stream
+        /// of a sensor.
+        enum class StreamRequest : uint8_t { None, Pending, Sent };
+        /// @brief One for each sensor we've asked for, or found we need.
+        std::vector<StreamRequest> m_streamRequests;
     };
 } // namespace common
 } // namespace osvr
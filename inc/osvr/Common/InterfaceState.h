@@ -33,12 +33,13 @@
 #include <osvr/Common/Tracing.h>
 #include <osvr/TypePack/TypeKeyedTuple.h>
 #include <osvr/TypePack/Quote.h>
+#include <osvr/Util/SeqlockValue.h>
 
 // Library/third-party includes
-#include <boost/optional.hpp>
+// - none
 
 // Standard includes
-// - none
+#include <atomic>
 
 namespace osvr {
 namespace common {
@@ -51,9 +52,9 @@ namespace common {
     };
 
     /// @brief Alias taking a report type and returning a state map
-    /// value type.
+    /// value type: a lock-free published (and initially empty) state.
     template <typename ReportType>
-    using StateMapValueType = boost::optional<StateMapContents<ReportType>>;
+    using StateMapValueType = util::SeqlockValue<StateMapContents<ReportType>>;
 
     /// @brief Data structure mapping from a report type to an optional state
     /// value.
@@ -61,8 +62,25 @@ namespace common {
         typepack::TypeKeyedTuple<traits::ReportTypeList,
                                  typepack::quote<StateMapValueType>>;
 
+    /// @brief The latest pose and velocity of an interface, with their
+    /// timestamps, published together so they can be read as a pair from
+    /// the same update.
+    struct PoseVelocityState {
+        bool hasPose;
+        OSVR_PoseState pose;
+        util::time::TimeValue poseTime;
+        bool hasVelocity;
+        OSVR_VelocityState velocity;
+        util::time::TimeValue velocityTime;
+    };
+
     /// @brief Class to maintain state for an interface for each report (and
     /// thus state) type explicitly enumerated.
+    ///
+    /// State is set by a single thread (the one running the client context
+    /// update), but may be read from any number of threads concurrently
+    /// without locking: each read gets a consistent state and timestamp pair
+    /// for its report type.
     class InterfaceState {
       public:
         template <typename ReportType>
@@ -71,31 +89,68 @@ namespace common {
             StateMapContents<ReportType> c;
             c.state = reportState(report);
             c.timestamp = timestamp;
-            typepack::get<ReportType, StateMap>(m_states) = c;
-            m_hasState = true;
+            typepack::get<ReportType, StateMap>(m_states).store(c);
+            m_updatePoseVelocity(c);
+            m_hasState.store(true, std::memory_order_release);
         }
 
         template <typename ReportType> bool hasState() const {
             // using typepack::get;
-            return m_hasState && bool(typepack::cget<ReportType>(m_states));
+            return hasAnyState() &&
+                   typepack::cget<ReportType>(m_states).hasValue();
         }
 
-        bool hasAnyState() const { return m_hasState; }
+        bool hasAnyState() const {
+            return m_hasState.load(std::memory_order_acquire);
+        }
 
+        /// @brief Gets a consistent snapshot of the state and timestamp for a
+        /// report type.
+        /// @return false (leaving the arguments untouched) if there is no
+        /// state for that report type yet.
         template <typename ReportType>
-        void getState(util::time::TimeValue &timestamp,
+        bool getState(util::time::TimeValue &timestamp,
                       traits::StateFromReport_t<ReportType> &state) const {
-            if (hasState<ReportType>()) {
-                timestamp = typepack::cget<ReportType>(m_states)->timestamp;
-                state = typepack::cget<ReportType>(m_states)->state;
+            StateMapContents<ReportType> c;
+            if (!typepack::cget<ReportType>(m_states).load(c)) {
+                return false;
             }
-            /// @todo do we fail silently or throw exception if we are asked for
-            /// state we don't have?
+            timestamp = c.timestamp;
+            state = c.state;
+            return true;
+        }
+
+        /// @brief Gets a consistent snapshot of the pose and velocity, and
+        /// their timestamps, as of the same update.
+        /// @return false (leaving the argument untouched) if there is neither
+        /// pose nor velocity state yet.
+        bool getPoseVelocityState(PoseVelocityState &state) const {
+            return m_poseVelocity.load(state);
         }
 
       private:
+        void m_updatePoseVelocity(StateMapContents<OSVR_PoseReport> const &c) {
+            m_poseVelocityWriting.hasPose = true;
+            m_poseVelocityWriting.pose = c.state;
+            m_poseVelocityWriting.poseTime = c.timestamp;
+            m_poseVelocity.store(m_poseVelocityWriting);
+        }
+        void
+        m_updatePoseVelocity(StateMapContents<OSVR_VelocityReport> const &c) {
+            m_poseVelocityWriting.hasVelocity = true;
+            m_poseVelocityWriting.velocity = c.state;
+            m_poseVelocityWriting.velocityTime = c.timestamp;
+            m_poseVelocity.store(m_poseVelocityWriting);
+        }
+        template <typename ReportType>
+        void m_updatePoseVelocity(StateMapContents<ReportType> const &) {}
+
         StateMap m_states;
-        bool m_hasState = false;
+        util::SeqlockValue<PoseVelocityState> m_poseVelocity;
+        /// @brief Writer thread's copy of m_poseVelocity, updated a field at a
+        /// time before being published.
+        PoseVelocityState m_poseVelocityWriting = PoseVelocityState();
+        std::atomic<bool> m_hasState{false};
     };
 
 } // namespace common
@@ -51,6 +51,10 @@ namespace common {
     /// is VR" so when milliseconds count, it might be OK. Bruce Dawson even
     /// says so :)
     /// https://randomascii.wordpress.com/2016/03/08/power-wastage-on-an-idle-laptop/#comment-20184
+    ///
+    /// On Linux, it minimizes the timer slack of the thread that creates it
+    /// (restoring it on destruction), so create and destroy it on the same
+    /// thread.
     class LowLatency {
       public:
         OSVR_COMMON_EXPORT LowLatency();
@@ -35,6 +35,7 @@
 
 // Standard includes
 #include <string>
+#include <vector>
 
 namespace osvr {
 namespace common {
@@ -79,6 +80,38 @@ namespace common {
         getNodeByPath(std::string const &path,
                       PathElement const &finalComponentDefault);
 
+        /// @brief A path already split into its components by parsePath(),
+        /// for looking up the same path repeatedly without re-parsing it.
+        typedef std::vector<std::string> PathComponents;
+
+        /// @brief Splits an absolute path into components, with the same
+        /// rules and exceptions as getNodeByPath().
+        OSVR_COMMON_EXPORT static PathComponents
+        parsePath(std::string const &path);
+
+        /// @overload
+        ///
+        /// Takes a path pre-parsed with parsePath().
+        OSVR_COMMON_EXPORT PathNode &getNodeByPath(PathComponents const &path);
+
+        /// @overload
+        ///
+        /// Takes a path pre-parsed with parsePath().
+        /// @throws util::tree::NoSuchChild
+        OSVR_COMMON_EXPORT PathNode const &
+        getNodeByPath(PathComponents const &path) const;
+
+        /// @brief Removes the node indicated by the path, if it exists.
+        ///
+        /// A node with children is kept (as a NullElement) to hold them;
+        /// otherwise it's removed outright, as are any ancestors left both
+        /// null and childless as a result.
+        ///
+        /// @return true if the path existed.
+        /// @throws exceptions::PathNotAbsolute, exceptions::EmptyPath,
+        /// exceptions::EmptyPathComponent
+        OSVR_COMMON_EXPORT bool removeNodeByPath(std::string const &path);
+
         /// @brief Reset the path tree to a new, empty root node.
         OSVR_COMMON_EXPORT void reset();
 
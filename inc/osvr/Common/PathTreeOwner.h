@@ -29,6 +29,7 @@
 #include <osvr/Common/PathTreeObserverPtr.h>
 #include <osvr/Common/PathTree.h>
 #include <osvr/Common/Export.h>
+#include <osvr/Util/StdInt.h>
 
 // Library/third-party includes
 #include <boost/noncopyable.hpp>
@@ -69,6 +70,20 @@ namespace common {
         /// serialized array of nodes.
         OSVR_COMMON_EXPORT void replaceTree(Json::Value const &nodes);
 
+        /// @brief Replace the entirety of the path tree with a copy of
+        /// another, notifying observers just as replaceTree() does.
+        OSVR_COMMON_EXPORT void copyTree(PathTree const &src);
+
+        /// @brief Update the path tree from a generation-tagged delta (see
+        /// SystemComponent::sendTreeDelta()), notifying observers just as
+        /// replaceTree() does.
+        ///
+        /// @return false (and leaves the tree untouched) if the delta is not a
+        /// keyframe and doesn't apply to the generation we currently have - in
+        /// which case, the caller should ask the server for a keyframe (see
+        /// SystemComponent::sendTreeDeltaSupport()).
+        OSVR_COMMON_EXPORT bool applyTreeDelta(Json::Value const &delta);
+
         /// @brief Access the path tree object itself
         PathTree &get() { return m_tree; }
 
@@ -77,8 +92,14 @@ namespace common {
 
       private:
         PathTree m_tree;
+        /// @brief Notifies observers around a modification of the tree
+        template <typename F> void m_updateTree(F &&f);
         std::vector<PathTreeObserverWeakPtr> m_observers;
         bool m_valid = false;
+        /// @brief Whether m_generation is known: set by applyTreeDelta(),
+        /// cleared by replaceTree().
+        bool m_haveGeneration = false;
+        uint32_t m_generation = 0;
     };
 } // namespace common
 } // namespace osvr
@@ -0,0 +1,44 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_PathTreeOwnerPtr_h_GUID_F50EA262_9E06_4321_A126_CD7F9B8A61B9
+#define INCLUDED_PathTreeOwnerPtr_h_GUID_F50EA262_9E06_4321_A126_CD7F9B8A61B9
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <osvr/Util/SharedPtr.h>
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace common {
+    class PathTreeOwner;
+    typedef shared_ptr<PathTreeOwner> PathTreeOwnerPtr;
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_PathTreeOwnerPtr_h_GUID_F50EA262_9E06_4321_A126_CD7F9B8A61B9
@@ -29,12 +29,14 @@
 #include <osvr/Common/Export.h>
 #include <osvr/Common/PathNode_fwd.h>
 #include <osvr/Common/PathTree_fwd.h>
+#include <osvr/Util/StdInt.h>
 
 // Library/third-party includes
 #include <json/value.h>
 
 // Standard includes
 #include <string>
+#include <vector>
 
 namespace osvr {
 namespace common {
@@ -49,6 +51,46 @@ namespace common {
 
     /// @brief Deserialize a path tree from a JSON array of objects
     OSVR_COMMON_EXPORT void jsonToPathTree(PathTree &tree, Json::Value nodes);
+
+    /// @brief Compute the difference between two serialized path trees (as
+    /// produced by pathTreeToJson()), as a JSON object with "added" and
+    /// "changed" arrays of nodes and a "removed" array of paths.
+    OSVR_COMMON_EXPORT Json::Value pathTreeDelta(Json::Value const &oldNodes,
+                                                 Json::Value const &newNodes);
+
+    /// @brief Checks whether a delta from pathTreeDelta() contains no changes.
+    OSVR_COMMON_EXPORT bool isPathTreeDeltaEmpty(Json::Value const &delta);
+
+    /// @brief Apply a delta from pathTreeDelta() to a path tree matching its
+    /// "old" side. Removed nodes are removed with PathTree::removeNodeByPath().
+    OSVR_COMMON_EXPORT void applyPathTreeDelta(PathTree &tree,
+                                               Json::Value const &delta);
+
+    /// @brief A path tree delta (see pathTreeDelta()) in a compact form
+    /// suitable for binary serialization: every string (paths, element data,
+    /// and descriptors as compact JSON text) is stored once in a table and
+    /// referred to by index elsewhere.
+    struct CompactPathTreeDelta {
+        /// @brief Interned strings.
+        std::vector<std::string> strings;
+        /// @brief Added nodes, back to back: path string index, element type
+        /// index, then one entry for each element data field.
+        std::vector<uint32_t> added;
+        /// @brief Changed nodes, in the same format as added.
+        std::vector<uint32_t> changed;
+        /// @brief String indices of removed paths.
+        std::vector<uint32_t> removed;
+    };
+
+    /// @brief Convert a delta from pathTreeDelta() to the compact form.
+    OSVR_COMMON_EXPORT CompactPathTreeDelta
+    compactPathTreeDelta(Json::Value const &delta);
+
+    /// @brief Convert a compact delta back to the JSON form.
+    ///
+    /// @throws std::runtime_error if the compact delta is malformed.
+    OSVR_COMMON_EXPORT Json::Value
+    expandPathTreeDelta(CompactPathTreeDelta const &compact);
 } // namespace common
 } // namespace osvr
 
@@ -35,6 +35,7 @@
 
 // Standard includes
 #include <string>
+#include <type_traits>
 
 namespace osvr {
 namespace common {
@@ -138,8 +139,52 @@ namespace common {
             BufferReaderType &m_reader;
         };
 
+        /// @brief Functor class used by osvr::common::getBufferSpaceRequired
+        /// to compute the serialized size of a message (including alignment
+        /// padding) without writing it anywhere.
+        class SpaceRequirementFunctor : boost::noncopyable {
+          public:
+            /// @brief Main function call operator method.
+            ///
+            /// @param v The value to process - in this case, to add the size
+            /// of.
+            template <typename T> void operator()(T const &v) {
+                m_bytes += getBufferSpaceRequiredRaw(m_bytes, v);
+            }
+
+            /// @brief Main function call operator method, taking a "tag type"
+            /// to specify non-default serialization-related behavior.
+            template <typename Tag, typename T>
+            void operator()(T const &v, Tag const &tag = Tag()) {
+                m_bytes += getBufferSpaceRequiredRaw(m_bytes, v, tag);
+            }
+
+            /// Sizing is a dry run of serialization, so message classes
+            /// should do whatever they'd do when serializing.
+            std::true_type isSerialize() const { return std::true_type(); }
+
+            std::false_type isDeserialize() const { return std::false_type(); }
+
+            /// @brief Accessor to the accumulated size
+            size_t get() const { return m_bytes; }
+
+          private:
+            size_t m_bytes = 0;
+        };
+
     } // namespace serialization
 
+    /// @brief Computes the number of bytes serializing a message (using a
+    /// `MessageClass`, as for osvr::common::serialize) will produce, in a
+    /// single pass that doesn't allocate. For messages made of fixed-size
+    /// fields, this reduces to a constant after inlining.
+    template <typename MessageClass>
+    size_t getBufferSpaceRequired(MessageClass &msg) {
+        serialization::SpaceRequirementFunctor functor;
+        msg.processMessage(functor);
+        return functor.get();
+    }
+
     /// @brief Serializes a message into a buffer, using a `MessageClass`
     ///
     /// Your `MessageClass` class must implement a method `template<typename T>
@@ -152,11 +197,27 @@ namespace common {
     void serialize(BufferType &buf, MessageClass &msg) {
         static_assert(is_buffer<BufferType>::value,
                       "First argument must be a buffer object");
-        /// @todo add another functor to first compute message length and
-        /// reserve buffer space?
         serialization::SerializeFunctor<BufferType> functor(buf);
         msg.processMessage(functor);
     }
+
+    /// @brief Serializes a message into a buffer that is reused from message
+    /// to message, replacing its contents.
+    ///
+    /// The buffer is sized exactly for the message up front, so it grows (if
+    /// at all) in one step, and not at all once it has been used for a
+    /// message at least as large: in steady state, no allocations.
+    ///
+    /// Sizing means an extra pass over the message, so for messages whose
+    /// size is expensive to compute (like those containing JSON), prefer
+    /// calling `buf.clear()` and serialize().
+    template <typename BufferType, typename MessageClass>
+    void serializeReusing(BufferType &buf, MessageClass &msg) {
+        buf.clear();
+        buf.reserve(getBufferSpaceRequired(msg));
+        serialize(buf, msg);
+    }
+
     /// @brief Deserializes a message from a buffer, using a `MessageClass`
     ///
     /// Your `MessageClass` class must implement a method `template<typename T>
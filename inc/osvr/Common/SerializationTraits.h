@@ -32,6 +32,8 @@
 #include <osvr/Util/BoolC.h>
 #include <osvr/Util/Vec2C.h>
 #include <osvr/Util/Vec3C.h>
+#include <osvr/Util/QuaternionC.h>
+#include <osvr/Util/Pose3C.h>
 #include <osvr/Util/TypeSafeId.h>
 
 // Library/third-party includes
@@ -364,6 +366,11 @@ namespace common {
                 deserializeRaw(reader, cVal);
                 val = (cVal == OSVR_TRUE);
             }
+
+            static size_t spaceRequired(size_t existingBytes,
+                                        Base::param_type, tag_type const &) {
+                return getBufferSpaceRequiredRaw(existingBytes, OSVR_CBool());
+            }
         };
         template <typename EnumType, typename IntegerType>
         struct SerializationTraits<EnumAsIntegerTag<EnumType, IntegerType>,
@@ -386,6 +393,12 @@ namespace common {
                 deserializeRaw(reader, intVal);
                 val = static_cast<EnumType>(intVal);
             }
+
+            static size_t spaceRequired(size_t existingBytes,
+                                        typename Base::param_type,
+                                        tag_type const &) {
+                return getBufferSpaceRequiredRaw(existingBytes, IntegerType());
+            }
         };
 
         /// @brief String, length-prefixed. (default)
@@ -558,6 +571,26 @@ namespace common {
             }
         };
 
+        template <>
+        struct SimpleStructSerialization<OSVR_Quaternion>
+            : SimpleStructSerializationBase {
+            template <typename F, typename T> static void apply(F &f, T &val) {
+                f(val.data[0]);
+                f(val.data[1]);
+                f(val.data[2]);
+                f(val.data[3]);
+            }
+        };
+
+        template <>
+        struct SimpleStructSerialization<OSVR_Pose3>
+            : SimpleStructSerializationBase {
+            template <typename F, typename T> static void apply(F &f, T &val) {
+                f(val.translation);
+                f(val.rotation);
+            }
+        };
+
         template <typename Tag>
         struct SimpleStructSerialization<util::TypeSafeId<Tag>>
             : SimpleStructSerializationBase {
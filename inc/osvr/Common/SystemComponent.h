@@ -31,6 +31,7 @@
 #include <osvr/Common/DeviceComponent.h>
 #include <osvr/Common/SerializationTags.h>
 #include <osvr/Common/PathTree_fwd.h>
+#include <osvr/Util/StdInt.h>
 
 // Library/third-party includes
 #include <json/value.h>
@@ -69,6 +70,27 @@ namespace common {
             class MessageSerialization;
             static const char *identifier();
         };
+
+        class TreeDeltaFromServer
+            : public MessageRegistration<TreeDeltaFromServer> {
+          public:
+            class MessageSerialization;
+            static const char *identifier();
+        };
+
+        class TreeDeltaQueryFromServer
+            : public MessageRegistration<TreeDeltaQueryFromServer> {
+          public:
+            class MessageSerialization;
+            static const char *identifier();
+        };
+
+        class TreeDeltaSupportToServer
+            : public MessageRegistration<TreeDeltaSupportToServer> {
+          public:
+            class MessageSerialization;
+            static const char *identifier();
+        };
     } // namespace messages
 
     /// @brief BaseDevice component, to be used only with the "OSVR" special
@@ -112,13 +134,86 @@ namespace common {
 
         OSVR_COMMON_EXPORT void sendReplacementTree(PathTree &tree);
 
+        /// @overload
+        ///
+        /// Takes a tree already serialized with pathTreeToJson().
+        OSVR_COMMON_EXPORT void sendReplacementTree(Json::Value const &nodes);
+
+        /// @brief Message from server, updating the client's configuration
+        /// incrementally: see pathTreeDelta(). When a treeOut message is also
+        /// needed (see treeDeltaQueryOut), this is sent first, so clients that
+        /// understand it may ignore the latter.
+        ///
+        /// Sent in a binary form (see CompactPathTreeDelta) rather than as
+        /// JSON text. Older clients never register a handler for it, so don't
+        /// receive it: they rely on treeOut.
+        messages::TreeDeltaFromServer treeDeltaOut;
+
+        /// @brief Sends a path tree delta, tagged with the generation number of
+        /// the tree it results in.
+        ///
+        /// @param keyframe If true, the delta is against an empty tree and
+        /// replaces the client's tree entirely, whatever generation it had.
+        /// Otherwise, it may only be applied to a tree of generation
+        /// `generation - 1`.
+        OSVR_COMMON_EXPORT void sendTreeDelta(Json::Value const &delta,
+                                              uint32_t generation,
+                                              bool keyframe);
+
+        /// @brief Registers a handler for tree deltas. The handler receives
+        /// the delta in JSON form, with "generation" and "keyframe" members
+        /// added.
+        OSVR_COMMON_EXPORT void registerTreeDeltaHandler(JsonHandler cb);
+
+        /// @brief Message from server, asking clients that understand
+        /// treeDeltaOut to say so with a treeDeltaSupportIn message quoting the
+        /// query's epoch number. Only while all connected clients have replied
+        /// can the server skip sending them treeOut.
+        messages::TreeDeltaQueryFromServer treeDeltaQueryOut;
+
+        OSVR_COMMON_EXPORT void sendTreeDeltaQuery(uint32_t epoch);
+
+        typedef std::function<void(uint32_t epoch)> TreeDeltaQueryHandler;
+        OSVR_COMMON_EXPORT void
+        registerTreeDeltaQueryHandler(TreeDeltaQueryHandler cb);
+
+        /// @brief Message from client, saying it understands treeDeltaOut.
+        ///
+        /// Sent with the epoch of a treeDeltaQueryOut message in reply to
+        /// it, or with epoch 0 (unsolicited) when the client gets a delta for
+        /// a generation it doesn't have: either way, `needKeyframe` asks the
+        /// server for a keyframe delta to get back in sync. `clientId` is
+        /// picked at random by each client context, so the server can tell
+        /// replies from different clients apart (it can't tell which
+        /// connection a message came in on).
+        messages::TreeDeltaSupportToServer treeDeltaSupportIn;
+
+        OSVR_COMMON_EXPORT void
+        sendTreeDeltaSupport(uint32_t epoch, bool needKeyframe,
+                             uint32_t clientId);
+
+        typedef std::function<void(uint32_t epoch, bool needKeyframe,
+                                   uint32_t clientId)>
+            TreeDeltaSupportHandler;
+        OSVR_COMMON_EXPORT void
+        registerTreeDeltaSupportHandler(TreeDeltaSupportHandler cb);
+
       private:
         SystemComponent();
         virtual void m_parentSet();
         static int VRPN_CALLBACK
         m_handleReplaceTree(void *userdata, vrpn_HANDLERPARAM p);
+        static int VRPN_CALLBACK
+        m_handleTreeDelta(void *userdata, vrpn_HANDLERPARAM p);
+        static int VRPN_CALLBACK
+        m_handleTreeDeltaQuery(void *userdata, vrpn_HANDLERPARAM p);
+        static int VRPN_CALLBACK
+        m_handleTreeDeltaSupport(void *userdata, vrpn_HANDLERPARAM p);
 
         std::vector<JsonHandler> m_replaceTreeHandlers;
+        std::vector<JsonHandler> m_treeDeltaHandlers;
+        std::vector<TreeDeltaQueryHandler> m_treeDeltaQueryHandlers;
+        std::vector<TreeDeltaSupportHandler> m_treeDeltaSupportHandlers;
     };
 } // namespace common
 } // namespace osvr
@@ -0,0 +1,106 @@
+/** @file
+    @brief Header with functions for applying real-time scheduling settings
+   (policy, priority, CPU affinity, timer slack) to latency-sensitive
+   threads.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_ThreadScheduling_h_GUID_93C1F6A2_0E7B_4D58_B4A9_6F2D8E1C7B35
+#define INCLUDED_ThreadScheduling_h_GUID_93C1F6A2_0E7B_4D58_B4A9_6F2D8E1C7B35
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+
+// Library/third-party includes
+#include <json/value.h>
+
+// Standard includes
+#include <string>
+#include <vector>
+
+namespace osvr {
+namespace common {
+    /// @brief Scheduling settings for a latency-sensitive thread (server loop,
+    /// tracker, image processing).
+    ///
+    /// Currently only applied on Linux: elsewhere, applying them just logs a
+    /// notice. The defaults change nothing.
+    struct ThreadSchedulingOptions {
+        enum class Policy {
+            /// Leave the scheduling policy alone.
+            Default,
+            /// SCHED_FIFO
+            Fifo,
+            /// SCHED_RR
+            RoundRobin
+        };
+        Policy policy = Policy::Default;
+        /// Real-time priority (1-99 on Linux) for the Fifo and RoundRobin
+        /// policies.
+        int priority = 1;
+        /// CPUs to restrict the thread to: empty to leave affinity alone.
+        std::vector<int> cpus;
+        /// Timer slack in nanoseconds (how late the kernel may wake the thread
+        /// from sleeps to batch wakeups): negative to leave it alone.
+        long timerSlackNs = -1;
+
+        /// @brief Do these options change anything?
+        bool isDefault() const {
+            return policy == Policy::Default && cpus.empty() &&
+                   timerSlackNs < 0;
+        }
+    };
+
+    /// @brief Parses scheduling options from a JSON object, with the optional
+    /// members "policy" ("fifo", "rr", or "default"), "priority", "cpus" (an
+    /// array of CPU numbers) and "timerSlackNs". A null value gives the
+    /// defaults.
+    ///
+    /// @throws std::invalid_argument on an unrecognized policy or a CPU number
+    /// that isn't a non-negative integer.
+    OSVR_COMMON_EXPORT ThreadSchedulingOptions
+    parseThreadSchedulingOptions(Json::Value const &config);
+
+    /// @brief Applies the options to the calling thread.
+    ///
+    /// Each setting is attempted independently: failures (most commonly lack
+    /// of privileges - real-time policies need CAP_SYS_NICE or a suitable
+    /// RLIMIT_RTPRIO) are logged as warnings and the thread keeps running with
+    /// whatever did succeed. CPU numbers beyond what the platform supports
+    /// are skipped with a warning.
+    ///
+    /// @param threadName Used only for log messages.
+    /// @return true if everything requested was applied.
+    OSVR_COMMON_EXPORT bool
+    applyThreadScheduling(ThreadSchedulingOptions const &opts,
+                          std::string const &threadName);
+
+    /// @brief Locks all current and future pages of the process into RAM
+    /// (mlockall), so that page faults can't stall latency-sensitive threads.
+    /// Failure is logged as a warning.
+    ///
+    /// @return true on success.
+    OSVR_COMMON_EXPORT bool lockProcessMemory();
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_ThreadScheduling_h_GUID_93C1F6A2_0E7B_4D58_B4A9_6F2D8E1C7B35
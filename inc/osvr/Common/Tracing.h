@@ -103,6 +103,31 @@ namespace common {
         inline void markConcatenation(const char *, std::string const &) {}
 #endif // !OSVR_COMMON_TRACING_ENABLED
 
+#ifdef OSVR_COMMON_TRACING_PORTABLE
+        /// @brief Starts recording trace events (into per-thread in-memory
+        /// ring buffers) to be written to @p filename as Chrome trace-event
+        /// JSON, viewable in chrome://tracing or the Perfetto UI, by
+        /// writeTraceRecording() and at process exit.
+        ///
+        /// Recording can also be started by setting the OSVR_TRACE_FILE
+        /// environment variable to the filename. Each thread keeps its most
+        /// recent 65536 events (override with OSVR_TRACE_BUFFER_EVENTS).
+        ///
+        /// @return false if this build has no in-process tracing backend.
+        OSVR_COMMON_EXPORT bool
+        startTraceRecording(std::string const &filename);
+
+        /// @brief Writes the events currently buffered to the trace file,
+        /// replacing its contents.
+        ///
+        /// @return false if not recording, if this build has no in-process
+        /// tracing backend, or if the file could not be written.
+        OSVR_COMMON_EXPORT bool writeTraceRecording();
+#else
+        inline bool startTraceRecording(std::string const &) { return false; }
+        inline bool writeTraceRecording() { return false; }
+#endif
+
         // -- Common code between dummy implementation and real implementation
 
         /// @brief "Guard"-type class to trace the region of a server update
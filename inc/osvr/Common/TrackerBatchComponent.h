@@ -0,0 +1,124 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_TrackerBatchComponent_h_GUID_4A7E1D93_25C6_4B8F_9E07_C3D61F8A52B0
+#define INCLUDED_TrackerBatchComponent_h_GUID_4A7E1D93_25C6_4B8F_9E07_C3D61F8A52B0
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Common/DeviceComponent.h>
+#include <osvr/Common/SerializationTags.h>
+#include <osvr/Common/SerializationTraits.h>
+#include <osvr/Util/ChannelCountC.h>
+#include <osvr/Util/ClientReportTypesC.h>
+
+// Library/third-party includes
+#include <vrpn_BaseClass.h>
+
+// Standard includes
+#include <vector>
+
+namespace osvr {
+namespace common {
+
+    /// @brief The pose of a single sensor within a batch.
+    struct TrackerPoseData {
+        OSVR_ChannelCount sensor;
+        OSVR_PoseState pose;
+    };
+
+    typedef std::vector<TrackerPoseData> TrackerPoseBatch;
+
+    namespace serialization {
+        template <>
+        struct SimpleStructSerialization<TrackerPoseData>
+            : SimpleStructSerializationBase {
+            template <typename F, typename T> static void apply(F &f, T &val) {
+                f(val.sensor);
+                f(val.pose);
+            }
+        };
+    } // namespace serialization
+
+    namespace messages {
+        class PoseBatch : public MessageRegistration<PoseBatch> {
+          public:
+            class MessageSerialization;
+
+            static const char *identifier();
+        };
+
+    } // namespace messages
+
+    /// @brief BaseDevice component carrying the poses of any number of tracker
+    /// sensors, sampled at the same time, in a single message.
+    ///
+    /// For devices with many sensors (skeletons, multi-body trackers), this
+    /// replaces one VRPN tracker message (and one client-side dispatch per
+    /// handler) per sensor with one per frame.
+    class TrackerBatchComponent : public DeviceComponent {
+      public:
+        /// @brief Factory method
+        ///
+        /// Required to ensure that allocation and deallocation stay on the same
+        /// side of a DLL line.
+        static OSVR_COMMON_EXPORT shared_ptr<TrackerBatchComponent>
+        create(OSVR_ChannelCount numSensor = 1);
+
+        /// @brief Message from server to client, containing a batch of poses.
+        messages::PoseBatch poseBatch;
+
+        /// @brief Server side: sends the poses of @p count sensors with a
+        /// shared timestamp.
+        ///
+        /// @param sensors Sensor number for each pose, or nullptr if the poses
+        /// are for sensors 0 through count - 1 in order.
+        OSVR_COMMON_EXPORT void sendPoses(OSVR_PoseState const *poses,
+                                          OSVR_ChannelCount const *sensors,
+                                          std::size_t count,
+                                          OSVR_TimeValue const &timestamp);
+
+        typedef std::function<void(TrackerPoseBatch const &,
+                                   util::time::TimeValue const &)>
+            PoseBatchHandler;
+        OSVR_COMMON_EXPORT void registerPoseBatchHandler(PoseBatchHandler cb);
+
+      private:
+        TrackerBatchComponent(OSVR_ChannelCount numChan);
+        virtual void m_parentSet();
+
+        static int VRPN_CALLBACK
+        m_handlePoseBatch(void *userdata, vrpn_HANDLERPARAM p);
+
+        OSVR_ChannelCount m_numSensor;
+        std::vector<PoseBatchHandler> m_cb;
+        /// @brief Reused between messages to avoid reallocating.
+        TrackerPoseBatch m_batch;
+    };
+
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_TrackerBatchComponent_h_GUID_4A7E1D93_25C6_4B8F_9E07_C3D61F8A52B0
@@ -45,6 +45,10 @@ namespace common {
         bool reportsAngularVelocity = false;
         bool reportsLinearAcceleration = false;
         bool reportsAngularAcceleration = false;
+        /// Whether poses (also) arrive in batched messages from a
+        /// TrackerBatchComponent rather than only as individual VRPN tracker
+        /// messages.
+        bool reportsBatchedPoses = false;
     };
 
     /// Given a fully-parsed tracker source, determines what messages and
@@ -77,6 +81,7 @@ namespace common {
             getBool(root, "linearAcceleration", info.reportsLinearAcceleration);
             getBool(root, "angularAcceleration",
                     info.reportsAngularAcceleration);
+            getBool(root, "batched", info.reportsBatchedPoses);
         };
         TrackerSensorInfo ret;
 
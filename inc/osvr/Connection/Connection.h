@@ -31,6 +31,9 @@
 #include <osvr/Connection/ConnectionDevicePtr.h>
 #include <osvr/Connection/ConnectionPtr.h>
 #include <osvr/Connection/DeviceInitObject.h>
+#include <osvr/Connection/ReportRateLimit.h>
+#include <osvr/Common/DirectReportDispatch_fwd.h>
+#include <osvr/Common/PathTreeOwnerPtr.h>
 #include <osvr/Util/DeviceCallbackTypesC.h>
 #include <osvr/PluginHost/RegistrationContext_fwd.h>
 #include <osvr/Util/Log.h>
@@ -39,6 +42,8 @@
 #include <boost/noncopyable.hpp>
 #include <boost/optional.hpp>
 #include <boost/range/iterator_range.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
 
 // Standard includes
 #include <string>
@@ -112,6 +117,35 @@ namespace connection {
         /// Someone needs to call this method frequently.
         OSVR_CONNECTION_EXPORT void process();
 
+        /// @brief Notify anyone waiting in waitForActivity() or
+        /// waitForActivityOrMessages() that there is work for the thread
+        /// calling process() (for instance, an asynchronous device waiting to
+        /// send).
+        ///
+        /// Safe to call from any thread.
+        OSVR_CONNECTION_EXPORT void signalActivity();
+
+        /// @brief Blocks until signalActivity() is called, or the given number
+        /// of microseconds elapse. Returns immediately if there was activity
+        /// since the last wait, or if the time given is 0.
+        ///
+        /// Note that this does not wait on messages arriving from the
+        /// underlying transport: see waitForActivityOrMessages() for that.
+        ///
+        /// @returns true if there was activity, false on timeout.
+        OSVR_CONNECTION_EXPORT bool waitForActivity(int microseconds);
+
+        /// @brief Like waitForActivity(), but also returns early when
+        /// messages arrive from the underlying transport, in a single blocking
+        /// wait where the transport supports it.
+        ///
+        /// No message handlers run here: arriving messages are left for the
+        /// next process(). Call only from the thread calling process().
+        ///
+        /// @returns true if there was activity or messages arrived, false on
+        /// timeout.
+        OSVR_CONNECTION_EXPORT bool waitForActivityOrMessages(int microseconds);
+
         /// @brief Register a function to be called when a client connects or
         /// pings.
         OSVR_CONNECTION_EXPORT void
@@ -125,6 +159,43 @@ namespace connection {
         /// handlers.
         OSVR_CONNECTION_EXPORT void triggerDescriptorHandlers();
 
+        /// @brief Sets a registry through which devices created from now on
+        /// deliver supported reports (currently tracker reports) directly to
+        /// client-side handlers in the same process, instead of sending them
+        /// over the connection. Only for connections with no out-of-process
+        /// clients, such as the loopback connection of a joint client
+        /// context: anything in-process that still listens on the connection
+        /// must call common::DirectReportDispatch::requireWire().
+        OSVR_CONNECTION_EXPORT void setDirectReportDispatch(
+            common::DirectReportDispatchPtr const &dispatch);
+
+        /// @brief Gets the direct report registry, if any (usually null).
+        OSVR_CONNECTION_EXPORT common::DirectReportDispatchPtr const &
+        getDirectReportDispatch() const;
+
+        /// @brief Sets the read-only copy of the server's path tree that
+        /// in-process client contexts (such as those of analysis plugins) may
+        /// observe and copy, instead of each receiving and parsing the tree
+        /// from the connection. The server keeps it current, in its own
+        /// thread. Don't resolve paths in it directly: that adds nodes.
+        OSVR_CONNECTION_EXPORT void
+        setSharedPathTree(common::PathTreeOwnerPtr const &tree);
+
+        /// @brief Gets the shared path tree, if any (null unless set by a
+        /// server).
+        OSVR_CONNECTION_EXPORT common::PathTreeOwnerPtr const &
+        getSharedPathTree() const;
+
+        /// @brief Sets the rates to which the state reports of devices
+        /// created from now on are limited, by device name.
+        OSVR_CONNECTION_EXPORT void
+        setReportRateLimits(ReportRateLimits const &limits);
+
+        /// @brief Gets the report rate limit for the named device (no limit,
+        /// unless one was set).
+        OSVR_CONNECTION_EXPORT ReportRateLimit
+        getReportRateLimit(std::string const &deviceName) const;
+
         /// @brief Destructor
         OSVR_CONNECTION_EXPORT virtual ~Connection();
 
@@ -197,6 +268,16 @@ namespace connection {
         /// block.
         virtual void m_process() = 0;
 
+        /// @brief (Subclass implementation) Wait up to the given time for
+        /// activity or incoming messages. The default only waits for
+        /// activity.
+        virtual bool m_waitForActivityOrMessages(int microseconds);
+
+        /// @brief (Subclass implementation) Called from signalActivity() on
+        /// the signalling thread, to interrupt a wait in
+        /// m_waitForActivityOrMessages(). The default does nothing.
+        virtual void m_activitySignalled();
+
         /// brief Constructor
         Connection();
 
@@ -204,6 +285,16 @@ namespace connection {
         DeviceList m_devices;
         std::vector<std::function<void()> > m_descriptorHandlers;
         util::log::LoggerPtr m_log;
+        common::DirectReportDispatchPtr m_directDispatch;
+        common::PathTreeOwnerPtr m_sharedTree;
+        ReportRateLimits m_reportRateLimits;
+
+        /// @name Activity signalling
+        /// @{
+        boost::mutex m_activityMutex;
+        boost::condition_variable m_activityCond;
+        bool m_activityPending = false;
+        /// @}
     };
 } // namespace connection
 } // namespace osvr
@@ -28,6 +28,7 @@
 // Internal Includes
 #include <osvr/Connection/DeviceInitObject_fwd.h>
 #include <osvr/Util/ChannelCountC.h>
+#include <osvr/Util/AsyncSendOverflowPolicyC.h>
 #include <osvr/Util/PluginRegContextC.h>
 #include <osvr/PluginHost/PluginSpecificRegistrationContext.h>
 #include <osvr/Util/StdInt.h>
@@ -86,6 +87,12 @@ struct OSVR_DeviceInitObject : boost::noncopyable {
     OSVR_CONNECTION_EXPORT void
     setTracker(osvr::connection::TrackerServerInterface **iface);
 
+    /// @brief Configures the queue used for data sent by an asynchronous
+    /// device: its capacity (in messages; 0 for the default) and what to do
+    /// when it is full. Ignored for other kinds of devices.
+    OSVR_CONNECTION_EXPORT void
+    setAsyncSendQueue(uint32_t capacity, OSVR_AsyncSendOverflowPolicy policy);
+
     /// @brief Add a server interface pointer to our list, which will get
     /// registered when the device is created.
     OSVR_CONNECTION_EXPORT void
@@ -156,6 +163,13 @@ struct OSVR_DeviceInitObject : boost::noncopyable {
         return m_components;
     }
 
+    uint32_t getAsyncSendQueueCapacity() const {
+        return m_asyncSendQueueCapacity;
+    }
+    OSVR_AsyncSendOverflowPolicy getAsyncSendOverflowPolicy() const {
+        return m_asyncSendOverflowPolicy;
+    }
+
   private:
     osvr::pluginhost::PluginSpecificRegistrationContext *m_context;
     osvr::connection::ConnectionPtr m_conn;
@@ -169,6 +183,9 @@ struct OSVR_DeviceInitObject : boost::noncopyable {
     osvr::connection::TrackerServerInterface **m_trackerIface;
     osvr::connection::ServerInterfaceList m_serverInterfaces;
     osvr::common::DeviceComponentList m_components;
+    uint32_t m_asyncSendQueueCapacity = 0;
+    OSVR_AsyncSendOverflowPolicy m_asyncSendOverflowPolicy =
+        OSVR_ASYNC_SEND_DROP_NEWEST;
     std::vector<OSVR_DeviceTokenObject **> m_tokenInterest;
 
     std::vector<osvr::connection::DeviceInterfaceBase *> m_deviceInterfaces;
@@ -49,6 +49,15 @@ namespace connection {
                                                  "with a device token!");
             return m_token->getSendGuard();
         }
+        /// @brief Sends a packed report through the device token: see
+        /// OSVR_DeviceTokenObject::sendPackedReport().
+        bool sendPackedReport(PackedReportFunction f, void *userdata,
+                              const char *data, size_t len) {
+            BOOST_ASSERT_MSG(m_token != nullptr, "Can't send a report "
+                                                 "before we've been supplied "
+                                                 "with a device token!");
+            return m_token->sendPackedReport(f, userdata, data, len);
+        }
 
       private:
         DeviceToken *m_token = nullptr;
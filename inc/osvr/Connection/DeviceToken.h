@@ -35,6 +35,7 @@
 #include <osvr/Util/DeviceCallbackTypesC.h>
 #include <osvr/Util/TimeValue.h>
 #include <osvr/Util/GuardPtr.h>
+#include <osvr/Util/StdInt.h>
 #include <osvr/Connection/ServerInterfaceList.h>
 #include <osvr/Util/KeyedOwnershipContainer.h>
 
@@ -44,10 +45,18 @@
 // Standard includes
 #include <string>
 #include <functional>
+#include <cstddef>
 
 namespace osvr {
 namespace connection {
     typedef std::function<OSVR_ReturnCode()> DeviceUpdateCallback;
+
+    /// @brief Sends a report packed by a device interface, given the bytes
+    /// it was packed into - or, if send is false, releases whatever the
+    /// packed report holds without sending it. See
+    /// OSVR_DeviceTokenObject::sendPackedReport().
+    typedef void (*PackedReportFunction)(void *userdata, const char *data,
+                                         size_t len, bool send);
 } // namespace connection
 } // namespace osvr
 
@@ -96,24 +105,70 @@ struct OSVR_DeviceTokenObject : boost::noncopyable {
     /// The timestamp for the data is assumed to be at the time this call is
     /// placed.
     ///
-    /// This may block until the next connectionInteract call before
-    /// forwarding on to ConnectionDevice::sendData, depending on the type
-    /// of device token.
+    /// Depending on the type of device token, this may be forwarded on to
+    /// ConnectionDevice::sendData directly, or queued until the next
+    /// connectionInteract call (async device tokens).
     OSVR_CONNECTION_EXPORT void sendData(osvr::connection::MessageType *type,
                                          const char *bytestream, size_t len);
 
     /// @brief Send data.
     ///
-    /// This may block until the next connectionInteract call before
-    /// forwarding on to ConnectionDevice::sendData, depending on the type
-    /// of device token.
+    /// Depending on the type of device token, this may be forwarded on to
+    /// ConnectionDevice::sendData directly, or queued until the next
+    /// connectionInteract call (async device tokens).
     OSVR_CONNECTION_EXPORT void
     sendData(osvr::util::time::TimeValue const &timestamp,
              osvr::connection::MessageType *type, const char *bytestream,
              size_t len);
 
+    /// @brief Send a report from a device interface, without waiting on the
+    /// send guard.
+    ///
+    /// The report's arguments are packed into the given bytes, which are
+    /// copied: f is then called with them, and send set to true, on the
+    /// thread allowed to send the device's messages. For an asynchronous
+    /// device, that's the server thread, in order with sendData() calls,
+    /// and this doesn't wait for it. If the report is dropped instead
+    /// (because an asynchronous device's send queue overflowed), f is
+    /// called with send set to false, possibly on another thread, so it
+    /// must then not touch the interface.
+    ///
+    /// @return false if the report was dropped.
+    OSVR_CONNECTION_EXPORT bool
+    sendPackedReport(osvr::connection::PackedReportFunction f,
+                     void *userdata, const char *data, size_t len);
+
+    /// @brief Gets a guard to lock before sending.
+    ///
+    /// Within a send transaction, returns a shared guard that is always
+    /// granted (without allocating), since the transaction already holds the
+    /// real one.
     OSVR_CONNECTION_EXPORT osvr::util::GuardPtr getSendGuard();
 
+    /// @brief Begins a send transaction: acquires the send guard once, so
+    /// the reports sent until the matching endSendTransaction() don't each
+    /// have to.
+    ///
+    /// Transactions may be nested: the guard is held until the outermost
+    /// one ends. Like the update callback, a transaction belongs to the
+    /// thread that sends the device's reports - begin it, send, and end it
+    /// on that thread.
+    ///
+    /// @return false if the send guard couldn't be acquired, in which case
+    /// no transaction was begun.
+    OSVR_CONNECTION_EXPORT bool beginSendTransaction();
+
+    /// @brief Ends a send transaction begun by beginSendTransaction(),
+    /// releasing the send guard if it's the outermost one.
+    ///
+    /// @return false if there was no transaction to end.
+    OSVR_CONNECTION_EXPORT bool endSendTransaction();
+
+    /// @brief Gets the number of messages passed to sendData() that were
+    /// dropped rather than sent (because an asynchronous device's send queue
+    /// overflowed). Always 0 for other kinds of device token.
+    OSVR_CONNECTION_EXPORT uint64_t getDroppedMessageCount() const;
+
     /// @brief Interact with connection. Only legal to end up in
     /// ConnectionDevice::sendData from within here somehow.
     void connectionInteract();
@@ -147,6 +202,18 @@ struct OSVR_DeviceTokenObject : boost::noncopyable {
                             osvr::connection::MessageType *type,
                             const char *bytestream, size_t len) = 0;
     virtual osvr::util::GuardPtr m_getSendGuard() = 0;
+    /// @brief Default sends the packed report right away, under the send
+    /// guard.
+    virtual bool m_sendPackedReport(osvr::connection::PackedReportFunction f,
+                                    void *userdata, const char *data,
+                                    size_t len);
+    /// @brief Called when the outermost send transaction has ended and
+    /// released the send guard. Default does nothing.
+    virtual void m_sendTransactionEnded();
+    /// @brief Whether a send transaction is in progress - only meaningful
+    /// on the thread sending the device's reports.
+    bool m_inSendTransaction() const { return m_sendTransactionDepth > 0; }
+    virtual uint64_t m_getDroppedMessageCount() const;
     virtual void m_connectionInteract() = 0;
     virtual void m_stopThreads();
 
@@ -158,6 +225,9 @@ struct OSVR_DeviceTokenObject : boost::noncopyable {
     osvr::connection::ServerInterfaceList m_serverInterfaces;
     EventFunction m_preConnectionInteract;
     osvr::util::MultipleKeyedOwnershipContainer m_ownedObjects;
+    /// @brief The send guard held by the outermost send transaction.
+    osvr::util::GuardPtr m_transactionGuard;
+    std::size_t m_sendTransactionDepth = 0;
 };
 
 #endif // INCLUDED_DeviceToken_h_GUID_428B015C_19A2_46B0_CFE6_CC100763D387
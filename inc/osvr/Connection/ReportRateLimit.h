@@ -0,0 +1,61 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_ReportRateLimit_h_GUID_A47D2E18_5C93_4F0B_B6E2_19F8C3D70A5E
+#define INCLUDED_ReportRateLimit_h_GUID_A47D2E18_5C93_4F0B_B6E2_19F8C3D70A5E
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <map>
+#include <string>
+
+namespace osvr {
+namespace connection {
+    /// @brief Maximum rates, in reports per second, at which a device's state
+    /// reports are sent to clients. 0 means no limit.
+    ///
+    /// When a device reports faster than this, only the latest report is
+    /// sent once the interval is up: clients still see the current state,
+    /// they just aren't sent every intermediate one.
+    struct ReportRateLimit {
+        /// @brief Per sensor, for poses, positions and orientations. Velocity
+        /// and acceleration reports are always all sent.
+        double tracker = 0;
+        /// @brief For analog values.
+        double analog = 0;
+    };
+
+    /// @brief Rate limits by device name (plugin name, slash, device name).
+    ///
+    /// Buttons have no limit, since every press and release matters.
+    typedef std::map<std::string, ReportRateLimit> ReportRateLimits;
+} // namespace connection
+} // namespace osvr
+
+#endif // INCLUDED_ReportRateLimit_h_GUID_A47D2E18_5C93_4F0B_B6E2_19F8C3D70A5E
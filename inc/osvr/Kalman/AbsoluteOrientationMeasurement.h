@@ -107,6 +107,8 @@ namespace kalman {
         static const types::DimensionType STATE_DIMENSION =
             types::Dimension<State>::value;
         using Base = AbsoluteOrientationBase;
+        /// Only depends on the incremental orientation.
+        using JacobianStructure = JacobianBlocks<JacobianBlock<3, 3>>;
 
         AbsoluteOrientationMeasurement(Eigen::Quaterniond const &quat,
                                        types::Vector<3> const &eulerVariance)
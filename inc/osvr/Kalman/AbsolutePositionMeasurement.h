@@ -93,6 +93,8 @@ namespace kalman {
             types::Dimension<State>::value;
         using Base = AbsolutePositionBase;
         using Jacobian = types::Matrix<DIMENSION, STATE_DIMENSION>;
+        /// Only depends on the position.
+        using JacobianStructure = JacobianBlocks<JacobianBlock<0, 3>>;
         AbsolutePositionMeasurement(MeasurementVector const &pos,
                                     MeasurementVector const &variance)
             : Base(pos, variance), m_jacobian(Jacobian::Zero()) {
@@ -91,6 +91,8 @@ namespace kalman {
         static const types::DimensionType STATE_DIMENSION =
             types::Dimension<State>::value;
         using Base = AngularVelocityBase;
+        /// Only depends on the angular velocity.
+        using JacobianStructure = JacobianBlocks<JacobianBlock<9, 3>>;
 
         AngularVelocityMeasurement(MeasurementVector const &vel,
                                    MeasurementVector const &variance)
@@ -117,6 +119,8 @@ namespace kalman {
         static const types::DimensionType STATE_DIMENSION =
             types::Dimension<State>::value;
         using Base = AngularVelocityBase;
+        /// Only depends on the angular velocity.
+        using JacobianStructure = JacobianBlocks<JacobianBlock<3, 3>>;
 
         AngularVelocityMeasurement(MeasurementVector const &vel,
                                    MeasurementVector const &variance)
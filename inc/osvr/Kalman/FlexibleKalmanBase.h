@@ -126,6 +126,25 @@ namespace kalman {
 
     } // namespace types
 
+    /// Identifies a block of Cols columns, starting at Offset, that may be
+    /// non-zero in a measurement Jacobian.
+    template <types::DimensionType Offset, types::DimensionType Cols>
+    struct JacobianBlock {
+        static const types::DimensionType offset = Offset;
+        static const types::DimensionType cols = Cols;
+    };
+
+    /// A measurement type whose Jacobian is zero outside of a few blocks of
+    /// columns can declare so with a member type alias like
+    ///
+    ///     using JacobianStructure = JacobianBlocks<JacobianBlock<0, 3>>;
+    ///
+    /// beginCorrection() then computes P H^T and H P H^T from just those
+    /// blocks, rather than with dense products mostly spent multiplying by
+    /// zero. The blocks must not overlap. getJacobian() must still return
+    /// the full matrix.
+    template <typename... Blocks> struct JacobianBlocks {};
+
     /// Computes P-
     ///
     /// Usage is optional, most likely called from the process model
@@ -149,6 +168,56 @@ namespace kalman {
                processModel.getSampledProcessNoiseCovariance(dt);
     }
 
+    /// Computes P- for the common case of a state made of N values followed
+    /// by their N derivatives, with a state transition matrix of the form
+    ///
+    ///     A = [ I  dt*I ; 0  diag(attenuation) ]
+    ///
+    /// and the sampled process noise covariance of eq. 4.8 in Welch 1996,
+    /// which is made of diagonal N x N blocks:
+    ///
+    ///     Q = [ diag(mu) dt^3/3  diag(mu) dt^2/2 ;
+    ///           diag(mu) dt^2/2  diag(mu) dt     ]
+    ///
+    /// Gives the same result as predictErrorCovariance() for such process
+    /// models, but works in N x N blocks, skipping all the multiplications by
+    /// zero and identity that the dense A P A^T does.
+    ///
+    /// @param P The error covariance to predict from, of dimension 2N x 2N.
+    /// @param attenuation The factors the derivatives get scaled by over dt
+    /// (all ones for an undamped model)
+    /// @param mu The noise autocorrelation for each of the N values.
+    template <types::DimensionType N>
+    inline types::SquareMatrix<2 * N>
+    predictConstantVelocityErrorCovariance(
+        types::SquareMatrix<2 * N> const &P, double dt,
+        types::Vector<N> const &attenuation, types::Vector<N> const &mu) {
+        using Block = types::SquareMatrix<N>;
+        types::SquareMatrix<2 * N> ret;
+        auto P11 = P.template topLeftCorner<N, N>();
+        auto P12 = P.template topRightCorner<N, N>();
+        auto P21 = P.template bottomLeftCorner<N, N>();
+        auto P22 = P.template bottomRightCorner<N, N>();
+
+        /// The top right block of A P, used twice.
+        Block AP12 = P12 + dt * P22;
+        ret.template topLeftCorner<N, N>() = P11 + dt * P21 + dt * AP12;
+        ret.template topRightCorner<N, N>() = AP12 * attenuation.asDiagonal();
+        ret.template bottomLeftCorner<N, N>() =
+            attenuation.asDiagonal() * (P21 + dt * P22);
+        ret.template bottomRightCorner<N, N>() =
+            attenuation.asDiagonal() * P22 * attenuation.asDiagonal();
+
+        /// Now add Q, which only touches the diagonals of each block.
+        auto dt3 = (dt * dt * dt) / 3;
+        auto dt2 = (dt * dt) / 2;
+        ret.template topLeftCorner<N, N>().diagonal() += mu * dt3;
+        ret.template topRightCorner<N, N>().diagonal() += mu * dt2;
+        ret.template bottomLeftCorner<N, N>().diagonal() += mu * dt2;
+        ret.template bottomRightCorner<N, N>().diagonal() += mu * dt;
+        return ret;
+    }
+
 } // namespace kalman
 } // namespace osvr
 
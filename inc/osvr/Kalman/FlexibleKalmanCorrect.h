@@ -129,6 +129,77 @@ namespace kalman {
         StateType &state_;
     };
 
+    namespace detail {
+        /// The "structure" of a measurement that doesn't declare any.
+        struct DenseJacobian {};
+
+        template <typename... Ts> struct make_void { using type = void; };
+
+        template <typename MeasurementType, typename = void>
+        struct JacobianStructureOf {
+            using type = DenseJacobian;
+        };
+        template <typename MeasurementType>
+        struct JacobianStructureOf<
+            MeasurementType,
+            typename make_void<
+                typename MeasurementType::JacobianStructure>::type> {
+            using type = typename MeasurementType::JacobianStructure;
+        };
+
+        /// Computes P H^T (into PHt) and H P H^T (into S).
+        template <typename PType, typename HType, typename PHtType,
+                  typename SType>
+        inline void computeInnovationProducts(PType const &P, HType const &H,
+                                              PHtType &PHt, SType &S,
+                                              DenseJacobian) {
+            PHt = P * H.transpose();
+            S = H * PHt;
+        }
+
+        /// Base case: no more blocks.
+        template <typename PType, typename HType, typename PHtType>
+        inline void accumulatePHt(PType const &, HType const &, PHtType &,
+                                  JacobianBlocks<>) {}
+
+        template <typename PType, typename HType, typename PHtType,
+                  typename Block, typename... Rest>
+        inline void accumulatePHt(PType const &P, HType const &H, PHtType &PHt,
+                                  JacobianBlocks<Block, Rest...>) {
+            PHt.noalias() +=
+                P.template middleCols<Block::cols>(Block::offset) *
+                H.template middleCols<Block::cols>(Block::offset).transpose();
+            accumulatePHt(P, H, PHt, JacobianBlocks<Rest...>{});
+        }
+
+        /// Base case: no more blocks.
+        template <typename HType, typename PHtType, typename SType>
+        inline void accumulateHPHt(HType const &, PHtType const &, SType &,
+                                   JacobianBlocks<>) {}
+
+        template <typename HType, typename PHtType, typename SType,
+                  typename Block, typename... Rest>
+        inline void accumulateHPHt(HType const &H, PHtType const &PHt,
+                                   SType &S, JacobianBlocks<Block, Rest...>) {
+            S.noalias() += H.template middleCols<Block::cols>(Block::offset) *
+                           PHt.template middleRows<Block::cols>(Block::offset);
+            accumulateHPHt(H, PHt, S, JacobianBlocks<Rest...>{});
+        }
+
+        template <typename PType, typename HType, typename PHtType,
+                  typename SType, typename... Blocks>
+        inline void
+        computeInnovationProducts(PType const &P, HType const &H, PHtType &PHt,
+                                  SType &S, JacobianBlocks<Blocks...> blocks) {
+            PHt.setZero();
+            accumulatePHt(P, H, PHt, blocks);
+            /// Since H is zero outside the blocks, H P H^T only needs the
+            /// matching rows of P H^T.
+            S.setZero();
+            accumulateHPHt(H, PHt, S, blocks);
+        }
+    } // namespace detail
+
     template <typename StateType, typename ProcessModelType,
               typename MeasurementType>
     inline CorrectionInProgress<StateType, MeasurementType>
@@ -150,11 +221,17 @@ namespace kalman {
         types::SquareMatrix<n> P = state.errorCovariance();
 
         /// The kalman gain stuff to not invert (called P12 in TAG)
-        types::Matrix<n, m> PHt = P * H.transpose();
+        types::Matrix<n, m> PHt;
 
         /// the stuff to invert for the kalman gain
         /// also sometimes called S or the "Innovation Covariance"
-        types::SquareMatrix<m> S = H * PHt + R;
+        types::SquareMatrix<m> S;
+
+        /// Exploits the structure of H, if the measurement declares any.
+        detail::computeInnovationProducts(
+            P, H, PHt, S,
+            typename detail::JacobianStructureOf<MeasurementType>::type{});
+        S += R;
 
         /// More computation is done in initializers/constructor
         return CorrectionInProgress<StateType, MeasurementType>(state, meas, P,
@@ -44,6 +44,9 @@ namespace kalman {
         using StateVector = pose_externalized_rotation::StateVector;
         using StateSquareMatrix = pose_externalized_rotation::StateSquareMatrix;
         using NoiseAutocorrelation = types::Vector<6>;
+        /// One entry per velocity: the factors they get scaled by in a
+        /// prediction.
+        using Velocities = types::Vector<6>;
         PoseConstantVelocityProcessModel(double positionNoise = 0.01,
                                          double orientationNoise = 0.1) {
             setNoiseAutocorrelation(positionNoise, orientationNoise);
@@ -56,6 +59,9 @@ namespace kalman {
         void setNoiseAutocorrelation(NoiseAutocorrelation const &noise) {
             m_mu = noise;
         }
+        NoiseAutocorrelation const &getNoiseAutocorrelation() const {
+            return m_mu;
+        }
 
         /// Also known as the "process model jacobian" in TAG, this is A.
         StateSquareMatrix getStateTransitionMatrix(State const &,
@@ -65,7 +71,11 @@ namespace kalman {
 
         void predictState(State &s, double dt) {
             auto xHatMinus = computeEstimate(s, dt);
-            auto Pminus = predictErrorCovariance(s, *this, dt);
+            /// A and Q have a simple block structure: see
+            /// predictConstantVelocityErrorCovariance()
+            StateSquareMatrix Pminus =
+                predictConstantVelocityErrorCovariance<6>(
+                    s.errorCovariance(), dt, Velocities::Ones(), m_mu);
             s.setStateVector(xHatMinus);
             s.setErrorCovariance(Pminus);
         }
@@ -47,6 +47,7 @@ namespace kalman {
         using StateSquareMatrix = pose_externalized_rotation::StateSquareMatrix;
         using BaseProcess = PoseConstantVelocityProcessModel;
         using NoiseAutocorrelation = BaseProcess::NoiseAutocorrelation;
+        using Velocities = BaseProcess::Velocities;
         PoseDampedConstantVelocityProcessModel(double damping = 0.1,
                                                double positionNoise = 0.01,
                                                double orientationNoise = 0.1)
@@ -79,7 +80,15 @@ namespace kalman {
 
         void predictState(State &s, double dt) {
             auto xHatMinus = computeEstimate(s, dt);
-            auto Pminus = predictErrorCovariance(s, *this, dt);
+            /// Same block structure as the undamped model, just with the
+            /// velocity terms attenuated.
+            StateSquareMatrix Pminus =
+                predictConstantVelocityErrorCovariance<6>(
+                    s.errorCovariance(), dt,
+                    Velocities::Constant(
+                        pose_externalized_rotation::computeAttenuation(m_damp,
+                                                                       dt)),
+                    m_constantVelModel.getNoiseAutocorrelation());
             s.setStateVector(xHatMinus);
             s.setErrorCovariance(Pminus);
         }
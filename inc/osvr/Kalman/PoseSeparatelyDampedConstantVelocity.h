@@ -48,6 +48,7 @@ namespace kalman {
         using StateSquareMatrix = pose_externalized_rotation::StateSquareMatrix;
         using BaseProcess = PoseConstantVelocityProcessModel;
         using NoiseAutocorrelation = BaseProcess::NoiseAutocorrelation;
+        using Velocities = BaseProcess::Velocities;
         PoseSeparatelyDampedConstantVelocityProcessModel(
             double positionDamping = 0.3, double orientationDamping = 0.01,
             double positionNoise = 0.01, double orientationNoise = 0.1)
@@ -84,7 +85,17 @@ namespace kalman {
 
         void predictState(State &s, double dt) {
             auto xHatMinus = computeEstimate(s, dt);
-            auto Pminus = predictErrorCovariance(s, *this, dt);
+            /// Same block structure as the undamped model, just with the
+            /// velocity terms attenuated.
+            using pose_externalized_rotation::computeAttenuation;
+            Velocities attenuation;
+            attenuation << Eigen::Vector3d::Constant(
+                computeAttenuation(m_posDamp, dt)),
+                Eigen::Vector3d::Constant(computeAttenuation(m_oriDamp, dt));
+            StateSquareMatrix Pminus =
+                predictConstantVelocityErrorCovariance<6>(
+                    s.errorCovariance(), dt, attenuation,
+                    m_constantVelModel.getNoiseAutocorrelation());
             s.setStateVector(xHatMinus);
             s.setErrorCovariance(Pminus);
         }
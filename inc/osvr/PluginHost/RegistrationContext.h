@@ -41,6 +41,7 @@
 // Standard includes
 #include <string>
 #include <map>
+#include <functional>
 
 namespace osvr {
 /// @brief PluginHost functionality: loading, hosting, registering, destroying,
@@ -76,6 +77,19 @@ namespace pluginhost {
         /// @brief Trigger any registered hardware detect callbacks.
         OSVR_PLUGINHOST_EXPORT void triggerHardwareDetect();
 
+        /// @brief Set the function called by requestHardwareDetect(), which
+        /// should arrange for triggerHardwareDetect() to be called soon on
+        /// the thread that owns this context.
+        OSVR_PLUGINHOST_EXPORT void
+        setHardwareDetectRequestHandler(std::function<void()> const &handler);
+
+        /// @brief Ask the host to trigger hardware detection again soon (for
+        /// instance, once a slow probe running on another thread has found
+        /// something). Does nothing if no handler has been set.
+        ///
+        /// Unlike the rest of this class, may be called from any thread.
+        OSVR_PLUGINHOST_EXPORT void requestHardwareDetect();
+
         /// @brief Call a driver instantiation callback for the given plugin
         /// name and driver name.
         /// @throws std::runtime_error if the plugin named hasn't been loaded,
@@ -181,6 +181,34 @@ namespace pluginkit {
             send(iface, msg, util::time::getNow());
         }
 
+        /// @brief Begins a send transaction, so the reports sent until
+        /// endSendTransaction() lock the device for sending only once.
+        ///
+        /// Prefer the SendTransaction class, which ends it for you.
+        ///
+        /// @sa osvrDeviceBeginSendTransaction()
+        ///
+        /// @throws std::runtime_error if the device couldn't be locked for
+        /// sending.
+        void beginSendTransaction() {
+            m_validateToken();
+            OSVR_ReturnCode ret = osvrDeviceBeginSendTransaction(m_dev);
+            if (OSVR_RETURN_SUCCESS != ret) {
+                throw std::runtime_error("Could not begin send transaction!");
+            }
+        }
+
+        /// @brief Ends a send transaction begun with beginSendTransaction().
+        ///
+        /// @throws std::logic_error if there was no transaction to end.
+        void endSendTransaction() {
+            m_validateToken();
+            OSVR_ReturnCode ret = osvrDeviceEndSendTransaction(m_dev);
+            if (OSVR_RETURN_SUCCESS != ret) {
+                throw std::logic_error("No send transaction to end!");
+            }
+        }
+
         /// @brief Submit a JSON self-descriptor string for the device.
         ///
         /// @param json The JSON string to transmit.
@@ -241,7 +269,7 @@ namespace pluginkit {
         ///
         /// @note The same function is used for synchronous and asynchronous
         /// devices: the device token is sufficient to determine whether locking
-        /// is needed.
+        /// (or, for asynchronous devices, queuing) is needed.
         ///
         /// @param msg The registered message type.
         /// @param bytestream A string of bytes to transmit.
@@ -293,7 +321,7 @@ namespace pluginkit {
         ///
         /// @note The same function is used for synchronous and asynchronous
         /// devices: the device token is sufficient to determine whether locking
-        /// is needed.
+        /// (or, for asynchronous devices, queuing) is needed.
         ///
         /// @param timestamp The timestamp you want to associate with this
         /// message.
@@ -347,6 +375,20 @@ namespace pluginkit {
         }
         /// @}
 
+        /// @brief Gets the number of messages dropped rather than sent due to
+        /// this (asynchronous) device's send queue overflowing.
+        ///
+        /// @throws std::runtime_error if error in getting the count.
+        uint64_t getDroppedMessageCount() const {
+            m_validateToken();
+            uint64_t count = 0;
+            OSVR_ReturnCode ret = osvrDeviceGetDroppedMessageCount(m_dev, &count);
+            if (OSVR_RETURN_SUCCESS != ret) {
+                throw std::runtime_error("Could not get dropped message count!");
+            }
+            return count;
+        }
+
       private:
         /// @brief Verifies that the user calls some init member before using
         /// other features of the token.
@@ -359,6 +401,42 @@ namespace pluginkit {
         OSVR_DeviceToken m_dev;
     };
 
+    /// @brief Scoped send transaction on a device: sends made during its
+    /// lifetime, on any of the device's interfaces, lock the device for
+    /// sending only once.
+    ///
+    /// For instance, in the update method of a device reporting many sensors:
+    ///
+    /// @code
+    /// osvr::pluginkit::SendTransaction transaction(m_dev);
+    /// for (auto sensor = 0; sensor < numSensors; ++sensor) {
+    ///     osvrDeviceTrackerSendPose(m_dev, m_tracker, &poses[sensor],
+    ///                               sensor);
+    /// }
+    /// @endcode
+    ///
+    /// @sa osvrDeviceBeginSendTransaction()
+    class SendTransaction {
+      public:
+        /// @brief Begins the transaction.
+        ///
+        /// @throws std::runtime_error if the device couldn't be locked for
+        /// sending.
+        explicit SendTransaction(DeviceToken &dev) : m_dev(dev) {
+            m_dev.beginSendTransaction();
+        }
+
+        /// @brief Ends the transaction.
+        ~SendTransaction() {
+            osvrDeviceEndSendTransaction(static_cast<OSVR_DeviceToken>(m_dev));
+        }
+
+      private:
+        SendTransaction(SendTransaction const &);
+        SendTransaction &operator=(SendTransaction const &);
+        DeviceToken &m_dev;
+    };
+
     /** @} */
 } // namespace pluginkit
 } // namespace osvr
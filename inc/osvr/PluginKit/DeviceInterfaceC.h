@@ -35,6 +35,7 @@
 #include <osvr/Util/DeviceCallbackTypesC.h>
 #include <osvr/Util/AnnotationMacrosC.h>
 #include <osvr/Util/TimeValueC.h>
+#include <osvr/Util/AsyncSendOverflowPolicyC.h>
 
 /* Library/third-party includes */
 /* none */
@@ -105,6 +106,8 @@ osvrDeviceRegisterMessageType(OSVR_IN_PTR OSVR_PluginRegContext ctx,
 
     @note The same function is used for synchronous and asynchronous devices:
    the device token is sufficient to determine whether locking is needed.
+   Asynchronous devices queue the data without waiting: see
+   osvrDeviceAsyncConfigureSendQueue().
 */
 OSVR_PLUGINKIT_EXPORT OSVR_ReturnCode
 osvrDeviceSendData(OSVR_IN_PTR OSVR_DeviceToken dev,
@@ -116,6 +119,8 @@ osvrDeviceSendData(OSVR_IN_PTR OSVR_DeviceToken dev,
 
     @note The same function is used for synchronous and asynchronous devices:
     the device token is sufficient to determine whether locking is needed.
+    Asynchronous devices queue the data without waiting: see
+    osvrDeviceAsyncConfigureSendQueue().
 */
 OSVR_PLUGINKIT_EXPORT OSVR_ReturnCode
 osvrDeviceSendTimestampedData(OSVR_IN_PTR OSVR_DeviceToken dev,
@@ -124,6 +129,39 @@ osvrDeviceSendTimestampedData(OSVR_IN_PTR OSVR_DeviceToken dev,
                               OSVR_IN_READS(len) const char *bytestream,
                               OSVR_IN size_t len) OSVR_FUNC_NONNULL((1, 2, 3));
 
+/** @brief Begin a send transaction on a device.
+
+    Sending a report (through osvrDeviceSendData() or any of the interface
+   send functions) normally locks the device for sending, and for an
+   asynchronous device that means waiting for the server thread each time. A
+   transaction locks it once for all the reports sent - across any of the
+   device's interfaces - until osvrDeviceEndSendTransaction(), so a device
+   reporting many sensors at once pays that cost once per update instead of
+   once per report. An asynchronous device sends the reports made in a
+   transaction straight away, rather than queueing them for the server
+   thread, which is waiting for the transaction to end. Synchronous devices
+   never wait to send, so a transaction gains them nothing.
+
+    Transactions may be nested, and must be begun, used, and ended on the
+   thread sending the device's reports. Keep them short: an asynchronous
+   device holds up the server thread until the transaction ends.
+
+    @return OSVR_RETURN_FAILURE if the device couldn't be locked for sending
+   (for instance, the server is shutting down), in which case no transaction
+   was begun and there is nothing to end.
+*/
+OSVR_PLUGINKIT_EXPORT OSVR_ReturnCode
+osvrDeviceBeginSendTransaction(OSVR_IN_PTR OSVR_DeviceToken dev)
+    OSVR_FUNC_NONNULL((1));
+
+/** @brief End a send transaction begun with osvrDeviceBeginSendTransaction().
+
+    @return OSVR_RETURN_FAILURE if there was no transaction to end.
+*/
+OSVR_PLUGINKIT_EXPORT OSVR_ReturnCode
+osvrDeviceEndSendTransaction(OSVR_IN_PTR OSVR_DeviceToken dev)
+    OSVR_FUNC_NONNULL((1));
+
 /** @brief Submit a JSON self-descriptor string for the device.
 
     Length does not include null terminator.
@@ -245,6 +283,34 @@ osvrDeviceAsyncInitWithOptions(OSVR_IN_PTR OSVR_PluginRegContext ctx,
                                OSVR_OUT_PTR OSVR_DeviceToken *device)
     OSVR_FUNC_NONNULL((1, 2, 3, 4));
 
+/** @brief Configure the queue that data sent with osvrDeviceSendData() and
+    osvrDeviceSendTimestampedData() from an asynchronous device passes
+    through: those calls copy the data into the queue and return without
+    waiting for the server thread, which sends queued data each time through
+    its loop.
+
+    Call before osvrDeviceAsyncInitWithOptions().
+
+    @param options The DeviceInitOptions for your device.
+    @param capacity Maximum number of messages queued (rounded up to a power of
+    two), or 0 for the default.
+    @param policy What to do when sending while the queue is full.
+*/
+OSVR_PLUGINKIT_EXPORT OSVR_ReturnCode
+osvrDeviceAsyncConfigureSendQueue(OSVR_INOUT_PTR OSVR_DeviceInitOptions options,
+                                  OSVR_IN uint32_t capacity,
+                                  OSVR_IN OSVR_AsyncSendOverflowPolicy policy)
+    OSVR_FUNC_NONNULL((1));
+
+/** @brief Get the number of messages from a device that were dropped rather
+    than sent, due to its send queue overflowing. Always 0 for synchronous
+    devices.
+*/
+OSVR_PLUGINKIT_EXPORT OSVR_ReturnCode
+osvrDeviceGetDroppedMessageCount(OSVR_IN_PTR OSVR_DeviceToken dev,
+                                 OSVR_OUT_PTR uint64_t *count)
+    OSVR_FUNC_NONNULL((1, 2));
+
 /** @} */
 
 /** @brief Request a thread sleep for at least the given number of microseconds.
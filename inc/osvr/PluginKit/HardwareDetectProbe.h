@@ -0,0 +1,121 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_HardwareDetectProbe_h_GUID_5B2E8D71_0C4A_4F36_9E17_A3D6F80B2C49
+#define INCLUDED_HardwareDetectProbe_h_GUID_5B2E8D71_0C4A_4F36_9E17_A3D6F80B2C49
+
+// Internal Includes
+#include <osvr/PluginKit/PluginRegistrationC.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <utility>
+
+namespace osvr {
+namespace pluginkit {
+    /// @brief Runs a slow hardware probe (such as opening a camera) on its
+    /// own thread, so a hardware detect callback doesn't hold up the server's
+    /// main loop while it runs.
+    ///
+    /// Call get() from your hardware detect callback. The first call starts
+    /// the probe and returns false; when the probe finds something, it asks
+    /// the host for another detection pass (see
+    /// osvrPluginRequestHardwareDetect()), in which get() hands over the
+    /// result so you can create your device there, on the main loop as
+    /// usual. A probe that finds nothing doesn't ask: the next detection pass
+    /// the server runs for its own reasons starts a fresh one.
+    ///
+    /// @tparam ResultType What the probe produces - typically an owning
+    /// pointer to the opened hardware - default-constructible, movable, and
+    /// contextually convertible to bool (true meaning "found").
+    template <typename ResultType>
+    class HardwareDetectProbe : boost::noncopyable {
+      public:
+        typedef std::function<ResultType()> ProbeFunction;
+
+        /// @param probe Called on the probe thread. Exceptions it throws
+        /// count as finding nothing.
+        explicit HardwareDetectProbe(ProbeFunction const &probe)
+            : m_probe(probe) {}
+
+        /// @brief Waits for any running probe to finish.
+        ~HardwareDetectProbe() {
+            if (m_thread.joinable()) {
+                m_thread.join();
+            }
+        }
+
+        /// @brief Call from the hardware detect callback.
+        ///
+        /// @param ctx The registration context passed to the callback.
+        /// @param[out] result Receives what the last probe found, if anything.
+        /// @return true if a finished probe found something (now in @p
+        /// result); false if a probe is running or has just been started.
+        bool get(OSVR_PluginRegContext ctx, ResultType &result) {
+            if (m_thread.joinable()) {
+                if (!m_done) {
+                    return false;
+                }
+                m_thread.join();
+                if (m_result) {
+                    result = std::move(m_result);
+                    m_result = ResultType();
+                    return true;
+                }
+            }
+            m_done = false;
+            m_thread = std::thread([this, ctx] {
+                ResultType found;
+                try {
+                    found = m_probe();
+                } catch (std::exception &) {
+                    found = ResultType();
+                }
+                bool foundSomething(found);
+                m_result = std::move(found);
+                m_done = true;
+                if (foundSomething) {
+                    osvrPluginRequestHardwareDetect(ctx);
+                }
+            });
+            return false;
+        }
+
+      private:
+        ProbeFunction m_probe;
+        std::thread m_thread;
+        /// Set by the probe thread once m_result is written.
+        std::atomic<bool> m_done{false};
+        ResultType m_result;
+    };
+} // namespace pluginkit
+} // namespace osvr
+
+#endif // INCLUDED_HardwareDetectProbe_h_GUID_5B2E8D71_0C4A_4F36_9E17_A3D6F80B2C49
@@ -119,18 +119,9 @@ namespace pluginkit {
                 throw std::logic_error(
                     "Must initialize the imaging interface before using it!");
             }
-            cv::Mat const &frame(message.getFrame());
-            util::NumberTypeData typedata =
-                util::opencvNumberTypeData(frame.type());
-            OSVR_ImagingMetadata metadata;
-            metadata.channels = frame.channels();
-            metadata.depth = static_cast<OSVR_ImageDepth>(typedata.getSize());
-            metadata.width = frame.cols;
-            metadata.height = frame.rows;
-            metadata.type = typedata.isFloatingPoint()
-                                ? OSVR_IVT_FLOATING_POINT
-                                : (typedata.isSigned() ? OSVR_IVT_SIGNED_INT
-                                                       : OSVR_IVT_UNSIGNED_INT);
+            OSVR_ImagingMetadata metadata =
+                getMetadata(message.getFrame().size(),
+                            message.getFrame().type());
 
             OSVR_ReturnCode ret = osvrDeviceImagingReportFrame(
                 dev, m_iface, metadata, message.getBuf(), message.getSensor(),
@@ -140,7 +131,66 @@ namespace pluginkit {
             }
         }
 
+        /// @brief Reserves the next frame slot for a sensor, returning a
+        /// cv::Mat header wrapping it (usually shared memory read directly by
+        /// clients) so you can capture or decode into it without a copy.
+        /// Follow with commitFrame() or cancelFrame() for the same sensor; do
+        /// not use the returned cv::Mat afterwards.
+        cv::Mat reserveFrame(DeviceToken &dev, cv::Size const &size, int type,
+                             OSVR_ChannelCount sensor = 0) {
+            if (!m_iface) {
+                throw std::logic_error(
+                    "Must initialize the imaging interface before using it!");
+            }
+            OSVR_ImageBufferElement *buf = NULL;
+            OSVR_ReturnCode ret = osvrDeviceImagingReserveFrame(
+                dev, m_iface, getMetadata(size, type), sensor, &buf);
+            if (OSVR_RETURN_SUCCESS != ret) {
+                throw std::runtime_error("Could not reserve imaging frame!");
+            }
+            return cv::Mat(size, type, buf);
+        }
+
+        /// @brief Sends the frame previously reserved for the sensor with
+        /// reserveFrame()
+        void commitFrame(DeviceToken &dev, OSVR_TimeValue const &timestamp,
+                         OSVR_ChannelCount sensor = 0) {
+            if (!m_iface) {
+                throw std::logic_error(
+                    "Must initialize the imaging interface before using it!");
+            }
+            OSVR_ReturnCode ret =
+                osvrDeviceImagingCommitFrame(dev, m_iface, sensor, &timestamp);
+            if (OSVR_RETURN_SUCCESS != ret) {
+                throw std::runtime_error("Could not send imaging message!");
+            }
+        }
+
+        /// @brief Discards the frame previously reserved for the sensor with
+        /// reserveFrame()
+        void cancelFrame(DeviceToken &dev, OSVR_ChannelCount sensor = 0) {
+            if (!m_iface) {
+                throw std::logic_error(
+                    "Must initialize the imaging interface before using it!");
+            }
+            osvrDeviceImagingCancelFrame(dev, m_iface, sensor);
+        }
+
       private:
+        static OSVR_ImagingMetadata getMetadata(cv::Size const &size,
+                                                int type) {
+            util::NumberTypeData typedata = util::opencvNumberTypeData(type);
+            OSVR_ImagingMetadata metadata;
+            metadata.channels = CV_MAT_CN(type);
+            metadata.depth = static_cast<OSVR_ImageDepth>(typedata.getSize());
+            metadata.width = size.width;
+            metadata.height = size.height;
+            metadata.type = typedata.isFloatingPoint()
+                                ? OSVR_IVT_FLOATING_POINT
+                                : (typedata.isSigned() ? OSVR_IVT_SIGNED_INT
+                                                       : OSVR_IVT_UNSIGNED_INT);
+            return metadata;
+        }
         OSVR_ImagingDeviceInterface m_iface;
     };
     /// @}
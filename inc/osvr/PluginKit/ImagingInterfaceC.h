@@ -79,6 +79,9 @@ OSVR_ReturnCode osvrDeviceImagingConfigure(
     only pass in memory allocated by `osvrAlignedAlloc`. The C++ wrapper for
     this function takes care of this automatically.
 
+    The image is copied before this returns: an asynchronous device doesn't
+    wait for the server to send it.
+
     @param dev Device token
     @param iface Imaging interface
     @param metadata Image metadata
@@ -96,6 +99,69 @@ osvrDeviceImagingReportFrame(OSVR_IN_PTR OSVR_DeviceToken dev,
                              OSVR_IN OSVR_ChannelCount sensor,
                              OSVR_IN_PTR OSVR_TimeValue const *timestamp)
     OSVR_FUNC_NONNULL((1, 2, 4, 6));
+
+/** @brief Reserve the next frame slot for a sensor, to be filled in place
+    rather than copied by osvrDeviceImagingReportFrame(). Where possible (the
+    usual case), the buffer returned points directly into the shared memory
+    that clients will read from, so a capture or decode step can write straight
+    into it.
+
+    Must be followed by osvrDeviceImagingCommitFrame() or
+    osvrDeviceImagingCancelFrame() for the same sensor: only one reservation
+    per sensor may be outstanding, and reserving again discards an uncommitted
+    one. The buffer remains owned by the imaging interface and must not be
+    used after committing or cancelling.
+
+    Reserving takes the device's send lock briefly, and committing doesn't
+    wait for the server at all; filling the buffer in between does not hold
+    up the server or clients.
+
+    @param dev Device token
+    @param iface Imaging interface
+    @param metadata Metadata of the image you will write: determines the size
+    of the buffer.
+    @param sensor Sensor number, usually 0
+    @param [out] buffer Receives a pointer to the reserved, aligned buffer of
+    exactly the size described by the metadata.
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode
+osvrDeviceImagingReserveFrame(OSVR_IN_PTR OSVR_DeviceToken dev,
+                              OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
+                              OSVR_IN OSVR_ImagingMetadata metadata,
+                              OSVR_IN OSVR_ChannelCount sensor,
+                              OSVR_OUT_PTR OSVR_ImageBufferElement **buffer)
+    OSVR_FUNC_NONNULL((1, 2, 5));
+
+/** @brief Publish a frame previously reserved for a sensor with
+    osvrDeviceImagingReserveFrame() and filled in place.
+
+    @param dev Device token
+    @param iface Imaging interface
+    @param sensor Sensor number, usually 0
+    @param timestamp Timestamp correlating to frame.
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode
+osvrDeviceImagingCommitFrame(OSVR_IN_PTR OSVR_DeviceToken dev,
+                             OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
+                             OSVR_IN OSVR_ChannelCount sensor,
+                             OSVR_IN_PTR OSVR_TimeValue const *timestamp)
+    OSVR_FUNC_NONNULL((1, 2, 4));
+
+/** @brief Discard a frame previously reserved for a sensor with
+    osvrDeviceImagingReserveFrame() without sending it.
+
+    @param dev Device token
+    @param iface Imaging interface
+    @param sensor Sensor number, usually 0
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode
+osvrDeviceImagingCancelFrame(OSVR_IN_PTR OSVR_DeviceToken dev,
+                             OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
+                             OSVR_IN OSVR_ChannelCount sensor)
+    OSVR_FUNC_NONNULL((1, 2));
 /** @} */ /* end of group */
 
 OSVR_EXTERN_C_END
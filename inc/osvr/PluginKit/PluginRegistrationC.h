@@ -92,6 +92,20 @@ OSVR_PLUGINKIT_EXPORT OSVR_ReturnCode osvrPluginRegisterHardwareDetectCallback(
     OSVR_IN OSVR_HardwareDetectCallback detectCallback,
     OSVR_IN_OPT void *userData OSVR_CPP_ONLY(= NULL)) OSVR_FUNC_NONNULL((1));
 
+/** @brief Ask the host to invoke the hardware detect callbacks again soon.
+
+   Hardware detect callbacks run on the server's main loop, so probing that
+   can take a while (opening a camera, for instance) is best done on a thread
+   of your own: when that probe finds something, call this (from any thread)
+   and your callback will be invoked again, on the main loop, to create the
+   device.
+
+   @param ctx The registration context passed to your entry point.
+*/
+OSVR_PLUGINKIT_EXPORT OSVR_ReturnCode
+osvrPluginRequestHardwareDetect(OSVR_INOUT_PTR OSVR_PluginRegContext ctx)
+    OSVR_FUNC_NONNULL((1));
+
 /** @brief Register an instantiation callback (constructor) for a driver type.
     The given constructor may be called with a string containing configuration
     information, the format of which you should document with your plugin. JSON
@@ -89,6 +89,28 @@ OSVR_ReturnCode osvrDeviceTrackerSendPoseTimestamped(
     OSVR_IN_PTR OSVR_TimeValue const *timestamp)
     OSVR_FUNC_NONNULL((1, 2, 3, 5));
 
+/** @brief Report the full rigid body poses of several sensors, all sampled at
+   the same time, in a single message with the supplied timestamp.
+
+   For devices with many sensors, this is much cheaper than sending each pose
+   individually. Clients ignore these messages (logging a warning) unless the
+   device descriptor's tracker interface sets `"batched": true`.
+
+   @param poses Array of @p count poses.
+   @param sensors Array of @p count sensor numbers, one for each pose, or NULL
+   if the poses are for sensors 0 through count - 1 in order.
+   @param count Number of poses.
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode osvrDeviceTrackerSendPoseBatchTimestamped(
+    OSVR_IN_PTR OSVR_DeviceToken dev,
+    OSVR_IN_PTR OSVR_TrackerDeviceInterface iface,
+    OSVR_IN_READS(count) OSVR_PoseState const *poses,
+    OSVR_IN_OPT OSVR_ChannelCount const *sensors,
+    OSVR_IN OSVR_ChannelCount count,
+    OSVR_IN_PTR OSVR_TimeValue const *timestamp)
+    OSVR_FUNC_NONNULL((1, 2, 3, 6));
+
 /** @brief Report the position of a sensor that doesn't report orientation,
    automatically generating a timestamp.
 */
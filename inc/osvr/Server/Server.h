@@ -29,6 +29,7 @@
 #include <osvr/Server/Export.h>
 #include <osvr/Server/ServerPtr.h>
 #include <osvr/Connection/ConnectionPtr.h>
+#include <osvr/Connection/ReportRateLimit.h>
 #include <osvr/Common/PathElementTypes_fwd.h>
 #include <osvr/Util/UniquePtr.h>
 
@@ -46,6 +47,9 @@ class Value;
 }
 
 namespace osvr {
+namespace common {
+    struct ThreadSchedulingOptions;
+} // namespace common
 /// @brief Server functionality
 namespace server {
     // Forward declaration for pimpl idiom.
@@ -242,6 +246,34 @@ namespace server {
         /// Call only before starting the server or from within server thread.
         OSVR_SERVER_EXPORT void setSleepTime(int microseconds);
 
+        /// @brief Sets whether the server loop, rather than sleeping a fixed
+        /// time each loop, waits for activity: it wakes as soon as an
+        /// asynchronous device has data to send, a client message arrives, or
+        /// another thread makes a change, and otherwise after the sleep time,
+        /// which bounds polling of synchronous devices. With a sleep time of
+        /// 0, the loop never waits.
+        ///
+        /// Call only before starting the server or from within server thread.
+        OSVR_SERVER_EXPORT void setEventDriven(bool eventDriven);
+
+        /// @brief Sets scheduling options (real-time policy and priority, CPU
+        /// affinity, timer slack) to apply to the server loop thread when it
+        /// starts. Options the process lacks the privileges for are skipped
+        /// with a warning.
+        ///
+        /// Call only before starting the server.
+        OSVR_SERVER_EXPORT void
+        setThreadScheduling(common::ThreadSchedulingOptions const &opts);
+
+        /// @brief Sets the rates (by device name) to which devices' state
+        /// reports are limited: a device reporting faster has only its latest
+        /// report sent each interval, cutting network and client load without
+        /// clients missing the current state.
+        ///
+        /// Call only before starting the server and creating devices.
+        OSVR_SERVER_EXPORT void
+        setReportRateLimits(connection::ReportRateLimits const &limits);
+
 #if 0
         /// @brief Returns the amount of time (in microseconds) that the server
         /// loop sleeps each loop.
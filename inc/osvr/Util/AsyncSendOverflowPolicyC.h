@@ -0,0 +1,64 @@
+/** @file
+    @brief Header
+
+    Must be c-safe!
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+/*
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#ifndef INCLUDED_AsyncSendOverflowPolicyC_h_GUID_3E1F7A52_6C0D_4B8E_9F21_5A7D0C4E8B13
+#define INCLUDED_AsyncSendOverflowPolicyC_h_GUID_3E1F7A52_6C0D_4B8E_9F21_5A7D0C4E8B13
+
+/* Internal Includes */
+#include <osvr/Util/StdInt.h>
+#include <osvr/Util/APIBaseC.h>
+
+/* Library/third-party includes */
+/* none */
+
+/* Standard includes */
+/* none */
+
+OSVR_EXTERN_C_BEGIN
+
+/** @addtogroup PluginKit
+@{
+*/
+
+/** @brief Type specifying what an asynchronous device does when it sends
+    data faster than the server can take it from the device's send queue.
+*/
+typedef uint8_t OSVR_AsyncSendOverflowPolicy;
+
+/** @brief Discard the message being sent (default). */
+#define OSVR_ASYNC_SEND_DROP_NEWEST (0)
+/** @brief Discard the oldest queued message to make room. */
+#define OSVR_ASYNC_SEND_DROP_OLDEST (1)
+/** @brief Wait in the sending thread until there is room. */
+#define OSVR_ASYNC_SEND_BLOCK (2)
+
+/** @} */
+
+OSVR_EXTERN_C_END
+
+#endif
@@ -28,6 +28,7 @@
 // Internal Includes
 #include <osvr/Util/Export.h>
 #include <osvr/Util/GuardInterface.h>
+#include <osvr/Util/GuardPtr.h>
 
 // Library/third-party includes
 // - none
@@ -41,6 +42,11 @@ namespace util {
       public:
         virtual bool lock() override { return true; }
         virtual ~DummyGuard();
+
+        /// @brief Returns a pointer to one shared dummy guard, which is
+        /// never deleted: since it has no state, handing it out repeatedly
+        /// (from any thread) is safe and costs no allocation.
+        static GuardPtr getShared();
     };
 
 } // namespace util
@@ -37,7 +37,25 @@
 
 namespace osvr {
 namespace util {
-    typedef unique_ptr<util::GuardInterface> GuardPtr;
+    /// @brief Deleter for GuardPtr: deletes the guard, unless it was made
+    /// with nonOwning() for a guard that outlives the pointer (such as a
+    /// shared, stateless one), so handing that out needs no allocation.
+    class GuardDeleter {
+      public:
+        GuardDeleter() : m_owning(true) {}
+        static GuardDeleter nonOwning() { return GuardDeleter(false); }
+        void operator()(GuardInterface *guard) const {
+            if (m_owning) {
+                delete guard;
+            }
+        }
+
+      private:
+        explicit GuardDeleter(bool owning) : m_owning(owning) {}
+        bool m_owning;
+    };
+
+    typedef unique_ptr<util::GuardInterface, GuardDeleter> GuardPtr;
 } // namespace util
 } // namespace osvr
 
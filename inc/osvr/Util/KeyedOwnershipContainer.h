@@ -26,13 +26,16 @@
 #define INCLUDED_KeyedOwnershipContainer_h_GUID_002CD118_DF06_45AC_44D8_C37BA99E0E93
 
 // Internal Includes
-// - none
+#include <osvr/Util/SharedPtr.h>
 
 // Library/third-party includes
 #include <boost/any.hpp>
 
 // Standard includes
+#include <cstddef>
 #include <map>
+#include <unordered_map>
+#include <utility>
 
 namespace osvr {
 namespace util {
@@ -104,6 +107,69 @@ namespace util {
 
     typedef BasicKeyedOwnershipContainer<MultipleReferenceOwnershipPolicy>
         MultipleKeyedOwnershipContainer;
+
+    /// @brief Like MultipleKeyedOwnershipContainer, for objects of a single
+    /// type handed out many times over (like image buffers, once per callback
+    /// per frame): keeps one shared_ptr and a count per object instead of one
+    /// container entry per reference.
+    ///
+    /// Entries whose count drops to zero are kept (empty) for reuse, up to a
+    /// limit, so objects whose addresses recur - buffers recycled by a pool,
+    /// for instance - don't cause any allocation here.
+    template <typename T> class KeyedRefCountContainer {
+      public:
+        static const std::size_t MAX_IDLE_ENTRIES = 32;
+
+        /// @brief Adds the given number of references to an object, returning
+        /// its void * usable to release each of them.
+        void *acquire(shared_ptr<T> const &ptr, std::size_t refs = 1) {
+            void *key = ptr.get();
+            if (0 == refs) {
+                return key;
+            }
+            auto result = m_container.insert(std::make_pair(key, Entry()));
+            auto &entry = result.first->second;
+            if (0 == entry.refs) {
+                if (!result.second) {
+                    // Reusing an idle entry.
+                    --m_idle;
+                }
+                entry.ptr = ptr;
+            }
+            entry.refs += refs;
+            return key;
+        }
+
+        /// @brief Releases one reference to the indicated object, if we have
+        /// any.
+        ///
+        /// @returns true if we found and released a reference.
+        bool release(void *rawPtr) {
+            auto it = m_container.find(rawPtr);
+            if (m_container.end() == it || 0 == it->second.refs) {
+                return false;
+            }
+            auto &entry = it->second;
+            if (0 == --entry.refs) {
+                entry.ptr.reset();
+                if (m_idle < MAX_IDLE_ENTRIES) {
+                    ++m_idle;
+                } else {
+                    m_container.erase(it);
+                }
+            }
+            return true;
+        }
+
+      private:
+        struct Entry {
+            shared_ptr<T> ptr;
+            std::size_t refs = 0;
+        };
+        std::unordered_map<void *, Entry> m_container;
+        /// @brief Number of entries with no references.
+        std::size_t m_idle = 0;
+    };
 } // namespace util
 } // namespace osvr
 
@@ -0,0 +1,117 @@
+/** @file
+    @brief Header providing a single-writer, multiple-reader value holder
+    based on a sequence lock.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_SeqlockValue_h_GUID_6B1E2C57_93A4_4D0F_8E35_2F7C41A9D0B3
+#define INCLUDED_SeqlockValue_h_GUID_6B1E2C57_93A4_4D0F_8E35_2F7C41A9D0B3
+
+// Internal Includes
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace osvr {
+namespace util {
+    /// @brief Holds a value that one thread updates and any number of other
+    /// threads may read, without locks, each always getting a consistent
+    /// copy.
+    ///
+    /// Readers copy the value out and retry if the writer published a new one
+    /// in the meantime, so the writer never waits. Intended for small,
+    /// trivially-copyable (C struct) values: it's copied bytewise.
+    ///
+    /// Only one thread may call store() at a time.
+    template <typename T> class SeqlockValue {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "SeqlockValue copies its value bytewise, and may copy "
+                      "one being overwritten: it must be trivially copyable.");
+
+      public:
+        typedef T value_type;
+        SeqlockValue() : m_seq(0) {}
+
+        SeqlockValue(SeqlockValue const &) = delete;
+        SeqlockValue &operator=(SeqlockValue const &) = delete;
+
+        /// @brief Publishes a new value. Writer thread only.
+        void store(value_type const &val) {
+            auto seq = m_seq.load(std::memory_order_relaxed);
+            m_seq.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            std::memcpy(&m_value, &val, sizeof(value_type));
+            m_seq.store(seq + 2, std::memory_order_release);
+        }
+
+        /// @brief Has a value ever been stored?
+        bool hasValue() const {
+            return m_seq.load(std::memory_order_acquire) != 0;
+        }
+
+        /// @brief Copies the most recently published value into @p val.
+        ///
+        /// @return false (leaving @p val untouched) if no value has been
+        /// stored yet.
+        bool load(value_type &val) const {
+            value_type copy;
+            for (;;) {
+                auto before = m_seq.load(std::memory_order_acquire);
+                if (before == 0) {
+                    return false;
+                }
+                if (before & 0x1) {
+                    /// Writer is mid-update.
+                    std::this_thread::yield();
+                    continue;
+                }
+                std::memcpy(&copy, &m_value, sizeof(value_type));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (m_seq.load(std::memory_order_relaxed) == before) {
+                    break;
+                }
+            }
+            val = copy;
+            return true;
+        }
+
+        /// @brief Gets the number of values stored so far (wraps, though that
+        /// takes a while).
+        uint32_t getGeneration() const {
+            return m_seq.load(std::memory_order_acquire) / 2;
+        }
+
+      private:
+        std::atomic<uint32_t> m_seq;
+        value_type m_value;
+    };
+} // namespace util
+} // namespace osvr
+
+#endif // INCLUDED_SeqlockValue_h_GUID_6B1E2C57_93A4_4D0F_8E35_2F7C41A9D0B3
@@ -38,6 +38,8 @@
 #include <vector>
 #include <algorithm>
 #include <stdexcept>
+#include <functional>
+#include <unordered_map>
 
 namespace osvr {
 namespace util {
@@ -49,6 +51,23 @@ namespace util {
             NoSuchChild(std::string const &name)
                 : std::runtime_error("No child found with the name " + name) {}
         };
+        namespace detail {
+            /// @brief Hash for a child name held by (non-owning) pointer,
+            /// hashing the string itself.
+            struct ChildNameHash {
+                size_t operator()(std::string const *name) const {
+                    return std::hash<std::string>()(*name);
+                }
+            };
+            /// @brief Equality for child names held by pointer, comparing the
+            /// strings themselves.
+            struct ChildNameEqual {
+                bool operator()(std::string const *a,
+                                std::string const *b) const {
+                    return *a == *b;
+                }
+            };
+        } // namespace detail
         /// @brief A node in a generic tree, which can contain an object by
         /// value.
         /// @tparam ValueType The contained value type: must be
@@ -66,8 +85,10 @@ namespace util {
         /// - A "get or create" method is provided that guarantees the return a
         /// child of the given name (default-constructing one if it doesn't
         /// exist)
-        ///
-        /// @todo methods to remove a child (by pointer and by name)
+        /// - Child lookup by name is a hash lookup, and nodes are never
+        /// relocated, so references to them remain valid as the tree grows.
+        /// - A child (and its descendants) may be removed by name: only
+        /// references into that subtree are invalidated.
         template <typename ValueType>
         class TreeNode : boost::noncopyable,
                          boost::operators<TreeNode<ValueType> > {
@@ -110,6 +131,26 @@ namespace util {
             /// exist.
             type const &getChildByName(std::string const &name) const;
 
+            /// @brief Remove the named child, along with all its descendants.
+            ///
+            /// @return false if there was no such child.
+            bool removeChildByName(std::string const &name);
+
+            /// @brief Get the descendant reached by following the given range
+            /// of child names (strings) in order, creating any that don't
+            /// exist. Useful for repeated lookups of a path that has been
+            /// split up front.
+            template <typename InputIterator>
+            type &getOrCreateDescendant(InputIterator first,
+                                        InputIterator last);
+
+            /// @brief Get the descendant reached by following the given range
+            /// of child names in order, throwing NoSuchChild if it doesn't
+            /// exist.
+            template <typename InputIterator>
+            type const &getDescendant(InputIterator first,
+                                      InputIterator last) const;
+
             /// @brief Gets the name of the current node. This will be empty if
             /// and
             /// only if this is the root.
@@ -194,9 +235,17 @@ namespace util {
             value_type m_value;
 
             typedef std::vector<ptr_type> ChildList;
-            /// @brief Ownership of children
+            /// @brief Ownership of children, in order of creation
             ChildList m_children;
 
+            typedef std::unordered_map<std::string const *, weak_ptr_type,
+                                       detail::ChildNameHash,
+                                       detail::ChildNameEqual>
+                ChildIndex;
+            /// @brief Index of children by name. The keys point to each
+            /// child's own (immutable) name, so names are only stored once.
+            ChildIndex m_childIndex;
+
             /// @brief Name
             std::string const m_name;
 
@@ -267,6 +316,47 @@ namespace util {
             throw NoSuchChild(name);
         }
 
+        template <typename ValueType>
+        inline bool
+        TreeNode<ValueType>::removeChildByName(std::string const &name) {
+            auto it = m_childIndex.find(&name);
+            if (it == end(m_childIndex)) {
+                return false;
+            }
+            weak_ptr_type child = it->second;
+            // The index key points into the child, so it goes first.
+            m_childIndex.erase(it);
+            m_children.erase(std::find_if(begin(m_children), end(m_children),
+                                          [&](ptr_type const &ptr) {
+                                              return ptr.get() == child;
+                                          }));
+            return true;
+        }
+
+        template <typename ValueType>
+        template <typename InputIterator>
+        inline TreeNode<ValueType> &
+        TreeNode<ValueType>::getOrCreateDescendant(InputIterator first,
+                                                   InputIterator last) {
+            type *ret = this;
+            for (; first != last; ++first) {
+                ret = &(ret->getOrCreateChildByName(*first));
+            }
+            return *ret;
+        }
+
+        template <typename ValueType>
+        template <typename InputIterator>
+        inline TreeNode<ValueType> const &
+        TreeNode<ValueType>::getDescendant(InputIterator first,
+                                           InputIterator last) const {
+            type const *ret = this;
+            for (; first != last; ++first) {
+                ret = &(ret->getChildByName(*first));
+            }
+            return *ret;
+        }
+
         template <typename ValueType>
         inline std::string const &TreeNode<ValueType>::getName() const {
             return m_name;
@@ -302,14 +392,10 @@ namespace util {
         template <typename ValueType>
         inline typename TreeNode<ValueType>::weak_ptr_type
         TreeNode<ValueType>::m_getChildByName(std::string const &name) const {
-            /// @todo Don't use a linear search here - use an unordered map or
-            /// something.
-            auto it = std::find_if(
-                begin(m_children), end(m_children),
-                [&](ptr_type const &n) { return n->getName() == name; });
+            auto it = m_childIndex.find(&name);
             weak_ptr_type ret = nullptr;
-            if (it != end(m_children)) {
-                ret = (*it).get();
+            if (it != end(m_childIndex)) {
+                ret = it->second;
             }
             return ret;
         }
@@ -318,12 +404,14 @@ namespace util {
         inline void TreeNode<ValueType>::m_addChild(
             typename TreeNode<ValueType>::ptr_type const &child) {
             m_children.push_back(child);
+            m_childIndex.emplace(&(child->m_name), child.get());
         }
 
         template <typename ValueType>
         inline TreeNode<ValueType>::TreeNode(TreeNode<ValueType> &parent,
                                              std::string const &name)
-            : m_value(), m_children(), m_name(name), m_parent(&parent) {
+            : m_value(), m_children(), m_childIndex(), m_name(name),
+              m_parent(&parent) {
             if (m_name.empty()) {
                 throw std::logic_error(
                     "Can't create a named tree node with an empty name!");
@@ -334,7 +422,8 @@ namespace util {
         inline TreeNode<ValueType>::TreeNode(TreeNode<ValueType> &parent,
                                              std::string const &name,
                                              ValueType const &val)
-            : m_value(val), m_children(), m_name(name), m_parent(&parent) {
+            : m_value(val), m_children(), m_childIndex(), m_name(name),
+              m_parent(&parent) {
             if (m_name.empty()) {
                 throw std::logic_error(
                     "Can't create a named tree node with an empty name!");
@@ -343,13 +432,15 @@ namespace util {
 
         template <typename ValueType>
         inline TreeNode<ValueType>::TreeNode()
-            : m_value(), m_children(), m_name(), m_parent(nullptr) {
+            : m_value(), m_children(), m_childIndex(), m_name(),
+              m_parent(nullptr) {
             /// Special root constructor
         }
 
         template <typename ValueType>
         inline TreeNode<ValueType>::TreeNode(ValueType const &val)
-            : m_value(val), m_children(), m_name(), m_parent(nullptr) {
+            : m_value(val), m_children(), m_childIndex(), m_name(),
+              m_parent(nullptr) {
             /// Special root constructor
         }
 
@@ -0,0 +1,226 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "HIDEnumerationCache.h"
+
+// Library/third-party includes
+#include "hidapi/hidapi.h"
+
+// Standard includes
+#include <chrono>
+
+#if defined(__linux__) && !defined(__ANDROID__)
+#define OSVR_HID_CACHE_USE_INOTIFY
+#include <dirent.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+/// How often to re-enumerate when there's no way to be told of changes.
+static const std::chrono::milliseconds POLLING_INTERVAL(1000);
+
+static inline bool operator==(HIDDeviceInfo const &lhs,
+                              HIDDeviceInfo const &rhs) {
+    return lhs.vendorId == rhs.vendorId && lhs.productId == rhs.productId &&
+           lhs.interfaceNumber == rhs.interfaceNumber && lhs.path == rhs.path;
+}
+
+#ifdef OSVR_HID_CACHE_USE_INOTIFY
+/// Refresh now and then even with inotify, in case a change was missed.
+static const int MONITORED_REFRESH_INTERVAL_MS = 10000;
+
+/// A device being plugged in produces a burst of node creation and
+/// permission changes (by udev rules): wait until it's been quiet this long
+/// before enumerating.
+static const int SETTLE_TIME_MS = 100;
+
+/// Watches the directories that hidraw and usbfs device nodes live in.
+class HIDEnumerationCache::ChangeMonitor : boost::noncopyable {
+  public:
+    ChangeMonitor() {
+        m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_inotify < 0 || pipe2(m_wakePipe, O_NONBLOCK | O_CLOEXEC) != 0) {
+            return;
+        }
+        static const uint32_t mask = IN_CREATE | IN_DELETE | IN_ATTRIB;
+        if (inotify_add_watch(m_inotify, "/dev", mask) < 0) {
+            return;
+        }
+        /// Only matters if hidapi is using the libusb backend, so failure is
+        /// fine here.
+        static const char usbfs[] = "/dev/bus/usb";
+        if (auto dir = opendir(usbfs)) {
+            while (auto entry = readdir(dir)) {
+                if (entry->d_name[0] == '.') {
+                    continue;
+                }
+                auto busDir = std::string(usbfs) + "/" + entry->d_name;
+                inotify_add_watch(m_inotify, busDir.c_str(), mask);
+            }
+            closedir(dir);
+        }
+        m_ok = true;
+    }
+
+    ~ChangeMonitor() {
+        for (auto fd : {m_inotify, m_wakePipe[0], m_wakePipe[1]}) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+    }
+
+    bool ok() const { return m_ok; }
+
+    /// Interrupts a wait() in progress (or the next one).
+    void wake() {
+        char c = 0;
+        auto ret = write(m_wakePipe[1], &c, 1);
+        (void)ret;
+    }
+
+    /// Blocks until a device node changes, the refresh interval passes, or
+    /// wake() is called.
+    void wait() {
+        pollfd fds[2] = {{m_inotify, POLLIN, 0}, {m_wakePipe[0], POLLIN, 0}};
+        int timeout = MONITORED_REFRESH_INTERVAL_MS;
+        while (poll(fds, 2, timeout) > 0) {
+            if (fds[1].revents) {
+                m_drain(m_wakePipe[0]);
+                return;
+            }
+            m_drain(m_inotify);
+            timeout = SETTLE_TIME_MS;
+        }
+    }
+
+  private:
+    static void m_drain(int fd) {
+        char buf[4096];
+        while (read(fd, buf, sizeof(buf)) > 0) {
+        }
+    }
+    bool m_ok = false;
+    int m_inotify = -1;
+    int m_wakePipe[2] = {-1, -1};
+};
+#else
+/// No way to be notified of device changes on this platform.
+class HIDEnumerationCache::ChangeMonitor : boost::noncopyable {
+  public:
+    bool ok() const { return false; }
+    void wake() {}
+    void wait() {}
+};
+#endif
+
+static HIDDeviceList enumerateWithHIDAPI() {
+    HIDDeviceList devices;
+    struct hid_device_info *enumData = hid_enumerate(0, 0);
+    for (struct hid_device_info *dev = enumData; dev != nullptr;
+         dev = dev->next) {
+        devices.push_back(HIDDeviceInfo{dev->vendor_id, dev->product_id,
+                                        dev->interface_number,
+                                        std::string(dev->path)});
+    }
+    hid_free_enumeration(enumData);
+    return devices;
+}
+
+HIDEnumerationCache::HIDEnumerationCache(ChangeCallback const &onChange,
+                                         Enumerator const &enumerate)
+    : m_onChange(onChange), m_enumerate(enumerate),
+      m_monitor(new ChangeMonitor) {
+    if (!m_enumerate) {
+        // hid_init isn't thread-safe, and devices opening HID handles in the
+        // server thread would otherwise race the first enumeration to call
+        // it.
+        hid_init();
+        m_enumerate = &enumerateWithHIDAPI;
+    }
+    m_thread = std::thread([&] { m_threadFunction(); });
+}
+
+HIDEnumerationCache::~HIDEnumerationCache() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    m_monitor->wake();
+    m_thread.join();
+}
+
+HIDEnumerationCache::Generation
+HIDEnumerationCache::getSnapshot(HIDDeviceList &devices) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    devices = m_devices;
+    return m_generation;
+}
+
+void HIDEnumerationCache::requestRefresh() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_refreshRequested = true;
+    }
+    m_cv.notify_all();
+    m_monitor->wake();
+}
+
+void HIDEnumerationCache::m_threadFunction() {
+    do {
+        m_refresh();
+    } while (m_waitForChange());
+}
+
+void HIDEnumerationCache::m_refresh() {
+    HIDDeviceList devices = m_enumerate();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_generation > 0 && devices == m_devices) {
+            return;
+        }
+        m_devices.swap(devices);
+        ++m_generation;
+    }
+    if (m_onChange) {
+        m_onChange();
+    }
+}
+
+bool HIDEnumerationCache::m_waitForChange() {
+    if (m_monitor->ok()) {
+        m_monitor->wait();
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_monitor->ok()) {
+        m_cv.wait_for(lock, POLLING_INTERVAL,
+                      [&] { return m_stop || m_refreshRequested; });
+    }
+    m_refreshRequested = false;
+    return !m_stop;
+}
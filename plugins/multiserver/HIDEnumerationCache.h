@@ -0,0 +1,121 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_HIDEnumerationCache_h_GUID_3B8E6F2A_90C4_4D1E_A7B5_6C2D48E0F913
+#define INCLUDED_HIDEnumerationCache_h_GUID_3B8E6F2A_90C4_4D1E_A7B5_6C2D48E0F913
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// The parts of a hid_device_info that hardware detection looks at, copied
+/// so they outlive the enumeration they came from.
+struct HIDDeviceInfo {
+    unsigned short vendorId;
+    unsigned short productId;
+    int interfaceNumber;
+    std::string path;
+};
+
+using HIDDeviceList = std::vector<HIDDeviceInfo>;
+
+/// Keeps an up-to-date HID enumeration, performed on a background thread, so
+/// that hardware detection (which runs in the server main loop) doesn't have
+/// to stall reports while the system enumerates devices.
+///
+/// On Linux, the enumeration is redone when inotify reports device nodes
+/// coming or going, with an occasional refresh in case a change is missed.
+/// Elsewhere, it is simply refreshed periodically.
+class HIDEnumerationCache : boost::noncopyable {
+  public:
+    using Generation = std::uint64_t;
+    /// Called on the background thread whenever a new snapshot is published.
+    using ChangeCallback = std::function<void()>;
+    /// Performs an enumeration: hidapi's unless replaced (e.g. for testing).
+    using Enumerator = std::function<HIDDeviceList()>;
+
+    /// Starts the background thread, which immediately performs an initial
+    /// enumeration.
+    ///
+    /// @param onChange Called (on the background thread) after each new
+    /// snapshot, including the first, so hardware detection can be asked to
+    /// look at it.
+    /// @param enumerate Replaces the hidapi enumeration if not empty.
+    explicit HIDEnumerationCache(ChangeCallback const &onChange = {},
+                                 Enumerator const &enumerate = {});
+
+    /// Stops and joins the background thread.
+    ~HIDEnumerationCache();
+
+    /// Gets the latest enumeration without waiting. Returns the generation
+    /// of the snapshot: 0 until the initial enumeration is done, then only
+    /// changing when the list of devices does.
+    Generation getSnapshot(HIDDeviceList &devices);
+
+    /// Asks the background thread to enumerate again now rather than waiting
+    /// for a change notification or the periodic refresh.
+    void requestRefresh();
+
+  private:
+    void m_threadFunction();
+    /// Re-enumerates, publishing the results if they differ from the
+    /// current snapshot.
+    void m_refresh();
+    /// Blocks until something may have changed or it's time for a periodic
+    /// refresh anyway, returning false if the thread should stop.
+    bool m_waitForChange();
+
+    ChangeCallback m_onChange;
+    Enumerator m_enumerate;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    /// @name Protected by m_mutex
+    /// @{
+    HIDDeviceList m_devices;
+    Generation m_generation = 0;
+    bool m_refreshRequested = false;
+    bool m_stop = false;
+    /// @}
+
+    /// Platform-specific change notification, if available.
+    class ChangeMonitor;
+    std::unique_ptr<ChangeMonitor> m_monitor;
+
+    std::thread m_thread;
+};
+
+#endif // INCLUDED_HIDEnumerationCache_h_GUID_3B8E6F2A_90C4_4D1E_A7B5_6C2D48E0F913
@@ -0,0 +1,177 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#define CATCH_CONFIG_MAIN
+
+// Internal Includes
+#include "HIDEnumerationCache.h"
+
+// Library/third-party includes
+#include <catch.hpp>
+
+// Standard includes
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+/// Stands in for hidapi behind an HIDEnumerationCache: sets the device list
+/// the next enumeration returns, and counts enumerations and change
+/// callbacks so tests can wait on them.
+class FakeHID {
+  public:
+    explicit FakeHID(HIDDeviceList const &devices) : m_devices(devices) {
+        cache.reset(new HIDEnumerationCache([&] { m_bump(m_changes); },
+                                            [&] { return m_enumerate(); }));
+    }
+
+    /// The cache's thread calls back into this, so it's stopped first.
+    ~FakeHID() { cache.reset(); }
+
+    void setDevices(HIDDeviceList const &devices) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_devices = devices;
+    }
+
+    /// Waits until at least n snapshots have been published.
+    bool waitForChanges(std::size_t n) { return m_waitFor(m_changes, n); }
+
+    /// Requests a refresh and waits until it, and any change callback it
+    /// makes, have certainly finished.
+    bool refreshAndSettle() {
+        std::size_t start;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            start = m_enumerations;
+        }
+        // An enumeration only starts once the one before it has been
+        // published (or skipped), so waiting for two covers the first.
+        for (std::size_t i = 1; i <= 2; ++i) {
+            cache->requestRefresh();
+            if (!m_waitFor(m_enumerations, start + i)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::size_t changes() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_changes;
+    }
+
+    std::unique_ptr<HIDEnumerationCache> cache;
+
+  private:
+    HIDDeviceList m_enumerate() {
+        HIDDeviceList ret;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ret = m_devices;
+        }
+        m_bump(m_enumerations);
+        return ret;
+    }
+    void m_bump(std::size_t &counter) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++counter;
+        }
+        m_cv.notify_all();
+    }
+    bool m_waitFor(std::size_t &counter, std::size_t n) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_cv.wait_for(lock, std::chrono::seconds(5),
+                             [&] { return counter >= n; });
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    HIDDeviceList m_devices;
+    std::size_t m_enumerations = 0;
+    std::size_t m_changes = 0;
+};
+
+static const HIDDeviceInfo hdk = {0x1532, 0x0b00, 2, "/dev/hidraw0"};
+static const HIDDeviceInfo hydra = {0x1532, 0x0300, 0, "/dev/hidraw1"};
+
+static bool samePaths(HIDDeviceList const &a, HIDDeviceList const &b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].path != b[i].path) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST_CASE("HIDEnumerationCache-initial-snapshot") {
+    FakeHID hid(HIDDeviceList{hdk});
+    REQUIRE(hid.waitForChanges(1));
+    HIDDeviceList devices;
+    REQUIRE(hid.cache->getSnapshot(devices) == 1);
+    REQUIRE(samePaths(devices, HIDDeviceList{hdk}));
+}
+
+TEST_CASE("HIDEnumerationCache-unchanged-keeps-generation") {
+    FakeHID hid(HIDDeviceList{hdk, hydra});
+    REQUIRE(hid.waitForChanges(1));
+    REQUIRE(hid.refreshAndSettle());
+
+    HIDDeviceList devices;
+    REQUIRE(hid.cache->getSnapshot(devices) == 1);
+    REQUIRE(samePaths(devices, HIDDeviceList{hdk, hydra}));
+    // So hardware detection isn't asked to look again.
+    REQUIRE(hid.changes() == 1);
+}
+
+TEST_CASE("HIDEnumerationCache-change-bumps-generation") {
+    FakeHID hid(HIDDeviceList{hdk});
+    REQUIRE(hid.waitForChanges(1));
+
+    hid.setDevices(HIDDeviceList{hdk, hydra});
+    hid.cache->requestRefresh();
+    REQUIRE(hid.waitForChanges(2));
+    HIDDeviceList devices;
+    REQUIRE(hid.cache->getSnapshot(devices) == 2);
+    REQUIRE(samePaths(devices, HIDDeviceList{hdk, hydra}));
+
+    SECTION("removal is a change too") {
+        hid.setDevices(HIDDeviceList{hydra});
+        hid.cache->requestRefresh();
+        REQUIRE(hid.waitForChanges(3));
+        REQUIRE(hid.cache->getSnapshot(devices) == 3);
+        REQUIRE(samePaths(devices, HIDDeviceList{hydra}));
+    }
+
+    SECTION("same devices in another order is a change") {
+        hid.setDevices(HIDDeviceList{hydra, hdk});
+        hid.cache->requestRefresh();
+        REQUIRE(hid.waitForChanges(3));
+        REQUIRE(hid.cache->getSnapshot(devices) == 3);
+    }
+}
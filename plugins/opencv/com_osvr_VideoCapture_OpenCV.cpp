@@ -24,6 +24,7 @@
 
 // Internal Includes
 #include <osvr/PluginKit/PluginKit.h>
+#include <osvr/PluginKit/HardwareDetectProbe.h>
 #include <osvr/PluginKit/ImagingInterface.h>
 #include <osvr/Util/StringLiteralFileToString.h>
 
@@ -45,16 +46,21 @@
 
 // Standard includes
 #include <iostream>
+#include <memory>
 #include <sstream>
 
 namespace {
 
 OSVR_MessageType cameraMessage;
 
+typedef std::unique_ptr<cv::VideoCapture> CameraPtr;
+
 class CameraDevice : boost::noncopyable {
   public:
-    CameraDevice(OSVR_PluginRegContext ctx, int cameraNum = 0, int channel = 0)
-        : m_camera(cameraNum), m_channel(channel) {
+    /// @param camera An already-opened capture for camera @p cameraNum.
+    CameraDevice(OSVR_PluginRegContext ctx, CameraPtr &&camera,
+                 int cameraNum = 0, int channel = 0)
+        : m_camera(std::move(camera)), m_channel(channel) {
 
         /// Create the initialization options
         OSVR_DeviceInitOptions opts = osvrDeviceCreateInitOptions(ctx);
@@ -82,7 +88,7 @@ class CameraDevice : boost::noncopyable {
     }
 
     OSVR_ReturnCode update() {
-        if (!m_camera.isOpened()) {
+        if (!m_camera->isOpened()) {
             // Couldn't open the camera.  Failing silently for now. Maybe the
             // camera will be plugged back in later.
             return OSVR_RETURN_SUCCESS;
@@ -92,13 +98,13 @@ class CameraDevice : boost::noncopyable {
         auto frameTime = osvr::util::time::getNow();
 
         // Trigger a camera grab.
-        bool grabbed = m_camera.grab();
+        bool grabbed = m_camera->grab();
 
         if (!grabbed) {
             // No frame available.
             return OSVR_RETURN_SUCCESS;
         }
-        bool retrieved = m_camera.retrieve(m_frame, m_channel);
+        bool retrieved = m_camera->retrieve(m_frame, m_channel);
         if (!retrieved) {
             return OSVR_RETURN_FAILURE;
         }
@@ -115,40 +121,50 @@ class CameraDevice : boost::noncopyable {
   private:
     osvr::pluginkit::DeviceToken m_dev;
     osvr::pluginkit::ImagingInterface m_imaging;
-    cv::VideoCapture m_camera;
+    CameraPtr m_camera;
     int m_channel;
     cv::Mat m_frame;
 };
 
 class CameraDetection {
   public:
-    CameraDetection() : m_found(false) {}
+    CameraDetection() : m_found(false), m_probe(&openCamera) {}
 
     OSVR_ReturnCode operator()(OSVR_PluginRegContext ctx) {
         if (m_found) {
             return OSVR_RETURN_SUCCESS;
         }
 
-        {
-            // Autodetect camera
-            cv::VideoCapture cap(0);
-            if (!cap.isOpened()) {
-                // Failed to find camera
-                return OSVR_RETURN_FAILURE;
-            }
+        // Opening the camera can take a while, so it's done off the server's
+        // main loop: we're called again once it has opened.
+        CameraPtr camera;
+        if (!m_probe.get(ctx, camera)) {
+            // Still looking, or failed to find camera
+            return OSVR_RETURN_FAILURE;
         }
 
         m_found = true;
 
-        /// Create our device object, passing the context, and register
-        /// the function to call
-        osvr::pluginkit::registerObjectForDeletion(ctx, new CameraDevice(ctx));
+        /// Create our device object, passing the context and the camera we
+        /// opened, and register the function to call
+        osvr::pluginkit::registerObjectForDeletion(
+            ctx, new CameraDevice(ctx, std::move(camera)));
 
         return OSVR_RETURN_SUCCESS;
     }
 
   private:
+    /// Autodetect camera: runs on the probe thread.
+    static CameraPtr openCamera() {
+        CameraPtr cap(new cv::VideoCapture(0));
+        if (!cap->isOpened()) {
+            return CameraPtr();
+        }
+        return cap;
+    }
+
     bool m_found;
+    osvr::pluginkit::HardwareDetectProbe<CameraPtr> m_probe;
 };
 
 } // end anonymous namespace
@@ -0,0 +1,164 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "BlobSearchRegions.h"
+#include "ConfigParams.h"
+#include "ForEachTracked.h"
+#include "TrackedBody.h"
+#include "TrackedBodyTarget.h"
+#include "TrackingSystem.h"
+#include <CameraDistortionModel.h>
+#include <cvToEigen.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cmath>
+
+namespace osvr {
+namespace vbtracker {
+    void mergeOverlapping(std::vector<cv::Rect> &regions) {
+        bool merged = true;
+        while (merged) {
+            merged = false;
+            for (std::size_t i = 0; i < regions.size() && !merged; ++i) {
+                for (std::size_t j = i + 1; j < regions.size(); ++j) {
+                    if ((regions[i] & regions[j]).area() > 0) {
+                        regions[i] |= regions[j];
+                        regions.erase(regions.begin() + j);
+                        merged = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    BlobSearchRegions::BlobSearchRegions(ConfigParams const &params)
+        : m_enabled(params.roiBlobExtraction),
+          m_fullFrameInterval(params.roiFullFrameInterval),
+          m_padding(params.roiPadding),
+          m_blobMoveThreshold(params.blobMoveThreshold),
+          m_maxAreaFraction(params.roiMaxAreaFraction) {}
+
+    void BlobSearchRegions::update(TrackingSystem &system) {
+        if (!m_enabled) {
+            return;
+        }
+        m_newPredictions.clear();
+
+        /// Only narrow the search once we have everything: until then, we
+        /// don't know where to look.
+        bool haveRegions = system.isRoomCalibrationComplete();
+        if (haveRegions) {
+            forEachBody(system, [&](TrackedBody &body) {
+                if (!body.hasPoseEstimate()) {
+                    haveRegions = false;
+                }
+            });
+        }
+        if (haveRegions) {
+            forEachTarget(system, [&](TrackedBodyTarget &target) {
+                for (auto const &led : target.leds()) {
+                    /// The blob tracking matches a blob to an LED if it moved
+                    /// less than blobMoveThreshold diameters: there's no point
+                    /// in looking any further than that, plus the blob itself.
+                    auto const &meas = led.getMeasurement();
+                    auto radius = (m_blobMoveThreshold + 0.5) * meas.diameter +
+                                  m_padding;
+                    m_newPredictions.push_back(
+                        Prediction{meas.loc, static_cast<float>(radius)});
+                }
+            });
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_haveRegions = haveRegions && !m_newPredictions.empty();
+        /// Swap so the old vector's allocation gets reused next time.
+        m_predictions.swap(m_newPredictions);
+    }
+
+    bool
+    BlobSearchRegions::getRegionsForNextFrame(CameraParameters const &camParams,
+                                              std::vector<cv::Rect> &regions) {
+        regions.clear();
+        if (!m_enabled) {
+            return false;
+        }
+        bool haveRegions;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            haveRegions = m_haveRegions;
+            if (haveRegions) {
+                m_predictionsCopy = m_predictions;
+            }
+        }
+        auto const fullFrameDue =
+            m_fullFrameInterval > 0 &&
+            m_framesSinceFullFrame + 1 >= m_fullFrameInterval;
+        if (!haveRegions || fullFrameDue) {
+            m_framesSinceFullFrame = 0;
+            return false;
+        }
+
+        /// Predictions are in undistorted image coordinates, like the
+        /// measurements they came from, but the frame isn't.
+        auto distortionModel = CameraDistortionModel{
+            Eigen::Vector2d{camParams.focalLengthX(), camParams.focalLengthY()},
+            cvToVector(camParams.principalPoint()),
+            Eigen::Vector3d{camParams.k1(), camParams.k2(), camParams.k3()}};
+        auto const frame = cv::Rect(cv::Point(), camParams.imageSize);
+        for (auto const &prediction : m_predictionsCopy) {
+            Eigen::Vector2d loc = distortionModel.distortPoint(
+                cvToVector(prediction.loc).cast<double>());
+            auto radius = static_cast<int>(std::ceil(prediction.radius));
+            auto region =
+                cv::Rect(static_cast<int>(std::floor(loc.x())) - radius,
+                         static_cast<int>(std::floor(loc.y())) - radius,
+                         2 * radius + 1, 2 * radius + 1) &
+                frame;
+            if (region.area() > 0) {
+                regions.push_back(region);
+            }
+        }
+        mergeOverlapping(regions);
+
+        double totalArea = 0;
+        for (auto const &region : regions) {
+            totalArea += region.area();
+        }
+        if (regions.empty() || totalArea > m_maxAreaFraction * frame.area()) {
+            /// Not worth it, or nothing left in view.
+            regions.clear();
+            m_framesSinceFullFrame = 0;
+            return false;
+        }
+        ++m_framesSinceFullFrame;
+        return true;
+    }
+
+} // namespace vbtracker
+} // namespace osvr
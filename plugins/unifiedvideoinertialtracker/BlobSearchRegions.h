@@ -0,0 +1,101 @@
+/** @file
+    @brief Header for predicting which parts of the next frame need to be
+    searched for LED blobs.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_BlobSearchRegions_h_GUID_7E2D5B90_3C18_4A6F_9D47_E05B1A8C63F2
+#define INCLUDED_BlobSearchRegions_h_GUID_7E2D5B90_3C18_4A6F_9D47_E05B1A8C63F2
+
+// Internal Includes
+#include <CameraParameters.h>
+
+// Library/third-party includes
+#include <opencv2/core/core.hpp>
+
+// Standard includes
+#include <mutex>
+#include <vector>
+
+namespace osvr {
+namespace vbtracker {
+    struct ConfigParams;
+    class TrackingSystem;
+
+    /// Replaces any overlapping rectangles with their bounding rectangle,
+    /// until none overlap, so no blob is found twice. Rectangles that only
+    /// touch are left alone.
+    void mergeOverlapping(std::vector<cv::Rect> &regions);
+
+    /// Keeps track of where the LEDs were seen in the latest processed frame,
+    /// so blob extraction on the following frames can skip the parts of the
+    /// image where they couldn't be. Updated by the tracker thread, and read
+    /// by the image processing thread.
+    class BlobSearchRegions {
+      public:
+        explicit BlobSearchRegions(ConfigParams const &params);
+
+        /// Call from the tracker thread once pose estimation is done for a
+        /// frame.
+        void update(TrackingSystem &system);
+
+        /// Call from the image processing thread before extracting blobs.
+        ///
+        /// @param camParams The (distorted) parameters of the camera the
+        /// frame came from.
+        /// @param regions Output: the non-overlapping regions to search.
+        /// @return false if the whole frame should be searched instead.
+        bool getRegionsForNextFrame(CameraParameters const &camParams,
+                                    std::vector<cv::Rect> &regions);
+
+      private:
+        /// Undistorted location an LED was last seen at, and how far from
+        /// there it might be seen next.
+        struct Prediction {
+            cv::Point2f loc;
+            float radius;
+        };
+        const bool m_enabled;
+        const int m_fullFrameInterval;
+        const double m_padding;
+        const double m_blobMoveThreshold;
+        const double m_maxAreaFraction;
+
+        /// Tracker thread only: reused to gather predictions outside the lock.
+        std::vector<Prediction> m_newPredictions;
+
+        /// Image processing thread only.
+        int m_framesSinceFullFrame = 0;
+        std::vector<Prediction> m_predictionsCopy;
+
+        std::mutex m_mutex;
+        /// @name Protected by m_mutex
+        /// @{
+        bool m_haveRegions = false;
+        std::vector<Prediction> m_predictions;
+        /// @}
+    };
+
+} // namespace vbtracker
+} // namespace osvr
+
+#endif // INCLUDED_BlobSearchRegions_h_GUID_7E2D5B90_3C18_4A6F_9D47_E05B1A8C63F2
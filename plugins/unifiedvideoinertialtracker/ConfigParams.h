@@ -29,7 +29,7 @@
 #include "BlobParams.h"
 
 // Library/third-party includes
-// - none
+#include <osvr/Common/ThreadScheduling.h>
 
 // Standard includes
 #include <cstdint>
@@ -250,6 +250,18 @@ namespace vbtracker {
         /// Only make sense for a single target.
         std::string calibrationFile = "";
 
+        /// If non-empty, an existing directory to record the camera frames and
+        /// IMU reports the tracker receives to, for later replay with
+        /// uvbi-replay-benchmark. Writing the frames slows image processing
+        /// down, so only for gathering test data.
+        std::string captureDirectory = "";
+
+        /// If non-zero, seeds the random number generator used by the Kalman
+        /// estimator to pick the order it applies beacon measurements in, so
+        /// that runs over the same input give the same poses. Zero means a
+        /// different (random) seed each run.
+        std::uint32_t randomSeed = 0;
+
         /// IMU input-related parameters.
         IMUInputParams imu;
 
@@ -281,6 +293,40 @@ namespace vbtracker {
         /// Soft reset data incorporation parameter: Orientation variance
         double softResetOrientationVariance = 1.e0;
 
+        /// Scheduling (real-time policy, CPU affinity, timer slack) for the
+        /// tracker thread, which runs the filters and IMU processing.
+        common::ThreadSchedulingOptions trackerThreadScheduling;
+
+        /// Scheduling for the image processing (blob extraction) thread.
+        common::ThreadSchedulingOptions imageProcessingThreadScheduling;
+
+        /// How many threads, including the tracker thread itself, to spread
+        /// per-body LED assignment and pose estimation across when tracking
+        /// more than one body. 1 processes bodies one after another on the
+        /// tracker thread; 0 or less chooses based on the number of CPUs.
+        /// Never more than the number of bodies. The extra threads use
+        /// trackerThreadScheduling.
+        int poseEstimationThreads = 0;
+
+        /// Once every body has a pose, should blob extraction only search the
+        /// parts of the frame near where LEDs were last seen, rather than the
+        /// whole frame? (Full frames are still searched periodically, and
+        /// whenever a body loses tracking, to find newly-visible beacons.)
+        bool roiBlobExtraction = false;
+
+        /// With roiBlobExtraction, the whole frame is searched at least once
+        /// every this many frames. 0 or less means only when needed.
+        int roiFullFrameInterval = 20;
+
+        /// With roiBlobExtraction, pixels added around the area each LED could
+        /// move within (blobMoveThreshold diameters) and still be associated
+        /// with its previous blob.
+        double roiPadding = 4.;
+
+        /// With roiBlobExtraction, if the regions would cover more than this
+        /// fraction of the frame, just search the whole frame.
+        double roiMaxAreaFraction = 0.5;
+
         ConfigParams();
     };
 } // namespace vbtracker
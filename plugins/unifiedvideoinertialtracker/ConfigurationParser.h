@@ -147,6 +147,9 @@ namespace vbtracker {
         getOptionalParameter(config.extraVerbose, root, "extraVerbose");
         getOptionalParameter(config.highGain, root, "highGain");
         getOptionalParameter(config.calibrationFile, root, "calibrationFile");
+        getOptionalParameter(config.captureDirectory, root,
+                             "captureDirectory");
+        getOptionalParameter(config.randomSeed, root, "randomSeed");
 
         getOptionalParameter(config.additionalPrediction, root,
                              "additionalPrediction");
@@ -158,6 +161,15 @@ namespace vbtracker {
         getOptionalParameter(config.blobsKeepIdentity, root,
                              "blobsKeepIdentity");
         getOptionalParameter(config.numThreads, root, "numThreads");
+        getOptionalParameter(config.poseEstimationThreads, root,
+                             "poseEstimationThreads");
+        getOptionalParameter(config.roiBlobExtraction, root,
+                             "roiBlobExtraction");
+        getOptionalParameter(config.roiFullFrameInterval, root,
+                             "roiFullFrameInterval");
+        getOptionalParameter(config.roiPadding, root, "roiPadding");
+        getOptionalParameter(config.roiMaxAreaFraction, root,
+                             "roiMaxAreaFraction");
         getOptionalParameter(config.cameraMicrosecondsOffset, root,
                              "cameraMicrosecondsOffset");
         getOptionalParameter(config.streamBeaconDebugInfo, root,
@@ -214,6 +226,13 @@ namespace vbtracker {
         getOptionalParameter(config.softResetOrientationVariance, root,
                              "softResetOrientationVariance");
 
+        /// Thread scheduling parameters
+        config.trackerThreadScheduling = common::parseThreadSchedulingOptions(
+            root["trackerThreadScheduling"]);
+        config.imageProcessingThreadScheduling =
+            common::parseThreadSchedulingOptions(
+                root["imageProcessingThreadScheduling"]);
+
         /// Blob-detection parameters
         if (root.isMember("blobParams")) {
             parseBlobParams(root["blobParams"], config.blobParams);
@@ -549,6 +549,8 @@ namespace kalman {
         using Base = IMUOrientationMeasBase<PolicyT>;
         using Base::DIMENSION;
         using JacobianType = types::Matrix<DIMENSION, STATE_DIMENSION>;
+        /// Only depends on the incremental orientation.
+        using JacobianStructure = JacobianBlocks<JacobianBlock<3, 3>>;
 
         /// Quat should already be rotated into camera space.
         IMUOrientationMeasurement(Eigen::Quaterniond const &quat,
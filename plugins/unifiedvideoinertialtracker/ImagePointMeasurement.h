@@ -59,6 +59,10 @@ namespace vbtracker {
         using Jacobian =
             kalman::types::Matrix<DIMENSION,
                                   kalman::types::Dimension<State>::value>;
+        /// Doesn't depend on the body velocities: see getJacobian()
+        using JacobianStructure =
+            kalman::JacobianBlocks<kalman::JacobianBlock<0, 6>,
+                                   kalman::JacobianBlock<12, 3>>;
         EIGEN_MAKE_ALIGNED_OPERATOR_NEW
         explicit ImagePointMeasurement(CameraModel const &cam,
                                        Eigen::Vector3d const &targetFromBody)
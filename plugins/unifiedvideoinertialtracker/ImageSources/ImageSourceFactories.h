@@ -27,6 +27,7 @@
 
 // Internal Includes
 #include "ImageSource.h"
+#include "TrackerCapture.h"
 
 // Library/third-party includes
 // - none
@@ -51,6 +52,12 @@ namespace vbtracker {
     /// Factory method to wrap an image source, already determined to be an
     /// Oculus DK2 camera, with unscrambling and keep-alive code.
     ImageSourcePtr openDK2WrappedCamera(ImageSourcePtr &&cam, bool doHid);
+
+    /// Factory method to wrap an image source so every frame retrieved is also
+    /// written to a tracker capture. If the writer isn't usable, the source is
+    /// returned unwrapped.
+    ImageSourcePtr openRecordingImageSource(ImageSourcePtr &&source,
+                                            CaptureWriterPtr const &writer);
 } // namespace vbtracker
 } // namespace osvr
 #endif // INCLUDED_ImageSourceFactories_h_GUID_9C2DA062_802C_41A0_E014_82E9EB8A7D5F
@@ -0,0 +1,82 @@
+/** @file
+    @brief Implementation of an image source wrapper that records the frames
+    passing through it to a tracker capture.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "ImageSourceFactories.h"
+#include "TrackerCapture.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace vbtracker {
+    class RecordingImageSource : public ImageSource {
+      public:
+        RecordingImageSource(ImageSourcePtr &&source,
+                             CaptureWriterPtr const &writer)
+            : m_source(std::move(source)), m_writer(writer) {}
+        virtual ~RecordingImageSource() {}
+
+        bool ok() const override { return m_source && m_source->ok(); }
+        bool grab() override { return m_source->grab(); }
+        void retrieve(cv::Mat &color, cv::Mat &gray,
+                      osvr::util::time::TimeValue &timestamp) override {
+            /// Pass through to retrieve() rather than retrieveColor(), in case
+            /// the wrapped source does something special there.
+            m_source->retrieve(color, gray, timestamp);
+            if (color.data) {
+                m_writer->writeFrame(timestamp, color);
+            }
+        }
+        cv::Size resolution() const override {
+            return m_source->resolution();
+        }
+        void retrieveColor(cv::Mat &color,
+                           osvr::util::time::TimeValue &timestamp) override {
+            m_source->retrieveColor(color, timestamp);
+            if (color.data) {
+                m_writer->writeFrame(timestamp, color);
+            }
+        }
+
+      private:
+        ImageSourcePtr m_source;
+        CaptureWriterPtr m_writer;
+    };
+
+    ImageSourcePtr openRecordingImageSource(ImageSourcePtr &&source,
+                                            CaptureWriterPtr const &writer) {
+        if (!source || !writer || !writer->ok()) {
+            // Can't record, but no reason not to keep tracking.
+            return std::move(source);
+        }
+        return ImageSourcePtr{
+            new RecordingImageSource(std::move(source), writer)};
+    }
+} // namespace vbtracker
+} // namespace osvr
@@ -0,0 +1,148 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "ReplayImageSource.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+namespace osvr {
+namespace vbtracker {
+    /// How long grab() waits before failing once the capture is used up, so
+    /// the tracker doesn't spin while whoever is driving the replay notices.
+    static const std::chrono::milliseconds END_OF_CAPTURE_WAIT{100};
+
+    static inline bool isFrame(CapturedEntry const &entry) {
+        return boost::get<CapturedFrame>(&entry.data) != nullptr;
+    }
+
+    ReplayImageSource::ReplayImageSource(std::string const &directory,
+                                         ReplayPacing pacing,
+                                         CapturedIMUSink const &imuSink,
+                                         std::int32_t cameraUsecOffset)
+        : m_directory(directory), m_pacing(pacing), m_sink(imuSink),
+          m_finished(false) {
+        if (!loadCaptureIndex(directory, m_entries)) {
+            return;
+        }
+        /// The index is in the order things arrived at the tracker, from
+        /// different threads: replay them by the time the tracker will see
+        /// them as having happened instead.
+        const util::time::TimeValue frameOffset{0, cameraUsecOffset};
+        auto trackerTime = [&](CapturedEntry const &entry) {
+            auto tv = entry.timestamp;
+            if (isFrame(entry)) {
+                osvrTimeValueSum(&tv, &frameOffset);
+            }
+            return tv;
+        };
+        std::stable_sort(
+            m_entries.begin(), m_entries.end(),
+            [&](CapturedEntry const &a, CapturedEntry const &b) {
+                return trackerTime(a) < trackerTime(b);
+            });
+        for (auto const &entry : m_entries) {
+            if (!isFrame(entry)) {
+                continue;
+            }
+            if (0 == m_numFrames) {
+                auto image = loadCapturedFrame(
+                    m_directory, boost::get<CapturedFrame>(entry.data));
+                if (!image.data) {
+                    std::cerr << "Could not load the first frame of the "
+                                 "capture in "
+                              << directory << std::endl;
+                    return;
+                }
+                m_res = image.size();
+            }
+            ++m_numFrames;
+        }
+    }
+
+    void ReplayImageSource::m_deliverIMU(std::size_t end) {
+        for (; m_nextIMU < end; ++m_nextIMU) {
+            auto const &entry = m_entries[m_nextIMU];
+            if (isFrame(entry)) {
+                continue;
+            }
+            if (m_sink && !m_sink(entry)) {
+                // Sink is full: try again next time.
+                return;
+            }
+        }
+    }
+
+    bool ReplayImageSource::grab() {
+        if (m_beforeFrame) {
+            m_beforeFrame();
+        }
+        auto const numEntries = m_entries.size();
+        while (m_nextFrame < numEntries && !isFrame(m_entries[m_nextFrame])) {
+            ++m_nextFrame;
+        }
+        m_deliverIMU(m_nextFrame);
+        if (m_nextFrame == numEntries) {
+            if (!m_finished.load()) {
+                m_endTime = clock::now();
+                m_finished.store(true);
+            }
+            std::this_thread::sleep_for(END_OF_CAPTURE_WAIT);
+            return false;
+        }
+
+        m_currentFrame = m_nextFrame;
+        ++m_nextFrame;
+        auto const &frameTime = m_entries[m_currentFrame].timestamp;
+        if (!m_started) {
+            m_started = true;
+            m_startTime = clock::now();
+            m_firstFrameTime = frameTime;
+        } else if (ReplayPacing::Recorded == m_pacing) {
+            auto offset = std::chrono::duration<double>(
+                osvrTimeValueDurationSeconds(&frameTime, &m_firstFrameTime));
+            std::this_thread::sleep_until(
+                m_startTime +
+                std::chrono::duration_cast<clock::duration>(offset));
+        }
+        return true;
+    }
+
+    void
+    ReplayImageSource::retrieveColor(cv::Mat &color,
+                                     osvr::util::time::TimeValue &timestamp) {
+        auto const &entry = m_entries[m_currentFrame];
+        color = loadCapturedFrame(m_directory,
+                                  boost::get<CapturedFrame>(entry.data));
+        timestamp = entry.timestamp;
+    }
+
+} // namespace vbtracker
+} // namespace osvr
@@ -0,0 +1,134 @@
+/** @file
+    @brief Header for an image source that plays back a tracker capture.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_ReplayImageSource_h_GUID_A85C3E17_D0B2_4F6E_91C4_5E27B8D06A39
+#define INCLUDED_ReplayImageSource_h_GUID_A85C3E17_D0B2_4F6E_91C4_5E27B8D06A39
+
+// Internal Includes
+#include "ImageSource.h"
+#include "TrackerCapture.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace osvr {
+namespace vbtracker {
+    enum class ReplayPacing {
+        /// Deliver frames with the same spacing as when they were recorded.
+        Recorded,
+        /// Deliver frames as fast as the tracker asks for them.
+        MaxSpeed
+    };
+
+    /// Receives the IMU reports from a capture being replayed: returns false
+    /// if the report couldn't be accepted right now, in which case it (and any
+    /// after it) will be offered again before the next frame.
+    using CapturedIMUSink = std::function<bool(CapturedEntry const &)>;
+
+    /// Plays back the frames of a capture, in timestamp order, once, along
+    /// with the IMU reports timestamped before each frame.
+    ///
+    /// The IMU reports are handed to the sink from grab() - that is, on the
+    /// thread that drives the image source - so submitting them to the
+    /// tracker from there keeps the relative order of frames and IMU data the
+    /// same from run to run.
+    class ReplayImageSource : public ImageSource {
+      public:
+        /// @param cameraUsecOffset The offset the tracker will apply to the
+        /// frame timestamps (cameraMicrosecondsOffset), so each frame comes
+        /// after exactly the IMU reports the tracker considers older.
+        ReplayImageSource(std::string const &directory, ReplayPacing pacing,
+                          CapturedIMUSink const &imuSink = CapturedIMUSink(),
+                          std::int32_t cameraUsecOffset = 0);
+        virtual ~ReplayImageSource() {}
+
+        /// Sets a function to call at the start of each grab(), before any
+        /// IMU reports are handed to the sink - so on the tracker thread, once
+        /// it's done with the previous frame. Call before the replay starts.
+        void setBeforeFrameCallback(std::function<void()> const &callback) {
+            m_beforeFrame = callback;
+        }
+
+        bool ok() const override { return m_numFrames > 0; }
+        /// Once the last frame has been delivered, waits a moment and returns
+        /// false.
+        bool grab() override;
+        void retrieveColor(cv::Mat &color,
+                           osvr::util::time::TimeValue &timestamp) override;
+        cv::Size resolution() const override { return m_res; }
+
+        std::size_t getNumFrames() const { return m_numFrames; }
+
+        /// Thread-safe: Has grab() been called after the last frame? (Since
+        /// the tracker processes one frame at a time, that frame has then been
+        /// fully processed.)
+        bool finished() const { return m_finished.load(); }
+
+        /// Time from the first frame being grabbed to finished() becoming
+        /// true: only valid once it has.
+        std::chrono::duration<double> getReplayDuration() const {
+            return m_endTime - m_startTime;
+        }
+
+      private:
+        /// Offers the sink the IMU reports preceding the entry at index @p
+        /// end.
+        void m_deliverIMU(std::size_t end);
+
+        const std::string m_directory;
+        const ReplayPacing m_pacing;
+        CapturedIMUSink m_sink;
+        std::function<void()> m_beforeFrame;
+        std::vector<CapturedEntry> m_entries;
+        std::size_t m_numFrames = 0;
+        cv::Size m_res;
+
+        /// Index of the next IMU report to offer the sink.
+        std::size_t m_nextIMU = 0;
+        /// Index of the next frame to deliver.
+        std::size_t m_nextFrame = 0;
+        /// Index of the frame being delivered.
+        std::size_t m_currentFrame = 0;
+
+        using clock = std::chrono::steady_clock;
+        bool m_started = false;
+        clock::time_point m_startTime;
+        clock::time_point m_endTime;
+        util::time::TimeValue m_firstFrameTime = {};
+
+        std::atomic<bool> m_finished;
+    };
+} // namespace vbtracker
+} // namespace osvr
+
+#endif // INCLUDED_ReplayImageSource_h_GUID_A85C3E17_D0B2_4F6E_91C4_5E27B8D06A39
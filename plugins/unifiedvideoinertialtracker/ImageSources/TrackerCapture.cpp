@@ -0,0 +1,203 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "TrackerCapture.h"
+
+// Library/third-party includes
+#include <opencv2/highgui/highgui.hpp> // for image file I/O
+
+// Standard includes
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+namespace osvr {
+namespace vbtracker {
+    static inline std::string joinPath(std::string const &directory,
+                                       std::string const &filename) {
+        return directory + "/" + filename;
+    }
+
+    CaptureWriter::CaptureWriter(std::string const &directory)
+        : m_directory(directory),
+          m_index(joinPath(directory, CAPTURE_INDEX_FILENAME)) {
+        m_ok = static_cast<bool>(m_index);
+        if (!m_ok) {
+            std::cerr << "Could not open tracker capture index in "
+                      << directory << std::endl;
+            return;
+        }
+        /// Enough digits that doubles survive the round trip exactly.
+        m_index << std::setprecision(std::numeric_limits<double>::digits10 + 2);
+    }
+
+    void CaptureWriter::m_startLine(const char *type,
+                                    util::time::TimeValue const &tv) {
+        m_index << type << "," << tv.seconds << "," << tv.microseconds;
+    }
+
+    void CaptureWriter::writeFrame(util::time::TimeValue const &tv,
+                                   cv::Mat const &color) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_ok) {
+            return;
+        }
+        std::ostringstream os;
+        os << std::setfill('0') << std::setw(6) << ++m_numFrames << ".png";
+        auto filename = os.str();
+        if (!cv::imwrite(joinPath(m_directory, filename), color)) {
+            std::cerr << "Could not write captured frame " << filename
+                      << ", stopping capture." << std::endl;
+            m_ok = false;
+            return;
+        }
+        m_startLine("frame", tv);
+        m_index << "," << filename << "\n";
+    }
+
+    void CaptureWriter::writeIMU(util::time::TimeValue const &tv,
+                                 OSVR_OrientationReport const &report) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_ok) {
+            return;
+        }
+        m_startLine("orientation", tv);
+        m_index << "," << report.sensor;
+        for (auto val : report.rotation.data) {
+            m_index << "," << val;
+        }
+        m_index << "\n";
+    }
+
+    void CaptureWriter::writeIMU(util::time::TimeValue const &tv,
+                                 OSVR_AngularVelocityReport const &report) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_ok) {
+            return;
+        }
+        m_startLine("angvel", tv);
+        m_index << "," << report.sensor << "," << report.state.dt;
+        for (auto val : report.state.incrementalRotation.data) {
+            m_index << "," << val;
+        }
+        m_index << "\n";
+    }
+
+    /// Reads a comma followed by a value.
+    template <typename T>
+    static inline bool readField(std::istream &is, T &val) {
+        char comma = '\0';
+        return static_cast<bool>(is >> comma >> val) && comma == ',';
+    }
+
+    template <std::size_t N>
+    static inline bool readFields(std::istream &is, double (&vals)[N]) {
+        for (auto &val : vals) {
+            if (!readField(is, val)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static inline bool parseCaptureLine(std::string const &line,
+                                        CapturedEntry &entry) {
+        auto typeEnd = line.find(',');
+        if (typeEnd == std::string::npos) {
+            return false;
+        }
+        auto type = line.substr(0, typeEnd);
+        std::istringstream is(line.substr(typeEnd));
+        if (!readField(is, entry.timestamp.seconds) ||
+            !readField(is, entry.timestamp.microseconds)) {
+            return false;
+        }
+        if (type == "frame") {
+            char comma = '\0';
+            CapturedFrame frame;
+            if (!(is >> comma >> frame.filename) || comma != ',') {
+                return false;
+            }
+            entry.data = frame;
+            return true;
+        }
+        if (type == "orientation") {
+            OSVR_OrientationReport report;
+            if (!readField(is, report.sensor) ||
+                !readFields(is, report.rotation.data)) {
+                return false;
+            }
+            entry.data = report;
+            return true;
+        }
+        if (type == "angvel") {
+            OSVR_AngularVelocityReport report;
+            if (!readField(is, report.sensor) ||
+                !readField(is, report.state.dt) ||
+                !readFields(is, report.state.incrementalRotation.data)) {
+                return false;
+            }
+            entry.data = report;
+            return true;
+        }
+        return false;
+    }
+
+    bool loadCaptureIndex(std::string const &directory,
+                          std::vector<CapturedEntry> &entries) {
+        entries.clear();
+        auto indexName = joinPath(directory, CAPTURE_INDEX_FILENAME);
+        std::ifstream index(indexName);
+        if (!index) {
+            std::cerr << "Could not open tracker capture index " << indexName
+                      << std::endl;
+            return false;
+        }
+        std::string line;
+        std::size_t lineNum = 0;
+        while (std::getline(index, line)) {
+            ++lineNum;
+            if (line.empty()) {
+                continue;
+            }
+            CapturedEntry entry;
+            if (!parseCaptureLine(line, entry)) {
+                std::cerr << "Could not parse line " << lineNum << " of "
+                          << indexName << std::endl;
+                return false;
+            }
+            entries.push_back(entry);
+        }
+        return true;
+    }
+
+    cv::Mat loadCapturedFrame(std::string const &directory,
+                              CapturedFrame const &frame) {
+        return cv::imread(joinPath(directory, frame.filename),
+                          CV_LOAD_IMAGE_COLOR);
+    }
+} // namespace vbtracker
+} // namespace osvr
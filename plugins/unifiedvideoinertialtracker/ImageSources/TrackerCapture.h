@@ -0,0 +1,120 @@
+/** @file
+    @brief Header for recording and loading captures of tracker input: camera
+    frames and IMU reports, with their timestamps, in the order they arrived.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_TrackerCapture_h_GUID_3F6B0D24_9E71_4C58_A2D3_7B8E15C94F60
+#define INCLUDED_TrackerCapture_h_GUID_3F6B0D24_9E71_4C58_A2D3_7B8E15C94F60
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <boost/variant.hpp>
+#include <opencv2/core/core.hpp>
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/TimeValue.h>
+
+// Standard includes
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace osvr {
+namespace vbtracker {
+    /// The name of the index file within a capture directory. Each line is
+    /// one of:
+    ///
+    /// - `frame,<sec>,<usec>,<image filename>`
+    /// - `orientation,<sec>,<usec>,<sensor>,<w>,<x>,<y>,<z>`
+    /// - `angvel,<sec>,<usec>,<sensor>,<dt>,<w>,<x>,<y>,<z>`
+    ///
+    /// Frame timestamps are as retrieved from the camera (before
+    /// cameraMicrosecondsOffset), IMU timestamps are as submitted to the
+    /// tracker (after the IMU offsets). Images are stored losslessly, next to
+    /// the index.
+    static const auto CAPTURE_INDEX_FILENAME = "capture.csv";
+
+    /// A camera frame in a capture: the image itself is loaded on demand.
+    struct CapturedFrame {
+        std::string filename;
+    };
+
+    using CapturedEntryData =
+        boost::variant<CapturedFrame, OSVR_OrientationReport,
+                       OSVR_AngularVelocityReport>;
+
+    struct CapturedEntry {
+        util::time::TimeValue timestamp;
+        CapturedEntryData data;
+    };
+
+    /// Writes a capture: safe to call from the image processing thread and the
+    /// thread receiving IMU reports at the same time.
+    class CaptureWriter {
+      public:
+        /// Opens the index in the given (existing) directory, replacing any
+        /// capture already there.
+        explicit CaptureWriter(std::string const &directory);
+
+        /// non-copyable.
+        CaptureWriter(CaptureWriter const &) = delete;
+        /// non-assignable.
+        CaptureWriter &operator=(CaptureWriter const &) = delete;
+
+        bool ok() const { return m_ok; }
+
+        void writeFrame(util::time::TimeValue const &tv, cv::Mat const &color);
+        void writeIMU(util::time::TimeValue const &tv,
+                      OSVR_OrientationReport const &report);
+        void writeIMU(util::time::TimeValue const &tv,
+                      OSVR_AngularVelocityReport const &report);
+
+      private:
+        /// Call with m_mutex held.
+        void m_startLine(const char *type, util::time::TimeValue const &tv);
+        std::string m_directory;
+        std::mutex m_mutex;
+        std::ofstream m_index;
+        std::size_t m_numFrames = 0;
+        bool m_ok = false;
+    };
+    using CaptureWriterPtr = std::shared_ptr<CaptureWriter>;
+
+    /// Loads the index of a capture directory.
+    ///
+    /// @return false (with a message on stderr) if it couldn't be opened or
+    /// a line couldn't be parsed.
+    bool loadCaptureIndex(std::string const &directory,
+                          std::vector<CapturedEntry> &entries);
+
+    /// Loads the image for a frame of a capture.
+    cv::Mat loadCapturedFrame(std::string const &directory,
+                              CapturedFrame const &frame);
+} // namespace vbtracker
+} // namespace osvr
+
+#endif // INCLUDED_TrackerCapture_h_GUID_3F6B0D24_9E71_4C58_A2D3_7B8E15C94F60
@@ -0,0 +1,184 @@
+/** @file
+    @brief Header for splitting cost function evaluations across threads.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_ParallelEvaluation_h_GUID_5D1C7A38_E6B4_4F02_8A9E_31C70F5B2D64
+#define INCLUDED_ParallelEvaluation_h_GUID_5D1C7A38_E6B4_4F02_8A9E_31C70F5B2D64
+
+// Internal Includes
+#include "UtilityFunctions.h"
+
+// Library/third-party includes
+#include <osvr/Util/EigenCoreGeometry.h>
+
+// Standard includes
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace osvr {
+namespace vbtracker {
+    /// Options (from the command line) controlling how cost function
+    /// evaluations are spread across threads.
+    struct ParallelEvalOptions {
+        /// Number of worker threads, which is also the number of independent
+        /// segments the data rows get split into. Results are reproducible
+        /// for a given value (as long as ConfigParams::randomSeed is fixed),
+        /// but vary between values, since each segment starts with a
+        /// freshly-created tracker. 1 gives the same results as the original
+        /// serial evaluation.
+        std::size_t numThreads = 1;
+        /// If non-empty, a file of candidate parameter vectors (one per line,
+        /// comma-separated) to evaluate concurrently instead of optimizing.
+        std::string batchFile;
+    };
+
+    /// A half-open range [first, second) of data row indices.
+    using RowRange = std::pair<std::size_t, std::size_t>;
+
+    /// Splits numRows rows into (at most) numSegments contiguous,
+    /// nearly-equal segments, in order. Depends only on its arguments, so
+    /// the split is the same every run.
+    inline std::vector<RowRange> splitIntoSegments(std::size_t numRows,
+                                                   std::size_t numSegments) {
+        std::vector<RowRange> ret;
+        numSegments = std::max(std::size_t(1), std::min(numSegments, numRows));
+        auto base = numRows / numSegments;
+        auto extra = numRows % numSegments;
+        std::size_t begin = 0;
+        for (std::size_t i = 0; i < numSegments; ++i) {
+            auto end = begin + base + (i < extra ? 1 : 0);
+            ret.emplace_back(begin, end);
+            begin = end;
+        }
+        return ret;
+    }
+
+    /// The pieces of the cost computed from one segment of the data, summed
+    /// (in segment order) to get the cost of the whole.
+    struct SegmentCost {
+        double accum = 0;
+        std::size_t samples = 0;
+        std::size_t numResets = 0;
+
+        SegmentCost &operator+=(SegmentCost const &other) {
+            accum += other.accum;
+            samples += other.samples;
+            numResets += other.numResets;
+            return *this;
+        }
+    };
+
+    /// Calls task(i) for every i in [0, numTasks), from up to numThreads
+    /// threads (including the calling one), returning once all are done.
+    /// Tasks are claimed in index order but may finish in any order, so they
+    /// should only write to their own slot of some preallocated output.
+    ///
+    /// If a task throws, the remaining unclaimed tasks are skipped and the
+    /// first exception is rethrown here.
+    template <typename F>
+    inline void runTasksInParallel(std::size_t numTasks,
+                                   std::size_t numThreads, F &&task) {
+        std::atomic<std::size_t> nextTask(0);
+        std::mutex errorMutex;
+        std::exception_ptr error;
+        auto worker = [&] {
+            std::size_t i;
+            while ((i = nextTask++) < numTasks) {
+                try {
+                    task(i);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                    nextTask = numTasks;
+                }
+            }
+        };
+        numThreads = std::min(numThreads, numTasks);
+        std::vector<std::thread> threads;
+        for (std::size_t i = 1; i < numThreads; ++i) {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    template <std::size_t N>
+    using VecList = std::vector<Vec<N>, Eigen::aligned_allocator<Vec<N>>>;
+
+    /// Loads candidate parameter vectors for batch evaluation: one per line,
+    /// with N comma-separated values each. Blank lines and lines starting
+    /// with # are skipped.
+    template <std::size_t N>
+    inline bool loadCandidateVecs(std::string const &fn,
+                                  VecList<N> &candidates) {
+        std::ifstream is(fn);
+        if (!is) {
+            std::cerr << "Could not open candidate parameter file " << fn
+                      << std::endl;
+            return false;
+        }
+        std::string line;
+        std::size_t lineNum = 0;
+        while (std::getline(is, line)) {
+            ++lineNum;
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            std::replace(line.begin(), line.end(), ',', ' ');
+            std::istringstream iss(line);
+            Vec<N> candidate;
+            std::size_t i = 0;
+            for (; i < N && (iss >> candidate[i]); ++i) {
+            }
+            double dummy;
+            if (i != N || (iss >> dummy)) {
+                std::cerr << "Line " << lineNum << " of " << fn
+                          << " does not have exactly " << N << " values"
+                          << std::endl;
+                return false;
+            }
+            candidates.push_back(candidate);
+        }
+        return true;
+    }
+
+} // namespace vbtracker
+} // namespace osvr
+#endif // INCLUDED_ParallelEvaluation_h_GUID_5D1C7A38_E6B4_4F02_8A9E_31C70F5B2D64
@@ -27,6 +27,7 @@
 
 // Internal Includes
 #include "OptimizationBase.h"
+#include "ParallelEvaluation.h"
 #include "UtilityFunctions.h"
 #include "newuoa.h"
 
@@ -34,18 +35,152 @@
 // - none
 
 // Standard includes
+#include <algorithm>
 #include <functional>
 #include <iomanip>
+#include <vector>
 
 namespace osvr {
 namespace vbtracker {
 
+    /// Runs the tracker with the given parameters over one segment of the
+    /// data rows, starting from a freshly-created tracking system, and
+    /// compares its results at each step to some source of reference data.
+    template <typename TrackingReferenceType, typename ParamSet>
+    SegmentCost computeSegmentCost(MeasurementsRows const &data,
+                                   RowRange const &rows,
+                                   OptimCommonData const &commonData,
+                                   Vec<ParamSet::Dimension> const &paramVec) {
+        ConfigParams params = commonData.initialParams;
+
+        /// Update config from provided param vec
+        ParamSet::updateParamsFromVec(params, paramVec);
+
+        auto optim = OptimData::make(params, commonData);
+
+        MainAlgoUnderStudy mainAlgo;
+        TrackingReferenceType ref;
+        SegmentCost ret;
+
+        /// Main algorithm loop
+        for (auto i = rows.first; i < rows.second; ++i) {
+            auto const &row = *data[i];
+            mainAlgo(optim, row);
+            ref(optim, row);
+            if (ref.havePose() && mainAlgo.havePose()) {
+                auto cost = costMeasurement(ref.getPose(), mainAlgo.getPose());
+                ret.accum += cost;
+                ret.samples++;
+            }
+        }
+        ret.numResets = mainAlgo.getNumResets(optim);
+        return ret;
+    }
+
+    /// Cost accumulation/post-processing, once the costs of all segments
+    /// have been summed.
+    inline double computeEffectiveCost(SegmentCost const &total) {
+        if (total.samples > 0) {
+            auto avgCost =
+                (total.accum / static_cast<double>(total.samples));
+            auto numResets = total.numResets;
+            /// Sometimes gets stuck in parameter ditches where we get
+            /// very few tracked frames
+            auto effectiveCost =
+                avgCost * (numResets + 1) * (numResets + 1) / total.samples;
+            if (std::isnan(effectiveCost)) {
+                effectiveCost = getReallyBigCost();
+            }
+            std::cout << std::setw(15) << std::to_string(effectiveCost)
+                      << " effective cost (average cost of " << std::setw(9)
+                      << avgCost << " over " << std::setw(4) << total.samples
+                      << " eligible frames with " << std::setw(2) << numResets
+                      << " resets)\n";
+            return effectiveCost;
+        }
+        std::cout << "No samples with pose for both algorithms?" << std::endl;
+        return getReallyBigCost();
+    }
+
+    /// Computes the cost of each of the candidate parameter vectors, running
+    /// every (candidate, data segment) pair as a separate task on the worker
+    /// threads. Segment costs are summed in segment order, so (with a fixed
+    /// ConfigParams::randomSeed) the results only depend on the data and the
+    /// number of segments.
+    template <typename TrackingReferenceType, typename ParamSet>
+    std::vector<double>
+    computeCosts(MeasurementsRows const &data,
+                 OptimCommonData const &commonData,
+                 ParallelEvalOptions const &parallelOpts,
+                 VecList<ParamSet::Dimension> const &candidates) {
+        auto segments =
+            splitIntoSegments(data.size(), parallelOpts.numThreads);
+        auto numSegments = segments.size();
+        std::vector<SegmentCost> segmentCosts(candidates.size() * numSegments);
+        runTasksInParallel(
+            segmentCosts.size(), parallelOpts.numThreads,
+            [&](std::size_t task) {
+                segmentCosts[task] =
+                    computeSegmentCost<TrackingReferenceType, ParamSet>(
+                        data, segments[task % numSegments], commonData,
+                        candidates[task / numSegments]);
+            });
+
+        std::vector<double> ret;
+        for (std::size_t i = 0; i < candidates.size(); ++i) {
+            SegmentCost total;
+            for (std::size_t j = 0; j < numSegments; ++j) {
+                total += segmentCosts[i * numSegments + j];
+            }
+            ret.push_back(computeEffectiveCost(total));
+        }
+        return ret;
+    }
+
+    /// Evaluates all the candidate parameter vectors in a file concurrently,
+    /// reporting their costs and which was best.
+    template <typename TrackingReferenceType, typename ParamSet>
+    void runBatchEvaluation(MeasurementsRows const &data,
+                            OptimCommonData const &commonData,
+                            ParallelEvalOptions const &parallelOpts) {
+        VecList<ParamSet::Dimension> candidates;
+        if (!loadCandidateVecs<ParamSet::Dimension>(parallelOpts.batchFile,
+                                                    candidates) ||
+            candidates.empty()) {
+            std::cerr << "No candidate parameter vectors to evaluate."
+                      << std::endl;
+            return;
+        }
+        std::cout << "Evaluating " << candidates.size()
+                  << " candidate parameter vectors from "
+                  << parallelOpts.batchFile << " for parameters described "
+                  << "as, respectively,\n"
+                  << ParamSet::getVecElementNames() << std::endl;
+        auto costs = computeCosts<TrackingReferenceType, ParamSet>(
+            data, commonData, parallelOpts, candidates);
+        auto best = std::min_element(costs.begin(), costs.end());
+        for (std::size_t i = 0; i < costs.size(); ++i) {
+            std::cout << "Candidate " << i << ": cost " << costs[i]
+                      << (costs.begin() + i == best ? " (best)" : "") << "\n";
+        }
+        std::cout << "Best parameter values:\n"
+                  << candidates[best - costs.begin()].format(getFullFormat())
+                  << std::endl;
+    }
+
     /// The main optimization routine, in which we run the tracker repeatedly
     /// with different parameters and compare its results at each step to some
     /// source of reference data.
     template <typename TrackingReferenceType, typename ParamSet>
     void runOptimizer(MeasurementsRows const &data, bool costOnly,
-                      OptimCommonData const &commonData, std::size_t maxRuns) {
+                      OptimCommonData const &commonData, std::size_t maxRuns,
+                      ParallelEvalOptions const &parallelOpts) {
+
+        if (!parallelOpts.batchFile.empty()) {
+            runBatchEvaluation<TrackingReferenceType, ParamSet>(
+                data, commonData, parallelOpts);
+            return;
+        }
 
         std::cout << "Max runs: " << maxRuns << std::endl;
 
@@ -59,51 +194,10 @@ namespace vbtracker {
         std::cout << "Initial vector:\n"
                   << x.format(getFullFormat()) << std::endl;
         auto functor = [&](ParamVec const &paramVec) -> double {
-            ConfigParams params = commonData.initialParams;
-
-            /// Update config from provided param vec
-            ParamSet::updateParamsFromVec(params, paramVec);
-
-            auto optim = OptimData::make(params, commonData);
-
-            MainAlgoUnderStudy mainAlgo;
-            TrackingReferenceType ref;
-            std::size_t samples = 0;
-            double accum = 0;
-
-            /// Main algorithm loop
-            for (auto const &rowPtr : data) {
-                mainAlgo(optim, *rowPtr);
-                ref(optim, *rowPtr);
-                if (ref.havePose() && mainAlgo.havePose()) {
-                    auto cost =
-                        costMeasurement(ref.getPose(), mainAlgo.getPose());
-                    accum += cost;
-                    samples++;
-                }
-            }
-
-            /// Cost accumulation/post-processing.
-            if (samples > 0) {
-                auto avgCost = (accum / static_cast<double>(samples));
-                auto numResets = mainAlgo.getNumResets(optim);
-                /// Sometimes gets stuck in parameter ditches where we get
-                /// very few tracked frames
-                auto effectiveCost =
-                    avgCost * (numResets + 1) * (numResets + 1) / samples;
-                if (std::isnan(effectiveCost)) {
-                    effectiveCost = getReallyBigCost();
-                }
-                std::cout << std::setw(15) << std::to_string(effectiveCost)
-                          << " effective cost (average cost of " << std::setw(9)
-                          << avgCost << " over " << std::setw(4) << samples
-                          << " eligible frames with " << std::setw(2)
-                          << numResets << " resets)\n";
-                return effectiveCost;
-            }
-            std::cout << "No samples with pose for both algorithms?"
-                      << std::endl;
-            return getReallyBigCost();
+            VecList<ParamSet::Dimension> candidates{paramVec};
+            return computeCosts<TrackingReferenceType, ParamSet>(
+                       data, commonData, parallelOpts, candidates)
+                .front();
         };
 
         if (costOnly) {
@@ -121,8 +215,10 @@ namespace vbtracker {
         std::cout << "for parameters described as, respectively,\n"
                   << ParamSet::getVecElementNames() << std::endl;
     }
-    using ParamOptimizerFunc = std::function<void(
-        MeasurementsRows const &, bool, OptimCommonData const &, std::size_t)>;
+    using ParamOptimizerFunc =
+        std::function<void(MeasurementsRows const &, bool,
+                           OptimCommonData const &, std::size_t,
+                           ParallelEvalOptions const &)>;
 } // namespace vbtracker
 } // namespace osvr
 #endif // INCLUDED_ParamFindingRoutine_h_GUID_C2088279_D54B_4D8B_562E_5748C748DAD0
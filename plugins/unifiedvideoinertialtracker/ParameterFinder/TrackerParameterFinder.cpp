@@ -36,7 +36,11 @@
 #include <boost/algorithm/string/predicate.hpp> // for argument handling
 
 // Standard includes
+#include <cstdint>
+#include <cstdlib>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 /// Define to add a "press enter to exit" thing at the end.
 #undef PAUSE_BEFORE_EXIT
@@ -118,6 +122,18 @@ int usage(const char *argv0) {
     std::cerr << "as well as an additional optional switch, --cost, if you'd "
                  "like to just run the current parameters through and compute "
                  "the cost, rather than optimize.\n\n";
+    std::cerr << "The ParamViaX routines also accept, anywhere on the command "
+                 "line:\n"
+              << "   --threads <n>  to split the data into n segments, each "
+                 "tracked by its own tracker on its own thread (0 for one per "
+                 "core). Costs are reproducible for a given n and seed. "
+                 "Default 1.\n"
+              << "   --seed <n>     to seed the Kalman estimator's shuffling "
+                 "of beacon measurements with n, or 0 for a different seed "
+                 "(and so slightly different costs) each run. Default 1.\n"
+              << "   --batch <file> to evaluate the parameter vectors in the "
+                 "file (one per line, comma-separated) concurrently, rather "
+                 "than optimize.\n";
     std::cerr
         << "\nIf no routine is explicitly specified, the default routine is "
         << routineToString(DEFAULT_ROUTINE) << "\n";
@@ -204,6 +220,46 @@ int main(int argc, char *argv[]) {
         return withUsage();
     };
 
+    osvr::vbtracker::ParallelEvalOptions parallelOpts;
+    std::uint32_t randomSeed = 1;
+    /// Pull out the options that can go anywhere, leaving the positional
+    /// arguments in argv for the rest of the parsing.
+    std::vector<char *> positionalArgs;
+    for (int i = 0; i < argc; ++i) {
+        if (i + 1 < argc && boost::iequals(argv[i], "--threads")) {
+            char *end = nullptr;
+            auto n = std::strtoul(argv[++i], &end, 10);
+            if (*end != '\0') {
+                std::cerr << "Could not parse '" << argv[i]
+                          << "' as a number of threads.\n"
+                          << std::endl;
+                return withUsage();
+            }
+            parallelOpts.numThreads =
+                n > 0 ? n : std::max(1u, std::thread::hardware_concurrency());
+            continue;
+        }
+        if (i + 1 < argc && boost::iequals(argv[i], "--seed")) {
+            char *end = nullptr;
+            auto n = std::strtoul(argv[++i], &end, 10);
+            if (*end != '\0') {
+                std::cerr << "Could not parse '" << argv[i]
+                          << "' as a random seed.\n"
+                          << std::endl;
+                return withUsage();
+            }
+            randomSeed = static_cast<std::uint32_t>(n);
+            continue;
+        }
+        if (i + 1 < argc && boost::iequals(argv[i], "--batch")) {
+            parallelOpts.batchFile = argv[++i];
+            continue;
+        }
+        positionalArgs.push_back(argv[i]);
+    }
+    argc = static_cast<int>(positionalArgs.size());
+    argv = positionalArgs.data();
+
     if (argc > 1) {
         routine = stringToRoutine(argv[1]);
         if (OptimizationRoutine::Unrecognized == routine) {
@@ -259,6 +315,12 @@ int main(int argc, char *argv[]) {
                 std::cerr << "Too many command line arguments!" << std::endl;
                 return withUsage();
             }
+            if (!parallelOpts.batchFile.empty()) {
+                std::cerr << "Batch evaluation is only available for the "
+                             "ParamViaX routines!"
+                          << std::endl;
+                return withUsage();
+            }
         }
     }
 
@@ -273,6 +335,9 @@ int main(int argc, char *argv[]) {
     params.performingOptimization = true;
     params.silent = true;
     params.debug = false;
+    /// Every tracker created to evaluate a cost shuffles its measurements the
+    /// same way, so costs only depend on the parameters.
+    params.randomSeed = randomSeed;
 
     params.offsetToCentroid = false;
     params.includeRearPanel = false;
@@ -294,13 +359,15 @@ int main(int argc, char *argv[]) {
     case OptimizationRoutine::ParamViaRansac:
 
         paramOptFunc(data, costOnly,
-                     osvr::vbtracker::OptimCommonData{camParams, params}, 30);
+                     osvr::vbtracker::OptimCommonData{camParams, params}, 30,
+                     parallelOpts);
         break;
 
     case OptimizationRoutine::ParamViaRefTracker:
 
         paramOptFunc(data, costOnly,
-                     osvr::vbtracker::OptimCommonData{camParams, params}, 300);
+                     osvr::vbtracker::OptimCommonData{camParams, params}, 300,
+                     parallelOpts);
         break;
 
     default:
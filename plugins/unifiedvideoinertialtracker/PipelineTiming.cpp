@@ -0,0 +1,81 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "PipelineTiming.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <numeric>
+
+namespace osvr {
+namespace vbtracker {
+    const char *getPipelineStageName(PipelineStage stage) {
+        switch (stage) {
+        case PipelineStage::Extraction:
+            return "extraction";
+        case PipelineStage::Assignment:
+            return "assignment";
+        case PipelineStage::Estimation:
+            return "estimation";
+        case PipelineStage::Reporting:
+            return "reporting";
+        }
+        return "unknown";
+    }
+
+    void PipelineTimingStats::record(PipelineStage stage,
+                                     clock::duration duration) {
+        auto usec =
+            std::chrono::duration<double, std::micro>(duration).count();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_samples[static_cast<std::size_t>(stage)].push_back(usec);
+    }
+
+    PipelineStageSummary
+    PipelineTimingStats::summarize(PipelineStage stage) const {
+        std::vector<double> samples;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            samples = m_samples[static_cast<std::size_t>(stage)];
+        }
+        PipelineStageSummary ret;
+        ret.count = samples.size();
+        if (samples.empty()) {
+            return ret;
+        }
+        std::sort(samples.begin(), samples.end());
+        static const double MS_PER_US = 1.e-3;
+        ret.mean = std::accumulate(samples.begin(), samples.end(), 0.) /
+                   samples.size() * MS_PER_US;
+        ret.median = samples[samples.size() / 2] * MS_PER_US;
+        ret.percentile95 = samples[(samples.size() * 95) / 100] * MS_PER_US;
+        ret.max = samples.back() * MS_PER_US;
+        return ret;
+    }
+} // namespace vbtracker
+} // namespace osvr
@@ -0,0 +1,108 @@
+/** @file
+    @brief Header for collecting how long each stage of the tracking pipeline
+    takes, frame by frame.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_PipelineTiming_h_GUID_C4719E3A_5B06_4D82_8F1D_26A9E0B7C345
+#define INCLUDED_PipelineTiming_h_GUID_C4719E3A_5B06_4D82_8F1D_26A9E0B7C345
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace osvr {
+namespace vbtracker {
+    enum class PipelineStage {
+        /// Blob extraction, on the image processing thread.
+        Extraction,
+        /// Assigning blobs to LEDs and identifying them.
+        Assignment,
+        /// Pose estimation from the LEDs.
+        Estimation,
+        /// Copying updated bodies into the reporting vector.
+        Reporting
+    };
+    static const std::size_t NUM_PIPELINE_STAGES = 4;
+
+    const char *getPipelineStageName(PipelineStage stage);
+
+    /// Summary of the time taken by one stage, in milliseconds.
+    struct PipelineStageSummary {
+        std::size_t count = 0;
+        double mean = 0;
+        double median = 0;
+        double percentile95 = 0;
+        double max = 0;
+    };
+
+    /// Collects the duration of every run of each pipeline stage: meant for
+    /// benchmarking, not for leaving on. Thread-safe.
+    class PipelineTimingStats {
+      public:
+        using clock = std::chrono::steady_clock;
+        void record(PipelineStage stage, clock::duration duration);
+        PipelineStageSummary summarize(PipelineStage stage) const;
+
+      private:
+        mutable std::mutex m_mutex;
+        /// Microseconds, per stage.
+        std::array<std::vector<double>, NUM_PIPELINE_STAGES> m_samples;
+    };
+
+    /// Records the time from construction to destruction as a run of the
+    /// given stage, if there's somewhere to record it.
+    class PipelineStageTimer {
+      public:
+        PipelineStageTimer(PipelineTimingStats *stats, PipelineStage stage)
+            : m_stats(stats), m_stage(stage) {
+            if (m_stats) {
+                m_start = PipelineTimingStats::clock::now();
+            }
+        }
+        ~PipelineStageTimer() {
+            if (m_stats) {
+                m_stats->record(m_stage,
+                                PipelineTimingStats::clock::now() - m_start);
+            }
+        }
+        PipelineStageTimer(PipelineStageTimer const &) = delete;
+        PipelineStageTimer &operator=(PipelineStageTimer const &) = delete;
+
+      private:
+        PipelineTimingStats *m_stats;
+        PipelineStage m_stage;
+        PipelineTimingStats::clock::time_point m_start;
+    };
+} // namespace vbtracker
+} // namespace osvr
+
+#endif // INCLUDED_PipelineTiming_h_GUID_C4719E3A_5B06_4D82_8F1D_26A9E0B7C345
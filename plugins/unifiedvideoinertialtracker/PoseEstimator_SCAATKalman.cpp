@@ -99,7 +99,8 @@ namespace vbtracker {
           m_distanceMeasVarianceIntercept(
               params.tuning.distanceMeasVarianceIntercept),
           m_extraVerbose(params.extraVerbose),
-          m_randEngine(std::random_device()()) {
+          m_randEngine(params.randomSeed != 0 ? params.randomSeed
+                                              : std::random_device()()) {
         std::tie(m_minBoxRatio, m_maxBoxRatio) =
             std::minmax({params.boundingBoxFilterRatio,
                          1.f / params.boundingBoxFilterRatio});
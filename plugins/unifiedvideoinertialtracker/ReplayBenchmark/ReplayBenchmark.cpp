@@ -0,0 +1,408 @@
+/** @file
+    @brief Replays a tracker capture through the real tracker thread pipeline,
+    reporting how long each stage took and, optionally, how the resulting
+    poses differ from those of an earlier run.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#define OSVR_HAVE_BOOST
+
+// Internal Includes
+#include "../AdditionalReports.h"
+#include "../ConfigParams.h"
+#include "../ConfigurationParser.h"
+#include "../ImageSources/ReplayImageSource.h"
+#include "../MakeHDKTrackingSystem.h"
+#include "../PipelineTiming.h"
+#include "../ThreadsafeBodyReporting.h"
+#include "../TrackedBody.h"
+#include "../TrackerThread.h"
+#include <CameraParameters.h>
+#include <osvr/Util/EigenInterop.h>
+#include <osvr/Util/MiniArgsHandling.h>
+
+// Library/third-party includes
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/variant.hpp>
+#include <json/reader.h>
+#include <json/value.h>
+
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace osvr {
+namespace vbtracker {
+    /// A pose the tracker reported for a body.
+    struct PoseSample {
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+        BodyId::wrapped_type body;
+        util::time::TimeValue timestamp;
+        Eigen::Vector3d position;
+        Eigen::Quaterniond orientation;
+    };
+    using PoseSampleVec =
+        std::vector<PoseSample, Eigen::aligned_allocator<PoseSample> >;
+
+    /// Hands replayed IMU reports to the tracker thread, as the plugin does
+    /// with live ones.
+    class SubmitIMUReport : public boost::static_visitor<bool> {
+      public:
+        SubmitIMUReport(TrackerThread &tracker, TrackedBodyIMU &imu,
+                        util::time::TimeValue const &tv)
+            : m_tracker(tracker), m_imu(imu), m_tv(tv) {}
+        bool operator()(CapturedFrame const &) const { return true; }
+        template <typename ReportType>
+        bool operator()(ReportType const &report) const {
+            return m_tracker.submitIMUReport(m_imu, m_tv, report);
+        }
+
+      private:
+        TrackerThread &m_tracker;
+        TrackedBodyIMU &m_imu;
+        util::time::TimeValue const &m_tv;
+    };
+
+    static const double RADIANS_TO_DEGREES = 180. / 3.14159265358979323846;
+
+    /// Used unless the config sets randomSeed, so runs can be compared.
+    static const std::uint32_t DEFAULT_REPLAY_SEED = 1;
+
+    /// Most IMU reports handed to the tracker per frame: any more wait for
+    /// the next frame. Each can produce a pose report, so this bounds how many
+    /// the reporting queues must hold between two frames.
+    static const std::size_t MAX_IMU_REPORTS_PER_FRAME = 48;
+    static const auto POSES_HEADER = "body,sec,usec,x,y,z,qw,qx,qy,qz";
+
+    bool writePoses(std::string const &fn, PoseSampleVec const &poses) {
+        std::ofstream os(fn);
+        if (!os) {
+            std::cerr << "Could not open " << fn << " to write poses to."
+                      << std::endl;
+            return false;
+        }
+        os << std::setprecision(std::numeric_limits<double>::digits10 + 2);
+        os << POSES_HEADER << "\n";
+        for (auto const &pose : poses) {
+            os << pose.body << "," << pose.timestamp.seconds << ","
+               << pose.timestamp.microseconds;
+            for (std::size_t i = 0; i < 3; ++i) {
+                os << "," << pose.position[i];
+            }
+            os << "," << pose.orientation.w() << "," << pose.orientation.x()
+               << "," << pose.orientation.y() << "," << pose.orientation.z()
+               << "\n";
+        }
+        return static_cast<bool>(os);
+    }
+
+    bool loadPoses(std::string const &fn, PoseSampleVec &poses) {
+        std::ifstream is(fn);
+        std::string line;
+        if (!is || !std::getline(is, line) || line != POSES_HEADER) {
+            std::cerr << "Could not load poses from " << fn << std::endl;
+            return false;
+        }
+        while (std::getline(is, line)) {
+            std::replace(line.begin(), line.end(), ',', ' ');
+            std::istringstream iss(line);
+            PoseSample pose;
+            double qw, qx, qy, qz;
+            if (!(iss >> pose.body >> pose.timestamp.seconds >>
+                  pose.timestamp.microseconds >> pose.position.x() >>
+                  pose.position.y() >> pose.position.z() >> qw >> qx >> qy >>
+                  qz)) {
+                std::cerr << "Could not parse pose line in " << fn << ": "
+                          << line << std::endl;
+                return false;
+            }
+            pose.orientation = Eigen::Quaterniond(qw, qx, qy, qz);
+            poses.push_back(pose);
+        }
+        return true;
+    }
+
+    /// Matches poses with those reported for the same body and timestamp in
+    /// the baseline, and prints how much they differ.
+    void comparePoses(PoseSampleVec const &baseline,
+                      PoseSampleVec const &poses) {
+        using Key = std::pair<BodyId::wrapped_type, std::int64_t>;
+        auto makeKey = [](PoseSample const &pose) {
+            return Key(pose.body,
+                       static_cast<std::int64_t>(pose.timestamp.seconds) *
+                               1000000 +
+                           pose.timestamp.microseconds);
+        };
+        std::map<Key, PoseSample const *> baselineByKey;
+        for (auto const &pose : baseline) {
+            baselineByKey[makeKey(pose)] = &pose;
+        }
+        std::size_t matched = 0;
+        double sumPosErr = 0;
+        double maxPosErr = 0;
+        double sumAngErr = 0;
+        double maxAngErr = 0;
+        for (auto const &pose : poses) {
+            auto it = baselineByKey.find(makeKey(pose));
+            if (it == baselineByKey.end()) {
+                continue;
+            }
+            auto const &other = *it->second;
+            ++matched;
+            auto posErr = (pose.position - other.position).norm() * 1000.;
+            auto angErr = pose.orientation.angularDistance(other.orientation) *
+                          RADIANS_TO_DEGREES;
+            sumPosErr += posErr;
+            sumAngErr += angErr;
+            maxPosErr = std::max(maxPosErr, posErr);
+            maxAngErr = std::max(maxAngErr, angErr);
+        }
+        std::cout << "Pose comparison against baseline:\n";
+        std::cout << "  matched " << matched << " of " << poses.size()
+                  << " poses (" << baseline.size() << " in baseline)\n";
+        if (matched > 0) {
+            std::cout << "  position difference (mm): mean "
+                      << sumPosErr / matched << ", max " << maxPosErr << "\n";
+            std::cout << "  orientation difference (deg): mean "
+                      << sumAngErr / matched << ", max " << maxAngErr << "\n";
+        }
+    }
+
+    void printTimingSummary(PipelineTimingStats const &stats) {
+        static const PipelineStage stages[] = {
+            PipelineStage::Extraction, PipelineStage::Assignment,
+            PipelineStage::Estimation, PipelineStage::Reporting};
+        std::cout << "Per-stage latency (ms):\n";
+        std::cout << std::setw(12) << "stage" << std::setw(8) << "count"
+                  << std::setw(10) << "mean" << std::setw(10) << "median"
+                  << std::setw(10) << "p95" << std::setw(10) << "max"
+                  << "\n";
+        for (auto stage : stages) {
+            auto summary = stats.summarize(stage);
+            std::cout << std::setw(12) << getPipelineStageName(stage)
+                      << std::setw(8) << summary.count << std::fixed
+                      << std::setprecision(3) << std::setw(10) << summary.mean
+                      << std::setw(10) << summary.median << std::setw(10)
+                      << summary.percentile95 << std::setw(10) << summary.max
+                      << "\n";
+        }
+        std::cout.unsetf(std::ios::fixed);
+    }
+
+    struct BenchmarkOptions {
+        ConfigParams params;
+        std::string captureDir;
+        bool maxSpeed = false;
+        std::string posesOut;
+        std::string baseline;
+    };
+
+    int runBenchmark(BenchmarkOptions const &opts) {
+        PoseSampleVec baseline;
+        if (!opts.baseline.empty() && !loadPoses(opts.baseline, baseline)) {
+            return -1;
+        }
+
+        auto params = opts.params;
+        if (0 == params.randomSeed) {
+            params.randomSeed = DEFAULT_REPLAY_SEED;
+        }
+        auto trackingSystem = makeHDKTrackingSystem(params);
+        PipelineTimingStats stats;
+        trackingSystem->setTimingStats(&stats);
+
+        /// Poses are collected before each frame, on the tracker thread, so
+        /// the queues only need to hold one frame's worth to never drop any:
+        /// one per IMU report, plus the frame's own.
+        auto numBodies = trackingSystem->getNumBodies();
+        BodyReportingVector reportingVec;
+        for (std::size_t i = 0; i < numBodies + extra_outputs::numExtraOutputs;
+             ++i) {
+            reportingVec.emplace_back(
+                BodyReporting::make(MAX_IMU_REPORTS_PER_FRAME + 1));
+        }
+
+        /// The image source needs somewhere to send the IMU data, and the
+        /// tracker thread needs the image source.
+        TrackerThread *tracker = nullptr;
+        auto &mainBody = trackingSystem->getBody(BodyId(0));
+        auto imu = mainBody.hasIMU() ? &mainBody.getIMU() : nullptr;
+        std::size_t imuReportsThisFrame = 0;
+        auto imuSink = [&](CapturedEntry const &entry) {
+            if (!imu) {
+                return true;
+            }
+            if (imuReportsThisFrame == MAX_IMU_REPORTS_PER_FRAME) {
+                return false;
+            }
+            if (!boost::apply_visitor(
+                    SubmitIMUReport(*tracker, *imu, entry.timestamp),
+                    entry.data)) {
+                return false;
+            }
+            ++imuReportsThisFrame;
+            return true;
+        };
+        ReplayImageSource source(opts.captureDir,
+                                 opts.maxSpeed ? ReplayPacing::MaxSpeed
+                                               : ReplayPacing::Recorded,
+                                 imuSink, params.cameraMicrosecondsOffset);
+        if (!source.ok()) {
+            std::cerr << "Could not load a capture from " << opts.captureDir
+                      << std::endl;
+            return -1;
+        }
+        std::cout << "Replaying " << source.getNumFrames() << " frames from "
+                  << opts.captureDir << " at "
+                  << (opts.maxSpeed ? "maximum" : "recorded") << " speed"
+                  << std::endl;
+
+        TrackerThread trackerThreadObj(
+            *trackingSystem, source, reportingVec, getHDKCameraParameters(),
+            params.cameraMicrosecondsOffset, !params.continuousReporting);
+        tracker = &trackerThreadObj;
+        trackerThreadObj.setThreadScheduling(
+            params.trackerThreadScheduling,
+            params.imageProcessingThreadScheduling);
+
+        PoseSampleVec poses;
+        auto collectPoses = [&] {
+            namespace ei = util::eigen_interop;
+            for (std::size_t i = 0; i < numBodies; ++i) {
+                BodyReport report;
+                while (reportingVec[i]->getUnpredictedReport(report)) {
+                    PoseSample pose;
+                    pose.body = static_cast<BodyId::wrapped_type>(i);
+                    pose.timestamp = report.timestamp;
+                    pose.position = ei::map(report.pose).translation();
+                    pose.orientation = ei::map(report.pose).rotation();
+                    poses.push_back(pose);
+                }
+            }
+        };
+
+        /// The tracker thread is done with the previous frame when it grabs
+        /// the next: drain the queues then, so their size, not how often this
+        /// thread gets to run, decides whether any poses are dropped.
+        source.setBeforeFrameCallback([&] {
+            collectPoses();
+            imuReportsThisFrame = 0;
+        });
+
+        std::thread trackerThread([&] { trackerThreadObj.threadAction(); });
+        trackerThreadObj.permitStart();
+        while (!source.finished()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        trackerThreadObj.triggerStop();
+        trackerThread.join();
+        /// Now the tracker thread is gone, this thread can be the consumer.
+        collectPoses();
+
+        auto seconds = source.getReplayDuration().count();
+        auto framesTracked = stats.summarize(PipelineStage::Assignment).count;
+        std::cout << "Tracked " << framesTracked << " frames in " << seconds
+                  << " s: " << framesTracked / seconds << " frames/sec\n";
+        printTimingSummary(stats);
+        std::cout << poses.size() << " poses reported\n";
+
+        if (!baseline.empty()) {
+            comparePoses(baseline, poses);
+        }
+        if (!opts.posesOut.empty() && !writePoses(opts.posesOut, poses)) {
+            return -1;
+        }
+        return 0;
+    }
+} // namespace vbtracker
+} // namespace osvr
+
+static const auto MAX_SPEED_SWITCH = "--max-speed";
+static const auto POSES_ARG = "--poses";
+static const auto BASELINE_ARG = "--baseline";
+
+static void usage(const char *argv0) {
+    std::cerr << "Usage: " << argv0 << " [config.json] <capture directory> ["
+              << MAX_SPEED_SWITCH << "] [" << POSES_ARG << " out.csv] ["
+              << BASELINE_ARG << " baseline.csv]\n"
+              << "Replays a capture recorded with the captureDirectory "
+                 "option through the tracker, reporting per-stage timing. "
+              << POSES_ARG << " saves the resulting poses, which can be "
+                 "passed to a later run as "
+              << BASELINE_ARG << " to compare. Unless the config sets "
+                                 "randomSeed, a fixed seed is used so runs "
+                                 "over the same capture match."
+              << std::endl;
+}
+
+using namespace osvr::util::args;
+int main(int argc, char *argv[]) {
+    osvr::vbtracker::BenchmarkOptions opts;
+    auto args = makeArgList(argc, argv);
+    try {
+        opts.maxSpeed = handle_has_switch(args, MAX_SPEED_SWITCH);
+        handle_value_arg(
+            args, [](std::string const &arg) { return arg == POSES_ARG; },
+            [&](std::string const &val) { opts.posesOut = val; });
+        handle_value_arg(
+            args, [](std::string const &arg) { return arg == BASELINE_ARG; },
+            [&](std::string const &val) { opts.baseline = val; });
+
+        /// parse json file arguments.
+        auto numJson = handle_arg(args, [&](std::string const &arg) {
+            if (!boost::iends_with(arg, ".json")) {
+                return false;
+            }
+            std::ifstream configFile(arg);
+            Json::Value root;
+            Json::Reader reader;
+            if (!configFile || !reader.parse(configFile, root)) {
+                throw std::runtime_error("Could not load " + arg +
+                                         " as a JSON config file!");
+            }
+            opts.params = osvr::vbtracker::parseConfigParams(root);
+            return true;
+        });
+        if (numJson > 1 || args.size() != 1) {
+            usage(argv[0]);
+            return -1;
+        }
+        opts.captureDir = args.front();
+    } catch (std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+    return osvr::vbtracker::runBenchmark(opts);
+}
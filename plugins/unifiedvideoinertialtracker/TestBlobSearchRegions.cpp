@@ -0,0 +1,127 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#define CATCH_CONFIG_MAIN
+
+// Internal Includes
+#include "BlobSearchRegions.h"
+#include <CameraDistortionModel.h>
+
+// Library/third-party includes
+#include <catch.hpp>
+
+// Standard includes
+#include <vector>
+
+using osvr::vbtracker::CameraDistortionModel;
+using osvr::vbtracker::mergeOverlapping;
+
+/// Distortion far stronger than the HDK camera's, so the iterative inverse
+/// has some work to do.
+static CameraDistortionModel makeModel(Eigen::Vector3d const &k) {
+    return CameraDistortionModel{Eigen::Vector2d{700, 700},
+                                 Eigen::Vector2d{320, 240}, k};
+}
+
+TEST_CASE("distortPoint inverts undistortPoint") {
+    auto model = makeModel(Eigen::Vector3d{-0.1, 0.01, 0});
+    for (double x : {0., 100., 320., 500., 639.}) {
+        for (double y : {0., 50., 240., 479.}) {
+            CAPTURE(x);
+            CAPTURE(y);
+            Eigen::Vector2d pointu{x, y};
+            Eigen::Vector2d roundTrip =
+                model.undistortPoint(model.distortPoint(pointu));
+            REQUIRE((roundTrip - pointu).norm() < 0.05);
+        }
+    }
+}
+
+TEST_CASE("distortPoint leaves the center of projection alone") {
+    auto model = makeModel(Eigen::Vector3d{-0.1, 0.01, 0});
+    Eigen::Vector2d center{320, 240};
+    REQUIRE((model.distortPoint(center) - center).norm() < 1e-9);
+}
+
+TEST_CASE("distortPoint is the identity without distortion") {
+    auto model = makeModel(Eigen::Vector3d::Zero());
+    Eigen::Vector2d pointu{12.5, 400};
+    REQUIRE((model.distortPoint(pointu) - pointu).norm() < 1e-9);
+}
+
+TEST_CASE("distortPoint moves points the opposite way to undistortPoint") {
+    auto model = makeModel(Eigen::Vector3d{-0.1, 0.01, 0});
+    Eigen::Vector2d center{320, 240};
+    Eigen::Vector2d point{600, 450};
+    auto radius = (point - center).norm();
+    REQUIRE((model.undistortPoint(point) - center).norm() < radius);
+    REQUIRE((model.distortPoint(point) - center).norm() > radius);
+}
+
+TEST_CASE("disjoint regions aren't merged") {
+    std::vector<cv::Rect> regions{cv::Rect(0, 0, 10, 10),
+                                  cv::Rect(20, 20, 10, 10)};
+    mergeOverlapping(regions);
+    REQUIRE(regions.size() == 2);
+    REQUIRE(regions[0] == cv::Rect(0, 0, 10, 10));
+    REQUIRE(regions[1] == cv::Rect(20, 20, 10, 10));
+}
+
+TEST_CASE("touching regions aren't merged") {
+    std::vector<cv::Rect> regions{cv::Rect(0, 0, 10, 10),
+                                  cv::Rect(10, 0, 10, 10)};
+    mergeOverlapping(regions);
+    REQUIRE(regions.size() == 2);
+}
+
+TEST_CASE("overlapping regions merge into their bounding rectangle") {
+    std::vector<cv::Rect> regions{cv::Rect(0, 0, 10, 10),
+                                  cv::Rect(5, 5, 10, 10)};
+    mergeOverlapping(regions);
+    REQUIRE(regions.size() == 1);
+    REQUIRE(regions[0] == cv::Rect(0, 0, 15, 15));
+}
+
+TEST_CASE("merging repeats until nothing overlaps") {
+    // The first two only overlap the third, and the fourth only overlaps the
+    // bounding rectangle of the first three.
+    std::vector<cv::Rect> regions{
+        cv::Rect(0, 0, 10, 10), cv::Rect(30, 0, 10, 10), cv::Rect(8, 4, 24, 2),
+        cv::Rect(15, 7, 5, 8), cv::Rect(100, 100, 10, 10)};
+    mergeOverlapping(regions);
+    REQUIRE(regions.size() == 2);
+    REQUIRE(regions[0] == cv::Rect(0, 0, 40, 15));
+    REQUIRE(regions[1] == cv::Rect(100, 100, 10, 10));
+}
+
+TEST_CASE("merging an empty or single list changes nothing") {
+    std::vector<cv::Rect> regions;
+    mergeOverlapping(regions);
+    REQUIRE(regions.empty());
+    regions.emplace_back(1, 2, 3, 4);
+    mergeOverlapping(regions);
+    REQUIRE(regions.size() == 1);
+    REQUIRE(regions[0] == cv::Rect(1, 2, 3, 4));
+}
@@ -0,0 +1,161 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#define CATCH_CONFIG_MAIN
+
+// Internal Includes
+#include "ParameterFinder/ParallelEvaluation.h"
+
+// Library/third-party includes
+#include <catch.hpp>
+
+// Standard includes
+#include <atomic>
+#include <cstddef>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using osvr::vbtracker::RowRange;
+using osvr::vbtracker::runTasksInParallel;
+using osvr::vbtracker::splitIntoSegments;
+
+TEST_CASE("segments cover the rows in order, nearly equally") {
+    for (std::size_t rows : {1, 2, 7, 10, 100, 101}) {
+        for (std::size_t segs : {1, 2, 3, 4, 16}) {
+            CAPTURE(rows);
+            CAPTURE(segs);
+            auto segments = splitIntoSegments(rows, segs);
+            REQUIRE(segments.size() == std::min(rows, segs));
+            std::size_t next = 0;
+            std::size_t smallest = rows;
+            std::size_t largest = 0;
+            for (auto const &segment : segments) {
+                REQUIRE(segment.first == next);
+                REQUIRE(segment.second > segment.first);
+                auto size = segment.second - segment.first;
+                smallest = std::min(smallest, size);
+                largest = std::max(largest, size);
+                next = segment.second;
+            }
+            REQUIRE(next == rows);
+            REQUIRE(largest - smallest <= 1);
+        }
+    }
+}
+
+TEST_CASE("segments put the extra rows first") {
+    auto segments = splitIntoSegments(10, 4);
+    std::vector<RowRange> expected{
+        RowRange(0, 3), RowRange(3, 6), RowRange(6, 8), RowRange(8, 10)};
+    REQUIRE(segments == expected);
+}
+
+TEST_CASE("no rows still makes one (empty) segment") {
+    for (std::size_t segs : {0, 1, 4}) {
+        CAPTURE(segs);
+        auto segments = splitIntoSegments(0, segs);
+        REQUIRE(segments.size() == 1);
+        REQUIRE(segments.front() == RowRange(0, 0));
+    }
+}
+
+TEST_CASE("zero segments is treated as one") {
+    auto segments = splitIntoSegments(5, 0);
+    REQUIRE(segments.size() == 1);
+    REQUIRE(segments.front() == RowRange(0, 5));
+}
+
+TEST_CASE("parallel tasks each run exactly once") {
+    for (std::size_t threads : {0, 1, 2, 4, 8}) {
+        for (std::size_t n : {0, 1, 3, 50}) {
+            CAPTURE(threads);
+            CAPTURE(n);
+            std::vector<std::atomic<int> > calls(n);
+            for (auto &c : calls) {
+                c = 0;
+            }
+            runTasksInParallel(n, threads, [&](std::size_t i) { ++calls[i]; });
+            for (auto &c : calls) {
+                REQUIRE(c == 1);
+            }
+        }
+    }
+}
+
+TEST_CASE("one thread runs the tasks in order on the caller") {
+    auto caller = std::this_thread::get_id();
+    std::vector<std::size_t> order;
+    std::set<std::thread::id> ids;
+    runTasksInParallel(5, 1, [&](std::size_t i) {
+        order.push_back(i);
+        ids.insert(std::this_thread::get_id());
+    });
+    REQUIRE(order == std::vector<std::size_t>({0, 1, 2, 3, 4}));
+    REQUIRE(ids.size() == 1);
+    REQUIRE(*ids.begin() == caller);
+}
+
+TEST_CASE("parallel tasks run concurrently") {
+    // Each task waits until both have started, which only finishes if they
+    // run at the same time.
+    std::atomic<int> started(0);
+    runTasksInParallel(2, 2, [&](std::size_t) {
+        ++started;
+        while (started < 2) {
+            std::this_thread::yield();
+        }
+    });
+    REQUIRE(started == 2);
+}
+
+TEST_CASE("the first exception is rethrown and later tasks skipped") {
+    std::atomic<int> ran(0);
+    REQUIRE_THROWS_AS(runTasksInParallel(100, 1,
+                                         [&](std::size_t i) {
+                                             ++ran;
+                                             if (i == 3) {
+                                                 throw std::runtime_error(
+                                                     "task failed");
+                                             }
+                                         }),
+                      std::runtime_error const &);
+    REQUIRE(ran == 4);
+}
+
+TEST_CASE("an exception on a worker thread reaches the caller") {
+    std::atomic<int> ran(0);
+    REQUIRE_THROWS_AS(runTasksInParallel(50, 4,
+                                         [&](std::size_t) {
+                                             ++ran;
+                                             throw std::runtime_error(
+                                                 "task failed");
+                                         }),
+                      std::runtime_error const &);
+    // Each thread stops after its first failure.
+    REQUIRE(ran >= 1);
+    REQUIRE(ran <= 4);
+}
@@ -0,0 +1,234 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#define CATCH_CONFIG_MAIN
+
+// Internal Includes
+#include "ImageSources/ReplayImageSource.h"
+#include "ImageSources/TrackerCapture.h"
+
+// Library/third-party includes
+#include <boost/filesystem.hpp>
+#include <boost/variant.hpp>
+#include <catch.hpp>
+
+// Standard includes
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace osvr::vbtracker;
+namespace fs = boost::filesystem;
+using osvr::util::time::TimeValue;
+
+/// A fresh directory, removed with everything in it when done.
+class TempDirectory {
+  public:
+    TempDirectory()
+        : m_path(fs::temp_directory_path() /
+                 fs::unique_path("uvbi-capture-%%%%-%%%%-%%%%")) {
+        fs::create_directories(m_path);
+    }
+    ~TempDirectory() {
+        boost::system::error_code ec;
+        fs::remove_all(m_path, ec);
+    }
+    std::string path() const { return m_path.string(); }
+
+  private:
+    fs::path m_path;
+};
+
+static TimeValue ms(int milliseconds) {
+    TimeValue tv;
+    tv.seconds = 1000;
+    tv.microseconds = milliseconds * 1000;
+    return tv;
+}
+
+/// A small image with every byte different.
+static cv::Mat makeImage(int seed) {
+    cv::Mat ret(3, 4, CV_8UC3);
+    auto data = ret.ptr<unsigned char>();
+    for (std::size_t i = 0, e = ret.total() * ret.elemSize(); i < e; ++i) {
+        data[i] = static_cast<unsigned char>(seed + i * 7);
+    }
+    return ret;
+}
+
+static OSVR_OrientationReport makeOrientation(double w) {
+    OSVR_OrientationReport report;
+    report.sensor = 1;
+    report.rotation.data[0] = w;
+    report.rotation.data[1] = 0.1234567890123456789;
+    report.rotation.data[2] = -1. / 3.;
+    report.rotation.data[3] = 1e-17;
+    return report;
+}
+
+TEST_CASE("capture index round trip") {
+    TempDirectory dir;
+    auto orientation = makeOrientation(0.70710678118654752);
+    OSVR_AngularVelocityReport angVel;
+    angVel.sensor = 2;
+    angVel.state.dt = 1. / 400.;
+    angVel.state.incrementalRotation.data[0] = 0.9999999999;
+    angVel.state.incrementalRotation.data[1] = 2. / 3.;
+    angVel.state.incrementalRotation.data[2] = -1e-12;
+    angVel.state.incrementalRotation.data[3] = 0;
+    auto image = makeImage(5);
+    {
+        CaptureWriter writer(dir.path());
+        REQUIRE(writer.ok());
+        writer.writeIMU(ms(1), orientation);
+        writer.writeFrame(ms(2), image);
+        writer.writeIMU(ms(3), angVel);
+    }
+
+    std::vector<CapturedEntry> entries;
+    REQUIRE(loadCaptureIndex(dir.path(), entries));
+    REQUIRE(entries.size() == 3);
+
+    REQUIRE(entries[0].timestamp == ms(1));
+    auto loadedOrientation =
+        boost::get<OSVR_OrientationReport>(&entries[0].data);
+    REQUIRE(loadedOrientation);
+    REQUIRE(loadedOrientation->sensor == orientation.sensor);
+    for (int i = 0; i < 4; ++i) {
+        REQUIRE(loadedOrientation->rotation.data[i] ==
+                orientation.rotation.data[i]);
+    }
+
+    REQUIRE(entries[1].timestamp == ms(2));
+    auto frame = boost::get<CapturedFrame>(&entries[1].data);
+    REQUIRE(frame);
+    auto loadedImage = loadCapturedFrame(dir.path(), *frame);
+    REQUIRE(loadedImage.size() == image.size());
+    REQUIRE(loadedImage.type() == image.type());
+    REQUIRE(cv::norm(loadedImage, image, cv::NORM_INF) == 0);
+
+    REQUIRE(entries[2].timestamp == ms(3));
+    auto loadedAngVel =
+        boost::get<OSVR_AngularVelocityReport>(&entries[2].data);
+    REQUIRE(loadedAngVel);
+    REQUIRE(loadedAngVel->sensor == angVel.sensor);
+    REQUIRE(loadedAngVel->state.dt == angVel.state.dt);
+    for (int i = 0; i < 4; ++i) {
+        REQUIRE(loadedAngVel->state.incrementalRotation.data[i] ==
+                angVel.state.incrementalRotation.data[i]);
+    }
+}
+
+/// Replays a capture at maximum speed, describing what happened in order.
+static std::vector<std::string> replay(std::string const &directory,
+                                       std::int32_t cameraUsecOffset = 0) {
+    std::vector<std::string> events;
+    auto sink = [&](CapturedEntry const &entry) {
+        events.push_back("imu " +
+                         std::to_string(entry.timestamp.microseconds / 1000));
+        return true;
+    };
+    ReplayImageSource source(directory, ReplayPacing::MaxSpeed, sink,
+                             cameraUsecOffset);
+    REQUIRE(source.ok());
+    source.setBeforeFrameCallback([&] { events.push_back("before"); });
+    while (source.grab()) {
+        cv::Mat color;
+        TimeValue tv;
+        source.retrieveColor(color, tv);
+        REQUIRE(!color.empty());
+        events.push_back("frame " + std::to_string(tv.microseconds / 1000));
+    }
+    REQUIRE(source.finished());
+    return events;
+}
+
+TEST_CASE("replay hands over frames and IMU reports in timestamp order") {
+    TempDirectory dir;
+    {
+        // Written in the order they might arrive at the tracker, which isn't
+        // the order they happened in.
+        CaptureWriter writer(dir.path());
+        writer.writeFrame(ms(10), makeImage(1));
+        writer.writeIMU(ms(5), makeOrientation(1));
+        writer.writeIMU(ms(15), makeOrientation(1));
+        writer.writeIMU(ms(12), makeOrientation(1));
+        writer.writeFrame(ms(20), makeImage(2));
+        writer.writeIMU(ms(25), makeOrientation(1));
+    }
+    auto events = replay(dir.path());
+    std::vector<std::string> expected{
+        "before", "imu 5",  "frame 10", "before", "imu 12", "imu 15",
+        "frame 20", "before", "imu 25"};
+    REQUIRE(events == expected);
+}
+
+TEST_CASE("replay orders frames by the time the tracker will give them") {
+    TempDirectory dir;
+    {
+        CaptureWriter writer(dir.path());
+        writer.writeIMU(ms(15), makeOrientation(1));
+        writer.writeFrame(ms(20), makeImage(1));
+    }
+    // The frame is taken to have happened 10 ms before it arrived, so before
+    // the IMU report.
+    auto events = replay(dir.path(), -10000);
+    std::vector<std::string> expected{"before", "frame 20", "before",
+                                      "imu 15"};
+    REQUIRE(events == expected);
+}
+
+TEST_CASE("replay offers refused IMU reports again before the next frame") {
+    TempDirectory dir;
+    {
+        CaptureWriter writer(dir.path());
+        writer.writeIMU(ms(5), makeOrientation(1));
+        writer.writeIMU(ms(6), makeOrientation(1));
+        writer.writeFrame(ms(10), makeImage(1));
+        writer.writeFrame(ms(20), makeImage(2));
+    }
+    std::vector<std::string> events;
+    bool refuse = true;
+    auto sink = [&](CapturedEntry const &entry) {
+        if (refuse && entry.timestamp == ms(6)) {
+            refuse = false;
+            return false;
+        }
+        events.push_back("imu " +
+                         std::to_string(entry.timestamp.microseconds / 1000));
+        return true;
+    };
+    ReplayImageSource source(dir.path(), ReplayPacing::MaxSpeed, sink);
+    REQUIRE(source.getNumFrames() == 2);
+    while (source.grab()) {
+        cv::Mat color;
+        TimeValue tv;
+        source.retrieveColor(color, tv);
+        events.push_back("frame " + std::to_string(tv.microseconds / 1000));
+    }
+    std::vector<std::string> expected{"imu 5", "frame 10", "imu 6",
+                                      "frame 20"};
+    REQUIRE(events == expected);
+}
@@ -0,0 +1,116 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#define CATCH_CONFIG_MAIN
+
+// Internal Includes
+#include "WorkerPool.h"
+
+// Library/third-party includes
+#include <catch.hpp>
+
+// Standard includes
+#include <atomic>
+#include <cstddef>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using osvr::vbtracker::WorkerPool;
+using osvr::vbtracker::chooseNumPoseEstimationThreads;
+
+static const osvr::common::ThreadSchedulingOptions defaultScheduling;
+
+TEST_CASE("worker pool runs each index exactly once") {
+    for (std::size_t threads : {1, 2, 4}) {
+        WorkerPool pool(threads, defaultScheduling);
+        REQUIRE(pool.getNumThreads() == (threads < 1 ? 1 : threads));
+        for (std::size_t n : {0, 1, 2, 3, 17, 100}) {
+            CAPTURE(threads);
+            CAPTURE(n);
+            std::vector<std::atomic<int> > calls(n);
+            for (auto &c : calls) {
+                c = 0;
+            }
+            pool.forEachIndex(n, [&](std::size_t i) { ++calls[i]; });
+            for (auto &c : calls) {
+                REQUIRE(c == 1);
+            }
+        }
+    }
+}
+
+TEST_CASE("worker pool with one thread runs inline") {
+    WorkerPool pool(1, defaultScheduling);
+    auto caller = std::this_thread::get_id();
+    std::set<std::thread::id> ids;
+    pool.forEachIndex(
+        10, [&](std::size_t) { ids.insert(std::this_thread::get_id()); });
+    REQUIRE(ids.size() == 1);
+    REQUIRE(*ids.begin() == caller);
+}
+
+TEST_CASE("worker pool spreads a batch over its threads") {
+    WorkerPool pool(2, defaultScheduling);
+    // Each task waits until both have started, which only finishes if they
+    // run concurrently.
+    std::atomic<int> started(0);
+    pool.forEachIndex(2, [&](std::size_t) {
+        ++started;
+        while (started < 2) {
+            std::this_thread::yield();
+        }
+    });
+    REQUIRE(started == 2);
+}
+
+TEST_CASE("worker pool rethrows after finishing the batch") {
+    WorkerPool pool(3, defaultScheduling);
+    std::atomic<int> calls(0);
+    REQUIRE_THROWS_AS(pool.forEachIndex(20,
+                                        [&](std::size_t i) {
+                                            ++calls;
+                                            if (i == 5) {
+                                                throw std::runtime_error(
+                                                    "task failed");
+                                            }
+                                        }),
+                      std::runtime_error const &);
+    REQUIRE(calls == 20);
+    // Still usable afterwards.
+    calls = 0;
+    pool.forEachIndex(20, [&](std::size_t) { ++calls; });
+    REQUIRE(calls == 20);
+}
+
+TEST_CASE("pose estimation thread count") {
+    REQUIRE(chooseNumPoseEstimationThreads(3, 10) == 3);
+    REQUIRE(chooseNumPoseEstimationThreads(8, 2) == 2);
+    REQUIRE(chooseNumPoseEstimationThreads(0, 1) == 1);
+    REQUIRE(chooseNumPoseEstimationThreads(1, 10) == 1);
+    auto automatic = chooseNumPoseEstimationThreads(0, 10);
+    REQUIRE(automatic >= 1);
+    REQUIRE(automatic <= 4);
+}
@@ -33,7 +33,8 @@
 #include <osvr/Util/TimeValueChrono.h>
 
 // Standard includes
-// - none
+#include <algorithm>
+#include <cstdint>
 
 namespace osvr {
 namespace vbtracker {
@@ -80,7 +81,15 @@ namespace vbtracker {
     }
 
     std::unique_ptr<BodyReporting> BodyReporting::make() {
-        std::unique_ptr<BodyReporting> ret(new BodyReporting);
+        std::unique_ptr<BodyReporting> ret(
+            new BodyReporting(REPORT_QUEUE_SIZE));
+        return ret;
+    }
+
+    std::unique_ptr<BodyReporting> BodyReporting::make(std::size_t minReports) {
+        /// The queue always keeps one slot empty.
+        std::unique_ptr<BodyReporting> ret(new BodyReporting(
+            std::max(REPORT_QUEUE_SIZE, minReports + 1)));
         return ret;
     }
 
@@ -97,14 +106,7 @@ namespace vbtracker {
             return false;
         }
 
-        /// Thaw out the frozen state.
-        m_dataTime = queueVal.timestamp;
-        Eigen::Map<QueueValueVec> valMap(queueVal.stateData.data());
-        m_state.incrementalOrientation() = Eigen::Vector3d::Zero();
-        m_state.position() = valMap.head<3>();
-        m_state.setQuaternion(Eigen::Quaterniond(valMap.segment<4>(3)));
-        m_state.velocity() = valMap.segment<3>(7);
-        m_state.angularVelocity() = valMap.tail<3>();
+        m_thawState(queueVal);
 
         // If we have a process model, and have non-zero velocity, then we can
         // do some prediction.
@@ -137,6 +139,28 @@ namespace vbtracker {
         return true;
     }
 
+    bool BodyReporting::getUnpredictedReport(BodyReport &report) {
+        QueueValueType queueVal;
+        if (!m_queue.read(queueVal)) {
+            return false;
+        }
+        m_thawState(queueVal);
+        report.timestamp = m_dataTime;
+        assignStateToBodyReport(m_state, report, m_trackerToRoom);
+        report.status = ReportStatus::Valid;
+        return true;
+    }
+
+    void BodyReporting::m_thawState(QueueValueType &queueVal) {
+        m_dataTime = queueVal.timestamp;
+        Eigen::Map<QueueValueVec> valMap(queueVal.stateData.data());
+        m_state.incrementalOrientation() = Eigen::Vector3d::Zero();
+        m_state.position() = valMap.head<3>();
+        m_state.setQuaternion(Eigen::Quaterniond(valMap.segment<4>(3)));
+        m_state.velocity() = valMap.segment<3>(7);
+        m_state.angularVelocity() = valMap.tail<3>();
+    }
+
     bool BodyReporting::updateState(util::time::TimeValue const &tv,
                                     BodyState const &state) {
         QueueValueType val;
@@ -159,9 +183,9 @@ namespace vbtracker {
         m_trackerToRoom = xform;
     }
 
-    BodyReporting::BodyReporting()
+    BodyReporting::BodyReporting(std::size_t queueSize)
         : m_trackerToRoom(Eigen::Isometry3d::Identity()),
-          m_queue(REPORT_QUEUE_SIZE) {}
+          m_queue(static_cast<std::uint32_t>(queueSize)) {}
 
 } // namespace vbtracker
 } // namespace osvr
@@ -36,6 +36,7 @@
 
 // Standard includes
 #include <array>
+#include <cstddef>
 #include <memory>
 
 namespace osvr {
@@ -67,6 +68,11 @@ namespace vbtracker {
         /// Factory function
         static std::unique_ptr<BodyReporting> make();
 
+        /// Factory function for a queue that can hold at least @p
+        /// minReports reports that haven't been received yet, for consumers
+        /// that can't afford to miss any.
+        static std::unique_ptr<BodyReporting> make(std::size_t minReports);
+
         EIGEN_MAKE_ALIGNED_OPERATOR_NEW
         /// @name mainloop-thread methods
         /// @{
@@ -78,6 +84,12 @@ namespace vbtracker {
         /// additionalPrediction if nonzero). If false is returned, no reports
         /// were available to consume.
         bool getReport(double additionalPrediction, BodyReport &report);
+
+        /// Receives the oldest queued report, exactly as it was produced (in
+        /// room space, but with no prediction): for tools that want to see
+        /// every state the tracker produced.
+        /// @return false if no reports were available.
+        bool getUnpredictedReport(BodyReport &report);
         /// @}
 
         /// @name processing-thread methods
@@ -98,7 +110,7 @@ namespace vbtracker {
         void setTrackerToRoomTransform(Eigen::Isometry3d const &xform);
         /// @}
       private:
-        BodyReporting();
+        explicit BodyReporting(std::size_t queueSize);
         /// @name One-time initialization
         /// @{
         bool m_hasProcessModel = false;
@@ -117,6 +129,9 @@ namespace vbtracker {
         /// The communication channel between threads.
         folly::ProducerConsumerQueue<QueueValueType> m_queue;
 
+        /// Consumer side: unpacks a queued value into m_state and m_dataTime.
+        void m_thawState(QueueValueType &queueVal);
+
         /// @name Convenience members used by the consumer side, so they don't
         /// have to create them each time.
         /// @{
@@ -181,9 +181,15 @@ namespace vbtracker {
         std::size_t trackingResets = 0;
         std::ostringstream outputSink;
 
+        /// Throttles for debug output: per target rather than static, since
+        /// bodies are processed in parallel.
+        ::util::Stride assignStride{157};
+        ::util::Stride varianceStride{101};
+
 #ifdef OSVR_UVBI_DUMP_BLOB_CSV
         std::ofstream blobFile;
         util::StreamCSV csv;
+        bool firstCsvRow = true;
 #endif // OSVR_UVBI_DUMP_BLOB_CSV
     };
 
@@ -342,9 +348,8 @@ namespace vbtracker {
         bool verbose = false;
         if (getParams().extraVerbose) {
             // if (getParams().debug) {
-            static ::util::Stride assignStride(157);
-            assignStride++;
-            if (assignStride) {
+            m_impl->assignStride++;
+            if (m_impl->assignStride) {
                 verbose = true;
             }
         }
@@ -412,9 +417,8 @@ namespace vbtracker {
 
 #ifdef OSVR_UVBI_DUMP_BLOB_CSV
         {
-            static bool first = true;
-            if (first) {
-                first = false;
+            if (m_impl->firstCsvRow) {
+                m_impl->firstCsvRow = false;
                 std::cout << "Dumping first row of blob data." << std::endl;
             }
             auto &row = m_impl->csv.row();
@@ -575,8 +579,7 @@ namespace vbtracker {
 
 #ifdef OSVR_DEBUG_ERROR_VARIANCE
 
-        static ::util::Stride varianceStride(101);
-        if (++varianceStride) {
+        if (++m_impl->varianceStride) {
             msg() << "Max positional error variance: "
                   << getMaxPositionalErrorVariance(getBody().getState())
                   << "   Distance: " << getBody().getState().position().z()
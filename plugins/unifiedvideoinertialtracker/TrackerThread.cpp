@@ -26,6 +26,7 @@
 #include "TrackerThread.h"
 #include "AdditionalReports.h"
 #include "ImageProcessingThread.h"
+#include "PipelineTiming.h"
 #include "ProcessIMUMessage.h"
 #include "SpaceTransformations.h"
 #include "TrackedBody.h"
@@ -48,6 +49,21 @@ namespace vbtracker {
     // 16 and even 32 was too small - we were dropping messages.
     static const uint32_t IMU_MESSAGE_QUEUE_SIZE = 64 + 1;
 
+    /// Gets a pointer to the timestamp of an IMU message, or nullptr if it's
+    /// empty.
+    class IMUMessageTimestamp
+        : public boost::static_visitor<util::time::TimeValue const *> {
+      public:
+        util::time::TimeValue const *operator()(boost::none_t const &) const {
+            return nullptr;
+        }
+        template <typename ReportType>
+        util::time::TimeValue const *
+        operator()(TimestampedImuReport<ReportType> const &report) const {
+            return &report.timestamp;
+        }
+    };
+
     TrackerThread::TrackerThread(TrackingSystem &trackingSystem,
                                  ImageSource &imageSource,
                                  BodyReportingVector &reportingVec,
@@ -70,6 +86,13 @@ namespace vbtracker {
 
     void TrackerThread::permitStart() { m_startupSignal.set_value(); }
 
+    void TrackerThread::setThreadScheduling(
+        common::ThreadSchedulingOptions const &tracker,
+        common::ThreadSchedulingOptions const &image) {
+        m_trackerScheduling = tracker;
+        m_imageScheduling = image;
+    }
+
     void TrackerThread::threadAction() {
         /// The thread internally is organized around processing video frames,
         /// with arrival of IMU reports internally handled as they come. Thus,
@@ -80,6 +103,9 @@ namespace vbtracker {
         msg() << "Tracker thread object invoked, waiting for permitStart()."
               << std::endl;
         m_startupSignal.get_future().wait();
+        if (!m_trackerScheduling.isDefault()) {
+            common::applyThreadScheduling(m_trackerScheduling, "tracker");
+        }
         /// sleep an extra half a second to give everyone else time to get off
         /// the starting blocks.
         std::this_thread::sleep_for(std::chrono::milliseconds(500));
@@ -93,7 +119,13 @@ namespace vbtracker {
         ImageProcessingThread imageProcThreadObj{
             m_trackingSystem, m_cam, *this, m_camParams, m_cameraUsecOffset};
         imageProcThreadObj_ = &imageProcThreadObj;
-        m_imageThread = std::thread{[&] { imageProcThreadObj.threadAction(); }};
+        m_imageThread = std::thread{[&] {
+            if (!m_imageScheduling.isDefault()) {
+                common::applyThreadScheduling(m_imageScheduling,
+                                              "image processing");
+            }
+            imageProcThreadObj.threadAction();
+        }};
 
         msg() << "Tracker thread object entering its main execution loop."
               << std::endl;
@@ -294,6 +326,12 @@ namespace vbtracker {
             return;
         }
 
+        // IMU reports from before the frame that are still queued (because the
+        // image step finished first) go in before it, so the filter sees them
+        // in timestamp order however long the image step took.
+        UpdatedBodyIndices earlierImuIds;
+        processIMUMessagesUpTo(m_imageData->tv, earlierImuIds);
+
         // Submit initial image data to the tracking system.
         auto bodyIds =
             m_trackingSystem.updateBodiesFromVideoData(std::move(m_imageData));
@@ -302,6 +340,9 @@ namespace vbtracker {
         // Sort those body IDs so we can merge them with the body IDs from any
         // IMU messages we're about to process.
         UpdatedBodyIndices sortedBodyIds{begin(bodyIds), end(bodyIds)};
+        for (auto &id : earlierImuIds) {
+            sortedBodyIds.insert(id);
+        }
         if (m_bufferImu) {
             for (auto &id : imuIndices) {
                 sortedBodyIds.insert(id);
@@ -329,6 +370,8 @@ namespace vbtracker {
             }
         }
 
+        PipelineStageTimer timer(m_trackingSystem.getTimingStats(),
+                                 PipelineStage::Reporting);
         updateReportingVector(sortedBodyIds);
     }
 
@@ -337,6 +380,24 @@ namespace vbtracker {
         return osvr::vbtracker::processImuMessage(m);
     }
 
+    void TrackerThread::processIMUMessagesUpTo(util::time::TimeValue const &tv,
+                                               UpdatedBodyIndices &bodyIds) {
+        while (auto message = m_imuMessages.frontPtr()) {
+            auto timestamp =
+                boost::apply_visitor(IMUMessageTimestamp{}, *message);
+            if (timestamp && *timestamp > tv) {
+                break;
+            }
+            if (timestamp) {
+                auto id = processIMUMessage(*message).first;
+                if (!id.empty()) {
+                    bodyIds.insert(id);
+                }
+            }
+            m_imuMessages.popFront();
+        }
+    }
+
     BodyReporting *TrackerThread::getCamPoseReporting() const {
 #ifdef OSVR_OUTPUT_CAMERA_POSE
         return m_reportingVec[m_numBodies + extra_outputs::outputCamIndex]
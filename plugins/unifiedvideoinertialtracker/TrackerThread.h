@@ -34,6 +34,7 @@
 #include "ImageSources/ImageSource.h"
 
 // Library/third-party includes
+#include <osvr/Common/ThreadScheduling.h>
 #include <osvr/Util/ClientReportTypesC.h>
 
 #include <opencv2/core/core.hpp> // for basic OpenCV types
@@ -93,6 +94,12 @@ namespace vbtracker {
         /// proceed with execution.
         void permitStart();
 
+        /// Sets the scheduling options the tracker thread and the image
+        /// processing thread apply to themselves when they start. Call before
+        /// permitStart().
+        void setThreadScheduling(common::ThreadSchedulingOptions const &tracker,
+                                 common::ThreadSchedulingOptions const &image);
+
         /// Call from the main thread to trigger this thread's execution to exit
         /// after the current frame.
         void triggerStop();
@@ -149,6 +156,12 @@ namespace vbtracker {
         std::pair<BodyId, ImuMessageCategory>
         processIMUMessage(IMUMessage const &m);
 
+        /// Processes queued IMU messages, in order, up to the first one
+        /// timestamped after @p tv, adding the bodies they updated to @p
+        /// bodyIds.
+        void processIMUMessagesUpTo(util::time::TimeValue const &tv,
+                                    UpdatedBodyIndices &bodyIds);
+
         /// pointer to body reporting object for camera pose in "room" space
         BodyReporting *getCamPoseReporting() const;
         /// pointer to body reporting object for IMU
@@ -225,6 +238,9 @@ namespace vbtracker {
 
         ImageProcessingThread *imageProcThreadObj_ = nullptr;
 
+        common::ThreadSchedulingOptions m_trackerScheduling;
+        common::ThreadSchedulingOptions m_imageScheduling;
+
         /// The thread used by timeConsumingImageStep()
         std::thread m_imageThread;
     };
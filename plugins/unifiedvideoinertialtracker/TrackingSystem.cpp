@@ -25,6 +25,7 @@
 // Internal Includes
 #include "TrackingSystem.h"
 #include "ForEachTracked.h"
+#include "PipelineTiming.h"
 #include "RoomCalibration.h"
 #include "SBDBlobExtractor.h"
 #include "TrackedBody.h"
@@ -35,8 +36,6 @@
 // Library/third-party includes
 #include <boost/assert.hpp>
 
-#include <util/Stride.h>
-
 // Standard includes
 #include <algorithm>
 #include <iostream>
@@ -75,19 +74,24 @@ namespace vbtracker {
         util::time::TimeValue const &tv, cv::Mat const &frame,
         cv::Mat const &frameGray, CameraParameters const &camParams) {
 
+        PipelineStageTimer timer(m_timingStats, PipelineStage::Extraction);
         ImageOutputDataPtr ret(new ImageProcessingOutput);
         ret->tv = tv;
         ret->frame = frame;
         ret->frameGray = frameGray;
         ret->camParams = camParams.createUndistortedVariant();
+        auto &regions = m_impl->searchRegionsScratch;
         auto rawMeasurements =
-            m_impl->blobExtractor->extractBlobs(ret->frameGray);
+            m_impl->searchRegions.getRegionsForNextFrame(camParams, regions)
+                ? m_impl->blobExtractor->extractBlobs(ret->frameGray, regions)
+                : m_impl->blobExtractor->extractBlobs(ret->frameGray);
         ret->ledMeasurements = undistortLeds(rawMeasurements, camParams);
         return ret;
     }
 
     LedUpdateCount const &
     TrackingSystem::updateLedsFromVideoData(ImageOutputDataPtr &&imageData) {
+        PipelineStageTimer timer(m_timingStats, PipelineStage::Assignment);
         /// Clear internal data, we're invalidating things here.
         m_updated.clear();
         auto &updateCount = m_impl->updateCount;
@@ -100,14 +104,32 @@ namespace vbtracker {
         m_impl->camParams = imageData->camParams;
         m_impl->lastFrame = imageData->tv;
 
-        /// Go through each target and try to process the measurements.
-        forEachTarget(*this, [&](TrackedBodyTarget &target) {
-            auto usedMeasurements =
-                target.processLedMeasurements(imageData->ledMeasurements);
-            if (usedMeasurements != 0) {
-                updateCount[target.getQualifiedId()] = usedMeasurements;
+        /// Go through each body's targets and try to process the
+        /// measurements: bodies are independent, so they may be processed in
+        /// parallel.
+        auto const numBodies = m_bodies.size();
+        auto &results = m_impl->bodyResults;
+        results.resize(numBodies);
+        auto const &ledMeasurements = imageData->ledMeasurements;
+        m_impl->getWorkers(m_params, numBodies)
+            .forEachIndex(numBodies, [&](std::size_t i) {
+                auto &result = results[i];
+                result.ledUpdates.clear();
+                result.gotPose = false;
+                forEachTarget(*m_bodies[i], [&](TrackedBodyTarget &target) {
+                    auto usedMeasurements =
+                        target.processLedMeasurements(ledMeasurements);
+                    if (usedMeasurements != 0) {
+                        result.ledUpdates.emplace_back(target.getQualifiedId(),
+                                                       usedMeasurements);
+                    }
+                });
+            });
+        for (auto const &result : results) {
+            for (auto const &targetUpdate : result.ledUpdates) {
+                updateCount[targetUpdate.first] = targetUpdate.second;
             }
-        });
+        }
         return updateCount;
     }
 
@@ -119,6 +141,10 @@ namespace vbtracker {
         /// Do the third phase of tracking.
         updatePoseEstimates();
 
+        /// Now we know where the LEDs are, narrow down where to look for them
+        /// next time, if configured to.
+        m_impl->searchRegions.update(*this);
+
         /// Trigger debug display, if activated.
         m_impl->triggerDebugDisplay(*this);
 
@@ -138,39 +164,50 @@ namespace vbtracker {
         }
     }
     void TrackingSystem::updatePoseEstimates() {
+        PipelineStageTimer timer(m_timingStats, PipelineStage::Estimation);
         if (!isRoomCalibrationComplete()) {
             /// If we need calibration, we need calibration. Go get it done.
             calibrationVideoPhaseThree();
             return;
         }
 
-        auto const &updateCount = m_impl->updateCount;
-        for (auto &bodyTargetWithMeasurements : updateCount) {
-            auto targetPtr = getTarget(bodyTargetWithMeasurements.first);
-            validateTargetPointerFromUpdateList(targetPtr);
-            auto &target = *targetPtr;
-
-            /// @todo right now assumes one target per body here!
-            auto &body = target.getBody();
-            util::time::TimeValue stateTime = {};
-            BodyState state;
-            auto newTime = m_impl->lastFrame;
-            auto validState =
-                body.getStateAtOrBefore(newTime, stateTime, state);
-            auto initialTime = stateTime;
-
-            auto gotPose = target.updatePoseEstimateFromLeds(
-                m_impl->camParams, newTime, state, stateTime, validState);
-            if (gotPose) {
-                body.replaceStateSnapshot(initialTime, newTime, state);
-#if 0
-                static auto s = ::util::Stride{101};
-                if (++s) {
-                    std::cout << body.getState().position().transpose() << "\n";
+        /// Each body's targets with measurements were recorded by
+        /// updateLedsFromVideoData(), so each body can be handled on its own,
+        /// possibly in parallel.
+        auto &results = m_impl->bodyResults;
+        auto const numBodies = results.size();
+        m_impl->getWorkers(m_params, numBodies)
+            .forEachIndex(numBodies, [&](std::size_t i) {
+                auto &result = results[i];
+                for (auto const &targetUpdate : result.ledUpdates) {
+                    auto targetPtr = getTarget(targetUpdate.first);
+                    validateTargetPointerFromUpdateList(targetPtr);
+                    auto &target = *targetPtr;
+
+                    auto &body = target.getBody();
+                    util::time::TimeValue stateTime = {};
+                    BodyState state;
+                    auto newTime = m_impl->lastFrame;
+                    auto validState =
+                        body.getStateAtOrBefore(newTime, stateTime, state);
+                    auto initialTime = stateTime;
+
+                    auto gotPose = target.updatePoseEstimateFromLeds(
+                        m_impl->camParams, newTime, state, stateTime,
+                        validState);
+                    if (gotPose) {
+                        body.replaceStateSnapshot(initialTime, newTime, state);
+                        result.gotPose = true;
+                    }
                 }
-#endif
-                /// @todo deduplicate in making this list.
-                m_updated.push_back(body.getId());
+            });
+
+        /// Report in body order, regardless of which thread got to which body
+        /// first.
+        for (std::size_t i = 0; i < numBodies; ++i) {
+            if (results[i].gotPose) {
+                m_updated.push_back(
+                    BodyId(static_cast<BodyId::wrapped_type>(i)));
             }
         }
         /// Prune history after video update.
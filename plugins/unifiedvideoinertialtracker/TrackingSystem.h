@@ -47,6 +47,7 @@ namespace osvr {
 namespace vbtracker {
     class TrackedBody;
     class TrackedBodyTarget;
+    class PipelineTimingStats;
     using BodyIndices = std::vector<BodyId>;
 
     using LedUpdateCount = std::unordered_map<BodyTargetId, std::size_t>;
@@ -145,6 +146,13 @@ namespace vbtracker {
 
         bool isRoomCalibrationComplete();
 
+        /// Sets where to record how long each stage of processing takes (null,
+        /// the default, to not bother). Set before processing starts.
+        void setTimingStats(PipelineTimingStats *stats) {
+            m_timingStats = stats;
+        }
+        PipelineTimingStats *getTimingStats() const { return m_timingStats; }
+
         /// private impl;
         struct Impl;
 
@@ -171,6 +179,8 @@ namespace vbtracker {
 
         std::unique_ptr<Impl> m_impl;
 
+        PipelineTimingStats *m_timingStats = nullptr;
+
         friend class TrackingDebugDisplay;
     };
 
@@ -42,7 +42,8 @@ namespace vbtracker {
           debugDisplay(new TrackingDebugDisplay(params)),
           calib(Eigen::Vector3d(params.cameraPosition), params.cameraIsForward),
           cameraPose(Eigen::Isometry3d::Identity()),
-          cameraPoseInv(Eigen::Isometry3d::Identity()) {}
+          cameraPoseInv(Eigen::Isometry3d::Identity()),
+          searchRegions(params) {}
 
     TrackingSystem::Impl::~Impl() {
         // out line to break circular dep with this and the debug display.
@@ -51,5 +52,16 @@ namespace vbtracker {
     void TrackingSystem::Impl::triggerDebugDisplay(TrackingSystem &tracking) {
         debugDisplay->triggerDisplay(tracking, *this);
     }
+
+    WorkerPool &TrackingSystem::Impl::getWorkers(ConfigParams const &params,
+                                                 std::size_t numBodies) {
+        if (!workers) {
+            workers.reset(new WorkerPool(
+                chooseNumPoseEstimationThreads(params.poseEstimationThreads,
+                                               numBodies),
+                params.trackerThreadScheduling));
+        }
+        return *workers;
+    }
 } // namespace vbtracker
 } // namespace osvr
@@ -26,9 +26,11 @@
 #define INCLUDED_TrackingSystem_Impl_h_GUID_9EC4CAF8_58AA_45A5_59A0_6B1FB4B86BE7
 
 // Internal Includes
+#include "BlobSearchRegions.h"
 #include "ConfigParams.h"
 #include "RoomCalibration.h"
 #include "TrackingSystem.h"
+#include "WorkerPool.h"
 #include <CameraParameters.h>
 #include <GenericBlobExtractor.h>
 
@@ -39,7 +41,10 @@
 #include <osvr/Util/TimeValue.h>
 
 // Standard includes
+#include <cstddef>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace osvr {
 namespace vbtracker {
@@ -52,6 +57,12 @@ namespace vbtracker {
         EIGEN_MAKE_ALIGNED_OPERATOR_NEW
         void triggerDebugDisplay(TrackingSystem &tracking);
 
+        /// Gets the pool for per-body processing, creating it the first time
+        /// (once the bodies have been set up) since its size depends on the
+        /// number of bodies.
+        WorkerPool &getWorkers(ConfigParams const &params,
+                               std::size_t numBodies);
+
         /// @name Cached data from the ImageProcessingOutput updated in phase 2
         /// @{
         /// Cached copy of the last grey frame
@@ -71,8 +82,26 @@ namespace vbtracker {
         RoomCalibration calib;
 
         LedUpdateCount updateCount;
+
+        /// What happened to one body in processing the latest frame: filled
+        /// in by whichever thread processed the body, and only read once all
+        /// bodies are done.
+        struct BodyFrameResults {
+            /// Targets that used measurements, and how many.
+            std::vector<std::pair<BodyTargetId, std::size_t> > ledUpdates;
+            bool gotPose = false;
+        };
+        /// Indexed by body ID: kept around to reuse the allocations.
+        std::vector<BodyFrameResults> bodyResults;
+        std::unique_ptr<WorkerPool> workers;
+
         BlobExtractorPtr blobExtractor;
         std::unique_ptr<TrackingDebugDisplay> debugDisplay;
+
+        /// Where to look for blobs in upcoming frames, if configured.
+        BlobSearchRegions searchRegions;
+        /// Image processing thread only: reused each frame.
+        std::vector<cv::Rect> searchRegionsScratch;
     };
 
 } // namespace vbtracker
@@ -0,0 +1,147 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "WorkerPool.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+
+namespace osvr {
+namespace vbtracker {
+    /// When choosing automatically: beyond this, the per-body work is too
+    /// small to be worth waking more threads, and we'd be competing with the
+    /// image processing thread.
+    static const std::size_t MAX_AUTO_POSE_ESTIMATION_THREADS = 4;
+
+    WorkerPool::WorkerPool(std::size_t numThreads,
+                           common::ThreadSchedulingOptions const &scheduling)
+        : m_scheduling(scheduling), m_nextTask(0) {
+        for (std::size_t i = 1; i < numThreads; ++i) {
+            m_workers.emplace_back([&] { m_workerThreadAction(); });
+        }
+    }
+
+    WorkerPool::~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_exiting = true;
+        }
+        m_batchStarted.notify_all();
+        for (auto &worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    void WorkerPool::m_runBatch(std::size_t n,
+                                std::function<void(std::size_t)> const &task) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_task = &task;
+            m_numTasks = n;
+            m_nextTask.store(0);
+            m_busyWorkers = m_workers.size();
+            m_error = nullptr;
+            ++m_batchNumber;
+        }
+        m_batchStarted.notify_all();
+
+        /// Pitch in rather than just waiting.
+        m_runTasks();
+
+        std::exception_ptr error;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_batchFinished.wait(lock, [&] { return m_busyWorkers == 0; });
+            m_task = nullptr;
+            error = m_error;
+            m_error = nullptr;
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    void WorkerPool::m_workerThreadAction() {
+        if (!m_scheduling.isDefault()) {
+            common::applyThreadScheduling(m_scheduling, "pose estimation");
+        }
+        std::uint64_t lastBatch = 0;
+        while (1) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_batchStarted.wait(lock, [&] {
+                    return m_exiting || m_batchNumber != lastBatch;
+                });
+                if (m_exiting) {
+                    return;
+                }
+                lastBatch = m_batchNumber;
+            }
+            m_runTasks();
+            bool last;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                last = (--m_busyWorkers == 0);
+            }
+            if (last) {
+                m_batchFinished.notify_one();
+            }
+        }
+    }
+
+    void WorkerPool::m_runTasks() {
+        while (1) {
+            auto i = m_nextTask.fetch_add(1);
+            if (i >= m_numTasks) {
+                return;
+            }
+            try {
+                (*m_task)(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_error) {
+                    m_error = std::current_exception();
+                }
+            }
+        }
+    }
+
+    std::size_t chooseNumPoseEstimationThreads(int configured,
+                                               std::size_t numBodies) {
+        std::size_t ret;
+        if (configured > 0) {
+            ret = static_cast<std::size_t>(configured);
+        } else {
+            ret = std::min<std::size_t>(std::thread::hardware_concurrency(),
+                                        MAX_AUTO_POSE_ESTIMATION_THREADS);
+        }
+        return std::max<std::size_t>(1, std::min(ret, numBodies));
+    }
+
+} // namespace vbtracker
+} // namespace osvr
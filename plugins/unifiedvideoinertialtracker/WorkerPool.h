@@ -0,0 +1,127 @@
+/** @file
+    @brief Header for a small, fixed-size pool of threads that help the tracker
+    thread process independent bodies in parallel.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_WorkerPool_h_GUID_4A0C7E2B_61D9_4F35_8B1E_C93D52F08A67
+#define INCLUDED_WorkerPool_h_GUID_4A0C7E2B_61D9_4F35_8B1E_C93D52F08A67
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <osvr/Common/ThreadScheduling.h>
+
+// Standard includes
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace osvr {
+namespace vbtracker {
+    /// Runs batches of independent tasks, identified by index, across a fixed
+    /// set of worker threads plus the calling thread, returning when the whole
+    /// batch is done. Only one thread may submit batches.
+    class WorkerPool {
+      public:
+        /// @param numThreads Total number of threads to run tasks on,
+        /// including the calling thread: 1 or less means no workers are
+        /// started and everything runs inline.
+        /// @param scheduling Applied to each worker thread as it starts.
+        WorkerPool(std::size_t numThreads,
+                   common::ThreadSchedulingOptions const &scheduling);
+        ~WorkerPool();
+
+        /// non-copyable.
+        WorkerPool(WorkerPool const &) = delete;
+        /// non-assignable.
+        WorkerPool &operator=(WorkerPool const &) = delete;
+
+        /// Total number of threads that run tasks, including the caller.
+        std::size_t getNumThreads() const { return m_workers.size() + 1; }
+
+        /// Calls f(i) for each i in [0, n), in no particular order and
+        /// possibly concurrently, returning once every call has finished. If
+        /// any call throws, the first exception is rethrown here (after the
+        /// rest of the batch completes).
+        template <typename F> void forEachIndex(std::size_t n, F &&f) {
+            if (m_workers.empty() || n < 2) {
+                for (std::size_t i = 0; i < n; ++i) {
+                    f(i);
+                }
+                return;
+            }
+            m_runBatch(n, std::function<void(std::size_t)>(std::ref(f)));
+        }
+
+      private:
+        void m_runBatch(std::size_t n,
+                        std::function<void(std::size_t)> const &task);
+        void m_workerThreadAction();
+        /// Claims and runs tasks from the current batch until there are none
+        /// left.
+        void m_runTasks();
+
+        common::ThreadSchedulingOptions m_scheduling;
+
+        std::mutex m_mutex;
+        std::condition_variable m_batchStarted;
+        std::condition_variable m_batchFinished;
+        /// @name Protected by m_mutex
+        /// @{
+        std::uint64_t m_batchNumber = 0;
+        std::size_t m_busyWorkers = 0;
+        bool m_exiting = false;
+        std::exception_ptr m_error;
+        /// @}
+
+        /// @name Current batch: set under m_mutex before it starts, read-only
+        /// while it runs.
+        /// @{
+        std::function<void(std::size_t)> const *m_task = nullptr;
+        std::size_t m_numTasks = 0;
+        /// @}
+        std::atomic<std::size_t> m_nextTask;
+
+        std::vector<std::thread> m_workers;
+    };
+
+    /// Works out the number of threads (including the tracker thread) to use
+    /// for per-body processing.
+    ///
+    /// @param configured From ConfigParams::poseEstimationThreads: a positive
+    /// value is used as-is, otherwise one is chosen based on the hardware.
+    /// @param numBodies No point in more threads than bodies.
+    std::size_t chooseNumPoseEstimationThreads(int configured,
+                                               std::size_t numBodies);
+
+} // namespace vbtracker
+} // namespace osvr
+
+#endif // INCLUDED_WorkerPool_h_GUID_4A0C7E2B_61D9_4F35_8B1E_C93D52F08A67
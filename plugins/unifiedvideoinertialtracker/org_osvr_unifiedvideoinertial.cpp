@@ -98,6 +98,7 @@ class UnifiedVideoInertialTracker : boost::noncopyable {
     OSVR_TrackerDeviceInterface m_tracker;
     OSVR_AnalogDeviceInterface m_analog;
     osvr::vbtracker::ImageSourcePtr m_source;
+    osvr::vbtracker::CaptureWriterPtr m_capture;
     cv::Mat m_frame;
     cv::Mat m_imageGray;
     TrackingSystemPtr m_trackingSystem;
@@ -111,24 +112,29 @@ class UnifiedVideoInertialTracker : boost::noncopyable {
     const std::int32_t m_angvelUsecOffset = 0;
     const bool m_continuousReporting;
     const bool m_debugData;
+    const osvr::common::ThreadSchedulingOptions m_trackerScheduling;
+    const osvr::common::ThreadSchedulingOptions m_imageScheduling;
     BodyReportingVector m_bodyReportingVector;
     std::unique_ptr<TrackerThread> m_trackerThreadManager;
     bool m_threadLoopStarted = false;
     std::thread m_trackerThread;
 
   public:
-    UnifiedVideoInertialTracker(OSVR_PluginRegContext ctx,
-                                osvr::vbtracker::ImageSourcePtr &&source,
-                                osvr::vbtracker::ConfigParams params,
-                                TrackingSystemPtr &&trackingSystem)
-        : m_source(std::move(source)),
+    UnifiedVideoInertialTracker(
+        OSVR_PluginRegContext ctx, osvr::vbtracker::ImageSourcePtr &&source,
+        osvr::vbtracker::ConfigParams params,
+        TrackingSystemPtr &&trackingSystem,
+        osvr::vbtracker::CaptureWriterPtr const &capture)
+        : m_source(std::move(source)), m_capture(capture),
           m_trackingSystem(std::move(trackingSystem)),
           m_additionalPrediction(params.additionalPrediction),
           m_camUsecOffset(params.cameraMicrosecondsOffset),
           m_oriUsecOffset(params.imu.orientationMicrosecondsOffset),
           m_angvelUsecOffset(params.imu.angularVelocityMicrosecondsOffset),
           m_continuousReporting(params.continuousReporting),
-          m_debugData(params.streamBeaconDebugInfo) {
+          m_debugData(params.streamBeaconDebugInfo),
+          m_trackerScheduling(params.trackerThreadScheduling),
+          m_imageScheduling(params.imageProcessingThreadScheduling) {
         if (params.numThreads > 0) {
             // Set the number of threads for OpenCV to use.
             cv::setNumThreads(params.numThreads);
@@ -187,6 +193,9 @@ class UnifiedVideoInertialTracker : boost::noncopyable {
     /// Processes a tracker report.
     template <typename ReportType>
     void handleData(OSVR_TimeValue const &timestamp, ReportType const &report) {
+        if (m_capture) {
+            m_capture->writeIMU(timestamp, report);
+        }
         m_trackerThreadManager->submitIMUReport(*m_imu, timestamp, report);
     }
 
@@ -320,6 +329,8 @@ class UnifiedVideoInertialTracker : boost::noncopyable {
             *m_trackingSystem, *m_source, m_bodyReportingVector,
             osvr::vbtracker::getHDKCameraParameters(), m_camUsecOffset,
             !m_continuousReporting, m_debugData));
+        m_trackerThreadManager->setThreadScheduling(m_trackerScheduling,
+                                                    m_imageScheduling);
 
         /// This will start the thread, but it won't enter its full main loop
         /// until we call permitStart()
@@ -416,12 +427,27 @@ class ConfiguredDeviceConstructor {
             return OSVR_RETURN_FAILURE;
         }
 
+        osvr::vbtracker::CaptureWriterPtr capture;
+        if (!config.captureDirectory.empty()) {
+            capture = std::make_shared<osvr::vbtracker::CaptureWriter>(
+                config.captureDirectory);
+            if (capture->ok()) {
+                std::cout << "Recording tracker input to "
+                          << config.captureDirectory << std::endl;
+                cam = osvr::vbtracker::openRecordingImageSource(std::move(cam),
+                                                                capture);
+            } else {
+                capture.reset();
+            }
+        }
+
         auto trackingSystem = osvr::vbtracker::makeHDKTrackingSystem(config);
         // OK, now that we have our parameters, create the device.
         osvr::pluginkit::PluginContext context(ctx);
         auto newTracker = osvr::pluginkit::registerObjectForDeletion(
             ctx, new UnifiedVideoInertialTracker(ctx, std::move(cam), config,
-                                                 std::move(trackingSystem)));
+                                                 std::move(trackingSystem),
+                                                 capture));
 
         return OSVR_RETURN_SUCCESS;
     }
@@ -29,6 +29,7 @@
 #include "ImageSource.h"
 #include "ImageSourceFactories.h"
 #include <osvr/PluginKit/PluginKit.h>
+#include <osvr/PluginKit/HardwareDetectProbe.h>
 #include <osvr/PluginKit/TrackerInterfaceC.h>
 #include <osvr/PluginKit/AnalogInterfaceC.h>
 #include "HDKData.h"
@@ -231,37 +232,17 @@ class HardwareDetection {
                       osvr::vbtracker::ConfigParams const &params =
                           osvr::vbtracker::ConfigParams{})
         : m_found(false), m_cameraFactory(camFactory), m_sensorSetup(setup),
-          m_cameraID(cameraID), m_params(params) {}
+          m_cameraID(cameraID), m_params(params),
+          m_probe([&] { return m_openCamera(); }) {}
 
     OSVR_ReturnCode operator()(OSVR_PluginRegContext ctx) {
         if (m_found) {
             return OSVR_RETURN_SUCCESS;
         }
-        auto src = m_cameraFactory();
-        if (!src || !src->ok()) {
-            if (!m_reportedNoCamera) {
-                m_reportedNoCamera = true;
-                std::cout
-                    << "\nVideo-based tracker: Could not open the tracking "
-                       "camera. If you intend to use it, make sure that "
-                       "all cables to it are plugged in firmly.\n";
-
-#ifdef _WIN32
-                /// @todo this is a strange quirk of the video capture backend,
-                /// as well as others like it, including Microsoft's own AMCap
-                /// You get a "can't start the filter graph" if you have, e.g.,
-                /// Skype or a webcam-using page in Chrome accessing any camera
-                /// on your system when you try to start the tracker. Once you
-                /// get it started, then you can use those things just fine.
-                std::cout << "Video-based tracker: Windows users may need to "
-                             "exit other camera-using applications or "
-                             "activities until after the tracking camera is "
-                             "turned on by this plugin. (This is the most "
-                             "common cause of messages regarding the 'filter "
-                             "graph')\n";
-#endif
-                std::cout << std::endl;
-            }
+        // Turning the camera on can take a while, so it's done off the
+        // server's main loop: we're called again once it's on.
+        osvr::vbtracker::ImageSourcePtr src;
+        if (!m_probe.get(ctx, src)) {
             return OSVR_RETURN_FAILURE;
         }
         std::cout << "Video-based tracker: Camera turned on!" << std::endl;
@@ -277,6 +258,38 @@ class HardwareDetection {
     }
 
   private:
+    /// @brief Runs on the probe thread (one at a time, so
+    /// m_reportedNoCamera needs no lock).
+    osvr::vbtracker::ImageSourcePtr m_openCamera() {
+        auto src = m_cameraFactory();
+        if (src && src->ok()) {
+            return src;
+        }
+        if (!m_reportedNoCamera) {
+            m_reportedNoCamera = true;
+            std::cout << "\nVideo-based tracker: Could not open the tracking "
+                         "camera. If you intend to use it, make sure that "
+                         "all cables to it are plugged in firmly.\n";
+
+#ifdef _WIN32
+            /// @todo this is a strange quirk of the video capture backend,
+            /// as well as others like it, including Microsoft's own AMCap
+            /// You get a "can't start the filter graph" if you have, e.g.,
+            /// Skype or a webcam-using page in Chrome accessing any camera
+            /// on your system when you try to start the tracker. Once you
+            /// get it started, then you can use those things just fine.
+            std::cout << "Video-based tracker: Windows users may need to "
+                         "exit other camera-using applications or "
+                         "activities until after the tracking camera is "
+                         "turned on by this plugin. (This is the most "
+                         "common cause of messages regarding the 'filter "
+                         "graph')\n";
+#endif
+            std::cout << std::endl;
+        }
+        return osvr::vbtracker::ImageSourcePtr();
+    }
+
     /// @brief Have we found our device yet? (this limits the plugin to one
     /// instance, so that only one tracker will use this camera.)
     bool m_found = false;
@@ -287,6 +300,11 @@ class HardwareDetection {
 
     int m_cameraID; //< Which OpenCV camera should we open?
     osvr::vbtracker::ConfigParams const m_params;
+
+    /// @brief Declared last, so its destructor waits for a running probe
+    /// before the members that probe uses go away.
+    osvr::pluginkit::HardwareDetectProbe<osvr::vbtracker::ImageSourcePtr>
+        m_probe;
 };
 
 class ConfiguredDeviceConstructor {
@@ -38,6 +38,7 @@
 #endif
 
 // Standard includes
+#include <algorithm>
 #include <iostream>
 #include <utility>
 
@@ -65,6 +66,15 @@ namespace vbtracker {
 #endif
     {
 
+        /// Each filter reaches out by half its kernel size (the Laplacian
+        /// always uses at least a 3x3 aperture).
+        regionPadding_ = extParams_.preEdgeDetectionBlurSize / 2 +
+                         std::max(extParams_.laplacianKSize, 3) / 2 +
+                         (extParams_.edgeDetectErosion ? 1 : 0) +
+                         (extParams_.postEdgeDetectionBlur
+                              ? extParams_.postEdgeDetectionBlurSize / 2
+                              : 0);
+
         compressionArtifactRemovalKernel_ =
             cv::Mat::ones(cv::Size(3, 3), CV_8U) *
             static_cast<std::uint8_t>(extractorParams.erosionKernelValue);
@@ -99,55 +109,155 @@ namespace vbtracker {
 
         /// Set up the threshold parameters
         auto rangeInfo = ImageRangeInfo(gray_);
-        if (rangeInfo.maxVal < p.absoluteMinThreshold) {
+        if (!computeThresholds(rangeInfo, p)) {
+            /// Early out - empty image!
+            return measurements_;
+        }
+
+        allocateImages(gray_.size(), gray_.type());
+        auto wholeFrame = cv::Rect(cv::Point(), gray_.size());
+        detectEdges(wholeFrame, false);
+        findBlobs(wholeFrame, p);
+        return measurements_;
+    }
+
+    LedMeasurementVec const &EdgeHoleBasedLedExtractor::
+    operator()(cv::Mat const &gray, BlobParams const &p,
+               std::vector<cv::Rect> const &regions, bool verboseBlobOutput) {
+        reset();
+
+#ifdef OSVR_UVBI_CORE
+        BlobExtraction trace;
+#endif
+
+        verbose_ = verboseBlobOutput;
+
+        auto const wholeFrame = cv::Rect(cv::Point(), gray.size());
+        auto const padding = cv::Size(regionPadding_, regionPadding_);
+        for (auto const &region : regions) {
+            auto clipped = region & wholeFrame;
+            if (clipped.area() > 0) {
+                regions_.push_back(clipped);
+            }
+        }
+        if (regions_.empty()) {
+            return measurements_;
+        }
+
+        /// Only the parts we look at are filled in, but the images are
+        /// kept frame-sized so coordinates (and debug views) work out the
+        /// same as for the full frame.
+        gray_.create(gray.size(), gray.type());
+        allocateImages(gray.size(), gray.type());
+        edge_.setTo(cv::Scalar::all(0));
+        edgeBinary_.setTo(cv::Scalar::all(0));
+
+        /// Set up the threshold parameters just as for the full frame: the
+        /// range over the regions alone would usually have a brighter
+        /// minimum, so a higher threshold, and reject blobs a full-frame pass
+        /// would accept. Finding the range is one cheap pass over the frame,
+        /// unlike the filtering.
+        auto rangeInfo = ImageRangeInfo(gray);
+        if (!computeThresholds(rangeInfo, p)) {
             /// Early out - empty image!
             return measurements_;
         }
 
+        for (auto const &region : regions_) {
+            /// Padding the area we filter means any approximations at its
+            /// border stay outside of the region itself. Each region is
+            /// filtered and searched before moving on to the next, so the
+            /// padding of one can't clobber another's results.
+            auto workArea = cv::Rect(region.tl() - cv::Point(padding.width,
+                                                             padding.height),
+                                     region.size() + padding + padding) &
+                            wholeFrame;
+            gray(workArea).copyTo(gray_(workArea));
+            detectEdges(workArea, true);
+            findBlobs(region, p);
+        }
+        return measurements_;
+    }
+
+    void EdgeHoleBasedLedExtractor::allocateImages(cv::Size const &size,
+                                                   int grayType) {
+        /// No-ops if they're already the right size, as they will be after
+        /// the first frame.
+        blurred_.create(size, grayType);
+        edge_.create(size, EDGE_DETECT_DEST_DEPTH);
+        edgeTemp_.create(size, EDGE_DETECT_DEST_DEPTH);
+        edgeBinary_.create(size, EDGE_DETECT_DEST_DEPTH);
+    }
+
+    bool EdgeHoleBasedLedExtractor::computeThresholds(
+        ImageRangeInfo const &rangeInfo, BlobParams const &p) {
+        if (rangeInfo.maxVal < p.absoluteMinThreshold) {
+            return false;
+        }
         auto thresholdInfo = ImageThresholdInfo(rangeInfo, p);
         minBeaconCenterVal_ =
             static_cast<std::uint8_t>(thresholdInfo.minThreshold);
+        return true;
+    }
+
+    void EdgeHoleBasedLedExtractor::detectEdges(cv::Rect const &area,
+                                                bool isolated) {
+        const int borderType =
+            cv::BORDER_DEFAULT | (isolated ? cv::BORDER_ISOLATED : 0);
+        auto areaGray = gray_(area);
+        auto areaBlurred = blurred_(area);
+        auto areaEdge = edge_(area);
 
         /// Used to do basic thresholding here first to reduce background noise,
         /// but turns out that actually produced worse results at the end of the
         /// process (presumably by producing very sharp edges)
         // MatType blurred;
 
-        cv::GaussianBlur(gray_, blurred_,
+        cv::GaussianBlur(areaGray, areaBlurred,
                          cv::Size(extParams_.preEdgeDetectionBlurSize,
                                   extParams_.preEdgeDetectionBlurSize),
-                         0, 0);
+                         0, 0, borderType);
 
 #ifdef OSVR_USE_REALTIME_LAPLACIAN
         /// Edge detection: re-apply our partially prepared laplacian to this
         /// frame now.
-        laplacianImpl_->apply(blurred_, edge_);
+        laplacianImpl_->apply(areaBlurred, areaEdge);
 #else
         /// Edge detection: apply a laplacian filter to this frame
-        cv::Laplacian(blurred_, edge_, CV_8U, extParams_.laplacianKSize,
-                      extParams_.laplacianScale);
+        cv::Laplacian(areaBlurred, areaEdge, CV_8U, extParams_.laplacianKSize,
+                      extParams_.laplacianScale, 0, borderType);
 #endif
 
         /// removal of mjpeg artifacts.
         if (extParams_.edgeDetectErosion) {
 #ifdef OSVR_OPENCV_2
-            compressionArtifactRemoval_->apply(edge_, edge_);
+            compressionArtifactRemoval_->apply(areaEdge, areaEdge,
+                                               cv::Rect(0, 0, -1, -1),
+                                               cv::Point(), isolated);
 #else
-            cv::erode(edge_, edge_, compressionArtifactRemovalKernel_);
+            cv::erode(areaEdge, areaEdge, compressionArtifactRemovalKernel_,
+                      cv::Point(-1, -1), 1, borderType);
 #endif
         }
 
-        // turn the edge detection into a binary image.
         if (extParams_.postEdgeDetectionBlur) {
-            cv::GaussianBlur(edge_, edgeTemp_,
+            cv::GaussianBlur(areaEdge, edgeTemp_(area),
                              cv::Size(extParams_.postEdgeDetectionBlurSize,
                                       extParams_.postEdgeDetectionBlurSize),
-                             0, 0);
-            cv::threshold(edgeTemp_, edgeBinary_,
+                             0, 0, borderType);
+        }
+    }
+
+    void EdgeHoleBasedLedExtractor::findBlobs(cv::Rect const &area,
+                                              BlobParams const &p) {
+        // turn the edge detection into a binary image.
+        auto areaBinary = edgeBinary_(area);
+        if (extParams_.postEdgeDetectionBlur) {
+            cv::threshold(edgeTemp_(area), areaBinary,
                           extParams_.postEdgeDetectionBlurThreshold, 255,
                           cv::THRESH_BINARY);
         } else {
-            cv::threshold(edge_, edgeBinary_,
+            cv::threshold(edge_(area), areaBinary,
                           extParams_.postEdgeDetectionBlurThreshold, 255,
                           cv::THRESH_BINARY);
         }
@@ -159,11 +269,11 @@ namespace vbtracker {
         // given. We examine it for suitability as an LED, and if it passes our
         // checks, add a derived measurement to our measurement vector and the
         // contour itself to our list of contours for debugging display.
-        edgeBinary_.copyTo(binTemp_);
+        areaBinary.copyTo(binTemp_);
         consumeHolesOfConnectedComponents(
             binTemp_, contoursTempStorage_, hierarchyTempStorage_,
-            [&](ContourType &&contour) { checkBlob(std::move(contour), p); });
-        return measurements_;
+            [&](ContourType &&contour) { checkBlob(std::move(contour), p); },
+            area.tl());
     }
     /// out of line for unique_ptr-based pimpl.
     EdgeHoleBasedLedExtractor::~EdgeHoleBasedLedExtractor() = default;
@@ -172,6 +282,7 @@ namespace vbtracker {
         contours_.clear();
         measurements_.clear();
         rejectList_.clear();
+        regions_.clear();
         contourId_ = 0;
     }
     void EdgeHoleBasedLedExtractor::checkBlob(ContourType &&contour,
@@ -82,6 +82,21 @@ namespace vbtracker {
         LedMeasurementVec const &operator()(cv::Mat const &gray,
                                             BlobParams const &p,
                                             bool verboseBlobOutput = false);
+
+        /// Like the full-frame overload, but only looks for LEDs within the
+        /// given (non-overlapping) regions of the frame, for when we already
+        /// have a good idea of where they'll be.
+        ///
+        /// Filtering is done on each region plus enough padding that the
+        /// result within the region matches a full-frame pass, and the
+        /// brightness range used to pick thresholds is still measured over
+        /// the whole frame. The edge detection images are blank outside of the
+        /// padded regions, and only those parts of the input gray image are
+        /// copied.
+        LedMeasurementVec const &
+        operator()(cv::Mat const &gray, BlobParams const &p,
+                   std::vector<cv::Rect> const &regions,
+                   bool verboseBlobOutput = false);
         ~EdgeHoleBasedLedExtractor();
 
         using ContourId = std::size_t;
@@ -105,6 +120,10 @@ namespace vbtracker {
             return measurements_;
         }
         RejectList const &getRejectList() const { return rejectList_; }
+        /// Regions searched in the latest frame: empty if the whole frame was.
+        std::vector<cv::Rect> const &getSearchedRegions() const {
+            return regions_;
+        }
 
       private:
 #if OSVR_EDGEHOLE_UMAT
@@ -116,6 +135,20 @@ namespace vbtracker {
             return input;
         }
 #endif
+        /// Makes sure the intermediate images are allocated at full size.
+        void allocateImages(cv::Size const &size, int grayType);
+        /// Sets minBeaconCenterVal_ from the brightness range.
+        /// @return false if nothing is bright enough to be an LED.
+        bool computeThresholds(ImageRangeInfo const &rangeInfo,
+                               BlobParams const &p);
+        /// Blurs and edge-detects the given area of gray_ into edge_ and
+        /// (blurred again, if configured) edgeTemp_. With isolated set,
+        /// pixels outside of the area aren't used, so results near its
+        /// border are approximate.
+        void detectEdges(cv::Rect const &area, bool isolated);
+        /// Thresholds an area of the edge detection image into edgeBinary_,
+        /// then checks each hole in the result as a possible LED.
+        void findBlobs(cv::Rect const &area, BlobParams const &p);
         void checkBlob(ContourType &&contour, BlobParams const &p);
         void addToRejectList(ContourId id, RejectReason reason,
                              BlobData const &data) {
@@ -127,6 +160,10 @@ namespace vbtracker {
 
         std::uint8_t minBeaconCenterVal_ = 127;
 
+        /// How far beyond a region filtering needs to start to get the same
+        /// results within the region as filtering the whole frame.
+        int regionPadding_ = 0;
+
         /// @name Frames/intermediates someone might care about
         /// @{
         MatType gray_;
@@ -165,6 +202,7 @@ namespace vbtracker {
         ContourList contours_;
         LedMeasurementVec measurements_;
         RejectList rejectList_;
+        std::vector<cv::Rect> regions_;
         bool verbose_ = false;
 
         ContourId contourId_ = 0;
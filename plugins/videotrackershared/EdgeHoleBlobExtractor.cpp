@@ -44,14 +44,24 @@ namespace vbtracker {
     cv::Mat EdgeHoleBlobExtractor::generateDebugBlobImage_() const {
         // Draw outlines and centers of detected LEDs in blue.
         cv::Mat gray = getLatestGrayImage();
-        return drawSingleColoredContours(gray, m_extractor.getContours(),
-                                         cv::Scalar(255, 0, 0));
+        cv::Mat ret = drawSingleColoredContours(
+            gray, m_extractor.getContours(), cv::Scalar(255, 0, 0));
+        // Outline any regions we limited the search to in green.
+        for (auto const &region : m_extractor.getSearchedRegions()) {
+            cv::rectangle(ret, region, cv::Scalar(0, 255, 0));
+        }
+        return ret;
     }
 
     LedMeasurementVec EdgeHoleBlobExtractor::extractBlobs_() {
         return m_extractor(getLatestGrayImage(), m_params);
     }
 
+    LedMeasurementVec EdgeHoleBlobExtractor::extractBlobsInRegions_(
+        std::vector<cv::Rect> const &regions) {
+        return m_extractor(getLatestGrayImage(), m_params, regions);
+    }
+
     BlobExtractorPtr
     makeEdgeHoleBlobExtractor(BlobParams const &blobParams,
                               EdgeHoleParams const &extParams) {
@@ -49,6 +49,8 @@ namespace vbtracker {
         cv::Mat generateDebugThresholdImage_() const override;
         cv::Mat generateDebugBlobImage_() const override;
         LedMeasurementVec extractBlobs_() override;
+        LedMeasurementVec
+        extractBlobsInRegions_(std::vector<cv::Rect> const &regions) override;
 
       private:
         BlobParams m_params;
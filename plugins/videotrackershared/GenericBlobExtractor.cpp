@@ -62,5 +62,22 @@ namespace vbtracker {
         return latestMeasurements_;
     }
 
+    LedMeasurementVec const &
+    GenericBlobExtractor::extractBlobs(cv::Mat const &grayImage,
+                                       std::vector<cv::Rect> const &regions) {
+        latestMeasurements_.clear();
+        lastGrayImage_ = grayImage.clone();
+
+        m_debugThresholdImageDirty = true;
+        m_debugBlobImageDirty = true;
+        latestMeasurements_ = extractBlobsInRegions_(regions);
+        return latestMeasurements_;
+    }
+
+    LedMeasurementVec GenericBlobExtractor::extractBlobsInRegions_(
+        std::vector<cv::Rect> const &) {
+        return extractBlobs_();
+    }
+
 } // namespace vbtracker
 } // namespace osvr
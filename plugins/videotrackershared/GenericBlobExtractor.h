@@ -33,6 +33,7 @@
 
 // Standard includes
 #include <memory>
+#include <vector>
 
 namespace osvr {
 namespace vbtracker {
@@ -49,6 +50,11 @@ namespace vbtracker {
         cv::Mat const &getDebugBlobImage();
 
         LedMeasurementVec const &extractBlobs(cv::Mat const &grayImage);
+        /// Extracts blobs only within the given regions, if the
+        /// implementation supports it: otherwise, the whole image is used.
+        LedMeasurementVec const &
+        extractBlobs(cv::Mat const &grayImage,
+                     std::vector<cv::Rect> const &regions);
         LedMeasurementVec const &getLatestMeasurements() const {
             return latestMeasurements_;
         }
@@ -57,6 +63,9 @@ namespace vbtracker {
         virtual cv::Mat generateDebugThresholdImage_() const = 0;
         virtual cv::Mat generateDebugBlobImage_() const = 0;
         virtual LedMeasurementVec extractBlobs_() = 0;
+        /// Default implementation just calls extractBlobs_()
+        virtual LedMeasurementVec
+        extractBlobsInRegions_(std::vector<cv::Rect> const &regions);
         GenericBlobExtractor() = default;
 
       private:
@@ -208,9 +208,10 @@ namespace vbtracker {
     inline void consumeHolesOfConnectedComponents(
         cv::InputOutputArray input,
         std::vector<ContourType> &contoursTempStorage,
-        std::vector<cv::Vec4i> &hierarchyTempStorage, F &&continuation) {
+        std::vector<cv::Vec4i> &hierarchyTempStorage, F &&continuation,
+        cv::Point offset = cv::Point()) {
         cv::findContours(input, contoursTempStorage, hierarchyTempStorage,
-                         cv::RETR_CCOMP, cv::CHAIN_APPROX_NONE);
+                         cv::RETR_CCOMP, cv::CHAIN_APPROX_NONE, offset);
         // intentionally storing in int, instead of auto, since we'll compare
         // against int.
         int n = static_cast<int>(contoursTempStorage.size());
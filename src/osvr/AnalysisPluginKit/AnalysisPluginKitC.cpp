@@ -28,6 +28,7 @@
 #include <osvr/Connection/Connection.h>
 #include <osvr/PluginHost/RegistrationContext.h>
 #include <osvr/Common/ClientContext.h>
+#include <osvr/Common/DirectReportDispatch.h>
 #include <osvr/Client/CreateContext.h>
 #include <osvr/Util/MacroToolsC.h>
 #include <osvr/Util/Verbosity.h>
@@ -96,13 +97,20 @@ osvrAnalysisSyncInit(OSVR_IN_PTR OSVR_PluginRegContext ctx,
             .getParent());
     auto vrpnConn = extractVrpnConnection(*osvrConn);
 
+    /// This client context listens on the connection, so devices can't send
+    /// only to the in-process client of a joint client context.
+    auto const &direct = osvrConn->getDirectReportDispatch();
+    if (direct) {
+        direct->requireWire();
+    }
+
     /// Create a client context here
 
     /// @todo Use an interface factory that handles relative paths.
     auto clientCtxSmart = osvr::common::wrapSharedContext(
         osvr::client::createAnalysisClientContext(
             "org.osvr.analysisplugin" /**< @todo */, "localhost" /**< @todo */,
-            vrpn_ConnectionPtr(vrpnConn)));
+            vrpn_ConnectionPtr(vrpnConn), osvrConn->getSharedPathTree()));
     auto &dev = **device;
     /// pass ownership
     dev.acquireObject(clientCtxSmart);
@@ -30,6 +30,7 @@
 #include <osvr/Common/PathElementTools.h>
 #include <osvr/Common/PathElementTypes.h>
 #include <osvr/Common/PathTreeFull.h>
+#include <osvr/Common/PathTreeObserver.h>
 #include <osvr/Common/SystemComponent.h>
 #include <osvr/Util/Verbosity.h>
 
@@ -49,6 +50,7 @@ namespace client {
 
     AnalysisClientContext::AnalysisClientContext(
         const char appId[], const char host[], vrpn_ConnectionPtr const &conn,
+        common::PathTreeOwnerPtr const &sharedTree,
         common::ClientContextDeleter del)
         : ::OSVR_ClientContextObject(appId, del), m_mainConn(conn),
           m_ifaceMgr(m_pathTreeOwner, m_factory,
@@ -68,17 +70,34 @@ namespace client {
         m_systemDevice = common::createClientDevice(sysDeviceName, m_mainConn);
         m_systemComponent =
             m_systemDevice->addComponent(common::SystemComponent::create());
-        using DedupJsonFunction =
-            common::DeduplicatingFunctionWrapper<Json::Value const &>;
-        m_systemComponent->registerReplaceTreeHandler(
-            DedupJsonFunction([&](Json::Value nodes) {
-
-                OSVR_DEV_VERBOSE("Got updated path tree, processing");
-
-                // Tree observers will handle destruction/creation of remote
-                // handlers.
-                m_pathTreeOwner.replaceTree(nodes);
-            }));
+        if (sharedTree) {
+            /// The server updates the shared tree itself, so there's no need
+            /// to listen for (and parse) the tree it sends to other clients.
+            /// We still copy it, since resolving our interfaces modifies the
+            /// tree, and other contexts share the server's.
+            OSVR_DEV_VERBOSE("Copying the server's path tree directly");
+            m_sharedTreeObserver = sharedTree->makeObserver();
+            m_sharedTreeObserver->setEventCallback(
+                common::PathTreeEvents::AfterUpdate,
+                [&](common::PathTree &tree) {
+                    m_pathTreeOwner.copyTree(tree);
+                });
+            if (*sharedTree) {
+                m_pathTreeOwner.copyTree(sharedTree->get());
+            }
+        } else {
+            using DedupJsonFunction =
+                common::DeduplicatingFunctionWrapper<Json::Value const &>;
+            m_systemComponent->registerReplaceTreeHandler(
+                DedupJsonFunction([&](Json::Value nodes) {
+
+                    OSVR_DEV_VERBOSE("Got updated path tree, processing");
+
+                    // Tree observers will handle destruction/creation of
+                    // remote handlers.
+                    m_pathTreeOwner.replaceTree(nodes);
+                }));
+        }
 
         // No startup spin.
     }
@@ -34,6 +34,8 @@
 #include <osvr/Common/ClientContext.h>
 #include <osvr/Common/PathTree.h>
 #include <osvr/Common/PathTreeOwner.h>
+#include <osvr/Common/PathTreeObserverPtr.h>
+#include <osvr/Common/PathTreeOwnerPtr.h>
 #include <osvr/Common/SystemComponent_fwd.h>
 #include <osvr/Common/Transform.h>
 #include <osvr/Util/TimeValue_fwd.h>
@@ -49,8 +51,12 @@ namespace client {
 
     class AnalysisClientContext : public ::OSVR_ClientContextObject {
       public:
+        /// @param sharedTree If non-null, the server's shared path tree,
+        /// which we'll copy our own tree from whenever it changes, instead of
+        /// getting it from messages on @p conn.
         AnalysisClientContext(const char appId[], const char host[],
                               vrpn_ConnectionPtr const &conn,
+                              common::PathTreeOwnerPtr const &sharedTree,
                               common::ClientContextDeleter del);
         virtual ~AnalysisClientContext();
         EIGEN_MAKE_ALIGNED_OPERATOR_NEW
@@ -94,7 +100,8 @@ namespace client {
         /// @brief All open VRPN connections, keyed by host
         VRPNConnectionCollection m_vrpnConns;
 
-        /// @brief Object owning a path tree.
+        /// @brief Object owning a path tree. Always our own, even with a
+        /// shared server tree: resolving interfaces adds nodes to the tree.
         common::PathTreeOwner m_pathTreeOwner;
 
         /// @brief Factory for producing remote handlers.
@@ -107,6 +114,10 @@ namespace client {
         /// with the path tree.
         ClientInterfaceObjectManager m_ifaceMgr;
 
+        /// @brief Observer of the server's shared path tree, if any: declared
+        /// after what its callback uses, so it's gone before they are.
+        common::PathTreeObserverPtr m_sharedTreeObserver;
+
         /// @brief Gets set to true once we actually get called to update and it
         /// becomes more socially acceptable to be verbose about things like our
         /// interfaces not resolving to a source.
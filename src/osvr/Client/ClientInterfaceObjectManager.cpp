@@ -32,12 +32,14 @@
 #include <osvr/Common/ClientInterface.h>
 #include <osvr/Util/Verbosity.h>
 #include <osvr/Common/ResolveTreeNode.h>
+#include <osvr/Common/OriginalSource.h>
 
 // Library/third-party includes
 #include <boost/assert.hpp>
 
 // Standard includes
 #include <unordered_set>
+#include <vector>
 
 namespace osvr {
 namespace client {
@@ -46,12 +48,14 @@ namespace client {
         common::ClientContext &ctx)
         : m_pathTree(tree.get()), m_treeObserver(tree.makeObserver()),
           m_factory(handlerFactory), m_ctx(&ctx) {
+        /// Handlers don't refer to the tree once constructed, so we can leave
+        /// them in place across an update and only touch the ones whose
+        /// source actually changed.
         m_treeObserver->setEventCallback(
-            common::PathTreeEvents::AboutToUpdate,
-            [&](common::PathTree &) { m_interfaces.clearHandlers(); });
-        m_treeObserver->setEventCallback(
-            common::PathTreeEvents::AfterUpdate,
-            [&](common::PathTree &) { m_connectNeededCallbacks(); });
+            common::PathTreeEvents::AfterUpdate, [&](common::PathTree &) {
+                m_refreshChangedCallbacks();
+                m_connectNeededCallbacks();
+            });
     }
 
     void ClientInterfaceObjectManager::addInterface(
@@ -80,7 +84,7 @@ namespace client {
         /// Start by removing handler from interface tree and handler container
         /// for this path, if found. Ensures that if we early-out (fail to set
         /// up a handler) we don't have a leftover one still active.
-        m_interfaces.eraseHandlerForPath(path);
+        m_removeCallbacksOnPath(path);
 
         auto source = common::resolveTreeNode(m_pathTree, path);
         if (!source.is_initialized()) {
@@ -100,6 +104,7 @@ namespace client {
             BOOST_ASSERT_MSG(
                 !oldHandler,
                 "We removed the old handler before so it should be null now");
+            m_handlerSources[path] = m_describeSource(*source);
             return true;
         }
 
@@ -112,6 +117,7 @@ namespace client {
     void ClientInterfaceObjectManager::m_removeCallbacksOnPath(
         std::string const &path) {
         m_interfaces.eraseHandlerForPath(path);
+        m_handlerSources.erase(path);
     }
 
     void ClientInterfaceObjectManager::m_connectNeededCallbacks() {
@@ -132,6 +138,42 @@ namespace client {
                          << " unconnected paths successfully";
     }
 
+    void ClientInterfaceObjectManager::m_refreshChangedCallbacks() {
+        /// Collect first, since we may modify handlers.
+        std::vector<std::string> paths;
+        m_interfaces.visitPathsWithHandlers(
+            [&](std::string const &path) { paths.push_back(path); });
+
+        auto changedPaths = size_t{0};
+        for (auto const &path : paths) {
+            auto source = common::resolveTreeNode(m_pathTree, path);
+            auto it = m_handlerSources.find(path);
+            if (source.is_initialized() && it != end(m_handlerSources) &&
+                it->second == m_describeSource(*source)) {
+                // Unchanged - keep the handler as-is.
+                continue;
+            }
+            changedPaths++;
+            // Leaves it without a handler if it no longer resolves.
+            m_connectCallbacksOnPath(path);
+        }
+        logger()->info() << "Path tree updated: sources changed for "
+                         << changedPaths << " of " << paths.size()
+                         << " connected paths";
+    }
+
+    ClientInterfaceObjectManager::SourceDescription
+    ClientInterfaceObjectManager::m_describeSource(
+        common::OriginalSource const &source) {
+        SourceDescription ret;
+        ret.devicePath = source.getDevicePath();
+        ret.device = source.getDeviceElement();
+        ret.interfaceName = source.getInterfaceName();
+        ret.sensor = source.getSensorNumber();
+        ret.transform = source.getTransformJson();
+        return ret;
+    }
+
     util::log::LoggerPtr const &ClientInterfaceObjectManager::logger() const {
         return m_ctx->logger();
     }
@@ -51,6 +51,14 @@ namespace client {
     common::ClientContext *
     createAnalysisClientContext(const char appId[], const char host[],
                                 vrpn_ConnectionPtr const &conn) {
+        return createAnalysisClientContext(appId, host, conn,
+                                           common::PathTreeOwnerPtr());
+    }
+
+    common::ClientContext *
+    createAnalysisClientContext(const char appId[], const char host[],
+                                vrpn_ConnectionPtr const &conn,
+                                common::PathTreeOwnerPtr const &sharedTree) {
         common::ClientContext *ret = nullptr;
         if (!appId || !appId[0]) {
             OSVR_DEV_VERBOSE("Could not create analysis client context - null "
@@ -70,7 +78,8 @@ namespace client {
             return ret;
         }
 
-        ret = common::makeContext<AnalysisClientContext>(appId, host, conn);
+        ret = common::makeContext<AnalysisClientContext>(appId, host, conn,
+                                                         sharedTree);
         return ret;
     }
 
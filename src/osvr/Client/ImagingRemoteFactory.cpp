@@ -91,11 +91,11 @@ namespace client {
             m_internals.forEachInterface(
                 [&timestamp, &report, &data](common::ClientInterface &iface) {
                     // Note: not setting state here! we don't store image state.
+                    // Acquire a reference for each callback we're going to
+                    // call: each one frees the image separately.
                     auto n = iface.getNumCallbacksFor(report);
-                    for (std::size_t i = 0; i < n; ++i) {
-                        // Acquire a reference for each callback we're going to
-                        // call.
-                        iface.getContext().acquireObject(data.buffer);
+                    if (n > 0) {
+                        iface.getContext().acquireImageBuffer(data.buffer, n);
                     }
                     iface.triggerCallbacks(timestamp, report);
                 });
@@ -0,0 +1,65 @@
+/** @file
+    @brief Header
+
+    Internal to osvrClient.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_IncrementalRotation_h_GUID_5A0E7C93_2D41_4B8F_9C16_E3F84B27D650
+#define INCLUDED_IncrementalRotation_h_GUID_5A0E7C93_2D41_4B8F_9C16_E3F84B27D650
+
+// Internal Includes
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/EigenCoreGeometry.h>
+#include <osvr/Util/EigenInterop.h>
+#include <osvr/Util/EigenQuatExponentialMap.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace client {
+    /// @brief Converts an incremental rotation quaternion (rotation over dt
+    /// seconds) to an angular velocity rotation vector in rad/s.
+    ///
+    /// A zero dt gives zero angular velocity.
+    inline Eigen::Vector3d
+    incRotToAngVelVec(OSVR_IncrementalQuaternion const &incRot) {
+        if (incRot.dt == 0) {
+            return Eigen::Vector3d::Zero();
+        }
+        Eigen::Quaterniond q =
+            util::eigen_interop::map(incRot.incrementalRotation);
+        if (q.w() < 0) {
+            // Take the short way around.
+            q.coeffs() *= -1;
+        }
+        // quat_ln gives half the rotation vector.
+        return util::quat_ln(q.normalized()) * (2. / incRot.dt);
+    }
+} // namespace client
+} // namespace osvr
+
+#endif // INCLUDED_IncrementalRotation_h_GUID_5A0E7C93_2D41_4B8F_9C16_E3F84B27D650
@@ -0,0 +1,164 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Client/PosePrediction.h>
+#include "IncrementalRotation.h"
+#include <osvr/Common/ClientInterface.h>
+#include <osvr/Common/ReportTypes.h>
+#include <osvr/Kalman/PoseConstantVelocity.h>
+#include <osvr/Kalman/PoseState.h>
+#include <osvr/Util/EigenInterop.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <vector>
+
+namespace osvr {
+namespace client {
+    namespace ei = util::eigen_interop;
+    namespace {
+        /// @brief The actual prediction, given a (reused) process model.
+        inline OSVR_PoseState
+        predictPoseImpl(kalman::PoseConstantVelocityProcessModel &process,
+                        OSVR_PoseState const &pose,
+                        util::time::TimeValue const &poseTime,
+                        OSVR_VelocityState const &velocity,
+                        util::time::TimeValue const &target) {
+            auto dt = osvrTimeValueDurationSeconds(&target, &poseTime);
+            bool linear = velocity.linearVelocityValid == OSVR_TRUE;
+            bool angular = velocity.angularVelocityValid == OSVR_TRUE;
+            if (dt == 0 || !(linear || angular)) {
+                return pose;
+            }
+            kalman::pose_externalized_rotation::State state;
+            state.position() = ei::map(pose.translation);
+            state.setQuaternion(ei::map(pose.rotation));
+            if (linear) {
+                state.velocity() = ei::map(velocity.linearVelocity);
+            }
+            if (angular) {
+                state.angularVelocity() =
+                    incRotToAngVelVec(velocity.angularVelocity);
+            }
+            /// Using computeEstimate instead of the normal prediction saves us
+            /// the unneeded prediction of the error covariance.
+            state.setStateVector(process.computeEstimate(state, dt));
+            state.postCorrect();
+
+            OSVR_PoseState ret;
+            ei::map(ret.translation) = state.position();
+            ei::map(ret.rotation) = state.getQuaternion();
+            return ret;
+        }
+
+        /// @brief Snapshot of the state needed to predict one interface.
+        struct PredictionInput {
+            OSVR_PoseState pose;
+            util::time::TimeValue poseTime;
+            OSVR_VelocityState velocity;
+        };
+
+        inline bool getPredictionInput(OSVR_ClientInterfaceObject const &iface,
+                                       PredictionInput &input) {
+            /// Pose and velocity from the same update, not one from before
+            /// and one from after it.
+            common::PoseVelocityState state;
+            if (!iface.getPoseVelocityState(state) || !state.hasPose) {
+                return false;
+            }
+            input.pose = state.pose;
+            input.poseTime = state.poseTime;
+            input.velocity = getPredictionVelocity(state);
+            return true;
+        }
+    } // namespace
+
+    OSVR_VelocityState
+    getPredictionVelocity(common::PoseVelocityState const &state) {
+        OSVR_VelocityState ret;
+        if (state.hasVelocity &&
+            osvrTimeValueDurationSeconds(&state.poseTime,
+                                         &state.velocityTime) <=
+                MAX_VELOCITY_AGE) {
+            ret = state.velocity;
+        } else {
+            ret.linearVelocityValid = OSVR_FALSE;
+            ret.angularVelocityValid = OSVR_FALSE;
+        }
+        return ret;
+    }
+
+    OSVR_PoseState predictPose(OSVR_PoseState const &pose,
+                               util::time::TimeValue const &poseTime,
+                               OSVR_VelocityState const &velocity,
+                               util::time::TimeValue const &target) {
+        kalman::PoseConstantVelocityProcessModel process;
+        return predictPoseImpl(process, pose, poseTime, velocity, target);
+    }
+
+    bool getPredictedPose(OSVR_ClientInterfaceObject const &iface,
+                          util::time::TimeValue const &target,
+                          OSVR_PoseState &pose) {
+        PredictionInput input;
+        if (!getPredictionInput(iface, input)) {
+            return false;
+        }
+        pose = predictPose(input.pose, input.poseTime, input.velocity, target);
+        return true;
+    }
+
+    std::size_t
+    getPredictedPoses(OSVR_ClientInterfaceObject const *const *ifaces,
+                      std::size_t count, util::time::TimeValue const &target,
+                      OSVR_PoseState *poses, bool *hasPose) {
+        /// Snapshot everything first, so the predictions are all based on as
+        /// close to the same update as we can get.
+        std::vector<PredictionInput> inputs(count);
+        std::vector<char> valid(count, 0);
+        for (std::size_t i = 0; i < count; ++i) {
+            valid[i] = ifaces[i] != nullptr &&
+                       getPredictionInput(*ifaces[i], inputs[i]);
+        }
+
+        kalman::PoseConstantVelocityProcessModel process;
+        std::size_t ret = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (hasPose) {
+                hasPose[i] = (valid[i] != 0);
+            }
+            if (!valid[i]) {
+                continue;
+            }
+            poses[i] = predictPoseImpl(process, inputs[i].pose,
+                                       inputs[i].poseTime, inputs[i].velocity,
+                                       target);
+            ++ret;
+        }
+        return ret;
+    }
+} // namespace client
+} // namespace osvr
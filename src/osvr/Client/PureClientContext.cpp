@@ -38,6 +38,7 @@
 #include <json/value.h>
 
 // Standard includes
+#include <random>
 #include <thread>
 #include <unordered_set>
 
@@ -93,6 +94,12 @@ namespace client {
             throw std::runtime_error("Network error: " + m_network.getError());
         }
 
+        {
+            std::random_device rd;
+            std::uniform_int_distribution<uint32_t> dist(1);
+            m_treeDeltaClientId = dist(rd);
+        }
+
         /// Create all the remote handler factories.
         populateRemoteHandlerFactory(m_factory, m_vrpnConns);
 
@@ -108,8 +115,39 @@ namespace client {
         using DedupJsonFunction =
             common::DeduplicatingFunctionWrapper<Json::Value const &>;
 
+        m_systemComponent->registerTreeDeltaHandler(
+            [&](Json::Value const &msg, util::time::TimeValue const &) {
+                auto delta = msg;
+                replaceLocalhostServers(delta["added"], m_host);
+                replaceLocalhostServers(delta["changed"], m_host);
+
+                // Tree observers will handle updating just the affected
+                // remote handlers.
+                m_treeDeltasInSync = m_pathTreeOwner.applyTreeDelta(delta);
+                if (m_treeDeltasInSync) {
+                    m_treeKeyframeRequested = false;
+                } else if (!m_treeKeyframeRequested) {
+                    logger()->notice("Got path tree delta for a generation "
+                                     "we don't have, asking for a keyframe");
+                    m_systemComponent->sendTreeDeltaSupport(
+                        0, true, m_treeDeltaClientId);
+                    m_treeKeyframeRequested = true;
+                }
+            });
+
+        m_systemComponent->registerTreeDeltaQueryHandler([&](uint32_t epoch) {
+            m_systemComponent->sendTreeDeltaSupport(
+                epoch, !m_treeDeltasInSync, m_treeDeltaClientId);
+        });
+
         m_systemComponent->registerReplaceTreeHandler(
             DedupJsonFunction([&](Json::Value nodes) {
+                if (m_treeDeltasInSync) {
+                    // Already got this update as a delta, which the server
+                    // sends first, for the sake of clients that haven't told
+                    // it they understand deltas.
+                    return;
+                }
                 logger()->debug("Got updated path tree, processing");
                 // Replace localhost before we even convert the json to a tree.
                 // replace the @localhost with the correct host name
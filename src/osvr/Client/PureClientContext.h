@@ -37,6 +37,7 @@
 #include <osvr/Common/PathTreeOwner.h>
 #include <osvr/Common/SystemComponent_fwd.h>
 #include <osvr/Common/Transform.h>
+#include <osvr/Util/StdInt.h>
 #include <osvr/Util/TimeValue_fwd.h>
 
 // Library/third-party includes
@@ -108,6 +109,18 @@ namespace client {
         /// @brief Have we gotten a connection to the main server?
         bool m_gotConnection = false;
 
+        /// @brief Are we keeping our path tree up to date with deltas (so can
+        /// ignore full path tree replacements)?
+        bool m_treeDeltasInSync = false;
+
+        /// @brief Have we asked the server for a keyframe delta, having missed
+        /// a delta, and not got one yet?
+        bool m_treeKeyframeRequested = false;
+
+        /// @brief Picked at random, so the server can tell our replies to its
+        /// tree delta queries from other clients'.
+        uint32_t m_treeDeltaClientId;
+
         /// @brief Room to world transform.
         common::Transform m_roomToWorld;
 
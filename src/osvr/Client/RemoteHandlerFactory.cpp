@@ -42,10 +42,9 @@
 
 namespace osvr {
 namespace client {
-    void populateRemoteHandlerFactory(RemoteHandlerFactory &factory,
-                                      VRPNConnectionCollection const &conns) {
-        /// Register all the factories.
-        TrackerRemoteFactory(conns).registerWith(factory);
+    static void
+    populateNonTrackerFactories(RemoteHandlerFactory &factory,
+                                VRPNConnectionCollection const &conns) {
         AnalogRemoteFactory(conns).registerWith(factory);
         ButtonRemoteFactory(conns).registerWith(factory);
         EyeTrackerRemoteFactory(conns).registerWith(factory);
@@ -56,5 +55,21 @@ namespace client {
         SkeletonRemoteFactory(conns).registerWith(factory);
     }
 
+    void populateRemoteHandlerFactory(RemoteHandlerFactory &factory,
+                                      VRPNConnectionCollection const &conns) {
+        /// Register all the factories.
+        TrackerRemoteFactory(conns).registerWith(factory);
+        populateNonTrackerFactories(factory, conns);
+    }
+
+    void
+    populateRemoteHandlerFactory(RemoteHandlerFactory &factory,
+                                 VRPNConnectionCollection const &conns,
+                                 common::DirectReportDispatchPtr const &direct,
+                                 std::string const &directHost) {
+        TrackerRemoteFactory(conns, direct, directHost).registerWith(factory);
+        populateNonTrackerFactories(factory, conns);
+    }
+
 } // namespace client
 } // namespace osvr
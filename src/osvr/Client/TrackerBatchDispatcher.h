@@ -0,0 +1,97 @@
+/** @file
+    @brief Header
+
+    Internal to osvrClient.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_TrackerBatchDispatcher_h_GUID_B83D1F6A_4C27_4E90_A5D8_29E0C7F13B64
+#define INCLUDED_TrackerBatchDispatcher_h_GUID_B83D1F6A_4C27_4E90_A5D8_29E0C7F13B64
+
+// Internal Includes
+#include <osvr/Common/TrackerBatchComponent.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace osvr {
+namespace client {
+    /// @brief Passes each batch of tracker poses from a device on to every
+    /// handler that wants it.
+    ///
+    /// One of these is shared by all the tracker handlers (one per
+    /// interface) for a device, so each batch message is decoded once per
+    /// device rather than once per interface.
+    class TrackerBatchDispatcher : boost::noncopyable {
+      public:
+        typedef std::function<void(common::TrackerPoseBatch const &,
+                                   util::time::TimeValue const &)>
+            Handler;
+        typedef std::size_t HandlerId;
+
+        /// @returns an ID to pass to removeHandler().
+        HandlerId addHandler(Handler const &handler) {
+            auto id = m_nextId++;
+            m_handlers.emplace_back(id, handler);
+            return id;
+        }
+
+        void removeHandler(HandlerId id) {
+            m_handlers.erase(
+                std::remove_if(m_handlers.begin(), m_handlers.end(),
+                               [id](std::pair<HandlerId, Handler> const &h) {
+                                   return h.first == id;
+                               }),
+                m_handlers.end());
+        }
+
+        void dispatch(common::TrackerPoseBatch const &batch,
+                      util::time::TimeValue const &timestamp) const {
+            for (auto const &h : m_handlers) {
+                h.second(batch, timestamp);
+            }
+        }
+
+        std::size_t numHandlers() const { return m_handlers.size(); }
+
+        /// @brief Whether the given handler is the earliest added of those
+        /// still registered.
+        bool isFirstHandler(HandlerId id) const {
+            return !m_handlers.empty() && m_handlers.front().first == id;
+        }
+
+      private:
+        std::vector<std::pair<HandlerId, Handler> > m_handlers;
+        HandlerId m_nextId = 0;
+    };
+} // namespace client
+} // namespace osvr
+
+#endif // INCLUDED_TrackerBatchDispatcher_h_GUID_B83D1F6A_4C27_4E90_A5D8_29E0C7F13B64
@@ -26,17 +26,22 @@
 #include "TrackerRemoteFactory.h"
 #include "PureClientContext.h"
 #include "RemoteHandlerInternals.h"
+#include "TrackerBatchDispatcher.h"
 #include "VRPNConnectionCollection.h"
 #include <osvr/Client/InterfaceTree.h>
 #include <osvr/Common/ClientInterface.h>
+#include <osvr/Common/CreateDevice.h>
+#include <osvr/Common/DirectReportDispatch.h>
 #include <osvr/Common/JSONTransformVisitor.h>
 #include <osvr/Common/OriginalSource.h>
 #include <osvr/Common/PathTreeFull.h>
 #include <osvr/Common/Tracing.h>
+#include <osvr/Common/TrackerBatchComponent.h>
 #include <osvr/Common/TrackerSensorInfo.h>
 #include <osvr/Common/Transform.h>
 #include <osvr/Util/ChannelCountC.h>
 #include <osvr/Util/EigenInterop.h>
+#include <osvr/Util/Logger.h>
 #include <osvr/Util/QuatlibInteropC.h>
 #include <osvr/Util/UniquePtr.h>
 #include <osvr/Util/Verbosity.h>
@@ -50,13 +55,64 @@
 #include <vrpn_Tracker.h>
 
 // Standard includes
-// - none
+#include <string>
 
 namespace ei = osvr::util::eigen_interop;
 
 namespace osvr {
 namespace client {
-    class VRPNTrackerHandler : public RemoteHandler {
+    /// @brief Receives and decodes the batched poses of one device, for all
+    /// the handlers of its interfaces.
+    class TrackerBatchSource : boost::noncopyable {
+      public:
+        TrackerBatchSource(vrpn_ConnectionPtr const &conn, const char *src,
+                           util::log::LoggerPtr const &logger)
+            : m_dev(common::createClientDevice(src, conn)), m_name(src),
+              m_logger(logger) {
+            auto batch = common::TrackerBatchComponent::create();
+            m_dev->addComponent(batch);
+            batch->registerPoseBatchHandler(
+                [&](common::TrackerPoseBatch const &poses,
+                    util::time::TimeValue const &timestamp) {
+                    m_dispatcher.dispatch(poses, timestamp);
+                });
+        }
+
+        TrackerBatchDispatcher &dispatcher() { return m_dispatcher; }
+
+        /// @brief Called by each handler on every update, but only does
+        /// anything for the first of them, so the device is updated once
+        /// per context update however many interfaces it has.
+        void update(TrackerBatchDispatcher::HandlerId caller) {
+            if (m_dispatcher.isFirstHandler(caller)) {
+                m_dev->update();
+            }
+        }
+
+        /// @brief Called by handlers receiving a batch that their descriptor
+        /// didn't say to expect: warns, the first time.
+        void unexpectedBatch() {
+            if (m_warned) {
+                return;
+            }
+            m_warned = true;
+            m_logger->warn()
+                << "Device " << m_name
+                << " sends batched tracker poses, but its descriptor doesn't "
+                   "set \"batched\": true for its tracker interface, so they "
+                   "are being ignored.";
+        }
+
+      private:
+        common::BaseDevicePtr m_dev;
+        TrackerBatchDispatcher m_dispatcher;
+        std::string m_name;
+        util::log::LoggerPtr m_logger;
+        bool m_warned = false;
+    };
+
+    class VRPNTrackerHandler : public RemoteHandler,
+                               public common::TrackerReportSink {
       public:
         struct Options {
             bool reportPose = false;
@@ -69,30 +125,40 @@ namespace client {
                            common::Transform const &t,
                            boost::optional<int> sensor,
                            common::InterfaceList &ifaces,
-                           common::ClientContext &ctx)
-            : m_remote(new vrpn_Tracker_Remote(src, conn.get())),
-              m_transform(t), m_ctx(ctx), m_internals(ifaces), m_opts(options),
-              m_info(info), m_sensor(sensor) {
-            if (m_info.reportsPosition || m_info.reportsOrientation) {
-                m_remote->register_change_handler(this,
-                                                  &VRPNTrackerHandler::handle,
-                                                  m_sensor.get_value_or(-1));
+                           common::ClientContext &ctx,
+                           common::DirectTrackerChannelPtr const &direct,
+                           shared_ptr<TrackerBatchSource> const &batch)
+            : m_direct(direct), m_batch(batch), m_transform(t), m_ctx(ctx),
+              m_internals(ifaces), m_opts(options), m_info(info),
+              m_sensor(sensor) {
+            if (m_direct) {
+                /// Reports will come straight from the in-process device.
+                m_direct->addSink(*this);
+            } else {
+                m_remote.reset(new vrpn_Tracker_Remote(src, conn.get()));
+                m_registerRemoteHandlers();
             }
-            if (m_info.reportsLinearVelocity || m_info.reportsAngularVelocity) {
-                m_remote->register_change_handler(
-                    this, &VRPNTrackerHandler::handleVel,
-                    m_sensor.get_value_or(-1));
-            }
-            if (m_info.reportsLinearAcceleration ||
-                m_info.reportsAngularAcceleration) {
-                m_remote->register_change_handler(
-                    this, &VRPNTrackerHandler::handleAccel,
-                    m_sensor.get_value_or(-1));
+            /// Registered even if we don't expect batches, so we can tell
+            /// when they arrive anyway.
+            if (m_batch) {
+                m_batchHandlerId = m_batch->dispatcher().addHandler(
+                    [&](common::TrackerPoseBatch const &poses,
+                        util::time::TimeValue const &timestamp) {
+                        m_handleBatch(poses, timestamp);
+                    });
             }
             OSVR_DEV_VERBOSE("Constructed a TrackerHandler for "
-                             << src << " sensor " << m_sensor.get_value_or(-1));
+                             << src << " sensor " << m_sensor.get_value_or(-1)
+                             << (m_direct ? " (direct)" : ""));
         }
         virtual ~VRPNTrackerHandler() {
+            if (m_batch) {
+                m_batch->dispatcher().removeHandler(m_batchHandlerId);
+            }
+            if (m_direct) {
+                m_direct->removeSink(*this);
+                return;
+            }
             if (m_info.reportsPosition || m_info.reportsOrientation) {
                 m_remote->unregister_change_handler(this,
                                                     &VRPNTrackerHandler::handle,
@@ -133,19 +199,113 @@ namespace client {
             auto self = static_cast<VRPNTrackerHandler *>(userdata);
             self->m_handle(info);
         }
-        virtual void update() { m_remote->mainloop(); }
+
+        /// @name TrackerReportSink implementation (direct mode)
+        /// @{
+        void handleDirectPose(OSVR_ChannelCount sensor,
+                              OSVR_PoseState const &pose,
+                              util::time::TimeValue const &tv) override {
+            if (!m_acceptsSensor(sensor) ||
+                !(m_info.reportsPosition || m_info.reportsOrientation)) {
+                return;
+            }
+            common::tracing::markNewTrackerData();
+            m_handlePose(static_cast<int32_t>(sensor), pose,
+                         getCurrentTransform(), tv);
+        }
+        void handleDirectVelocity(OSVR_ChannelCount sensor,
+                                  OSVR_VelocityState const &vel,
+                                  util::time::TimeValue const &tv) override {
+            if (!m_acceptsSensor(sensor) ||
+                !(m_info.reportsLinearVelocity ||
+                  m_info.reportsAngularVelocity)) {
+                return;
+            }
+            m_handleVelocity(static_cast<int32_t>(sensor), vel, tv);
+        }
+        void
+        handleDirectAcceleration(OSVR_ChannelCount sensor,
+                                 OSVR_AccelerationState const &accel,
+                                 util::time::TimeValue const &tv) override {
+            if (!m_acceptsSensor(sensor) ||
+                !(m_info.reportsLinearAcceleration ||
+                  m_info.reportsAngularAcceleration)) {
+                return;
+            }
+            m_handleAcceleration(static_cast<int32_t>(sensor), accel, tv);
+        }
+        /// @}
+
+        virtual void update() {
+            if (m_remote) {
+                m_remote->mainloop();
+            }
+            if (m_batch) {
+                m_batch->update(m_batchHandlerId);
+            }
+        }
 
       private:
+        void m_registerRemoteHandlers() {
+            if (m_info.reportsPosition || m_info.reportsOrientation) {
+                m_remote->register_change_handler(this,
+                                                  &VRPNTrackerHandler::handle,
+                                                  m_sensor.get_value_or(-1));
+            }
+            if (m_info.reportsLinearVelocity || m_info.reportsAngularVelocity) {
+                m_remote->register_change_handler(
+                    this, &VRPNTrackerHandler::handleVel,
+                    m_sensor.get_value_or(-1));
+            }
+            if (m_info.reportsLinearAcceleration ||
+                m_info.reportsAngularAcceleration) {
+                m_remote->register_change_handler(
+                    this, &VRPNTrackerHandler::handleAccel,
+                    m_sensor.get_value_or(-1));
+            }
+        }
+
+        bool m_acceptsSensor(OSVR_ChannelCount sensor) const {
+            return !m_sensor || *m_sensor == static_cast<int>(sensor);
+        }
+
         /// Pass pose messages on to the client
         void m_handle(vrpn_TRACKERCB const &info) {
             common::tracing::markNewTrackerData();
-            OSVR_PoseReport report;
-            report.sensor = info.sensor;
             OSVR_TimeValue timestamp;
             osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
-            osvrQuatFromQuatlib(&(report.pose.rotation), info.quat);
-            osvrVec3FromQuatlib(&(report.pose.translation), info.pos);
+            OSVR_PoseState pose;
+            osvrQuatFromQuatlib(&(pose.rotation), info.quat);
+            osvrVec3FromQuatlib(&(pose.translation), info.pos);
+            m_handlePose(info.sensor, pose, getCurrentTransform(), timestamp);
+        }
+
+        /// Pass the poses from a batch message on to the client, in one pass.
+        void m_handleBatch(common::TrackerPoseBatch const &batch,
+                           util::time::TimeValue const &timestamp) {
+            if (!m_info.reportsBatchedPoses) {
+                m_batch->unexpectedBatch();
+                return;
+            }
+            common::tracing::markNewTrackerData();
             auto xform = getCurrentTransform();
+            for (auto const &data : batch) {
+                auto sensor = static_cast<int32_t>(data.sensor);
+                if (m_sensor && *m_sensor != sensor) {
+                    /// doesn't match our filter.
+                    continue;
+                }
+                m_handlePose(sensor, data.pose, xform, timestamp);
+            }
+        }
+
+        /// Transform a (raw) pose and report it in all the forms requested.
+        void m_handlePose(int32_t sensor, OSVR_PoseState const &pose,
+                          common::Transform const &xform,
+                          OSVR_TimeValue const &timestamp) {
+            OSVR_PoseReport report;
+            report.sensor = sensor;
+            report.pose = pose;
             ei::map(report.pose) =
                 xform.transform(ei::map(report.pose).matrix());
 
@@ -155,7 +315,7 @@ namespace client {
 
             if (m_opts.reportPosition) {
                 OSVR_PositionReport positionReport;
-                positionReport.sensor = info.sensor;
+                positionReport.sensor = sensor;
                 positionReport.xyz = report.pose.translation;
 
                 m_internals.setStateAndTriggerCallbacks(timestamp,
@@ -164,7 +324,7 @@ namespace client {
 
             if (m_opts.reportOrientation) {
                 OSVR_OrientationReport oriReport;
-                oriReport.sensor = info.sensor;
+                oriReport.sensor = sensor;
                 oriReport.rotation = report.pose.rotation;
 
                 m_internals.setStateAndTriggerCallbacks(timestamp, oriReport);
@@ -173,27 +333,37 @@ namespace client {
 
         /// Pass velocity messages on to the client
         void m_handle(vrpn_TRACKERVELCB const &info) {
-            /// @todo should we be marking a trace event here?
-            // common::tracing::markNewTrackerData();
-
             OSVR_TimeValue timestamp;
             osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
+            OSVR_VelocityState state;
+            osvrVec3FromQuatlib(&(state.linearVelocity), info.vel);
+            osvrQuatFromQuatlib(&(state.angularVelocity.incrementalRotation),
+                                info.vel_quat);
+            state.angularVelocity.dt = info.vel_quat_dt;
+            m_handleVelocity(info.sensor, state, timestamp);
+        }
+
+        /// Transform a (raw) velocity and report the parts the device
+        /// provides.
+        void m_handleVelocity(int32_t sensor, OSVR_VelocityState const &raw,
+                              OSVR_TimeValue const &timestamp) {
+            /// @todo should we be marking a trace event here?
+            // common::tracing::markNewTrackerData();
 
             OSVR_VelocityReport overallReport;
-            overallReport.sensor = info.sensor;
+            overallReport.sensor = sensor;
             auto xform = getCurrentTransform();
 
             overallReport.state.linearVelocityValid =
                 m_info.reportsLinearVelocity;
             if (m_info.reportsLinearVelocity) {
-                OSVR_LinearVelocityState vel;
-                osvrVec3FromQuatlib(&(vel), info.vel);
+                OSVR_LinearVelocityState vel = raw.linearVelocity;
 
                 ei::map(vel) = xform.transformDerivative(ei::map(vel));
 
                 overallReport.state.linearVelocity = vel;
                 OSVR_LinearVelocityReport report;
-                report.sensor = info.sensor;
+                report.sensor = sensor;
                 report.state = vel;
                 m_internals.setStateAndTriggerCallbacks(timestamp, report);
             }
@@ -201,17 +371,14 @@ namespace client {
             overallReport.state.angularVelocityValid =
                 m_info.reportsAngularVelocity;
             if (m_info.reportsAngularVelocity) {
-                OSVR_AngularVelocityState state;
-                osvrQuatFromQuatlib(&(state.incrementalRotation),
-                                    info.vel_quat);
-                state.dt = info.vel_quat_dt;
+                OSVR_AngularVelocityState state = raw.angularVelocity;
 
                 ei::map(state.incrementalRotation) = xform.transformDerivative(
                     ei::map(state.incrementalRotation));
 
                 overallReport.state.angularVelocity = state;
                 OSVR_AngularVelocityReport report;
-                report.sensor = info.sensor;
+                report.sensor = sensor;
                 report.state = state;
                 m_internals.setStateAndTriggerCallbacks(timestamp, report);
             }
@@ -221,52 +388,67 @@ namespace client {
 
         /// Pass acceleration messages on to the client
         void m_handle(vrpn_TRACKERACCCB const &info) {
-            /// @todo should we be marking a trace event here?
-            // common::tracing::markNewTrackerData();
             OSVR_TimeValue timestamp;
             osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
+            OSVR_AccelerationState state;
+            osvrVec3FromQuatlib(&(state.linearAcceleration), info.acc);
+            osvrQuatFromQuatlib(
+                &(state.angularAcceleration.incrementalRotation),
+                info.acc_quat);
+            state.angularAcceleration.dt = info.acc_quat_dt;
+            m_handleAcceleration(info.sensor, state, timestamp);
+        }
+
+        /// Transform a (raw) acceleration and report the parts the device
+        /// provides.
+        void m_handleAcceleration(int32_t sensor,
+                                  OSVR_AccelerationState const &raw,
+                                  OSVR_TimeValue const &timestamp) {
+            /// @todo should we be marking a trace event here?
+            // common::tracing::markNewTrackerData();
 
             OSVR_AccelerationReport overallReport;
-            overallReport.sensor = info.sensor;
+            overallReport.sensor = sensor;
 
             auto xform = getCurrentTransform();
 
             overallReport.state.linearAccelerationValid =
                 m_info.reportsLinearAcceleration;
             if (m_info.reportsLinearAcceleration) {
-                OSVR_LinearAccelerationState accel;
-                osvrVec3FromQuatlib(&(accel), info.acc);
+                OSVR_LinearAccelerationState accel = raw.linearAcceleration;
 
                 ei::map(accel) = xform.transformDerivative(ei::map(accel));
 
                 overallReport.state.linearAcceleration = accel;
                 OSVR_LinearAccelerationReport report;
-                report.sensor = info.sensor;
+                report.sensor = sensor;
                 report.state = accel;
                 m_internals.setStateAndTriggerCallbacks(timestamp, report);
             }
             overallReport.state.angularAccelerationValid =
                 m_info.reportsAngularAcceleration;
             if (m_info.reportsAngularAcceleration) {
-
-                OSVR_AngularAccelerationState state;
-                osvrQuatFromQuatlib(&(state.incrementalRotation),
-                                    info.acc_quat);
-                state.dt = info.acc_quat_dt;
+                OSVR_AngularAccelerationState state = raw.angularAcceleration;
 
                 ei::map(state.incrementalRotation) = xform.transformDerivative(
                     ei::map(state.incrementalRotation));
 
                 overallReport.state.angularAcceleration = state;
                 OSVR_AngularAccelerationReport report;
-                report.sensor = info.sensor;
+                report.sensor = sensor;
                 report.state = state;
                 m_internals.setStateAndTriggerCallbacks(timestamp, report);
             }
 
             m_internals.setStateAndTriggerCallbacks(timestamp, overallReport);
         }
+        /// Only created if not in direct mode.
         unique_ptr<vrpn_Tracker_Remote> m_remote;
+        /// Set in direct mode.
+        common::DirectTrackerChannelPtr m_direct;
+        /// Shared with the handlers for the device's other interfaces.
+        shared_ptr<TrackerBatchSource> m_batch;
+        TrackerBatchDispatcher::HandlerId m_batchHandlerId = 0;
         common::Transform m_transform;
         common::ClientContext &m_ctx;
         RemoteHandlerInternals m_internals;
@@ -277,7 +459,14 @@ namespace client {
 
     TrackerRemoteFactory::TrackerRemoteFactory(
         VRPNConnectionCollection const &conns)
-        : m_conns(conns) {}
+        : m_conns(conns), m_batchSources(make_shared<BatchSourceMap>()) {}
+
+    TrackerRemoteFactory::TrackerRemoteFactory(
+        VRPNConnectionCollection const &conns,
+        common::DirectReportDispatchPtr const &direct,
+        std::string const &directHost)
+        : m_conns(conns), m_direct(direct), m_directHost(directHost),
+          m_batchSources(make_shared<BatchSourceMap>()) {}
 
     shared_ptr<RemoteHandler> TrackerRemoteFactory::
     operator()(common::OriginalSource const &source,
@@ -304,10 +493,30 @@ namespace client {
             xform = xformParse.getTransform();
         }
 
+        /// Devices hosted by the in-process server report directly.
+        common::DirectTrackerChannelPtr direct;
+        if (m_direct && devElt.getServer() == m_directHost) {
+            direct = m_direct->getTrackerChannel(devElt.getDeviceName());
+        }
+
+        auto conn = m_conns.getConnection(devElt);
+        auto const &devName = devElt.getFullDeviceName();
+
+        /// Listen for batched poses with one decoder shared by all the
+        /// device's interfaces - even if its descriptor doesn't say it sends
+        /// them, so we can warn rather than silently dropping them.
+        auto &entry = (*m_batchSources)[devName];
+        auto batch = entry.lock();
+        if (!batch) {
+            batch = make_shared<TrackerBatchSource>(conn, devName.c_str(),
+                                                    ctx.logger());
+            entry = batch;
+        }
+
         /// @todo find out why make_shared causes a crash here
-        ret.reset(new VRPNTrackerHandler(
-            m_conns.getConnection(devElt), devElt.getFullDeviceName().c_str(),
-            opts, info, xform, source.getSensorNumber(), ifaces, ctx));
+        ret.reset(new VRPNTrackerHandler(conn, devName.c_str(), opts, info,
+                                         xform, source.getSensorNumber(),
+                                         ifaces, ctx, direct, batch));
         return ret;
     }
 
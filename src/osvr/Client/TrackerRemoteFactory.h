@@ -27,6 +27,7 @@
 
 // Internal Includes
 #include "VRPNConnectionCollection.h"
+#include <osvr/Common/DirectReportDispatch_fwd.h>
 #include <osvr/Common/InterfaceList.h>
 #include <osvr/Common/OriginalSource.h>
 #include <osvr/Util/SharedPtr.h>
@@ -38,15 +39,24 @@
 // - none
 
 // Standard includes
-// - none
+#include <map>
+#include <string>
 
 namespace osvr {
 namespace client {
+    class TrackerBatchSource;
 
     class TrackerRemoteFactory {
       public:
         TrackerRemoteFactory(VRPNConnectionCollection const &conns);
 
+        /// @brief Constructor for a factory whose handlers for devices on
+        /// @p directHost receive reports through @p direct rather than over
+        /// the connection.
+        TrackerRemoteFactory(VRPNConnectionCollection const &conns,
+                             common::DirectReportDispatchPtr const &direct,
+                             std::string const &directHost);
+
         template <typename T> void registerWith(T &factory) const {
             factory.addFactory("tracker", *this);
         }
@@ -57,6 +67,14 @@ namespace client {
 
       private:
         VRPNConnectionCollection m_conns;
+        common::DirectReportDispatchPtr m_direct;
+        std::string m_directHost;
+        /// @brief Batched pose sources by full device name, shared by the
+        /// handlers for all of a device's interfaces (and by copies of this
+        /// factory) while any of them is alive.
+        typedef std::map<std::string, weak_ptr<TrackerBatchSource> >
+            BatchSourceMap;
+        shared_ptr<BatchSourceMap> m_batchSources;
     };
 
 } // namespace client
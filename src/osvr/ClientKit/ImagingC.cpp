@@ -34,6 +34,6 @@
 
 OSVR_ReturnCode osvrClientFreeImage(OSVR_ClientContext ctx,
                                     OSVR_ImageBufferElement *buf) {
-    auto ret = ctx->releaseObject(buf);
+    auto ret = ctx->releaseImageBuffer(buf);
     return (ret ? OSVR_RETURN_SUCCESS : OSVR_RETURN_FAILURE);
 }
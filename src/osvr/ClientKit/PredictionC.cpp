@@ -0,0 +1,66 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/ClientKit/PredictionC.h>
+#include <osvr/Client/PosePrediction.h>
+#include <osvr/Common/ClientInterface.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <memory>
+
+OSVR_ReturnCode osvrGetPredictedPoseState(OSVR_ClientInterface iface,
+                                          struct OSVR_TimeValue const *target,
+                                          OSVR_PoseState *state) {
+    if (nullptr == iface || nullptr == target || nullptr == state) {
+        return OSVR_RETURN_FAILURE;
+    }
+    bool hasPose = osvr::client::getPredictedPose(*iface, *target, *state);
+    return hasPose ? OSVR_RETURN_SUCCESS : OSVR_RETURN_FAILURE;
+}
+
+OSVR_ReturnCode osvrGetPredictedPoseStates(OSVR_ClientInterface const *ifaces,
+                                           size_t count,
+                                           struct OSVR_TimeValue const *target,
+                                           OSVR_PoseState *states,
+                                           OSVR_CBool *hasPose) {
+    if (0 == count) {
+        return OSVR_RETURN_SUCCESS;
+    }
+    if (nullptr == ifaces || nullptr == target || nullptr == states) {
+        return OSVR_RETURN_FAILURE;
+    }
+    std::unique_ptr<bool[]> has(new bool[count]);
+    auto numWithPose = osvr::client::getPredictedPoses(ifaces, count, *target,
+                                                       states, has.get());
+    if (hasPose) {
+        for (size_t i = 0; i < count; ++i) {
+            hasPose[i] = has[i] ? OSVR_TRUE : OSVR_FALSE;
+        }
+    }
+    return numWithPose == count ? OSVR_RETURN_SUCCESS : OSVR_RETURN_FAILURE;
+}
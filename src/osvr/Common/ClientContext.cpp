@@ -144,6 +144,16 @@ bool OSVR_ClientContextObject::releaseObject(void *obj) {
     return m_ownedObjects.release(obj);
 }
 
+void OSVR_ClientContextObject::acquireImageBuffer(
+    osvr::shared_ptr<OSVR_ImageBufferElement> const &buf, std::size_t refs) {
+    m_imageBuffers.acquire(buf, refs);
+}
+
+bool OSVR_ClientContextObject::releaseImageBuffer(
+    OSVR_ImageBufferElement *buf) {
+    return m_imageBuffers.release(buf);
+}
+
 osvr::common::Transform const &
 OSVR_ClientContextObject::getRoomToWorldTransform() const {
     return m_getRoomToWorldTransform();
@@ -34,6 +34,11 @@
 
 namespace osvr {
 namespace common {
+    /// Comfortably more than any fixed-size report, so those never allocate
+    /// once warmed up, while a component that once sent a multi-megabyte
+    /// message doesn't keep that much around for its lifetime.
+    static const size_t MAX_RETAINED_SEND_BUFFER = 64 * 1024;
+
     DeviceComponent::DeviceComponent() : m_parent(nullptr) {}
 
     void DeviceComponent::recordParent(Parent &dev) {
@@ -51,6 +56,11 @@ namespace common {
         return *m_parent;
     }
 
+    Buffer<> &DeviceComponent::m_getSendBuffer() {
+        m_sendBuffer.clearAndTrim(MAX_RETAINED_SEND_BUFFER);
+        return m_sendBuffer;
+    }
+
     void DeviceComponent::m_registerHandler(vrpn_MESSAGEHANDLER handler,
                                             void *userdata,
                                             RawMessageType const &msgType) {
@@ -0,0 +1,69 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/Common/DirectReportDispatch.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace common {
+    TrackerReportSink::~TrackerReportSink() {}
+
+    DirectReportDispatchPtr DirectReportDispatch::create() {
+        DirectReportDispatchPtr ret(new DirectReportDispatch);
+        return ret;
+    }
+
+    DirectReportDispatch::DirectReportDispatch()
+        : m_state(make_shared<detail::DirectReportState>()) {}
+
+    DirectTrackerChannelPtr
+    DirectReportDispatch::getTrackerChannel(std::string const &deviceName) {
+        auto &channel = m_trackerChannels[deviceName];
+        if (!channel) {
+            channel.reset(new DirectTrackerChannel(m_state));
+        }
+        return channel;
+    }
+
+    void DirectReportDispatch::deliver() {
+        if (m_state->queue.empty()) {
+            return;
+        }
+        m_delivering.swap(m_state->queue);
+        /// Every channel stays in m_trackerChannels, so the pointers in the
+        /// reports are still good.
+        for (auto const &report : m_delivering) {
+            report.channel->m_deliver(report);
+        }
+        m_delivering.clear();
+    }
+} // namespace common
+} // namespace osvr
@@ -78,9 +78,9 @@ namespace common {
                                           OSVR_ChannelCount sensor,
                                           OSVR_TimeValue const &timestamp) {
 
-        Buffer<> buf;
+        auto &buf = m_getSendBuffer();
         messages::DirectionRecord::MessageSerialization msg(direction, sensor);
-        serialize(buf, msg);
+        serializeReusing(buf, msg);
 
         m_getParent().packMessage(buf, directionRecord.getMessageType(),
                                   timestamp);
@@ -73,12 +73,12 @@ namespace common {
     EyeTrackerComponent::sendNotification(OSVR_ChannelCount sensor,
                                           OSVR_TimeValue const &timestamp) {
 
-        Buffer<> buf;
+        auto &buf = m_getSendBuffer();
         OSVR_EyeNotification notification;
         notification.sensor = sensor;
         messages::EyeRegion::MessageSerialization msg(notification);
 
-        serialize(buf, msg);
+        serializeReusing(buf, msg);
 
         m_getParent().packMessage(buf, eyeRegion.getMessageType(), timestamp);
     }
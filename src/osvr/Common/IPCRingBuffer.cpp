@@ -36,6 +36,8 @@
 #include <boost/version.hpp>
 
 // Standard includes
+#include <atomic>
+#include <cstring>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
@@ -55,6 +57,13 @@ namespace common {
     /// that would interfere with communication.
     static IPCRingBuffer::abi_level_type SHM_SOURCE_ABI_LEVEL = 0;
 
+    /// @brief Flag combined with the ABI level to indicate the lock-free
+    /// layout (LockFreeBookkeeping, LockFreeElementData) - chosen so that
+    /// older clients, which only compare for equality with the level above,
+    /// decline such buffers rather than misinterpreting them.
+    static const IPCRingBuffer::abi_level_type SHM_LOCK_FREE_ABI_FLAG =
+        0x80000000;
+
 /// Some tests that can be automated for ensuring validity of the ABI level
 /// number.
 /// The base boost version test has been moved exclusively to CMake, to error
@@ -110,25 +119,46 @@ namespace common {
             size_t alignedEntrySize = opts.getEntrySize() + opts.getAlignment();
             size_t dataSize = alignedEntrySize * (opts.getEntries() + 1);
             // Give 33% overhead on the raw bookkeeping data
-            static const size_t BOOKKEEPING_SIZE =
-                (sizeof(detail::Bookkeeping) +
-                 (sizeof(detail::ElementData) * opts.getEntries())) *
+            const size_t BOOKKEEPING_SIZE =
+                (opts.getLockFree()
+                     ? (sizeof(detail::LockFreeBookkeeping) +
+                        (sizeof(detail::LockFreeElementData) *
+                         opts.getEntries()))
+                     : (sizeof(detail::Bookkeeping) +
+                        (sizeof(detail::ElementData) * opts.getEntries()))) *
                 4 / 3;
             return dataSize + BOOKKEEPING_SIZE;
         }
 
         class SharedMemorySegmentHolder {
           public:
-            SharedMemorySegmentHolder() : m_bookkeeping(nullptr) {}
+            SharedMemorySegmentHolder()
+                : m_bookkeeping(nullptr), m_lockFreeBookkeeping(nullptr) {}
             virtual ~SharedMemorySegmentHolder(){};
 
             detail::Bookkeeping *getBookkeeping() { return m_bookkeeping; }
+            detail::LockFreeBookkeeping *getLockFreeBookkeeping() {
+                return m_lockFreeBookkeeping;
+            }
+
+            /// @brief Whether either kind of bookkeeping was found/created.
+            /// @brief Whether the segment holds a ring buffer with at least
+            /// one entry: one whose entry buffers couldn't be allocated at
+            /// all is no use.
+            bool valid() const {
+                if (nullptr != m_lockFreeBookkeeping) {
+                    return 0 != m_lockFreeBookkeeping->getCapacity();
+                }
+                return nullptr != m_bookkeeping &&
+                       0 != m_bookkeeping->getCapacity();
+            }
 
             virtual uint64_t getSize() const = 0;
             virtual uint64_t getFreeMemory() const = 0;
 
           protected:
             detail::Bookkeeping *m_bookkeeping;
+            detail::LockFreeBookkeeping *m_lockFreeBookkeeping;
         };
 
         template <typename ManagedMemory>
@@ -168,12 +198,21 @@ namespace common {
                     return;
                 }
                 // detail::Bookkeeping::destroy(*Base::m_shm);
-                Base::m_bookkeeping =
-                    detail::Bookkeeping::construct(*Base::m_shm, opts);
+                if (opts.getLockFree()) {
+                    Base::m_lockFreeBookkeeping =
+                        detail::LockFreeBookkeeping::construct(*Base::m_shm,
+                                                               opts);
+                } else {
+                    Base::m_bookkeeping =
+                        detail::Bookkeeping::construct(*Base::m_shm, opts);
+                }
             }
 
             virtual ~ServerSharedMemorySegmentHolder() {
-                detail::Bookkeeping::destroy(*Base::m_shm);
+                if (Base::m_shm) {
+                    detail::Bookkeeping::destroy(*Base::m_shm);
+                    detail::LockFreeBookkeeping::destroy(*Base::m_shm);
+                }
                 removeSharedMemory();
             }
 
@@ -203,7 +242,13 @@ namespace common {
                         << opts.getName() << " with exception: " << e.what();
                     return;
                 }
-                Base::m_bookkeeping = detail::Bookkeeping::find(*Base::m_shm);
+                if (opts.getLockFree()) {
+                    Base::m_lockFreeBookkeeping =
+                        detail::LockFreeBookkeeping::find(*Base::m_shm);
+                } else {
+                    Base::m_bookkeeping =
+                        detail::Bookkeeping::find(*Base::m_shm);
+                }
             }
 
             virtual ~ClientSharedMemorySegmentHolder() {}
@@ -224,7 +269,7 @@ namespace common {
                 ret.reset(
                     new ClientSharedMemorySegmentHolder<ManagedMemory>(opts));
             }
-            if (nullptr == ret->getBookkeeping()) {
+            if (!ret->valid()) {
                 ret.reset();
             } else {
                 getIPCRingBufferLogger().debug()
@@ -295,21 +340,47 @@ namespace common {
         m_entrySize = entrySize;
         return *this;
     }
+
+    IPCRingBuffer::Options &IPCRingBuffer::Options::setLockFree(bool lockFree) {
+        m_lockFree = lockFree;
+        return *this;
+    }
+
     class IPCRingBuffer::Impl {
       public:
         Impl(unique_ptr<SharedMemorySegmentHolder> &&segment,
              Options const &opts)
-            : m_seg(std::move(segment)), m_bookkeeping(nullptr), m_opts(opts) {
+            : m_seg(std::move(segment)), m_bookkeeping(nullptr),
+              m_lockFreeBookkeeping(nullptr), m_opts(opts),
+              m_spareReadCopy(nullptr) {
             m_bookkeeping = m_seg->getBookkeeping();
-            m_opts.setEntries(m_bookkeeping->getCapacity());
-            m_opts.setEntrySize(m_bookkeeping->getBufferLength());
+            m_lockFreeBookkeeping = m_seg->getLockFreeBookkeeping();
+            m_opts.setLockFree(nullptr != m_lockFreeBookkeeping);
+            if (m_lockFreeBookkeeping) {
+                m_opts.setEntries(m_lockFreeBookkeeping->getCapacity());
+                m_opts.setEntrySize(m_lockFreeBookkeeping->getBufferLength());
+            } else {
+                m_opts.setEntries(m_bookkeeping->getCapacity());
+                m_opts.setEntrySize(m_bookkeeping->getBufferLength());
+            }
+        }
+
+        ~Impl() {
+            util::AlignedImageBufferPtr spare(
+                m_spareReadCopy.exchange(nullptr));
         }
 
         detail::IPCPutResultPtr put() {
+            if (m_lockFreeBookkeeping) {
+                return m_lockFreeBookkeeping->produceElement();
+            }
             return m_bookkeeping->produceElement();
         }
 
         detail::IPCGetResultPtr get(sequence_type num) {
+            if (m_lockFreeBookkeeping) {
+                return m_getLockFree(num);
+            }
             detail::IPCGetResultPtr ret;
             auto boundsLock = m_bookkeeping->getSharableLock();
             auto elt = m_bookkeeping->getBySequenceNumber(num, boundsLock);
@@ -324,6 +395,13 @@ namespace common {
         }
 
         detail::IPCGetResultPtr getLatest() {
+            if (m_lockFreeBookkeeping) {
+                sequence_type num;
+                if (!m_lockFreeBookkeeping->backSequenceNumber(num)) {
+                    return detail::IPCGetResultPtr();
+                }
+                return m_getLockFree(num);
+            }
             detail::IPCGetResultPtr ret;
             auto boundsLock = m_bookkeeping->getSharableLock();
             auto elt = m_bookkeeping->back(boundsLock);
@@ -341,10 +419,61 @@ namespace common {
         Options const &getOpts() const { return m_opts; }
 
       private:
+        /// @brief Seqlock-style read: copy the element out, then make sure the
+        /// producer didn't start overwriting it while we were copying.
+        detail::IPCGetResultPtr m_getLockFree(sequence_type num) {
+            detail::IPCGetResultPtr ret;
+            auto &elt = m_lockFreeBookkeeping->getBySequenceNumber(num);
+            detail::LockFreeElementData::version_type version;
+            if (!elt.beginRead(num, version)) {
+                return ret;
+            }
+            auto copy = m_takeReadCopy();
+            std::memcpy(copy.get(), elt.getBuf(), m_opts.getEntrySize());
+            if (!elt.validateRead(version)) {
+                m_recycleReadCopy(std::move(copy));
+                return ret;
+            }
+            auto buf = copy.get();
+            /// The nullptr will be filled in by the main object.
+            ret.reset(new detail::IPCGetResult{
+                buf, ipc::sharable_lock_type(), num, nullptr, std::move(copy),
+                [this](util::AlignedImageBufferPtr &&used) {
+                    m_recycleReadCopy(std::move(used));
+                }});
+            return ret;
+        }
+
+        /// @brief Gets a buffer to copy an entry into: the one the last
+        /// released read handed back, if any, so that a reader that lets go
+        /// of each entry before getting the next doesn't allocate.
+        util::AlignedImageBufferPtr m_takeReadCopy() {
+            util::AlignedImageBufferPtr ret(m_spareReadCopy.exchange(nullptr));
+            if (!ret) {
+                ret = util::makeAlignedImageBuffer(m_opts.getEntrySize(),
+                                                   m_opts.getAlignment());
+            }
+            return ret;
+        }
+
+        /// @brief Keeps a finished-with copy buffer for the next read, unless
+        /// one is already kept. (Read results hold a reference to our
+        /// IPCRingBuffer, so we outlive them.)
+        void m_recycleReadCopy(util::AlignedImageBufferPtr &&copy) {
+            OSVR_ImageBufferElement *expected = nullptr;
+            if (m_spareReadCopy.compare_exchange_strong(expected,
+                                                        copy.get())) {
+                copy.release();
+            }
+        }
+
         unique_ptr<SharedMemorySegmentHolder> m_seg;
         detail::Bookkeeping *m_bookkeeping;
+        detail::LockFreeBookkeeping *m_lockFreeBookkeeping;
 
         Options m_opts;
+        /// @brief Lock-free mode: a copy buffer kept for reuse, if any.
+        std::atomic<OSVR_ImageBufferElement *> m_spareReadCopy;
     };
 
     IPCRingBufferPtr IPCRingBuffer::m_constructorHelper(Options const &opts,
@@ -393,6 +522,24 @@ namespace common {
         return SHM_SOURCE_ABI_LEVEL;
     }
 
+    IPCRingBuffer::abi_level_type IPCRingBuffer::getABILevel(bool lockFree) {
+        return lockFree ? (SHM_SOURCE_ABI_LEVEL | SHM_LOCK_FREE_ABI_FLAG)
+                        : SHM_SOURCE_ABI_LEVEL;
+    }
+
+    bool IPCRingBuffer::isABILevelSupported(abi_level_type level,
+                                            bool &lockFree) {
+        if (level == getABILevel(false)) {
+            lockFree = false;
+            return true;
+        }
+        if (level == getABILevel(true)) {
+            lockFree = true;
+            return true;
+        }
+        return false;
+    }
+
     IPCRingBufferPtr IPCRingBuffer::create(Options const &opts) {
         return m_constructorHelper(opts, true);
     }
@@ -421,6 +568,14 @@ namespace common {
         return m_impl->getOpts().getEntries();
     }
 
+    bool IPCRingBuffer::getLockFree() const {
+        return m_impl->getOpts().getLockFree();
+    }
+
+    IPCRingBuffer::abi_level_type IPCRingBuffer::getSegmentABILevel() const {
+        return getABILevel(getLockFree());
+    }
+
     IPCRingBuffer::BufferWriteProxy IPCRingBuffer::put() {
         return BufferWriteProxy(m_impl->put(), shared_from_this());
     }
@@ -29,12 +29,14 @@
 #include <osvr/Common/IPCRingBuffer.h>
 #include "SharedMemory.h"
 #include "SharedMemoryObjectWithMutex.h"
+#include <osvr/Util/AlignedMemoryUniquePtr.h>
 
 // Library/third-party includes
 // - none
 
 // Standard includes
-// - none
+#include <functional>
+#include <utility>
 
 namespace osvr {
 namespace common {
@@ -46,14 +48,27 @@ namespace common {
                 OSVR_DEV_VERBOSE("Releasing exclusive lock on sequence "
                                  << seq);
 #endif
-                elementLock.unlock();
-                boundsLock.unlock();
+                if (commit) {
+                    commit();
+                }
+                if (elementLock.owns()) {
+                    elementLock.unlock();
+                }
+                if (boundsLock.owns()) {
+                    boundsLock.unlock();
+                }
             }
             IPCRingBuffer::value_type *buffer;
             IPCRingBuffer::sequence_type seq;
+            /// @brief Empty (not owning a mutex) in lock-free mode.
             ipc::exclusive_lock_type elementLock;
+            /// @brief Unused (not owning a mutex): the ring's lock is only held
+            /// while claiming an element, not while it's being filled.
             ipc::exclusive_lock_type boundsLock;
             IPCRingBufferPtr shm;
+            /// @brief Publishes the element to readers once the producer is
+            /// done writing it.
+            std::function<void()> commit;
         };
 
         struct IPCGetResult {
@@ -62,12 +77,23 @@ namespace common {
 #ifdef OSVR_SHM_LOCK_DEBUGGING
                 OSVR_DEV_VERBOSE("Releasing shared lock on sequence " << seq);
 #endif
-                elementLock.unlock();
+                if (elementLock.owns()) {
+                    elementLock.unlock();
+                }
+                if (ownedCopy && recycleCopy) {
+                    recycleCopy(std::move(ownedCopy));
+                }
             }
             IPCRingBuffer::value_type *buffer;
+            /// @brief Empty (not owning a mutex) in lock-free mode.
             ipc::sharable_lock_type elementLock;
             IPCRingBuffer::sequence_type seq;
             IPCRingBufferPtr shm;
+            /// @brief In lock-free mode, the private copy of the element that
+            /// `buffer` points to, validated against concurrent overwrite.
+            util::AlignedImageBufferPtr ownedCopy;
+            /// @brief Hands ownedCopy back to the reader for its next read.
+            std::function<void(util::AlignedImageBufferPtr &&)> recycleCopy;
         };
     } // namespace detail
 
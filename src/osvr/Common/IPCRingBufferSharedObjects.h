@@ -34,9 +34,11 @@
 #include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
+#include <boost/assert.hpp>
 #include <boost/noncopyable.hpp>
 
 // Standard includes
+#include <atomic>
 #include <utility>
 
 namespace osvr {
@@ -171,7 +173,7 @@ namespace common {
             template <typename LockType>
             sequence_type backSequenceNumber(LockType &lock) {
                 verifyReaderLock(lock);
-                return m_nextSequenceNumber - 1;
+                return m_beginSequenceNumber + m_size - 1;
             }
 
             template <typename LockType> ElementData *back(LockType &lock) {
@@ -182,6 +184,13 @@ namespace common {
                 return &getByRawIndex(m_begin + m_size - 1, lock);
             }
 
+            /// @brief Starts overwriting the oldest element (or the next
+            /// unused one).
+            ///
+            /// The ring's lock is only held while claiming the element: it's
+            /// taken out of the readable range first, so readers don't wait
+            /// on it while the producer fills it, and only added back (as the
+            /// newest element) once the returned result is released.
             IPCPutResultPtr produceElement() {
                 auto lock = getExclusiveLock();
                 auto sequenceNumber = m_nextSequenceNumber;
@@ -189,23 +198,40 @@ namespace common {
                 if (m_size == m_capacity) {
                     m_begin++;
                     m_beginSequenceNumber++;
-                } else {
-                    m_size++;
+                    m_size--;
                 }
+                auto &elt = getByRawIndex(m_begin + m_size, lock);
 #ifdef OSVR_SHM_LOCK_DEBUGGING
                 OSVR_DEV_VERBOSE(
                     "Attempting to get an exclusive lock on sequence "
-                    << sequenceNumber << " aka index " << back(lock));
+                    << sequenceNumber << " aka index " << &elt);
 #endif
-                auto elementLock = back(lock)->getExclusiveLock();
+                // Waits only for readers still holding the evicted element.
+                auto elementLock = elt.getExclusiveLock();
+                auto buf = elt.getBuf(elementLock);
+                lock.unlock();
                 /// shared memory nullptr filled in by outer class
                 IPCPutResultPtr ret(new IPCPutResult{
-                    back(lock)->getBuf(elementLock), sequenceNumber,
-                    std::move(elementLock), std::move(lock), nullptr});
+                    buf, sequenceNumber, std::move(elementLock),
+                    ipc::exclusive_lock_type(), nullptr,
+                    [this, sequenceNumber] { publish(sequenceNumber); }});
                 return ret;
             }
 
           private:
+            /// @brief Makes a filled element readable.
+            ///
+            /// Called with the element's lock still held: that's safe, since
+            /// readers can't reach the element (so can't be holding the
+            /// ring's lock while waiting on it) until this returns.
+            void publish(sequence_type seq) {
+                auto lock = getExclusiveLock();
+                // Single producer: this is always the next element in order.
+                BOOST_ASSERT(seq == m_beginSequenceNumber + m_size);
+                (void)seq;
+                m_size++;
+            }
+
             raw_index_type m_capacity;
             ipc_offset_ptr<ElementData> elementArray;
             IPCRingBuffer::sequence_type m_beginSequenceNumber;
@@ -214,6 +240,204 @@ namespace common {
             raw_index_type m_size;
             uint32_t m_bufLen;
         };
+
+        /// @brief Element bookkeeping for the lock-free (single-writer
+        /// seqlock) mode: instead of a mutex, each element carries a version
+        /// counter that is odd while the producer is writing, plus the
+        /// sequence number it currently holds.
+        class LockFreeElementData : boost::noncopyable {
+          public:
+            typedef IPCRingBuffer::value_type BufferType;
+            typedef IPCRingBuffer::sequence_type sequence_type;
+            typedef uint32_t version_type;
+
+            static_assert(ATOMIC_INT_LOCK_FREE == 2,
+                          "Lock-free shared memory mode requires always "
+                          "lock-free 32-bit atomics.");
+
+            LockFreeElementData() : m_version(0), m_seq(0), m_buf(nullptr) {}
+
+            BufferType *getBuf() const { return m_buf.get(); }
+
+            template <typename ManagedMemory>
+            void allocateBuf(ManagedMemory &shm,
+                             IPCRingBuffer::Options const &opts) {
+                freeBuf(shm);
+                m_buf = static_cast<BufferType *>(shm.allocate_aligned(
+                    opts.getEntrySize(), opts.getAlignment()));
+            }
+
+            template <typename ManagedMemory> void freeBuf(ManagedMemory &shm) {
+                if (nullptr != m_buf) {
+                    shm.deallocate(m_buf.get());
+                }
+                m_buf = nullptr;
+            }
+
+            /// @brief Producer only: mark the element as being overwritten
+            /// with the given sequence number.
+            void beginWrite(sequence_type seq) {
+                auto version = m_version.load(std::memory_order_relaxed);
+                m_version.store(version + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                m_seq.store(seq, std::memory_order_relaxed);
+            }
+
+            /// @brief Producer only: mark the element as stable again.
+            void endWrite() {
+                auto version = m_version.load(std::memory_order_relaxed);
+                m_version.store(version + 1, std::memory_order_release);
+            }
+
+            /// @brief Reader: snapshot the version before reading the buffer.
+            ///
+            /// @return false if the element does not (stably) hold the
+            /// requested sequence number right now.
+            bool beginRead(sequence_type seq, version_type &version) const {
+                version = m_version.load(std::memory_order_acquire);
+                if (0 == version || (version & 0x1) != 0) {
+                    // never written, or a write is in progress
+                    return false;
+                }
+                return m_seq.load(std::memory_order_relaxed) == seq;
+            }
+
+            /// @brief Reader: after reading the buffer, confirm the producer
+            /// didn't touch it in the meantime.
+            bool validateRead(version_type version) const {
+                std::atomic_thread_fence(std::memory_order_acquire);
+                return m_version.load(std::memory_order_relaxed) == version;
+            }
+
+          private:
+            std::atomic<version_type> m_version;
+            std::atomic<sequence_type> m_seq;
+            ipc_offset_ptr<BufferType> m_buf;
+        };
+
+        /// @brief Ring bookkeeping for the lock-free mode: the producer never
+        /// blocks and readers never take a lock, validating what they read
+        /// instead.
+        ///
+        /// There must only be a single producer per ring buffer.
+        class LockFreeBookkeeping : boost::noncopyable {
+          public:
+            typedef IPCRingBuffer::sequence_type sequence_type;
+            typedef uint16_t raw_index_type;
+
+            template <typename ManagedMemory>
+            static LockFreeBookkeeping *find(ManagedMemory &shm) {
+                auto self = shm.template find<LockFreeBookkeeping>(
+                    bip::unique_instance);
+                return self.first;
+            }
+
+            template <typename ManagedMemory>
+            static LockFreeBookkeeping *
+            construct(ManagedMemory &shm, IPCRingBuffer::Options const &opts) {
+                return shm.template construct<LockFreeBookkeeping>(
+                    bip::unique_instance)(shm, opts);
+            }
+
+            template <typename ManagedMemory>
+            static void destroy(ManagedMemory &shm) {
+                auto self = find(shm);
+                if (nullptr == self) {
+                    return;
+                }
+                self->freeBufs(shm);
+                shm.template destroy<LockFreeBookkeeping>(
+                    bip::unique_instance);
+            }
+
+            template <typename ManagedMemory>
+            LockFreeBookkeeping(ManagedMemory &shm,
+                                IPCRingBuffer::Options const &opts)
+                : m_capacity(opts.getEntries()),
+                  elementArray(shm.template construct<LockFreeElementData>(
+                      bip::unique_instance)[m_capacity]()),
+                  m_nextSequenceNumber(0), m_latestSequenceNumber(0),
+                  m_anyPublished(0), m_bufLen(opts.getEntrySize()) {
+                for (raw_index_type i = 0; i < m_capacity; ++i) {
+                    try {
+                        getByRawIndex(i).allocateBuf(shm, opts);
+                    } catch (std::bad_alloc &) {
+                        OSVR_DEV_VERBOSE("Couldn't allocate buffer #"
+                                         << i
+                                         << ", truncating the ring buffer");
+                        m_capacity = i;
+                        break;
+                    }
+                }
+            }
+
+            template <typename ManagedMemory>
+            void freeBufs(ManagedMemory &shm) {
+                for (raw_index_type i = 0; i < m_capacity; ++i) {
+                    getByRawIndex(i).freeBuf(shm);
+                }
+                shm.template destroy<LockFreeElementData>(bip::unique_instance);
+            }
+
+            /// @brief Get number of elements.
+            raw_index_type getCapacity() const { return m_capacity; }
+
+            /// @brief Get capacity of elements.
+            uint32_t getBufferLength() const { return m_bufLen; }
+
+            LockFreeElementData &getByRawIndex(raw_index_type index) {
+                return *(elementArray + (index % m_capacity));
+            }
+
+            /// @brief Gets the element that would hold the given sequence
+            /// number: whether it still does must be checked with
+            /// LockFreeElementData::beginRead()
+            LockFreeElementData &getBySequenceNumber(sequence_type num) {
+                return *(elementArray + (num % m_capacity));
+            }
+
+            /// @brief Gets the most recently published sequence number, if
+            /// any.
+            bool backSequenceNumber(sequence_type &num) const {
+                if (0 == m_anyPublished.load(std::memory_order_acquire)) {
+                    return false;
+                }
+                num = m_latestSequenceNumber.load(std::memory_order_acquire);
+                return true;
+            }
+
+            /// @brief Producer only: starts overwriting the oldest element.
+            /// Never blocks: readers in the middle of copying that element
+            /// will detect the overwrite and discard their copy.
+            IPCPutResultPtr produceElement() {
+                auto sequenceNumber = m_nextSequenceNumber;
+                m_nextSequenceNumber++;
+                auto &elt = getBySequenceNumber(sequenceNumber);
+                elt.beginWrite(sequenceNumber);
+                /// shared memory nullptr filled in by outer class
+                IPCPutResultPtr ret(new IPCPutResult{
+                    elt.getBuf(), sequenceNumber, ipc::exclusive_lock_type(),
+                    ipc::exclusive_lock_type(), nullptr,
+                    [this, &elt, sequenceNumber] {
+                        elt.endWrite();
+                        publish(sequenceNumber);
+                    }});
+                return ret;
+            }
+
+          private:
+            void publish(sequence_type num) {
+                m_latestSequenceNumber.store(num, std::memory_order_release);
+                m_anyPublished.store(1, std::memory_order_release);
+            }
+            raw_index_type m_capacity;
+            ipc_offset_ptr<LockFreeElementData> elementArray;
+            /// @brief Only touched by the (single) producer.
+            sequence_type m_nextSequenceNumber;
+            std::atomic<sequence_type> m_latestSequenceNumber;
+            std::atomic<uint32_t> m_anyPublished;
+            uint32_t m_bufLen;
+        };
     } // namespace detail
 
 } // namespace common
@@ -0,0 +1,71 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "ImageBufferPool.h"
+#include <osvr/Util/AlignedMemoryUniquePtr.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace common {
+    static inline ImageBufferPtr makeBuffer(std::size_t bytes) {
+        return ImageBufferPtr(util::makeAlignedImageBuffer(bytes).release(),
+                              &util::alignedFree);
+    }
+
+    ImageBufferPool::ImageBufferPool(std::size_t maxBuffers)
+        : m_maxBuffers(maxBuffers) {
+        m_entries.reserve(maxBuffers);
+    }
+
+    ImageBufferPtr ImageBufferPool::acquire(std::size_t bytes) {
+        Entry *freeOtherSize = nullptr;
+        for (auto &entry : m_entries) {
+            if (entry.buffer.use_count() != 1) {
+                continue;
+            }
+            if (entry.bytes == bytes) {
+                return entry.buffer;
+            }
+            freeOtherSize = freeOtherSize ? freeOtherSize : &entry;
+        }
+        if (freeOtherSize) {
+            // Image size changed: replace a buffer of the old size.
+            freeOtherSize->buffer = makeBuffer(bytes);
+            freeOtherSize->bytes = bytes;
+            return freeOtherSize->buffer;
+        }
+        if (m_entries.size() < m_maxBuffers) {
+            m_entries.push_back(Entry{makeBuffer(bytes), bytes});
+            return m_entries.back().buffer;
+        }
+        return makeBuffer(bytes);
+    }
+} // namespace common
+} // namespace osvr
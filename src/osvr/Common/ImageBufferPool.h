@@ -0,0 +1,79 @@
+/** @file
+    @brief Header
+
+    Internal to osvrCommon.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_ImageBufferPool_h_GUID_0D7B52E4_A1C3_4F68_B93E_5E2A81C6F7D0
+#define INCLUDED_ImageBufferPool_h_GUID_0D7B52E4_A1C3_4F68_B93E_5E2A81C6F7D0
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Common/ImagingComponent.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <vector>
+
+namespace osvr {
+namespace common {
+    /// @brief Recycles the aligned buffers that received images are placed
+    /// in, so a steady stream of same-sized frames doesn't allocate.
+    ///
+    /// The pool keeps its own reference to each buffer it hands out: a buffer
+    /// is free again once that's the only reference left, which is to say
+    /// once every callback and client holding the image has let go. Only the
+    /// pool can hand out new references, so seeing a use count of one can't
+    /// race with anyone else's release.
+    ///
+    /// Buffers still in use when the pool is destroyed are freed as usual
+    /// when their last reference goes away.
+    class ImageBufferPool : boost::noncopyable {
+      public:
+        static const std::size_t DEFAULT_MAX_BUFFERS = 8;
+
+        OSVR_COMMON_EXPORT explicit ImageBufferPool(
+            std::size_t maxBuffers = DEFAULT_MAX_BUFFERS);
+
+        /// @brief Gets a buffer of the given size, reusing a free one if
+        /// possible.
+        ///
+        /// If every pooled buffer is in use and the pool is full, returns a
+        /// buffer that isn't pooled.
+        OSVR_COMMON_EXPORT ImageBufferPtr acquire(std::size_t bytes);
+
+      private:
+        struct Entry {
+            ImageBufferPtr buffer;
+            std::size_t bytes;
+        };
+        std::vector<Entry> m_entries;
+        std::size_t m_maxBuffers;
+    };
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_ImageBufferPool_h_GUID_0D7B52E4_A1C3_4F68_B93E_5E2A81C6F7D0
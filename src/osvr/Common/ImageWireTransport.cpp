@@ -0,0 +1,408 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "ImageWireTransport.h"
+#include "ImageBufferPool.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace osvr {
+namespace common {
+    namespace image_wire {
+        OSVR_ImageBufferElement const *
+        reduceImage(OSVR_ImagingMetadata &meta,
+                    OSVR_ImageBufferElement const *data,
+                    NetworkImageStreamOptions const &opts,
+                    std::vector<OSVR_ImageBufferElement> &scratch) {
+            // Clip the region of interest to the image.
+            uint32_t x0 = std::min<uint32_t>(opts.roiX, meta.width);
+            uint32_t y0 = std::min<uint32_t>(opts.roiY, meta.height);
+            uint32_t w = meta.width - x0;
+            uint32_t h = meta.height - y0;
+            if (opts.roiWidth != 0) {
+                w = std::min(w, opts.roiWidth);
+            }
+            if (opts.roiHeight != 0) {
+                h = std::min(h, opts.roiHeight);
+            }
+            uint32_t step = std::max<uint32_t>(opts.downscale, 1);
+            if (x0 == 0 && y0 == 0 && w == meta.width && h == meta.height &&
+                step == 1) {
+                return data;
+            }
+            // Round up, so an image smaller than the step still has a pixel.
+            uint32_t outW = (w + step - 1) / step;
+            uint32_t outH = (h + step - 1) / step;
+            std::size_t pixelBytes = std::size_t(meta.channels) * meta.depth;
+            std::size_t inStride = meta.width * pixelBytes;
+
+            scratch.resize(std::size_t(outW) * outH * pixelBytes);
+            auto dest = scratch.data();
+            for (uint32_t y = 0; y < outH; ++y) {
+                auto row = data + (y0 + y * step) * inStride + x0 * pixelBytes;
+                if (step == 1) {
+                    std::memcpy(dest, row, outW * pixelBytes);
+                    dest += outW * pixelBytes;
+                    continue;
+                }
+                for (uint32_t x = 0; x < outW; ++x) {
+                    std::memcpy(dest, row + x * step * pixelBytes, pixelBytes);
+                    dest += pixelBytes;
+                }
+            }
+            meta.width = outW;
+            meta.height = outH;
+            return scratch.data();
+        }
+
+        /// @name RowDelta encoding
+        ///
+        /// Each byte is replaced by its difference (mod 256) from the same
+        /// byte of the pixel to its left, which turns flat areas - like the
+        /// dark background of a tracking camera frame - into runs of zero.
+        /// The differences are then written as a series of runs, each
+        /// starting with a control byte:
+        ///
+        /// - 0x00-0x7f: n + 1 literal bytes follow
+        /// - 0x80-0xfe: a run of (n - 0x80) + 1 zero bytes
+        /// - 0xff: a run of zero bytes, with the length in the following 4
+        /// bytes (little-endian)
+        /// @{
+        static const std::size_t MAX_LITERAL_RUN = 0x80;
+        static const std::size_t MAX_SHORT_ZERO_RUN = 0x7f;
+        static const unsigned char LONG_ZERO_RUN = 0xff;
+
+        static inline void appendZeroRun(std::vector<char> &out,
+                                         std::size_t n) {
+            if (n <= MAX_SHORT_ZERO_RUN) {
+                out.push_back(static_cast<char>(0x80 + n - 1));
+                return;
+            }
+            out.push_back(static_cast<char>(LONG_ZERO_RUN));
+            for (int i = 0; i < 4; ++i) {
+                out.push_back(static_cast<char>((n >> (8 * i)) & 0xff));
+            }
+        }
+
+        static inline void appendLiterals(std::vector<char> &out,
+                                          unsigned char const *begin,
+                                          std::size_t n) {
+            while (n > 0) {
+                auto count = std::min(n, MAX_LITERAL_RUN);
+                out.push_back(static_cast<char>(count - 1));
+                out.insert(out.end(), begin, begin + count);
+                begin += count;
+                n -= count;
+            }
+        }
+
+        /// Encodes, giving up (and returning false) as soon as the output
+        /// reaches the raw size.
+        static bool encodeRowDelta(OSVR_ImagingMetadata const &meta,
+                                   unsigned char const *data,
+                                   std::vector<char> &out) {
+            auto rawSize = getImageBufferSize(meta);
+            std::size_t pixelBytes = std::size_t(meta.channels) * meta.depth;
+            std::size_t stride = meta.width * pixelBytes;
+            /// Differences of the current row, so runs can be found in it.
+            std::vector<unsigned char> deltas(stride);
+            std::size_t zeroRun = 0;
+            for (std::size_t y = 0; y < meta.height; ++y) {
+                auto row = data + y * stride;
+                std::copy(row, row + std::min(pixelBytes, stride),
+                          deltas.begin());
+                for (std::size_t i = pixelBytes; i < stride; ++i) {
+                    deltas[i] = static_cast<unsigned char>(
+                        row[i] - row[i - pixelBytes]);
+                }
+                std::size_t i = 0;
+                while (i < stride) {
+                    if (deltas[i] == 0) {
+                        ++zeroRun;
+                        ++i;
+                        continue;
+                    }
+                    if (zeroRun > 0) {
+                        appendZeroRun(out, zeroRun);
+                        zeroRun = 0;
+                    }
+                    // Literals run until the next pair of zeros: a lone zero
+                    // is cheaper kept as a literal.
+                    auto begin = i;
+                    while (i < stride &&
+                           !(deltas[i] == 0 && i + 1 < stride &&
+                             deltas[i + 1] == 0)) {
+                        ++i;
+                    }
+                    appendLiterals(out, &deltas[begin], i - begin);
+                }
+                if (out.size() >= rawSize) {
+                    return false;
+                }
+            }
+            if (zeroRun > 0) {
+                appendZeroRun(out, zeroRun);
+            }
+            return out.size() < rawSize;
+        }
+
+        static bool decodeRowDelta(OSVR_ImagingMetadata const &meta,
+                                   unsigned char const *in,
+                                   std::size_t inLength,
+                                   unsigned char *out) {
+            auto rawSize = getImageBufferSize(meta);
+            auto inEnd = in + inLength;
+            std::size_t pos = 0;
+            while (in != inEnd) {
+                unsigned char control = *in++;
+                if (control < 0x80) {
+                    std::size_t n = control + 1u;
+                    if (std::size_t(inEnd - in) < n || rawSize - pos < n) {
+                        return false;
+                    }
+                    std::copy(in, in + n, out + pos);
+                    in += n;
+                    pos += n;
+                    continue;
+                }
+                std::size_t n = control - 0x80 + 1u;
+                if (control == LONG_ZERO_RUN) {
+                    if (inEnd - in < 4) {
+                        return false;
+                    }
+                    n = 0;
+                    for (int i = 0; i < 4; ++i) {
+                        n |= std::size_t(in[i]) << (8 * i);
+                    }
+                    in += 4;
+                }
+                if (rawSize - pos < n) {
+                    return false;
+                }
+                std::fill(out + pos, out + pos + n, 0);
+                pos += n;
+            }
+            if (pos != rawSize) {
+                return false;
+            }
+            // Undo the differences, row by row.
+            std::size_t pixelBytes = std::size_t(meta.channels) * meta.depth;
+            std::size_t stride = meta.width * pixelBytes;
+            for (std::size_t y = 0; y < meta.height; ++y) {
+                auto row = out + y * stride;
+                for (std::size_t i = pixelBytes; i < stride; ++i) {
+                    row[i] = static_cast<unsigned char>(row[i] +
+                                                        row[i - pixelBytes]);
+                }
+            }
+            return true;
+        }
+        /// @}
+
+        ImageWireEncoding encodeImage(ImageWireEncoding encoding,
+                                      OSVR_ImagingMetadata const &meta,
+                                      OSVR_ImageBufferElement const *data,
+                                      std::vector<char> &out) {
+            out.clear();
+            if (encoding == ImageWireEncoding::RowDelta) {
+                if (encodeRowDelta(meta, data, out)) {
+                    return encoding;
+                }
+                out.clear();
+            }
+            out.insert(out.end(), data, data + getImageBufferSize(meta));
+            return ImageWireEncoding::Raw;
+        }
+
+        bool decodeImage(ImageWireEncoding encoding,
+                         OSVR_ImagingMetadata const &meta, char const *in,
+                         std::size_t inLength, OSVR_ImageBufferElement *out) {
+            auto uin = reinterpret_cast<unsigned char const *>(in);
+            switch (encoding) {
+            case ImageWireEncoding::Raw:
+                if (inLength != getImageBufferSize(meta)) {
+                    return false;
+                }
+                std::copy(uin, uin + inLength, out);
+                return true;
+            case ImageWireEncoding::RowDelta:
+                return decodeRowDelta(meta, uin, inLength, out);
+            }
+            return false;
+        }
+
+        void FrameChunker::startFrame(ChunkHeader const &header) {
+            if (m_inFlight) {
+                ++m_abandoned;
+            }
+            m_header = header;
+            m_header.encodedSize = static_cast<uint32_t>(m_encoded.size());
+            m_header.offset = 0;
+            m_header.length = 0;
+            m_inFlight = true;
+        }
+
+        bool FrameChunker::nextChunk(uint32_t maxLength, ChunkHeader &header,
+                                     char const *&bytes) {
+            if (!m_inFlight) {
+                return false;
+            }
+            m_header.offset += m_header.length;
+            m_header.length =
+                std::min(m_header.encodedSize - m_header.offset, maxLength);
+            header = m_header;
+            bytes = m_encoded.data() + m_header.offset;
+            // An empty frame still gets its one (empty) chunk.
+            if (m_header.offset + m_header.length >= m_header.encodedSize) {
+                m_inFlight = false;
+            }
+            return true;
+        }
+
+        /// Whether two chunks agree on the frame they belong to.
+        static bool sameFrameLayout(ChunkHeader const &a,
+                                    ChunkHeader const &b) {
+            return a.encoding == b.encoding &&
+                   a.encodedSize == b.encodedSize &&
+                   a.metadata.height == b.metadata.height &&
+                   a.metadata.width == b.metadata.width &&
+                   a.metadata.channels == b.metadata.channels &&
+                   a.metadata.depth == b.metadata.depth &&
+                   a.metadata.type == b.metadata.type;
+        }
+
+        /// Adds [begin, end) to the sorted, merged ranges, merging it with
+        /// any it overlaps or touches.
+        static void
+        addReceivedRange(std::vector<std::pair<uint32_t, uint32_t> > &ranges,
+                         uint32_t begin, uint32_t end) {
+            typedef std::pair<uint32_t, uint32_t> Range;
+            // First range that ends at or after our start.
+            auto first = std::lower_bound(
+                ranges.begin(), ranges.end(), begin,
+                [](Range const &r, uint32_t val) { return r.second < val; });
+            auto last = first;
+            while (last != ranges.end() && last->first <= end) {
+                begin = std::min(begin, last->first);
+                end = std::max(end, last->second);
+                ++last;
+            }
+            first = ranges.erase(first, last);
+            ranges.insert(first, Range(begin, end));
+        }
+
+        FrameReassembler::FrameReassembler(ImageBufferPool &pool,
+                                           std::size_t maxFrames)
+            : m_pool(pool), m_slots(std::max<std::size_t>(maxFrames, 1)) {}
+
+        bool FrameReassembler::addChunk(ChunkHeader const &header,
+                                        char const *bytes, ImageData &data) {
+            // Neither encoding ever produces more than the raw image size.
+            if (header.encodedSize > getImageBufferSize(header.metadata) ||
+                header.offset > header.encodedSize ||
+                header.length > header.encodedSize - header.offset) {
+                return false;
+            }
+            auto slot = m_findOrStartFrame(header);
+            if (!slot || !sameFrameLayout(header, slot->header)) {
+                // A chunk disagreeing with the rest of its frame about its
+                // size could otherwise write past the end of the buffer.
+                return false;
+            }
+            std::copy(bytes, bytes + header.length,
+                      slot->encoded.begin() + header.offset);
+            auto &received = slot->received;
+            addReceivedRange(received, header.offset,
+                             header.offset + header.length);
+            if (received.size() != 1 || received.front().first != 0 ||
+                received.front().second != slot->header.encodedSize) {
+                return false;
+            }
+
+            auto &meta = slot->header.metadata;
+            auto buf = m_pool.acquire(getImageBufferSize(meta));
+            bool ok = decodeImage(slot->header.encoding, meta,
+                                  slot->encoded.data(), slot->encoded.size(),
+                                  buf.get());
+            if (!ok) {
+                m_drop(*slot);
+                return false;
+            }
+            data.sensor = slot->header.sensor;
+            data.metadata = meta;
+            data.buffer = std::move(buf);
+            slot->inUse = false;
+            return true;
+        }
+
+        FrameReassembler::Slot *
+        FrameReassembler::m_findOrStartFrame(ChunkHeader const &header) {
+            Slot *free = nullptr;
+            Slot *oldest = nullptr;
+            for (auto &slot : m_slots) {
+                if (!slot.inUse) {
+                    free = free ? free : &slot;
+                    continue;
+                }
+                if (slot.header.sensor == header.sensor) {
+                    if (slot.header.frameSeq == header.frameSeq) {
+                        return &slot;
+                    }
+                    // Older frame from this sensor that never finished.
+                    m_drop(slot);
+                    free = free ? free : &slot;
+                    continue;
+                }
+                if (!oldest || slot.startOrder < oldest->startOrder) {
+                    oldest = &slot;
+                }
+            }
+            if (!free) {
+                m_drop(*oldest);
+                free = oldest;
+            }
+            free->inUse = true;
+            free->header = header;
+            free->received.clear();
+            free->startOrder = ++m_framesStarted;
+            // Keeps its capacity from earlier frames, so this rarely
+            // allocates once things are going.
+            free->encoded.resize(header.encodedSize);
+            return free;
+        }
+
+        void FrameReassembler::m_drop(Slot &slot) {
+            slot.inUse = false;
+            ++m_dropped;
+        }
+    } // namespace image_wire
+} // namespace common
+} // namespace osvr
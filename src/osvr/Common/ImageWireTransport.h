@@ -0,0 +1,212 @@
+/** @file
+    @brief Header for the pieces of sending images over the network that
+    don't depend on the connection: stream reduction, compression, and
+    reassembly of frames sent in chunks.
+
+    Internal to osvrCommon, used by ImagingComponent (exported only for
+    the tests).
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_ImageWireTransport_h_GUID_6F1A3C92_4B7E_4D05_9E28_D3A1B57C0E64
+#define INCLUDED_ImageWireTransport_h_GUID_6F1A3C92_4B7E_4D05_9E28_D3A1B57C0E64
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Common/ImagingComponent.h>
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace osvr {
+namespace common {
+    class ImageBufferPool;
+    namespace image_wire {
+        /// @brief Bytes in an image described by the metadata.
+        inline std::size_t
+        getImageBufferSize(OSVR_ImagingMetadata const &meta) {
+            return std::size_t(meta.height) * meta.width * meta.depth *
+                   meta.channels;
+        }
+
+        /// @brief Applies the region of interest and downscaling of a stream
+        /// to an image.
+        ///
+        /// @param[in,out] meta Metadata of the image, updated to describe the
+        /// reduced image.
+        /// @param data The image.
+        /// @param scratch Storage for the reduced image, if reduction is
+        /// needed.
+        /// @return data, if the options leave the image unchanged, otherwise
+        /// a pointer into scratch.
+        OSVR_COMMON_EXPORT OSVR_ImageBufferElement const *
+        reduceImage(OSVR_ImagingMetadata &meta,
+                    OSVR_ImageBufferElement const *data,
+                    NetworkImageStreamOptions const &opts,
+                    std::vector<OSVR_ImageBufferElement> &scratch);
+
+        /// @brief Encodes an image (described by meta) with the given
+        /// encoding, replacing the contents of out.
+        ///
+        /// @return the encoding actually used: RowDelta falls back to Raw if
+        /// it wouldn't make the image any smaller.
+        OSVR_COMMON_EXPORT ImageWireEncoding
+        encodeImage(ImageWireEncoding encoding,
+                    OSVR_ImagingMetadata const &meta,
+                    OSVR_ImageBufferElement const *data,
+                    std::vector<char> &out);
+
+        /// @brief Decodes an image produced by encodeImage() into out, which
+        /// must have room for getImageBufferSize(meta) bytes.
+        ///
+        /// @return false if the encoded data is malformed.
+        OSVR_COMMON_EXPORT bool
+        decodeImage(ImageWireEncoding encoding,
+                    OSVR_ImagingMetadata const &meta, char const *in,
+                    std::size_t inLength, OSVR_ImageBufferElement *out);
+
+        /// @brief What each chunk of a frame carries, besides its bytes.
+        struct ChunkHeader {
+            OSVR_ChannelCount sensor;
+            /// @brief Per-sensor frame counter, identifying the frame a chunk
+            /// belongs to.
+            uint32_t frameSeq;
+            /// @brief Metadata of the (possibly reduced) image.
+            OSVR_ImagingMetadata metadata;
+            ImageWireEncoding encoding;
+            /// @brief Total size of the encoded frame.
+            uint32_t encodedSize;
+            /// @brief Where this chunk's bytes go in the encoded frame.
+            uint32_t offset;
+            uint32_t length;
+        };
+
+        /// @brief Server side: holds the encoded frame being sent for a
+        /// sensor and hands out its chunks a few at a time, so a large frame
+        /// goes out over several passes through the server loop instead of
+        /// holding up one of them until every byte is written.
+        ///
+        /// Starting a frame abandons whatever is left of the previous one:
+        /// clients drop that partial frame once the new one arrives, so a
+        /// connection that can't keep up gets fewer frames instead of
+        /// falling further and further behind.
+        class FrameChunker {
+          public:
+            /// @brief Storage to encode the next frame into, before calling
+            /// startFrame().
+            std::vector<char> &getEncodeBuffer() { return m_encoded; }
+
+            /// @brief Starts sending the frame now in the encode buffer.
+            ///
+            /// @param header Describes the frame: its size and chunk fields
+            /// are filled in here.
+            OSVR_COMMON_EXPORT void startFrame(ChunkHeader const &header);
+
+            /// @brief Gets the next chunk of the current frame, if any.
+            ///
+            /// @param maxLength Largest chunk payload to hand out.
+            /// @param[out] header Header for the chunk.
+            /// @param[out] bytes The chunk's payload, valid until the next
+            /// startFrame().
+            /// @return false if there's nothing left to send.
+            OSVR_COMMON_EXPORT bool nextChunk(uint32_t maxLength,
+                                              ChunkHeader &header,
+                                              char const *&bytes);
+
+            /// @brief Whether some of the current frame is still unsent.
+            bool inFlight() const { return m_inFlight; }
+
+            /// @brief Number of frames abandoned before all was sent.
+            std::size_t getAbandonedFrames() const { return m_abandoned; }
+
+          private:
+            std::vector<char> m_encoded;
+            ChunkHeader m_header;
+            bool m_inFlight = false;
+            std::size_t m_abandoned = 0;
+        };
+
+        /// @brief Client side: collects the chunks of frames into a fixed
+        /// number of reusable buffers, decoding each frame when it's
+        /// complete into a buffer from the given pool.
+        ///
+        /// When a chunk of a new frame arrives and all buffers are busy, the
+        /// oldest partial frame is dropped to make room. A partial frame is
+        /// also dropped as soon as a chunk of a newer frame for the same
+        /// sensor arrives, since it's stale by then. Either way, memory use
+        /// stays bounded no matter how far behind a client falls.
+        class FrameReassembler {
+          public:
+            static const std::size_t DEFAULT_MAX_FRAMES = 4;
+
+            OSVR_COMMON_EXPORT explicit FrameReassembler(
+                ImageBufferPool &pool,
+                std::size_t maxFrames = DEFAULT_MAX_FRAMES);
+
+            /// @brief Adds a chunk.
+            ///
+            /// Chunks that don't fit in their frame, or that describe the
+            /// frame differently than its first chunk did, are ignored. A
+            /// frame is complete once every byte of it has arrived, however
+            /// many times some of them did.
+            ///
+            /// @return true if it completed a frame, which is then decoded
+            /// into data.
+            OSVR_COMMON_EXPORT bool addChunk(ChunkHeader const &header,
+                                             char const *bytes,
+                                             ImageData &data);
+
+            /// @brief Number of frames dropped before they were complete (or
+            /// because they couldn't be decoded).
+            std::size_t getDroppedFrames() const { return m_dropped; }
+
+          private:
+            struct Slot {
+                bool inUse = false;
+                ChunkHeader header;
+                /// @brief The [begin, end) byte ranges of the encoded frame
+                /// received so far, sorted, with touching ranges merged.
+                std::vector<std::pair<uint32_t, uint32_t> > received;
+                /// @brief Order in which frames were started, for finding
+                /// the oldest.
+                uint64_t startOrder = 0;
+                std::vector<char> encoded;
+            };
+            Slot *m_findOrStartFrame(ChunkHeader const &header);
+            void m_drop(Slot &slot);
+
+            ImageBufferPool &m_pool;
+            std::vector<Slot> m_slots;
+            uint64_t m_framesStarted = 0;
+            std::size_t m_dropped = 0;
+        };
+    } // namespace image_wire
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_ImageWireTransport_h_GUID_6F1A3C92_4B7E_4D05_9E28_D3A1B57C0E64
@@ -23,6 +23,8 @@
 // limitations under the License.
 
 // Internal Includes
+#include "ImageBufferPool.h"
+#include "ImageWireTransport.h"
 #include <osvr/Common/ImagingComponent.h>
 #include <osvr/Common/BaseDevice.h>
 #include <osvr/Common/Serialization.h>
@@ -35,6 +37,7 @@
 // - none
 
 // Standard includes
+#include <algorithm>
 #include <sstream>
 #include <utility>
 
@@ -68,11 +71,13 @@ namespace common {
                            }), // That's a null-deleter right there for you.
                   m_sensor(sensor) {}
 
-            MessageSerialization() : m_imgBuf(nullptr) {}
+            /// @brief For deserializing into a buffer from the pool.
+            explicit MessageSerialization(ImageBufferPool &pool)
+                : m_imgBuf(nullptr), m_pool(&pool) {}
 
             template <typename T>
             void allocateBuffer(T &, size_t bytes, std::true_type const &) {
-                m_imgBuf = util::makeAlignedImageBuffer(bytes);
+                m_imgBuf = m_pool->acquire(bytes);
             }
 
             template <typename T>
@@ -102,6 +107,7 @@ namespace common {
             OSVR_ImagingMetadata m_meta;
             ImageBufferPtr m_imgBuf;
             OSVR_ChannelCount m_sensor;
+            ImageBufferPool *m_pool = nullptr;
         };
         const char *ImageRegion::identifier() {
             return "com.osvr.imaging.imageregion";
@@ -193,15 +199,148 @@ namespace common {
         const char *ImagePlacedInSharedMemory::identifier() {
             return "com.osvr.imaging.imageplacedinsharedmemory";
         }
+
+        namespace {
+            typedef serialization::EnumAsIntegerTag<ImageWireEncoding,
+                                                    uint8_t>
+                EncodingTag;
+        } // namespace
+
+        /// The chunk's bytes follow the header directly. They're only
+        /// written by this class: the receiver reads them in place with
+        /// getPayload() instead of copying them out.
+        class ImageChunk::MessageSerialization {
+          public:
+            MessageSerialization() {}
+            MessageSerialization(image_wire::ChunkHeader const &header,
+                                 char const *payload)
+                : m_header(header), m_payload(payload) {}
+
+            template <typename T> void processMessage(T &p) {
+                p(m_header.sensor);
+                p(m_header.frameSeq);
+                process(m_header.metadata, p);
+                p(m_header.encoding, EncodingTag());
+                p(m_header.encodedSize);
+                p(m_header.offset);
+                p(m_header.length);
+                processPayload(p, p.isDeserialize());
+            }
+
+            template <typename T>
+            void processPayload(T &p, std::false_type const &) {
+                p(m_payload,
+                  serialization::AlignedDataBufferTag(m_header.length, 1));
+            }
+
+            template <typename T>
+            void processPayload(T &, std::true_type const &) {}
+
+            template <typename BufferReaderType>
+            char const *getPayload(BufferReaderType &reader) const {
+                return reader.readBytes(m_header.length);
+            }
+
+            image_wire::ChunkHeader const &getHeader() const {
+                return m_header;
+            }
+
+          private:
+            image_wire::ChunkHeader m_header;
+            char const *m_payload = nullptr;
+        };
+
+        const char *ImageChunk::identifier() {
+            return "com.osvr.imaging.imagechunk";
+        }
+
+        class ImageStreamRequest::MessageSerialization {
+          public:
+            MessageSerialization() {}
+            MessageSerialization(OSVR_ChannelCount sensor,
+                                 NetworkImageStreamOptions const &opts)
+                : m_sensor(sensor), m_opts(opts) {}
+
+            template <typename T> void processMessage(T &p) {
+                p(m_sensor);
+                p(m_opts.encoding, EncodingTag());
+                p(m_opts.downscale);
+                p(m_opts.roiX);
+                p(m_opts.roiY);
+                p(m_opts.roiWidth);
+                p(m_opts.roiHeight);
+            }
+
+            OSVR_ChannelCount getSensor() const { return m_sensor; }
+            NetworkImageStreamOptions const &getOptions() const {
+                return m_opts;
+            }
+
+          private:
+            OSVR_ChannelCount m_sensor = 0;
+            NetworkImageStreamOptions m_opts;
+        };
+
+        const char *ImageStreamRequest::identifier() {
+            return "com.osvr.imaging.imagestreamrequest";
+        }
     } // namespace messages
 
+    /// Leaves room in each VRPN message for the chunk header and VRPN's own.
+    static const uint32_t MAX_CHUNK_PAYLOAD = vrpn_CONNECTION_TCP_BUFLEN - 1024;
+
+    /// Chunks of a sensor's frame sent per pass through the server loop.
+    /// Each one about fills VRPN's outgoing buffer, so this bounds how long a
+    /// pass can be held up writing to a slow client.
+    static const std::size_t CHUNKS_PER_UPDATE = 2;
+
+    /// When the device didn't say how many sensors it has, stream requests
+    /// naming a sensor at or above this are ignored, as a client could
+    /// otherwise make us allocate per-sensor state for any index it likes.
+    static const OSVR_ChannelCount MAX_REQUESTABLE_SENSORS = 256;
+
     shared_ptr<ImagingComponent>
     ImagingComponent::create(OSVR_ChannelCount numChan) {
         shared_ptr<ImagingComponent> ret(new ImagingComponent(numChan));
         return ret;
     }
     ImagingComponent::ImagingComponent(OSVR_ChannelCount numChan)
-        : m_numSensor(numChan) {}
+        : m_numSensor(numChan), m_gotOne(false),
+#ifdef OSVR_COMMON_LOCK_FREE_SHM_IMAGING
+          m_lockFreeShm(true)
+#else
+          m_lockFreeShm(false)
+#endif
+    {
+    }
+
+    ImagingComponent::~ImagingComponent() {}
+
+    void ImagingComponent::setLockFreeSharedMemory(bool lockFree) {
+        m_lockFreeShm = lockFree;
+    }
+
+    void ImagingComponent::setNetworkImageStream(
+        OSVR_ChannelCount sensor, NetworkImageStreamOptions const &opts) {
+        m_growWireStreamVecIfRequired(sensor);
+        m_wireStreams[sensor].requested = true;
+        m_wireStreams[sensor].options = opts;
+    }
+
+    void ImagingComponent::requestNetworkImageStream(
+        OSVR_ChannelCount sensor, NetworkImageStreamOptions const &opts) {
+        if (sensor < MAX_REQUESTABLE_SENSORS) {
+            if (m_streamRequests.size() <= sensor) {
+                m_streamRequests.resize(sensor + 1, StreamRequest::None);
+            }
+            m_streamRequests[sensor] = StreamRequest::Sent;
+        }
+        auto &buf = m_getSendBuffer();
+        messages::ImageStreamRequest::MessageSerialization msg(sensor, opts);
+        serializeReusing(buf, msg);
+        m_getParent().packMessage(buf, imageStreamRequest.getMessageType());
+        m_getParent().sendPending();
+    }
 
     void ImagingComponent::sendImageData(OSVR_ImagingMetadata metadata,
                                          OSVR_ImageBufferElement *imageData,
@@ -224,6 +363,72 @@ namespace common {
         }
     }
 
+    OSVR_ImageBufferElement *
+    ImagingComponent::reserveImageFrame(OSVR_ImagingMetadata const &metadata,
+                                        OSVR_ChannelCount sensor) {
+        m_growPendingVecIfRequired(sensor);
+        auto &frame = m_pendingFrames[sensor];
+        // Drop any reservation that was never committed.
+        frame = PendingFrame{};
+
+#ifdef OSVR_COMMON_IN_PROCESS_IMAGING
+        frame.ownedBuffer =
+            util::makeAlignedImageBuffer(getBufferSize(metadata));
+        frame.buffer = frame.ownedBuffer.get();
+#else
+        if (!m_ensureSharedMemory(metadata, sensor)) {
+            return nullptr;
+        }
+        frame.proxy.reset(
+            new IPCRingBuffer::BufferWriteProxy(m_shmBuf[sensor]->put()));
+        frame.buffer = frame.proxy->get();
+#endif
+        if (nullptr != frame.buffer) {
+            frame.metadata = metadata;
+        }
+        return frame.buffer;
+    }
+
+    bool ImagingComponent::commitImageFrame(OSVR_ChannelCount sensor,
+                                            OSVR_TimeValue const &timestamp) {
+        if (m_pendingFrames.size() <= sensor ||
+            nullptr == m_pendingFrames[sensor].buffer) {
+            return false;
+        }
+        PendingFrame frame(std::move(m_pendingFrames[sensor]));
+        m_pendingFrames[sensor] = PendingFrame{};
+
+        util::Flag dataSent;
+#ifdef OSVR_COMMON_IN_PROCESS_IMAGING
+        // The wire copy has to happen before the buffer is handed off.
+        dataSent += m_sendImageDataOnTheWire(frame.metadata, frame.buffer,
+                                             sensor, timestamp);
+        dataSent += m_sendImageDataViaInProcessMemory(
+            frame.metadata, std::move(frame.ownedBuffer), sensor, timestamp);
+#else
+        auto seq = frame.proxy->getSequenceNumber();
+        // Releasing the proxy publishes the element to readers: the buffer
+        // stays valid for our use until our next put, since we're the only
+        // producer.
+        frame.proxy.reset();
+        dataSent += m_sendSharedMemoryNotification(frame.metadata, seq, sensor,
+                                                   timestamp);
+        dataSent += m_sendImageDataOnTheWire(frame.metadata, frame.buffer,
+                                             sensor, timestamp);
+#endif
+        if (dataSent) {
+            m_checkFirst(frame.metadata);
+        }
+        return true;
+    }
+
+    void ImagingComponent::cancelImageFrame(OSVR_ChannelCount sensor) {
+        if (m_pendingFrames.size() <= sensor) {
+            return;
+        }
+        m_pendingFrames[sensor] = PendingFrame{};
+    }
+
 #ifdef OSVR_COMMON_IN_PROCESS_IMAGING
     bool ImagingComponent::m_sendImageDataViaInProcessMemory(
         OSVR_ImagingMetadata metadata, OSVR_ImageBufferElement *imageData,
@@ -233,13 +438,21 @@ namespace common {
         auto imageBufferCopy = util::makeAlignedImageBuffer(imageBufferSize);
         memcpy(imageBufferCopy.get(), imageData, imageBufferSize);
 
-        Buffer<> buf;
+        return m_sendImageDataViaInProcessMemory(
+            metadata, std::move(imageBufferCopy), sensor, timestamp);
+    }
+
+    bool ImagingComponent::m_sendImageDataViaInProcessMemory(
+        OSVR_ImagingMetadata metadata, util::AlignedImageBufferPtr &&imageData,
+        OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp) {
+
+        auto &buf = m_getSendBuffer();
         messages::ImagePlacedInProcessMemory::MessageSerialization
             serialization(messages::InProcessMemoryMessage{
                 metadata, sensor,
-                reinterpret_cast<intptr_t>(imageBufferCopy.release())});
+                reinterpret_cast<intptr_t>(imageData.release())});
 
-        serialize(buf, serialization);
+        serializeReusing(buf, serialization);
         m_getParent().packMessage(
             buf, imagePlacedInProcessMemory.getMessageType(), timestamp);
 
@@ -247,14 +460,13 @@ namespace common {
     }
 #endif
 
-    bool ImagingComponent::m_sendImageDataViaSharedMemory(
-        OSVR_ImagingMetadata metadata, OSVR_ImageBufferElement *imageData,
-        OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp) {
-
+    bool ImagingComponent::m_ensureSharedMemory(
+        OSVR_ImagingMetadata const &metadata, OSVR_ChannelCount sensor) {
         m_growShmVecIfRequired(sensor);
         uint32_t imageBufferSize = getBufferSize(metadata);
         if (!m_shmBuf[sensor] ||
-            m_shmBuf[sensor]->getEntrySize() != imageBufferSize) {
+            m_shmBuf[sensor]->getEntrySize() != imageBufferSize ||
+            m_shmBuf[sensor]->getLockFree() != m_lockFreeShm) {
             // create or replace the shared memory ring buffer.
             auto makeName = [](OSVR_ChannelCount sensor,
                                std::string const &devName) {
@@ -265,22 +477,39 @@ namespace common {
             m_shmBuf[sensor] = IPCRingBuffer::create(
                 IPCRingBuffer::Options(
                     makeName(sensor, m_getParent().getDeviceName()))
-                    .setEntrySize(imageBufferSize));
+                    .setEntrySize(imageBufferSize)
+                    .setLockFree(m_lockFreeShm));
         }
         if (!m_shmBuf[sensor]) {
             OSVR_DEV_VERBOSE(
                 "Some issue creating shared memory for imaging, skipping out.");
             return false;
         }
-        auto &shm = *(m_shmBuf[sensor]);
-        auto seq = shm.put(imageData, imageBufferSize);
+        return true;
+    }
 
-        Buffer<> buf;
+    bool ImagingComponent::m_sendImageDataViaSharedMemory(
+        OSVR_ImagingMetadata metadata, OSVR_ImageBufferElement *imageData,
+        OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp) {
+
+        if (!m_ensureSharedMemory(metadata, sensor)) {
+            return false;
+        }
+        auto seq = m_shmBuf[sensor]->put(imageData, getBufferSize(metadata));
+        return m_sendSharedMemoryNotification(metadata, seq, sensor,
+                                              timestamp);
+    }
+
+    bool ImagingComponent::m_sendSharedMemoryNotification(
+        OSVR_ImagingMetadata metadata, IPCRingBuffer::sequence_type seq,
+        OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp) {
+        auto &shm = *(m_shmBuf[sensor]);
+        auto &buf = m_getSendBuffer();
         messages::ImagePlacedInSharedMemory::MessageSerialization serialization(
             messages::SharedMemoryMessage{metadata, seq, sensor,
-                                          IPCRingBuffer::getABILevel(),
+                                          shm.getSegmentABILevel(),
                                           shm.getBackend(), shm.getName()});
-        serialize(buf, serialization);
+        serializeReusing(buf, serialization);
         m_getParent().packMessage(
             buf, imagePlacedInSharedMemory.getMessageType(), timestamp);
 
@@ -290,33 +519,112 @@ namespace common {
     bool ImagingComponent::m_sendImageDataOnTheWire(
         OSVR_ImagingMetadata metadata, OSVR_ImageBufferElement *imageData,
         OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp) {
-        /// @todo currently only handle 8bit data over network
-        if (metadata.depth != 1) {
-            return false;
-        }
-        Buffer<> buf;
+        m_growWireStreamVecIfRequired(sensor);
+        bool chunked = m_wireStreams[sensor].requested;
         messages::ImageRegion::MessageSerialization msg(metadata, imageData,
                                                         sensor);
-        serialize(buf, msg);
-        if (buf.size() > vrpn_CONNECTION_TCP_BUFLEN) {
-#if 0
-            OSVR_DEV_VERBOSE("Skipping imaging message: size is "
-                             << buf.size() << " vs the maximum of "
-                             << vrpn_CONNECTION_TCP_BUFLEN);
-#endif
+        /// imageRegion only handles 8bit data, and clients that predate
+        /// chunks can only receive frames that fit in a single message.
+        bool fitsImageRegion =
+            metadata.depth == 1 &&
+            getBufferSpaceRequired(msg) <= vrpn_CONNECTION_TCP_BUFLEN;
+        if (chunked &&
+            (!fitsImageRegion ||
+             !m_wireStreams[sensor].options.isDefault())) {
+            return m_sendImageDataInChunks(metadata, imageData, sensor,
+                                           timestamp);
+        }
+        if (!fitsImageRegion) {
             return false;
         }
+        auto &buf = m_getSendBuffer();
+        serializeReusing(buf, msg);
         m_getParent().packMessage(buf, imageRegion.getMessageType(), timestamp);
         m_getParent().sendPending();
         return true;
     }
 
+    bool ImagingComponent::m_sendImageDataInChunks(
+        OSVR_ImagingMetadata metadata, OSVR_ImageBufferElement const *imageData,
+        OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp) {
+        auto &stream = m_wireStreams[sensor];
+        if (!stream.chunker) {
+            stream.chunker.reset(new image_wire::FrameChunker);
+        }
+        auto reduced = image_wire::reduceImage(metadata, imageData,
+                                               stream.options, m_reducedImage);
+        auto encoding = image_wire::encodeImage(
+            stream.options.encoding, metadata, reduced,
+            stream.chunker->getEncodeBuffer());
+
+        image_wire::ChunkHeader header;
+        header.sensor = sensor;
+        header.frameSeq = ++stream.frameSeq;
+        header.metadata = metadata;
+        header.encoding = encoding;
+        stream.chunker->startFrame(header);
+        stream.timestamp = timestamp;
+        m_sendPendingChunks(sensor);
+        return true;
+    }
+
+    void ImagingComponent::m_sendPendingChunks(OSVR_ChannelCount sensor) {
+        auto &stream = m_wireStreams[sensor];
+        image_wire::ChunkHeader header;
+        char const *bytes = nullptr;
+        for (std::size_t i = 0; i < CHUNKS_PER_UPDATE &&
+                                stream.chunker->nextChunk(MAX_CHUNK_PAYLOAD,
+                                                          header, bytes);
+             ++i) {
+            auto &buf = m_getSendBuffer();
+            messages::ImageChunk::MessageSerialization msg(header, bytes);
+            serializeReusing(buf, msg);
+            // No explicit sendPending(): the server loop sends what's packed
+            // each pass, and VRPN itself sends early if its buffer fills.
+            m_getParent().packMessage(buf, imageChunk.getMessageType(),
+                                      stream.timestamp);
+        }
+    }
+
+    void ImagingComponent::m_update() {
+        for (OSVR_ChannelCount sensor = 0, e = m_wireStreams.size();
+             sensor < e; ++sensor) {
+            auto const &chunker = m_wireStreams[sensor].chunker;
+            if (chunker && chunker->inFlight()) {
+                m_sendPendingChunks(sensor);
+            }
+        }
+        // Not from the message handler that found we need the stream, so
+        // we aren't sending in the middle of receiving.
+        for (OSVR_ChannelCount sensor = 0, e = m_streamRequests.size();
+             sensor < e; ++sensor) {
+            if (m_streamRequests[sensor] == StreamRequest::Pending) {
+                requestNetworkImageStream(sensor,
+                                          NetworkImageStreamOptions());
+            }
+        }
+    }
+
+    void ImagingComponent::m_needNetworkStream(OSVR_ChannelCount sensor) {
+        if (sensor >= MAX_REQUESTABLE_SENSORS) {
+            return;
+        }
+        if (m_streamRequests.size() <= sensor) {
+            m_streamRequests.resize(sensor + 1, StreamRequest::None);
+        }
+        if (m_streamRequests[sensor] == StreamRequest::None) {
+            OSVR_DEV_VERBOSE("Asking for the network image stream of sensor "
+                             << sensor);
+            m_streamRequests[sensor] = StreamRequest::Pending;
+        }
+    }
+
     int VRPN_CALLBACK
     ImagingComponent::m_handleImageRegion(void *userdata, vrpn_HANDLERPARAM p) {
         auto self = static_cast<ImagingComponent *>(userdata);
         auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
 
-        messages::ImageRegion::MessageSerialization msg;
+        messages::ImageRegion::MessageSerialization msg(*self->m_bufferPool);
         deserialize(bufReader, msg);
         auto data = msg.getData();
         auto timestamp = util::time::fromStructTimeval(p.msg_time);
@@ -328,6 +636,50 @@ namespace common {
         return 0;
     }
 
+    int VRPN_CALLBACK
+    ImagingComponent::m_handleImageChunk(void *userdata, vrpn_HANDLERPARAM p) {
+        auto self = static_cast<ImagingComponent *>(userdata);
+        auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
+
+        messages::ImageChunk::MessageSerialization msg;
+        deserialize(bufReader, msg);
+        auto sensor = msg.getHeader().sensor;
+        if (sensor < self->m_shmBuf.size() && self->m_shmBuf[sensor]) {
+            // This client already gets the sensor's frames through shared
+            // memory: the chunks are for network clients.
+            return 0;
+        }
+        auto payload = msg.getPayload(bufReader);
+
+        ImageData data;
+        if (!self->m_reassembler->addChunk(msg.getHeader(), payload, data)) {
+            // Frame not complete yet (or dropped).
+            return 0;
+        }
+        auto timestamp = util::time::fromStructTimeval(p.msg_time);
+        self->m_checkFirst(data.metadata);
+        for (auto const &cb : self->m_cb) {
+            cb(data, timestamp);
+        }
+        return 0;
+    }
+
+    int VRPN_CALLBACK ImagingComponent::m_handleImageStreamRequest(
+        void *userdata, vrpn_HANDLERPARAM p) {
+        auto self = static_cast<ImagingComponent *>(userdata);
+        auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
+
+        messages::ImageStreamRequest::MessageSerialization msg;
+        deserialize(bufReader, msg);
+        auto maxSensors = self->m_numSensor != 0 ? self->m_numSensor
+                                                 : MAX_REQUESTABLE_SENSORS;
+        if (msg.getSensor() >= maxSensors) {
+            return 0;
+        }
+        self->setNetworkImageStream(msg.getSensor(), msg.getOptions());
+        return 0;
+    }
+
 #ifdef OSVR_COMMON_IN_PROCESS_IMAGING
     int VRPN_CALLBACK ImagingComponent::m_handleImagePlacedInProcessMemory(
         void *userdata, vrpn_HANDLERPARAM p) {
@@ -363,28 +715,34 @@ namespace common {
         auto &msg = msgSerialize.getMessage();
         auto timestamp = util::time::fromStructTimeval(p.msg_time);
 
-        if (IPCRingBuffer::getABILevel() != msg.abiLevel) {
+        bool lockFree = false;
+        if (!IPCRingBuffer::isABILevelSupported(msg.abiLevel, lockFree)) {
             /// Can't interoperate with this server over shared memory
             OSVR_DEV_VERBOSE("Can't handle SHM ABI level " << msg.abiLevel);
+            self->m_needNetworkStream(msg.sensor);
             return 0;
         }
         self->m_growShmVecIfRequired(msg.sensor);
-        auto checkSameRingBuf = [](messages::SharedMemoryMessage const &msg,
-                                   IPCRingBufferPtr &ringbuf) {
+        auto checkSameRingBuf = [lockFree](
+            messages::SharedMemoryMessage const &msg,
+            IPCRingBufferPtr &ringbuf) {
             return (msg.backend == ringbuf->getBackend()) &&
                    (ringbuf->getEntrySize() == getBufferSize(msg.metadata)) &&
+                   (ringbuf->getLockFree() == lockFree) &&
                    (ringbuf->getName() == msg.shmName);
         };
         if (!self->m_shmBuf[msg.sensor] ||
             !checkSameRingBuf(msg, self->m_shmBuf[msg.sensor])) {
             self->m_shmBuf[msg.sensor] = IPCRingBuffer::find(
-                IPCRingBuffer::Options(msg.shmName, msg.backend));
+                IPCRingBuffer::Options(msg.shmName, msg.backend)
+                    .setLockFree(lockFree));
         }
         if (!self->m_shmBuf[msg.sensor]) {
             /// Can't find the shared memory referred to - possibly not a local
             /// client
             OSVR_DEV_VERBOSE("Can't find desired IPC ring buffer "
                              << msg.shmName);
+            self->m_needNetworkStream(msg.sensor);
             return 0;
         }
 
@@ -407,6 +765,12 @@ namespace common {
             m_registerHandler(&ImagingComponent::m_handleImageRegion, this,
                               imageRegion.getMessageType());
 
+            m_bufferPool.reset(new ImageBufferPool);
+            m_reassembler.reset(
+                new image_wire::FrameReassembler(*m_bufferPool));
+            m_registerHandler(&ImagingComponent::m_handleImageChunk, this,
+                              imageChunk.getMessageType());
+
             m_registerHandler(
                 &ImagingComponent::m_handleImagePlacedInSharedMemory, this,
                 imagePlacedInSharedMemory.getMessageType());
@@ -425,6 +789,12 @@ namespace common {
 #ifdef OSVR_COMMON_IN_PROCESS_IMAGING
         m_getParent().registerMessageType(imagePlacedInProcessMemory);
 #endif
+        m_getParent().registerMessageType(imageChunk);
+        m_getParent().registerMessageType(imageStreamRequest);
+
+        // Only sent by clients, so this handler never fires client-side.
+        m_registerHandler(&ImagingComponent::m_handleImageStreamRequest, this,
+                          imageStreamRequest.getMessageType());
     }
 
     void ImagingComponent::m_checkFirst(OSVR_ImagingMetadata const &metadata) {
@@ -441,5 +811,17 @@ namespace common {
             m_shmBuf.resize(sensor + 1);
         }
     }
+    void
+    ImagingComponent::m_growPendingVecIfRequired(OSVR_ChannelCount sensor) {
+        if (m_pendingFrames.size() <= sensor) {
+            m_pendingFrames.resize(sensor + 1);
+        }
+    }
+    void
+    ImagingComponent::m_growWireStreamVecIfRequired(OSVR_ChannelCount sensor) {
+        if (m_wireStreams.size() <= sensor) {
+            m_wireStreams.resize(sensor + 1);
+        }
+    }
 } // namespace common
 } // namespace osvr
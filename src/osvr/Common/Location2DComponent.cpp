@@ -78,9 +78,9 @@ namespace common {
                                           OSVR_ChannelCount sensor,
                                           OSVR_TimeValue const &timestamp) {
 
-        Buffer<> buf;
+        auto &buf = m_getSendBuffer();
         messages::LocationRecord::MessageSerialization msg(location, sensor);
-        serialize(buf, msg);
+        serializeReusing(buf, msg);
 
         m_getParent().packMessage(buf, locationRecord.getMessageType(),
                                   timestamp);
@@ -106,12 +106,12 @@ namespace common {
         OSVR_NaviVelocityState naviVelocityState, OSVR_ChannelCount sensor,
         OSVR_TimeValue const &timestamp) {
 
-        Buffer<> buf;
+        auto &buf = m_getSendBuffer();
 
         messages::NaviVelocityRecord::MessageSerialization msg(
             naviVelocityState, sensor);
 
-        serialize(buf, msg);
+        serializeReusing(buf, msg);
         m_getParent().packMessage(buf, naviVelRecord.getMessageType(),
                                   timestamp);
     }
@@ -120,11 +120,11 @@ namespace common {
         OSVR_NaviPositionState naviPositionState, OSVR_ChannelCount sensor,
         OSVR_TimeValue const &timestamp) {
 
-        Buffer<> buf;
+        auto &buf = m_getSendBuffer();
 
         messages::NaviPositionRecord::MessageSerialization msg(
             naviPositionState, sensor);
-        serialize(buf, msg);
+        serializeReusing(buf, msg);
 
         m_getParent().packMessage(buf, naviPosnRecord.getMessageType(),
                                   timestamp);
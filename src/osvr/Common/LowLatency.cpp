@@ -24,12 +24,17 @@
 
 // Internal Includes
 #include <osvr/Common/LowLatency.h>
+#include <osvr/Util/PlatformConfig.h>
 
 #ifdef _WIN32
 #define NO_MINMAX
 #include <windows.h>
 #endif
 
+#ifdef OSVR_LINUX
+#include <sys/prctl.h>
+#endif
+
 namespace osvr {
 namespace common {
 
@@ -61,6 +66,29 @@ namespace common {
     }
 #endif
 
+#ifdef OSVR_LINUX
+#define OSVR_HAVE_LOWLATENCY_CODE
+    /// The closest Linux analogue to timeBeginPeriod is per-thread: shrink the
+    /// timer slack (default 50us) so sleeps and timed waits wake up on time
+    /// instead of being coalesced. Affects the constructing thread only.
+    struct LowLatency::Impl {
+        int previousSlack = -1;
+    };
+
+    LowLatency::LowLatency() : m_impl(new Impl) {
+        m_impl->previousSlack = prctl(PR_GET_TIMERSLACK, 0, 0, 0, 0);
+        /// 0 would mean "reset to default", so 1ns is the minimum.
+        prctl(PR_SET_TIMERSLACK, 1ul, 0, 0, 0);
+    }
+
+    LowLatency::~LowLatency() {
+        if (m_impl->previousSlack > 0) {
+            prctl(PR_SET_TIMERSLACK,
+                  static_cast<unsigned long>(m_impl->previousSlack), 0, 0, 0);
+        }
+    }
+#endif
+
 #ifndef OSVR_HAVE_LOWLATENCY_CODE
     // Fallback no-op implementations
     struct LowLatency::Impl {};
@@ -34,6 +34,7 @@
 // Library/third-party includes
 #include <json/value.h>
 #include <json/reader.h>
+#include <json/writer.h>
 #include <boost/variant.hpp>
 #include <boost/mpl/for_each.hpp>
 #include <boost/noncopyable.hpp>
@@ -41,6 +42,8 @@
 // Standard includes
 #include <type_traits>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace osvr {
 namespace common {
@@ -156,6 +159,143 @@ namespace common {
             std::string const m_typename;
             elements::PathElement &m_elt;
         };
+
+        /// @brief Functor for use with a serializationDescription overload, for
+        /// the direction PathElement->compact (see CompactPathTreeDelta): each
+        /// field becomes one integer, strings being replaced by their index
+        /// from the interning function.
+        template <typename InternFunction>
+        class PathElementToCompactFunctor : boost::noncopyable {
+          public:
+            PathElementToCompactFunctor(InternFunction &intern,
+                                        std::vector<uint32_t> &out)
+                : m_intern(intern), m_out(out) {}
+
+            void operator()(const char[], std::string const &data) {
+                m_out.push_back(m_intern(data));
+            }
+            /// @brief Descriptors are stored as compact JSON text, so identical
+            /// ones share a string table entry.
+            void operator()(const char[], Json::Value const &data) {
+                Json::FastWriter writer;
+                m_out.push_back(m_intern(writer.write(data)));
+            }
+            void operator()(const char[], bool data) {
+                m_out.push_back(data ? 1 : 0);
+            }
+            void operator()(const char[], uint8_t data) {
+                m_out.push_back(data);
+            }
+
+          private:
+            InternFunction &m_intern;
+            std::vector<uint32_t> &m_out;
+        };
+
+        /// @brief Functor for use with a serializationDescription overload, for
+        /// the direction compact->PathElement: consumes one integer per field
+        /// from the given range.
+        class PathElementFromCompactFunctor : boost::noncopyable {
+          public:
+            typedef std::vector<uint32_t>::const_iterator iterator;
+            PathElementFromCompactFunctor(
+                std::vector<std::string> const &strings, iterator &it,
+                iterator end)
+                : m_strings(strings), m_it(it), m_end(end) {}
+
+            void operator()(const char name[], std::string &dataRef) {
+                dataRef = m_string(name);
+            }
+            void operator()(const char name[], Json::Value &dataRef) {
+                Json::Reader reader;
+                if (!reader.parse(m_string(name), dataRef)) {
+                    throw std::runtime_error(
+                        "Could not parse compact JSON for member " +
+                        std::string(name));
+                }
+            }
+            void operator()(const char name[], bool &dataRef) {
+                dataRef = (m_next(name) != 0);
+            }
+            void operator()(const char name[], uint8_t &dataRef) {
+                dataRef = static_cast<uint8_t>(m_next(name));
+            }
+
+          private:
+            uint32_t m_next(const char name[]) {
+                if (m_it == m_end) {
+                    throw std::runtime_error(
+                        "Compact path element truncated before member " +
+                        std::string(name));
+                }
+                return *(m_it++);
+            }
+            std::string const &m_string(const char name[]) {
+                auto idx = m_next(name);
+                if (idx >= m_strings.size()) {
+                    throw std::runtime_error(
+                        "Bad string index in compact path element member " +
+                        std::string(name));
+                }
+                return m_strings[idx];
+            }
+            std::vector<std::string> const &m_strings;
+            iterator &m_it;
+            iterator m_end;
+        };
+
+        /// @brief Functor for use with the PathElement's type list and
+        /// mpl::for_each, to convert from type index to actual type and load
+        /// the data from the compact form.
+        class DeserializeCompactElementFunctor {
+          public:
+            DeserializeCompactElementFunctor(
+                PathElementFromCompactFunctor &fields, uint32_t typeIndex,
+                elements::PathElement &elt, bool &found)
+                : m_fields(fields), m_typeIndex(typeIndex), m_elt(elt),
+                  m_found(found) {
+                m_found = false;
+            }
+
+            /// @brief Don't try to generate an assignment operator.
+            DeserializeCompactElementFunctor &
+            operator=(const DeserializeCompactElementFunctor &) = delete;
+
+            template <typename T> void operator()(T const &) {
+                if (m_current++ == m_typeIndex) {
+                    T value;
+                    serializationDescription(m_fields, value);
+                    m_elt = value;
+                    m_found = true;
+                }
+            }
+
+          private:
+            PathElementFromCompactFunctor &m_fields;
+            uint32_t const m_typeIndex;
+            uint32_t m_current = 0;
+            elements::PathElement &m_elt;
+            bool &m_found;
+        };
+
+        /// @brief Visitor applying a PathElementToCompactFunctor to whatever
+        /// type a PathElement holds.
+        template <typename InternFunction>
+        class PathElementToCompactVisitor
+            : public boost::static_visitor<>,
+              boost::noncopyable {
+          public:
+            PathElementToCompactVisitor(
+                PathElementToCompactFunctor<InternFunction> &functor)
+                : m_functor(functor) {}
+
+            template <typename T> void operator()(T const &value) {
+                serializationDescription(m_functor, value);
+            }
+
+          private:
+            PathElementToCompactFunctor<InternFunction> &m_functor;
+        };
     } // namespace
 
     /// @brief Returns a JSON object with any element-type-specific data for the
@@ -175,6 +315,39 @@ namespace common {
         return elt;
     }
 
+    /// @brief Appends the type index and element-type-specific data of the
+    /// given PathElement to a compact node record.
+    template <typename InternFunction>
+    inline void pathElementToCompact(elements::PathElement const &elt,
+                                     InternFunction &intern,
+                                     std::vector<uint32_t> &out) {
+        out.push_back(static_cast<uint32_t>(elt.which()));
+        PathElementToCompactFunctor<InternFunction> functor(intern, out);
+        PathElementToCompactVisitor<InternFunction> visitor(functor);
+        boost::apply_visitor(visitor, elt);
+    }
+
+    /// @brief Reads a PathElement (type index and data) from a compact node
+    /// record, advancing the iterator past it.
+    inline elements::PathElement
+    compactToPathElement(std::vector<std::string> const &strings,
+                         std::vector<uint32_t>::const_iterator &it,
+                         std::vector<uint32_t>::const_iterator end) {
+        PathElementFromCompactFunctor fields{strings, it, end};
+        if (it == end) {
+            throw std::runtime_error(
+                "Compact path element truncated before type index");
+        }
+        elements::PathElement elt;
+        bool found;
+        DeserializeCompactElementFunctor functor{fields, *(it++), elt, found};
+        boost::mpl::for_each<elements::PathElement::types>(functor);
+        if (!found) {
+            throw std::runtime_error("Bad type index in compact path element");
+        }
+        return elt;
+    }
+
 } // namespace common
 } // namespace osvr
 
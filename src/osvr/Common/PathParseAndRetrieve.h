@@ -32,12 +32,11 @@
 
 // Library/third-party includes
 #include <boost/assert.hpp>
-#include <boost/algorithm/string/find_iterator.hpp>
-#include <boost/algorithm/string/finder.hpp>
-#include <boost/range/adaptor/sliced.hpp>
 
 // Standard includes
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace osvr {
 namespace common {
@@ -61,7 +60,7 @@ namespace common {
 
         template <typename GetChildFunctor, typename Node>
         inline Node &treePathRetrieveImplementation(
-            GetChildFunctor f, Node &node, std::string path,
+            GetChildFunctor f, Node &node, std::string const &path,
             ParentPolicy permitParent = GETPARENT_DENY,
             AbsolutePolicy permitAbsolute = ABSOLUTEPATH_PERMIT) {
 
@@ -69,9 +68,14 @@ namespace common {
                 return node;
             }
             Node *ret = &node;
+            const auto sep = getPathSeparatorCharacter();
+
+            // Bounds of the portion of the path we'll split into components.
+            std::string::size_type pos = 0;
+            std::string::size_type len = path.size();
 
             // Check for leading slash, indicating absolute path
-            if (path.at(0) == getPathSeparatorCharacter()) {
+            if (path[0] == sep) {
                 if (ABSOLUTEPATH_PERMIT != permitAbsolute) {
                     throw exceptions::ForbiddenAbsolutePath();
                 }
@@ -83,60 +87,52 @@ namespace common {
                     // Literally just asking for the root.
                     return *ret;
                 }
-                // Remove the leading slash for the iterator's benefit.
-                path.erase(begin(path));
+                // Skip the leading slash.
+                pos = 1;
             }
 
-            // Remove any trailing slash
-            if (path.back() == getPathSeparatorCharacter()) {
-                path.pop_back();
+            // Ignore any trailing slash
+            if (path[len - 1] == sep) {
+                --len;
             }
 
-            // new scope for the iterators and loop:
-            {
-                // Create a boost string algorithm "split iterator" to iterate
-                // through components of the path.
-                auto begin = boost::algorithm::make_split_iterator(
-                    path,
-                    boost::first_finder(getPathSeparator(), boost::is_equal()));
-                // Create the corresponding end iterator: same type as begin,
-                // but default constructed.
-                auto end = decltype(begin)();
-
-                // Temporary string that will be re-used each pass through the
-                // loop
-                std::string component;
-
-                // Use the iterators as a range in a loop, to process each
-                // component of the path
-                for (auto rangeIt : boost::make_iterator_range(begin, end)) {
-                    // Extract the component to a string for interpretation.
-                    component = boost::copy_range<std::string>(rangeIt);
-
-                    // Interpret the component: four cases
-                    if (component.empty()) {
-                        // Empty components are forbidden
-                        throw exceptions::EmptyPathComponent(path);
-                    } else if (component == ".") {
-                        // current location - go to the next component without
-                        // changing location
-                        continue;
-                    } else if (component == "..") {
-                        // parent path - must check for permission first, then
-                        // possibility (root has no parent)
-                        if (GETPARENT_PERMIT != permitParent) {
-                            throw exceptions::ForbiddenParentPath();
-                        }
-                        if (ret->isRoot()) {
-                            throw exceptions::ImpossibleParentPath();
-                        }
-                        ret = ret->getParent();
-                    } else {
-                        // A non-special string: just get the child
-                        ret = f(ret, component);
+            // Temporary string that will be re-used each pass through the
+            // loop, to avoid re-allocating.
+            std::string component;
+
+            // Walk through each component of the path, delimited by
+            // separators, without copying the whole path.
+            while (pos <= len) {
+                auto next = path.find(sep, pos);
+                if (next == std::string::npos || next > len) {
+                    next = len;
+                }
+                component.assign(path, pos, next - pos);
+                pos = next + 1;
+
+                // Interpret the component: four cases
+                if (component.empty()) {
+                    // Empty components are forbidden
+                    throw exceptions::EmptyPathComponent(path);
+                } else if (component == ".") {
+                    // current location - go to the next component without
+                    // changing location
+                    continue;
+                } else if (component == "..") {
+                    // parent path - must check for permission first, then
+                    // possibility (root has no parent)
+                    if (GETPARENT_PERMIT != permitParent) {
+                        throw exceptions::ForbiddenParentPath();
+                    }
+                    if (ret->isRoot()) {
+                        throw exceptions::ImpossibleParentPath();
                     }
-                    // if we make it to here we've updated ret.
+                    ret = ret->getParent();
+                } else {
+                    // A non-special string: just get the child
+                    ret = f(ret, component);
                 }
+                // if we make it to here we've updated ret.
             }
 
             return *ret;
@@ -232,6 +228,52 @@ namespace common {
 
         return treePathRetrieve(root, path);
     }
+
+    /// @brief Internal method for splitting an absolute path into its
+    /// components once, for use with TreeNode::getOrCreateDescendant() and
+    /// TreeNode::getDescendant(). "." components are dropped, and a trailing
+    /// slash is trimmed silently. The root path results in an empty vector.
+    ///
+    /// @throws exceptions::PathNotAbsolute, exceptions::EmptyPath,
+    /// exceptions::EmptyPathComponent, exceptions::ForbiddenParentPath
+    inline std::vector<std::string>
+    pathParseComponents(std::string const &path) {
+        if (path.empty()) {
+            throw exceptions::EmptyPath();
+        }
+        const auto sep = getPathSeparatorCharacter();
+        if (path[0] != sep) {
+            throw exceptions::PathNotAbsolute(path);
+        }
+        std::vector<std::string> ret;
+        std::string::size_type len = path.size();
+        if (len == 1) {
+            return ret;
+        }
+        if (path[len - 1] == sep) {
+            --len;
+        }
+        std::string::size_type pos = 1;
+        while (pos <= len) {
+            auto next = path.find(sep, pos);
+            if (next == std::string::npos || next > len) {
+                next = len;
+            }
+            if (next == pos) {
+                throw exceptions::EmptyPathComponent(path);
+            }
+            std::string component(path, pos, next - pos);
+            pos = next + 1;
+            if (component == ".") {
+                continue;
+            }
+            if (component == "..") {
+                throw exceptions::ForbiddenParentPath();
+            }
+            ret.push_back(std::move(component));
+        }
+        return ret;
+    }
 } // namespace common
 } // namespace osvr
 
@@ -63,8 +63,47 @@ namespace common {
                                     path);
     }
 
+    PathTree::PathComponents PathTree::parsePath(std::string const &path) {
+        return pathParseComponents(path);
+    }
+
+    PathNode &PathTree::getNodeByPath(PathComponents const &path) {
+        return m_root->getOrCreateDescendant(begin(path), end(path));
+    }
+
+    PathNode const &PathTree::getNodeByPath(PathComponents const &path) const {
+        return m_root->getDescendant(begin(path), end(path));
+    }
+
     void PathTree::reset() { m_root = PathNode::createRoot(); }
 
+    bool PathTree::removeNodeByPath(std::string const &path) {
+        auto components = parsePath(path);
+        PathNode *node = nullptr;
+        try {
+            // The const overload looks up without creating anything.
+            node = const_cast<PathNode *>(
+                &(const_cast<PathTree const &>(*this).getNodeByPath(
+                    components)));
+        } catch (util::tree::NoSuchChild &) {
+            return false;
+        }
+        if (node->hasChildren()) {
+            node->value() = elements::NullElement{};
+            return true;
+        }
+        // Remove the leaf, then any ancestors only left there to hold it.
+        while (!node->isRoot()) {
+            auto parent = node->getParent();
+            parent->removeChildByName(node->getName());
+            node = parent;
+            if (node->hasChildren() || !elements::isNull(node->value())) {
+                break;
+            }
+        }
+        return true;
+    }
+
     /// @brief Determine if the node needs updating given that we want to add an
     /// alias there pointing to source with the given automatic status.
     static inline bool aliasNeedsUpdate(PathNode &node,
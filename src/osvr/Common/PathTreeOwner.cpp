@@ -24,6 +24,7 @@
 
 // Internal Includes
 #include <osvr/Common/PathTreeOwner.h>
+#include <osvr/Common/PathTree.h>
 #include <osvr/Common/PathTreeObserver.h>
 #include <osvr/Common/PathTreeSerialization.h>
 
@@ -33,6 +34,7 @@
 // Standard includes
 #include <algorithm>
 #include <iterator>
+#include <utility>
 
 namespace osvr {
 namespace common {
@@ -71,15 +73,13 @@ namespace common {
         return ret;
     }
 
-    void PathTreeOwner::replaceTree(Json::Value const &nodes) {
+    template <typename F> inline void PathTreeOwner::m_updateTree(F &&f) {
         for_each_cleanup_pointers(
             m_observers, [&](PathTreeObserver const &observer) {
                 observer.notifyEvent(PathTreeEvents::AboutToUpdate, m_tree);
             });
 
-        m_tree.reset();
-
-        common::jsonToPathTree(m_tree, nodes);
+        std::forward<F>(f)();
 
         m_valid = true;
 
@@ -88,5 +88,39 @@ namespace common {
                 observer.notifyEvent(PathTreeEvents::AfterUpdate, m_tree);
             });
     }
+
+    void PathTreeOwner::replaceTree(Json::Value const &nodes) {
+        m_updateTree([&] {
+            m_tree.reset();
+            common::jsonToPathTree(m_tree, nodes);
+        });
+        m_haveGeneration = false;
+    }
+
+    void PathTreeOwner::copyTree(PathTree const &src) {
+        m_updateTree([&] {
+            m_tree.reset();
+            common::clonePathTree(src, m_tree);
+        });
+        m_haveGeneration = false;
+    }
+
+    bool PathTreeOwner::applyTreeDelta(Json::Value const &delta) {
+        auto generation = delta["generation"].asUInt();
+        auto keyframe = delta["keyframe"].asBool();
+        if (!keyframe &&
+            (!m_haveGeneration || generation != m_generation + 1)) {
+            return false;
+        }
+        m_updateTree([&] {
+            if (keyframe) {
+                m_tree.reset();
+            }
+            common::applyPathTreeDelta(m_tree, delta);
+        });
+        m_haveGeneration = true;
+        m_generation = generation;
+        return true;
+    }
 } // namespace common
 } // namespace osvr
@@ -35,7 +35,9 @@
 #include <json/value.h>
 
 // Standard includes
-// - none
+#include <string>
+#include <unordered_map>
+#include <stdexcept>
 
 namespace osvr {
 namespace common {
@@ -61,10 +63,6 @@ namespace common {
                 return ret;
             }
         };
-        Json::Value pathNodeToJson(PathNode const &node) {
-            PathNodeToJsonVisitor visitor;
-            return applyPathNodeVisitor(visitor, node);
-        }
         /// @brief A PathNode (tree) visitor to recursively convert nodes in a
         /// PathTree to JSON
         class PathTreeToJsonVisitor {
@@ -87,8 +85,95 @@ namespace common {
             Json::Value m_ret;
             bool m_keepNulls;
         };
+
+        static const char PATH_KEY[] = "path";
+        static const char ADDED_KEY[] = "added";
+        static const char CHANGED_KEY[] = "changed";
+        static const char REMOVED_KEY[] = "removed";
+
+        /// @brief Index an array of serialized nodes by path.
+        inline std::unordered_map<std::string, Json::Value const *>
+        indexNodesByPath(Json::Value const &nodes) {
+            std::unordered_map<std::string, Json::Value const *> ret;
+            ret.reserve(nodes.size());
+            for (auto const &node : nodes) {
+                ret[node[PATH_KEY].asString()] = &node;
+            }
+            return ret;
+        }
+
+        /// @brief A PathElement visitor returning the element-type-specific
+        /// data as a JSON object.
+        class ElementToJsonVisitor
+            : public boost::static_visitor<Json::Value> {
+          public:
+            template <typename T> Json::Value operator()(T const &elt) const {
+                return pathElementToJson(elt);
+            }
+        };
+
+        /// @brief Interning function for CompactPathTreeDelta::strings.
+        class StringTable : boost::noncopyable {
+          public:
+            StringTable(std::vector<std::string> &strings)
+                : m_strings(strings) {}
+
+            uint32_t operator()(std::string const &str) {
+                auto it = m_indices.find(str);
+                if (it != end(m_indices)) {
+                    return it->second;
+                }
+                auto idx = static_cast<uint32_t>(m_strings.size());
+                m_strings.push_back(str);
+                m_indices.emplace(str, idx);
+                return idx;
+            }
+
+          private:
+            std::vector<std::string> &m_strings;
+            std::unordered_map<std::string, uint32_t> m_indices;
+        };
+
+        inline void compactNodes(Json::Value const &nodes, StringTable &intern,
+                                 std::vector<uint32_t> &out) {
+            for (auto const &node : nodes) {
+                out.push_back(intern(node[PATH_KEY].asString()));
+                pathElementToCompact(jsonToPathElement(node), intern, out);
+            }
+        }
+
+        inline std::string const &
+        lookupString(CompactPathTreeDelta const &compact, uint32_t idx) {
+            if (idx >= compact.strings.size()) {
+                throw std::runtime_error(
+                    "Bad string index in compact path tree delta");
+            }
+            return compact.strings[idx];
+        }
+
+        inline Json::Value expandNodes(CompactPathTreeDelta const &compact,
+                                       std::vector<uint32_t> const &nodes) {
+            Json::Value ret(Json::arrayValue);
+            auto it = nodes.cbegin();
+            auto e = nodes.cend();
+            while (it != e) {
+                auto const &path = lookupString(compact, *(it++));
+                auto elt = compactToPathElement(compact.strings, it, e);
+                ElementToJsonVisitor visitor;
+                auto node = boost::apply_visitor(visitor, elt);
+                node[PATH_KEY] = path;
+                node["type"] = getTypeName(elt);
+                ret.append(node);
+            }
+            return ret;
+        }
     } // namespace
 
+    Json::Value pathNodeToJson(PathNode const &node) {
+        PathNodeToJsonVisitor visitor;
+        return applyPathNodeVisitor(visitor, node);
+    }
+
     Json::Value pathTreeToJson(PathTree const &tree, bool keepNulls) {
         auto visitor = PathTreeToJsonVisitor{keepNulls};
         tree.visitConstTree(visitor);
@@ -98,8 +183,72 @@ namespace common {
     void jsonToPathTree(PathTree &tree, Json::Value nodes) {
         for (auto const &node : nodes) {
             elements::PathElement elt = jsonToPathElement(node);
-            tree.getNodeByPath(node["path"].asString()).value() = elt;
+            tree.getNodeByPath(node[PATH_KEY].asString()).value() = elt;
+        }
+    }
+
+    Json::Value pathTreeDelta(Json::Value const &oldNodes,
+                              Json::Value const &newNodes) {
+        Json::Value ret(Json::objectValue);
+        ret[ADDED_KEY] = Json::arrayValue;
+        ret[CHANGED_KEY] = Json::arrayValue;
+        ret[REMOVED_KEY] = Json::arrayValue;
+
+        auto oldIndex = indexNodesByPath(oldNodes);
+        for (auto const &node : newNodes) {
+            auto it = oldIndex.find(node[PATH_KEY].asString());
+            if (it == end(oldIndex)) {
+                ret[ADDED_KEY].append(node);
+                continue;
+            }
+            if (*(it->second) != node) {
+                ret[CHANGED_KEY].append(node);
+            }
+            // Whatever is left in the index at the end was removed.
+            oldIndex.erase(it);
+        }
+        for (auto const &node : oldNodes) {
+            auto const &path = node[PATH_KEY];
+            if (oldIndex.find(path.asString()) != end(oldIndex)) {
+                ret[REMOVED_KEY].append(path);
+            }
+        }
+        return ret;
+    }
+
+    bool isPathTreeDeltaEmpty(Json::Value const &delta) {
+        return delta[ADDED_KEY].empty() && delta[CHANGED_KEY].empty() &&
+               delta[REMOVED_KEY].empty();
+    }
+
+    void applyPathTreeDelta(PathTree &tree, Json::Value const &delta) {
+        for (auto const &path : delta[REMOVED_KEY]) {
+            tree.removeNodeByPath(path.asString());
+        }
+        jsonToPathTree(tree, delta[ADDED_KEY]);
+        jsonToPathTree(tree, delta[CHANGED_KEY]);
+    }
+
+    CompactPathTreeDelta compactPathTreeDelta(Json::Value const &delta) {
+        CompactPathTreeDelta ret;
+        StringTable intern{ret.strings};
+        compactNodes(delta[ADDED_KEY], intern, ret.added);
+        compactNodes(delta[CHANGED_KEY], intern, ret.changed);
+        for (auto const &path : delta[REMOVED_KEY]) {
+            ret.removed.push_back(intern(path.asString()));
+        }
+        return ret;
+    }
+
+    Json::Value expandPathTreeDelta(CompactPathTreeDelta const &compact) {
+        Json::Value ret(Json::objectValue);
+        ret[ADDED_KEY] = expandNodes(compact, compact.added);
+        ret[CHANGED_KEY] = expandNodes(compact, compact.changed);
+        ret[REMOVED_KEY] = Json::arrayValue;
+        for (auto idx : compact.removed) {
+            ret[REMOVED_KEY].append(lookupString(compact, idx));
         }
+        return ret;
     }
 } // namespace common
 } // namespace osvr
\ No newline at end of file
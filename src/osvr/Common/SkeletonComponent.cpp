@@ -107,19 +107,20 @@ namespace common {
     void SkeletonComponent::sendNotification(OSVR_ChannelCount sensor,
                                              OSVR_TimeValue const &timestamp) {
 
-        Buffer<> buf;
+        auto &buf = m_getSendBuffer();
         SkeletonNotification notification;
         notification.sensor = sensor;
         messages::SkeletonRecord::MessageSerialization msg(notification);
 
-        serialize(buf, msg);
+        serializeReusing(buf, msg);
 
         m_getParent().packMessage(buf, skeletonRecord.getMessageType(),
                                   timestamp);
     }
     void SkeletonComponent::sendArticulationSpec(std::string const &jsonSpec) {
 
-        Buffer<> buf;
+        auto &buf = m_getSendBuffer();
+        buf.clear();
         SkeletonSpec articSpec;
         Json::Reader reader;
         Json::Value spec;
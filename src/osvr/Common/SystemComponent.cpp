@@ -30,12 +30,13 @@
 #include <osvr/Common/JSONSerializationTags.h>
 #include <osvr/Common/Buffer.h>
 #include <osvr/Common/PathTreeSerialization.h>
+#include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
 #include <json/value.h>
 
 // Standard includes
-// - none
+#include <exception>
 
 namespace osvr {
 namespace common {
@@ -93,6 +94,83 @@ namespace common {
         const char *ReplacementTreeFromServer::identifier() {
             return "com.osvr.system.ReplacementTreeFromServer";
         }
+
+        class TreeDeltaFromServer::MessageSerialization {
+          public:
+            MessageSerialization() {}
+            MessageSerialization(Json::Value const &delta, uint32_t generation,
+                                 bool keyframe)
+                : m_generation(generation), m_keyframe(keyframe),
+                  m_delta(compactPathTreeDelta(delta)) {}
+
+            template <typename T> void processMessage(T &p) {
+                p(m_generation);
+                p(m_keyframe);
+                p(m_delta.strings);
+                p(m_delta.added);
+                p(m_delta.changed);
+                p(m_delta.removed);
+            }
+
+            /// @brief Gets the delta in JSON form, with "generation" and
+            /// "keyframe" members added.
+            Json::Value getValue() const {
+                auto ret = expandPathTreeDelta(m_delta);
+                ret["generation"] = m_generation;
+                ret["keyframe"] = m_keyframe;
+                return ret;
+            }
+
+          private:
+            uint32_t m_generation = 0;
+            bool m_keyframe = false;
+            CompactPathTreeDelta m_delta;
+        };
+        const char *TreeDeltaFromServer::identifier() {
+            return "com.osvr.system.TreeDeltaFromServer";
+        }
+
+        class TreeDeltaQueryFromServer::MessageSerialization {
+          public:
+            explicit MessageSerialization(uint32_t epoch = 0)
+                : m_epoch(epoch) {}
+
+            template <typename T> void processMessage(T &p) { p(m_epoch); }
+
+            uint32_t getEpoch() const { return m_epoch; }
+
+          private:
+            uint32_t m_epoch;
+        };
+        const char *TreeDeltaQueryFromServer::identifier() {
+            return "com.osvr.system.TreeDeltaQueryFromServer";
+        }
+
+        class TreeDeltaSupportToServer::MessageSerialization {
+          public:
+            MessageSerialization(uint32_t epoch = 0, bool needKeyframe = false,
+                                 uint32_t clientId = 0)
+                : m_epoch(epoch), m_needKeyframe(needKeyframe),
+                  m_clientId(clientId) {}
+
+            template <typename T> void processMessage(T &p) {
+                p(m_epoch);
+                p(m_needKeyframe);
+                p(m_clientId);
+            }
+
+            uint32_t getEpoch() const { return m_epoch; }
+            bool getNeedKeyframe() const { return m_needKeyframe; }
+            uint32_t getClientId() const { return m_clientId; }
+
+          private:
+            uint32_t m_epoch;
+            bool m_needKeyframe;
+            uint32_t m_clientId;
+        };
+        const char *TreeDeltaSupportToServer::identifier() {
+            return "com.osvr.system.TreeDeltaSupportToServer";
+        }
     } // namespace messages
 
     const char *SystemComponent::deviceName() {
@@ -107,9 +185,9 @@ namespace common {
     SystemComponent::SystemComponent() {}
 
     void SystemComponent::sendRoutes(std::string const &routes) {
-        Buffer<> buf;
+        auto &buf = m_getSendBuffer();
         messages::RoutesFromServer::MessageSerialization msg(routes);
-        serialize(buf, msg);
+        serializeReusing(buf, msg);
         m_getParent().packMessage(buf, routesOut.getMessageType());
     }
 
@@ -119,9 +197,9 @@ namespace common {
     }
 
     void SystemComponent::sendClientRouteUpdate(std::string const &route) {
-        Buffer<> buf;
+        auto &buf = m_getSendBuffer();
         messages::ClientRouteToServer::MessageSerialization msg(route);
-        serialize(buf, msg);
+        serializeReusing(buf, msg);
         m_getParent().packMessage(buf, routeIn.getMessageType());
     }
 
@@ -131,9 +209,13 @@ namespace common {
     }
 
     void SystemComponent::sendReplacementTree(PathTree &tree) {
-        auto config = pathTreeToJson(tree);
-        Buffer<> buf;
-        messages::ReplacementTreeFromServer::MessageSerialization msg(config);
+        sendReplacementTree(pathTreeToJson(tree));
+    }
+
+    void SystemComponent::sendReplacementTree(Json::Value const &nodes) {
+        auto &buf = m_getSendBuffer();
+        buf.clear();
+        messages::ReplacementTreeFromServer::MessageSerialization msg(nodes);
         serialize(buf, msg);
         m_getParent().packMessage(buf, treeOut.getMessageType());
 
@@ -148,11 +230,66 @@ namespace common {
         m_replaceTreeHandlers.push_back(cb);
     }
 
+    void SystemComponent::sendTreeDelta(Json::Value const &delta,
+                                        uint32_t generation, bool keyframe) {
+        auto &buf = m_getSendBuffer();
+        messages::TreeDeltaFromServer::MessageSerialization msg(
+            delta, generation, keyframe);
+        serializeReusing(buf, msg);
+        m_getParent().packMessage(buf, treeDeltaOut.getMessageType());
+    }
+
+    void SystemComponent::registerTreeDeltaHandler(JsonHandler cb) {
+        if (m_treeDeltaHandlers.empty()) {
+            m_registerHandler(&SystemComponent::m_handleTreeDelta, this,
+                              treeDeltaOut.getMessageType());
+        }
+        m_treeDeltaHandlers.push_back(cb);
+    }
+
+    void SystemComponent::sendTreeDeltaQuery(uint32_t epoch) {
+        auto &buf = m_getSendBuffer();
+        messages::TreeDeltaQueryFromServer::MessageSerialization msg(epoch);
+        serializeReusing(buf, msg);
+        m_getParent().packMessage(buf, treeDeltaQueryOut.getMessageType());
+    }
+
+    void
+    SystemComponent::registerTreeDeltaQueryHandler(TreeDeltaQueryHandler cb) {
+        if (m_treeDeltaQueryHandlers.empty()) {
+            m_registerHandler(&SystemComponent::m_handleTreeDeltaQuery, this,
+                              treeDeltaQueryOut.getMessageType());
+        }
+        m_treeDeltaQueryHandlers.push_back(cb);
+    }
+
+    void SystemComponent::sendTreeDeltaSupport(uint32_t epoch,
+                                               bool needKeyframe,
+                                               uint32_t clientId) {
+        auto &buf = m_getSendBuffer();
+        messages::TreeDeltaSupportToServer::MessageSerialization msg(
+            epoch, needKeyframe, clientId);
+        serializeReusing(buf, msg);
+        m_getParent().packMessage(buf, treeDeltaSupportIn.getMessageType());
+    }
+
+    void SystemComponent::registerTreeDeltaSupportHandler(
+        TreeDeltaSupportHandler cb) {
+        if (m_treeDeltaSupportHandlers.empty()) {
+            m_registerHandler(&SystemComponent::m_handleTreeDeltaSupport, this,
+                              treeDeltaSupportIn.getMessageType());
+        }
+        m_treeDeltaSupportHandlers.push_back(cb);
+    }
+
     void SystemComponent::m_parentSet() {
         m_getParent().registerMessageType(routesOut);
         m_getParent().registerMessageType(appStartup);
         m_getParent().registerMessageType(routeIn);
         m_getParent().registerMessageType(treeOut);
+        m_getParent().registerMessageType(treeDeltaOut);
+        m_getParent().registerMessageType(treeDeltaQueryOut);
+        m_getParent().registerMessageType(treeDeltaSupportIn);
     }
 
     int SystemComponent::m_handleReplaceTree(void *userdata,
@@ -169,5 +306,50 @@ namespace common {
         }
         return 0;
     }
+
+    int SystemComponent::m_handleTreeDelta(void *userdata,
+                                           vrpn_HANDLERPARAM p) {
+        auto self = static_cast<SystemComponent *>(userdata);
+        auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
+        messages::TreeDeltaFromServer::MessageSerialization msg;
+        Json::Value delta;
+        try {
+            deserialize(bufReader, msg);
+            delta = msg.getValue();
+        } catch (std::exception const &e) {
+            OSVR_DEV_VERBOSE("Ignoring malformed tree delta message: "
+                             << e.what());
+            return 0;
+        }
+        auto timestamp = util::time::fromStructTimeval(p.msg_time);
+        for (auto const &cb : self->m_treeDeltaHandlers) {
+            cb(delta, timestamp);
+        }
+        return 0;
+    }
+
+    int SystemComponent::m_handleTreeDeltaQuery(void *userdata,
+                                                vrpn_HANDLERPARAM p) {
+        auto self = static_cast<SystemComponent *>(userdata);
+        auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
+        messages::TreeDeltaQueryFromServer::MessageSerialization msg;
+        deserialize(bufReader, msg);
+        for (auto const &cb : self->m_treeDeltaQueryHandlers) {
+            cb(msg.getEpoch());
+        }
+        return 0;
+    }
+
+    int SystemComponent::m_handleTreeDeltaSupport(void *userdata,
+                                                  vrpn_HANDLERPARAM p) {
+        auto self = static_cast<SystemComponent *>(userdata);
+        auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
+        messages::TreeDeltaSupportToServer::MessageSerialization msg;
+        deserialize(bufReader, msg);
+        for (auto const &cb : self->m_treeDeltaSupportHandlers) {
+            cb(msg.getEpoch(), msg.getNeedKeyframe(), msg.getClientId());
+        }
+        return 0;
+    }
 } // namespace common
 } // namespace osvr
@@ -0,0 +1,181 @@
+/** @file
+    @brief Implementation of real-time thread scheduling helpers.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/ThreadScheduling.h>
+#include <osvr/Util/Logger.h>
+#include <osvr/Util/PlatformConfig.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <stdexcept>
+
+#ifdef OSVR_LINUX
+#include <cerrno>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#endif
+
+namespace osvr {
+namespace common {
+    static util::log::Logger &getSchedulingLogger() {
+        static util::log::LoggerPtr logger =
+            util::log::make_logger("ThreadScheduling");
+        return *logger;
+    }
+
+    ThreadSchedulingOptions
+    parseThreadSchedulingOptions(Json::Value const &config) {
+        ThreadSchedulingOptions ret;
+        if (!config.isObject()) {
+            return ret;
+        }
+        auto policy = config.get("policy", "default").asString();
+        if (policy == "fifo") {
+            ret.policy = ThreadSchedulingOptions::Policy::Fifo;
+        } else if (policy == "rr") {
+            ret.policy = ThreadSchedulingOptions::Policy::RoundRobin;
+        } else if (policy != "default") {
+            throw std::invalid_argument("Unrecognized thread scheduling "
+                                        "policy (expected fifo, rr, or "
+                                        "default): " +
+                                        policy);
+        }
+        ret.priority = config.get("priority", ret.priority).asInt();
+        for (auto const &cpu : config["cpus"]) {
+            if (!cpu.isIntegral() || cpu.asInt() < 0) {
+                throw std::invalid_argument("CPU numbers for thread "
+                                            "scheduling must be non-negative "
+                                            "integers.");
+            }
+            ret.cpus.push_back(cpu.asInt());
+        }
+        ret.timerSlackNs = static_cast<long>(
+            config.get("timerSlackNs", Json::Int64(ret.timerSlackNs))
+                .asInt64());
+        return ret;
+    }
+
+#ifdef OSVR_LINUX
+    bool applyThreadScheduling(ThreadSchedulingOptions const &opts,
+                               std::string const &threadName) {
+        auto &log = getSchedulingLogger();
+        bool success = true;
+        if (opts.policy != ThreadSchedulingOptions::Policy::Default) {
+            int policy =
+                opts.policy == ThreadSchedulingOptions::Policy::Fifo ? SCHED_FIFO
+                                                                     : SCHED_RR;
+            sched_param param;
+            std::memset(&param, 0, sizeof(param));
+            param.sched_priority = opts.priority;
+            auto err = pthread_setschedparam(pthread_self(), policy, &param);
+            if (err != 0) {
+                log.warn() << "Could not set real-time scheduling for the "
+                           << threadName << " thread (" << std::strerror(err)
+                           << "), continuing with the default policy.";
+                success = false;
+            } else {
+                log.info() << "Set " << threadName << " thread to "
+                           << (policy == SCHED_FIFO ? "SCHED_FIFO"
+                                                    : "SCHED_RR")
+                           << " priority " << opts.priority;
+            }
+        }
+
+        if (!opts.cpus.empty()) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            bool anyCpu = false;
+            for (auto cpu : opts.cpus) {
+                /// CPU_SET doesn't check its argument.
+                if (cpu < 0 || cpu >= CPU_SETSIZE) {
+                    log.warn() << "Ignoring CPU " << cpu << " for the "
+                               << threadName << " thread: out of range.";
+                    success = false;
+                    continue;
+                }
+                CPU_SET(cpu, &cpus);
+                anyCpu = true;
+            }
+            /// pid 0 means the calling thread.
+            if (anyCpu && sched_setaffinity(0, sizeof(cpus), &cpus) != 0) {
+                log.warn() << "Could not set CPU affinity for the "
+                           << threadName << " thread ("
+                           << std::strerror(errno) << ")";
+                success = false;
+            }
+        }
+
+        if (opts.timerSlackNs >= 0) {
+            /// A slack of 0 would mean "reset to the default", so the
+            /// smallest we can ask for is 1.
+            unsigned long slack =
+                opts.timerSlackNs > 0
+                    ? static_cast<unsigned long>(opts.timerSlackNs)
+                    : 1ul;
+            if (prctl(PR_SET_TIMERSLACK, slack, 0, 0, 0) != 0) {
+                log.warn() << "Could not set timer slack for the "
+                           << threadName << " thread ("
+                           << std::strerror(errno) << ")";
+                success = false;
+            }
+        }
+        return success;
+    }
+
+    bool lockProcessMemory() {
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+            getSchedulingLogger().warn()
+                << "Could not lock process memory (" << std::strerror(errno)
+                << "): may need CAP_IPC_LOCK or a higher RLIMIT_MEMLOCK.";
+            return false;
+        }
+        return true;
+    }
+#else
+    bool applyThreadScheduling(ThreadSchedulingOptions const &opts,
+                               std::string const &threadName) {
+        if (opts.isDefault()) {
+            return true;
+        }
+        getSchedulingLogger().notice()
+            << "Thread scheduling options for the " << threadName
+            << " thread are not supported on this platform, ignoring.";
+        return false;
+    }
+
+    bool lockProcessMemory() {
+        getSchedulingLogger().notice()
+            << "Locking process memory is not supported on this platform.";
+        return false;
+    }
+#endif
+
+} // namespace common
+} // namespace osvr
@@ -0,0 +1,80 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "ThreadTraceBuffer.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstring>
+
+namespace osvr {
+namespace common {
+    namespace tracing {
+        ThreadTraceBuffer::ThreadTraceBuffer(std::size_t capacity,
+                                             std::uint32_t tid)
+            : m_events(capacity), m_head(0), m_tid(tid) {}
+
+        void ThreadTraceBuffer::push(char phase, char category,
+                                     const char *text,
+                                     std::int64_t timestamp) {
+            auto idx = m_head.load(std::memory_order_relaxed);
+            auto &ev = m_events[idx % m_events.size()];
+            ev.timestamp = timestamp;
+            ev.phase = phase;
+            ev.category = category;
+            std::strncpy(ev.name, text, sizeof(ev.name) - 1);
+            ev.name[sizeof(ev.name) - 1] = '\0';
+            m_head.store(idx + 1, std::memory_order_release);
+        }
+
+        void
+        ThreadTraceBuffer::copyEvents(std::vector<TraceEvent> &out) const {
+            const std::uint64_t capacity = m_events.size();
+            auto head = m_head.load(std::memory_order_acquire);
+            auto first = head > capacity ? head - capacity : 0;
+            std::vector<TraceEvent> copy;
+            copy.reserve(static_cast<std::size_t>(head - first));
+            for (auto i = first; i < head; ++i) {
+                copy.push_back(m_events[i % capacity]);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            /// The owner may have wrapped around over the oldest events while
+            /// we copied, and may be mid-write on the slot after its head.
+            auto newHead = m_head.load(std::memory_order_relaxed);
+            auto firstIntact =
+                newHead + 1 > capacity ? newHead + 1 - capacity : 0;
+            auto skip = firstIntact > first ? firstIntact - first : 0;
+            if (skip >= copy.size()) {
+                return;
+            }
+            out.insert(out.end(),
+                       copy.begin() + static_cast<std::ptrdiff_t>(skip),
+                       copy.end());
+        }
+    } // namespace tracing
+} // namespace common
+} // namespace osvr
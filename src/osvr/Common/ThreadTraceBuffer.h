@@ -0,0 +1,87 @@
+/** @file
+    @brief Header for the per-thread event rings behind the portable trace
+    recorder.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_ThreadTraceBuffer_h_GUID_8B61C0D4_2E7A_4F35_9D18_6A4F0E3B72C9
+#define INCLUDED_ThreadTraceBuffer_h_GUID_8B61C0D4_2E7A_4F35_9D18_6A4F0E3B72C9
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace osvr {
+namespace common {
+    namespace tracing {
+        /// @brief A single recorded event, sized to a cache line.
+        struct TraceEvent {
+            /// Nanoseconds since the recorder was created.
+            std::int64_t timestamp;
+            /// Chrome trace-event phase: 'B', 'E', or 'i'
+            char phase;
+            /// 'm' for MainTracePolicy, 'w' for WorkerTracePolicy
+            char category;
+            /// Copied, possibly truncated, NUL-terminated event text.
+            char name[54];
+        };
+
+        /// @brief Fixed-capacity ring of events, written only by its owning
+        /// thread and snapshotted (without locking) by whoever writes the
+        /// trace file. Old events are overwritten once it's full.
+        class ThreadTraceBuffer {
+          public:
+            OSVR_COMMON_EXPORT ThreadTraceBuffer(std::size_t capacity,
+                                                 std::uint32_t tid);
+
+            /// @brief Owning thread only.
+            OSVR_COMMON_EXPORT void push(char phase, char category,
+                                         const char *text,
+                                         std::int64_t timestamp);
+
+            /// @brief Appends the events currently in the buffer, oldest
+            /// first, to @p out, skipping any that the owning thread may have
+            /// overwritten while they were being copied.
+            OSVR_COMMON_EXPORT void
+            copyEvents(std::vector<TraceEvent> &out) const;
+
+            std::uint32_t getThreadId() const { return m_tid; }
+
+          private:
+            std::vector<TraceEvent> m_events;
+            /// Total number of events ever pushed.
+            std::atomic<std::uint64_t> m_head;
+            std::uint32_t m_tid;
+        };
+    } // namespace tracing
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_ThreadTraceBuffer_h_GUID_8B61C0D4_2E7A_4F35_9D18_6A4F0E3B72C9
@@ -0,0 +1,228 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/TracingConfig.h>
+
+#ifdef OSVR_COMMON_TRACING_PORTABLE
+#include "TraceRecorder.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <utility>
+
+#ifdef _WIN32
+#include <process.h>
+#define OSVR_TRACE_THREAD_LOCAL __declspec(thread)
+#else
+#include <unistd.h>
+#define OSVR_TRACE_THREAD_LOCAL __thread
+#endif
+
+namespace osvr {
+namespace common {
+    namespace tracing {
+        /// 64k events (4MB) per thread that traces while recording.
+        static const std::size_t DEFAULT_CAPACITY = 65536;
+
+        /// Plain pointer so it works with compiler-specific thread-local
+        /// storage, and so recording doesn't pay for a thread_local with a
+        /// destructor: the buffers themselves are owned by the recorder.
+        static OSVR_TRACE_THREAD_LOCAL ThreadTraceBuffer *t_buffer = nullptr;
+        static OSVR_TRACE_THREAD_LOCAL bool t_exiting = false;
+
+        namespace {
+            /// Created only on a thread's first event, to hand its buffer
+            /// back to the recorder when the thread exits.
+            struct ThreadBufferReleaser {
+                ~ThreadBufferReleaser() {
+                    t_exiting = true;
+                    if (t_buffer) {
+                        auto buffer = t_buffer;
+                        t_buffer = nullptr;
+                        TraceRecorder::instance().releaseThreadBuffer(buffer);
+                    }
+                }
+            };
+        } // namespace
+
+        TraceRecorder &TraceRecorder::instance() {
+            static TraceRecorder *recorder = new TraceRecorder;
+            return *recorder;
+        }
+
+        static void writeTraceAtExit() { TraceRecorder::instance().write(); }
+
+        TraceRecorder::TraceRecorder()
+            : m_epoch(clock::now()), m_recording(false),
+              m_capacity(DEFAULT_CAPACITY) {
+            const char *capacity = std::getenv("OSVR_TRACE_BUFFER_EVENTS");
+            if (capacity) {
+                auto val = std::strtoul(capacity, nullptr, 10);
+                if (val > 0) {
+                    m_capacity = val;
+                }
+            }
+            const char *filename = std::getenv("OSVR_TRACE_FILE");
+            if (filename && filename[0] != '\0') {
+                start(filename);
+            }
+            std::atexit(&writeTraceAtExit);
+        }
+
+        void TraceRecorder::start(std::string const &filename) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_filename = filename;
+            }
+            m_recording.store(true, std::memory_order_relaxed);
+        }
+
+        void TraceRecorder::record(char phase, char category,
+                                   const char *text) {
+            auto timestamp =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    clock::now() - m_epoch)
+                    .count();
+            auto buffer = m_getThreadBuffer();
+            if (buffer) {
+                buffer->push(phase, category, text, timestamp);
+            }
+        }
+
+        void TraceRecorder::releaseThreadBuffer(ThreadTraceBuffer *buffer) {
+            std::vector<TraceEvent> events;
+            if (isRecording()) {
+                /// Called on the owning thread, so nothing's overwriting it.
+                buffer->copyEvents(events);
+            }
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!events.empty()) {
+                m_numRetired += events.size();
+                m_retired.push_back(
+                    RetiredEvents{buffer->getThreadId(), std::move(events)});
+                while (m_numRetired > m_capacity && m_retired.size() > 1) {
+                    m_numRetired -= m_retired.front().events.size();
+                    m_retired.pop_front();
+                }
+            }
+            auto it = std::find_if(
+                m_buffers.begin(), m_buffers.end(),
+                [&](std::unique_ptr<ThreadTraceBuffer> const &buf) {
+                    return buf.get() == buffer;
+                });
+            if (it != m_buffers.end()) {
+                m_buffers.erase(it);
+            }
+        }
+
+        ThreadTraceBuffer *TraceRecorder::m_getThreadBuffer() {
+            if (!t_buffer && !t_exiting) {
+                static thread_local ThreadBufferReleaser releaser;
+                (void)releaser;
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_buffers.emplace_back(
+                    new ThreadTraceBuffer(m_capacity, ++m_lastThreadId));
+                t_buffer = m_buffers.back().get();
+            }
+            return t_buffer;
+        }
+
+        static void writeEscaped(std::ostream &os, const char *text) {
+            for (; *text; ++text) {
+                auto c = *text;
+                if (c == '"' || c == '\\') {
+                    os << '\\' << c;
+                } else if (static_cast<unsigned char>(c) < 0x20) {
+                    os << ' ';
+                } else {
+                    os << c;
+                }
+            }
+        }
+
+        bool TraceRecorder::write() {
+            if (!isRecording()) {
+                return false;
+            }
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::ofstream os(m_filename.c_str(),
+                             std::ios::out | std::ios::trunc);
+            if (!os) {
+                return false;
+            }
+#ifdef _WIN32
+            const auto pid = _getpid();
+#else
+            const auto pid = getpid();
+#endif
+            os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+            os << std::fixed << std::setprecision(3);
+            bool first = true;
+            auto writeEvents = [&](std::vector<TraceEvent> const &events,
+                                   std::uint32_t tid) {
+                for (auto const &ev : events) {
+                    os << (first ? "\n" : ",\n");
+                    first = false;
+                    os << "{\"name\":\"";
+                    writeEscaped(os, ev.name);
+                    os << "\",\"cat\":\""
+                       << (ev.category == 'w' ? "worker" : "main")
+                       << "\",\"ph\":\"" << ev.phase << "\"";
+                    if (ev.phase == 'i') {
+                        os << ",\"s\":\"t\"";
+                    }
+                    /// Trace-event timestamps are in microseconds.
+                    os << ",\"ts\":" << (ev.timestamp / 1000.0)
+                       << ",\"pid\":" << pid << ",\"tid\":" << tid << "}";
+                }
+            };
+            for (auto const &retired : m_retired) {
+                writeEvents(retired.events, retired.tid);
+            }
+            std::vector<TraceEvent> events;
+            for (auto const &buf : m_buffers) {
+                events.clear();
+                buf->copyEvents(events);
+                writeEvents(events, buf->getThreadId());
+            }
+            os << "\n]}\n";
+            return static_cast<bool>(os);
+        }
+
+        /// Make sure the environment variables are checked at startup, rather
+        /// than on the first call to a tracing function.
+        static const bool s_recorderInitialized =
+            (TraceRecorder::instance(), true);
+    } // namespace tracing
+} // namespace common
+} // namespace osvr
+
+#endif // OSVR_COMMON_TRACING_PORTABLE
@@ -0,0 +1,111 @@
+/** @file
+    @brief Header for the portable, in-process trace event recorder.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_TraceRecorder_h_GUID_5D3A8E21_7C4B_4F96_A1E0_3B9C62D4F817
+#define INCLUDED_TraceRecorder_h_GUID_5D3A8E21_7C4B_4F96_A1E0_3B9C62D4F817
+
+// Internal Includes
+#include "ThreadTraceBuffer.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace osvr {
+namespace common {
+    namespace tracing {
+        /// @brief Process-wide recorder behind the portable tracing backend.
+        class TraceRecorder {
+          public:
+            /// @brief Gets the singleton, which on first use checks the
+            /// OSVR_TRACE_FILE environment variable (and
+            /// OSVR_TRACE_BUFFER_EVENTS for the per-thread capacity) to
+            /// start recording.
+            ///
+            /// Intentionally never destroyed, so threads still tracing during
+            /// shutdown don't touch freed buffers: the trace file is written
+            /// by an atexit handler instead.
+            static TraceRecorder &instance();
+
+            bool isRecording() const {
+                return m_recording.load(std::memory_order_relaxed);
+            }
+
+            void start(std::string const &filename);
+
+            /// @brief Records an event on the calling thread's buffer.
+            void record(char phase, char category, const char *text);
+
+            /// @brief Called as a thread that traced exits: frees its buffer,
+            /// keeping just its events (if recording) for the trace file.
+            void releaseThreadBuffer(ThreadTraceBuffer *buffer);
+
+            /// @brief Writes everything currently buffered to the trace file
+            /// as Chrome trace-event JSON.
+            /// @return false if not recording or the file couldn't be
+            /// written.
+            bool write();
+
+          private:
+            TraceRecorder();
+            /// @return nullptr if the calling thread is already exiting.
+            ThreadTraceBuffer *m_getThreadBuffer();
+
+            typedef std::chrono::steady_clock clock;
+            const clock::time_point m_epoch;
+            std::atomic<bool> m_recording;
+            std::size_t m_capacity;
+
+            /// Protects the members below: taken only on a thread's first
+            /// event and when writing the file.
+            std::mutex m_mutex;
+            std::string m_filename;
+            std::vector<std::unique_ptr<ThreadTraceBuffer> > m_buffers;
+            std::uint32_t m_lastThreadId = 0;
+
+            /// Events of threads that have exited, oldest thread first.
+            struct RetiredEvents {
+                std::uint32_t tid;
+                std::vector<TraceEvent> events;
+            };
+            std::deque<RetiredEvents> m_retired;
+            /// Total events in m_retired, kept to at most one thread buffer's
+            /// capacity by dropping the oldest threads' events.
+            std::size_t m_numRetired = 0;
+        };
+    } // namespace tracing
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_TraceRecorder_h_GUID_5D3A8E21_7C4B_4F96_A1E0_3B9C62D4F817
@@ -31,6 +31,9 @@
 #include <vrpn_WindowsH.h>
 #include <ETWProviders/etwprof.h>
 #endif
+#if OSVR_COMMON_TRACING_PORTABLE
+#include "TraceRecorder.h"
+#endif
 
 // Standard includes
 // - none
@@ -58,6 +61,49 @@ namespace common {
 
         void WorkerTracePolicy::mark(const char *text) { ETWWorkerMark(text); }
 #endif
+
+#if OSVR_COMMON_TRACING_PORTABLE
+        /// The begin stamp isn't needed: the trace-event format pairs begin
+        /// and end events by nesting within a thread.
+        static inline void recordIfEnabled(char phase, char category,
+                                           const char *text) {
+            auto &recorder = TraceRecorder::instance();
+            if (recorder.isRecording()) {
+                recorder.record(phase, category, text);
+            }
+        }
+
+        TraceBeginStamp MainTracePolicy::begin(const char *text) {
+            recordIfEnabled('B', 'm', text);
+            return 0;
+        }
+        void MainTracePolicy::end(const char *text, TraceBeginStamp) {
+            recordIfEnabled('E', 'm', text);
+        }
+
+        void MainTracePolicy::mark(const char *text) {
+            recordIfEnabled('i', 'm', text);
+        }
+
+        TraceBeginStamp WorkerTracePolicy::begin(const char *text) {
+            recordIfEnabled('B', 'w', text);
+            return 0;
+        }
+        void WorkerTracePolicy::end(const char *text, TraceBeginStamp) {
+            recordIfEnabled('E', 'w', text);
+        }
+
+        void WorkerTracePolicy::mark(const char *text) {
+            recordIfEnabled('i', 'w', text);
+        }
+
+        bool startTraceRecording(std::string const &filename) {
+            TraceRecorder::instance().start(filename);
+            return true;
+        }
+
+        bool writeTraceRecording() { return TraceRecorder::instance().write(); }
+#endif
     } // namespace tracing
 } // namespace common
 } // namespace osvr
@@ -0,0 +1,113 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/TrackerBatchComponent.h>
+#include <osvr/Common/BaseDevice.h>
+#include <osvr/Common/Serialization.h>
+#include <osvr/Common/Buffer.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace common {
+    namespace messages {
+        class PoseBatch::MessageSerialization {
+          public:
+            /// @brief Serializes from or deserializes into the given batch.
+            explicit MessageSerialization(TrackerPoseBatch &batch)
+                : m_batch(batch) {}
+
+            template <typename T> void processMessage(T &p) { p(m_batch); }
+
+          private:
+            TrackerPoseBatch &m_batch;
+        };
+        const char *PoseBatch::identifier() {
+            return "com.osvr.tracker.posebatch";
+        }
+    } // namespace messages
+
+    shared_ptr<TrackerBatchComponent>
+    TrackerBatchComponent::create(OSVR_ChannelCount numChan) {
+        shared_ptr<TrackerBatchComponent> ret(
+            new TrackerBatchComponent(numChan));
+        return ret;
+    }
+
+    TrackerBatchComponent::TrackerBatchComponent(OSVR_ChannelCount numChan)
+        : m_numSensor(numChan) {}
+
+    void TrackerBatchComponent::sendPoses(OSVR_PoseState const *poses,
+                                          OSVR_ChannelCount const *sensors,
+                                          std::size_t count,
+                                          OSVR_TimeValue const &timestamp) {
+        m_batch.resize(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            m_batch[i].sensor = sensors ? sensors[i]
+                                        : static_cast<OSVR_ChannelCount>(i);
+            m_batch[i].pose = poses[i];
+        }
+        auto &buf = m_getSendBuffer();
+        messages::PoseBatch::MessageSerialization msg(m_batch);
+        serializeReusing(buf, msg);
+
+        m_getParent().packMessage(buf, poseBatch.getMessageType(), timestamp);
+    }
+
+    int VRPN_CALLBACK
+    TrackerBatchComponent::m_handlePoseBatch(void *userdata,
+                                             vrpn_HANDLERPARAM p) {
+        auto self = static_cast<TrackerBatchComponent *>(userdata);
+        auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
+
+        messages::PoseBatch::MessageSerialization msg(self->m_batch);
+        deserialize(bufReader, msg);
+        auto timestamp = util::time::fromStructTimeval(p.msg_time);
+
+        for (auto const &cb : self->m_cb) {
+            cb(self->m_batch, timestamp);
+        }
+        return 0;
+    }
+
+    void TrackerBatchComponent::registerPoseBatchHandler(
+        PoseBatchHandler handler) {
+        if (m_cb.empty()) {
+            m_registerHandler(&TrackerBatchComponent::m_handlePoseBatch, this,
+                              poseBatch.getMessageType());
+        }
+        m_cb.push_back(handler);
+    }
+    void TrackerBatchComponent::m_parentSet() {
+        m_getParent().registerMessageType(poseBatch);
+    }
+
+} // namespace common
+} // namespace osvr
@@ -80,6 +80,9 @@ namespace connection {
             m_sharedRts = true;
             m_sharedDone = false;
             m_calledRequest = true;
+            if (m_control.m_requestNotifier) {
+                m_control.m_requestNotifier();
+            }
             /// Take the main thread "free to go" status lock.
             {
                 m_lockDone.lock();
@@ -109,11 +112,23 @@ namespace connection {
     AsyncAccessControl::AsyncAccessControl()
         : m_rts(false), m_done(false), m_mainMessage(MTM_WAIT) {}
 
+    void AsyncAccessControl::setRequestNotifier(
+        std::function<void()> const &notifier) {
+        MainLockType lock(m_mut);
+        m_requestNotifier = notifier;
+    }
+
     bool AsyncAccessControl::mainThreadCTS() {
         MainLockType lock(m_mut);
         return m_handleRTS(lock, MTM_CLEAR_TO_SEND);
     }
 
+    bool AsyncAccessControl::mainThreadCTS(
+        std::function<void()> const &beforeGrant) {
+        MainLockType lock(m_mut);
+        return m_handleRTS(lock, MTM_CLEAR_TO_SEND, MTM_WAIT, beforeGrant);
+    }
+
     bool AsyncAccessControl::mainThreadDeny() {
         MainLockType lock(m_mut);
         return m_handleRTS(lock, MTM_DENY_SEND);
@@ -135,9 +150,10 @@ namespace connection {
     }
 
     bool
-    AsyncAccessControl::m_handleRTS(MainLockType &lock,
-                                    MainThreadMessages response,
-                                    MainThreadMessages postCompletionState) {
+    AsyncAccessControl::m_handleRTS(
+        MainLockType &lock, MainThreadMessages response,
+        MainThreadMessages postCompletionState,
+        std::function<void()> const &beforeResponse) {
         if (!lock.owns_lock() || (lock.mutex() != &m_mut)) {
             throw std::logic_error(
                 "m_handleRTS requires its caller to pass a lock "
@@ -148,6 +164,9 @@ namespace connection {
         }
 
         // In here, then, there must be an RTS.
+        if (beforeResponse) {
+            beforeResponse();
+        }
         m_mainMessage = response;
         lock.unlock(); // Unlock to let the requestor through.
         m_condAsyncThread.notify_one();
@@ -34,7 +34,7 @@
 #include <boost/optional/optional.hpp>
 
 // Standard includes
-// - none
+#include <functional>
 
 namespace osvr {
 namespace connection {
@@ -55,6 +55,14 @@ namespace connection {
         /// @returns true if there was a request to send.
         bool mainThreadCTS();
 
+        /// @overload
+        ///
+        /// @param beforeGrant Called if there is a request to send, while the
+        /// async thread waits for permission: everything it did before
+        /// requesting is visible, and nothing it sends with permission has
+        /// happened yet.
+        bool mainThreadCTS(std::function<void()> const &beforeGrant);
+
         /// @brief Check for waiting async thread, and deny it permission to
         /// send if
         /// found.
@@ -67,6 +75,11 @@ namespace connection {
         /// @returns true if there was a request to send.
         bool mainThreadDenyPermanently();
 
+        /// @brief Sets a function called (from the async thread) each time a
+        /// request to send is posted, to wake up the main thread if it is
+        /// waiting for something to do. Set before the async thread starts.
+        void setRequestNotifier(std::function<void()> const &notifier);
+
       private:
         /// @brief Messages/status that may be set by the main thread for read
         /// by
@@ -84,8 +97,9 @@ namespace connection {
 
         /// @brief Shared code to handle an RTS and send a message.
         ///
-        /// Blocks until the message is handled (the RTS object is destroyed),
-        /// then sets the message to the given post-completion state.
+        /// Calls beforeResponse, if given, once an RTS is found. Blocks until
+        /// the message is handled (the RTS object is destroyed), then sets the
+        /// message to the given post-completion state.
         ///
         /// If an RTS was handled, the lock given will be unlocked on return.
         ///
@@ -94,7 +108,9 @@ namespace connection {
         /// @returns true if an RTS was handled
         /// @throws std::logic_error if lock precondition not met
         bool m_handleRTS(MainLockType &lock, MainThreadMessages response,
-                         MainThreadMessages postCompletionState = MTM_WAIT);
+                         MainThreadMessages postCompletionState = MTM_WAIT,
+                         std::function<void()> const &beforeResponse =
+                             std::function<void()>());
 
         /// @brief mutex keeping the main thread from running away before the
         /// async is done.
@@ -104,6 +120,8 @@ namespace connection {
 
         boost::optional<boost::thread::id> m_currentRequestThread;
 
+        std::function<void()> m_requestNotifier;
+
         /// @brief For the main thread sleep/wake awaiting completion of the
         /// async thread's work.
         boost::condition_variable m_condMainThread;
@@ -27,6 +27,9 @@
 // Internal Includes
 #include "AsyncDeviceToken.h"
 #include <osvr/Connection/ConnectionDevice.h>
+#include <osvr/Connection/Connection.h>
+#include <osvr/Util/LogNames.h>
+#include <osvr/Util/Logger.h>
 #include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
@@ -40,8 +43,14 @@ namespace connection {
     using boost::unique_lock;
     using boost::mutex;
 
-    AsyncDeviceToken::AsyncDeviceToken(std::string const &name)
-        : OSVR_DeviceTokenObject(name) {}
+    AsyncDeviceToken::AsyncDeviceToken(
+        std::string const &name, uint32_t sendQueueCapacity,
+        OSVR_AsyncSendOverflowPolicy overflowPolicy)
+        : OSVR_DeviceTokenObject(name),
+          m_sendQueue(sendQueueCapacity ? sendQueueCapacity
+                                        : AsyncSendQueue::DEFAULT_CAPACITY,
+                      overflowPolicy),
+          m_log(util::log::make_logger(util::log::OSVR_SERVER_LOG)) {}
 
     AsyncDeviceToken::~AsyncDeviceToken() {
         OSVR_DEV_VERBOSE("AsyncDeviceToken\t"
@@ -54,6 +63,7 @@ namespace connection {
         OSVR_DEV_VERBOSE("AsyncDeviceToken\t"
                          "In signalShutdown");
         m_run.signalShutdown();
+        m_sendQueue.close();
         m_accessControl.mainThreadDenyPermanently();
     }
 
@@ -96,6 +106,12 @@ namespace connection {
     }
     void AsyncDeviceToken::m_ensureThreadStarted() {
         if ((!m_callbackThread) && m_cb) {
+            /// Wake up the server thread as soon as we have something to send,
+            /// in case it's waiting for activity rather than polling. (We hold
+            /// a reference to the connection for our whole lifetime.)
+            auto conn = m_getConnection().get();
+            m_accessControl.setRequestNotifier(
+                [conn] { conn->signalActivity(); });
             m_callbackThread.reset(
                 new boost::thread(WaitCallbackLoop(m_run, m_cb)));
             m_run.signalAndWaitForStart();
@@ -105,22 +121,76 @@ namespace connection {
     void AsyncDeviceToken::m_sendData(util::time::TimeValue const &timestamp,
                                       MessageType *type, const char *bytestream,
                                       size_t len) {
-        OSVR_DEV_VERBOSE("AsyncDeviceToken::m_sendData\t"
-                         "about to create RTS object");
-        RequestToSend rts(m_accessControl);
-
-        bool clear = rts.request();
-        if (!clear) {
+        if (m_inSendTransaction()) {
+            /// The transaction holds the send guard, so the server thread is
+            /// parked waiting for us: queueing would leave the message for
+            /// it to send later (and, with a full queue and the blocking
+            /// policy, wait forever). Send it ourselves instead, after
+            /// anything queued before, so the order is kept.
+            m_sendQueued();
+            m_getConnectionDevice()->sendData(timestamp, type, bytestream,
+                                              len);
+            m_signalAfterTransaction = true;
+            return;
+        }
+        bool wasEmpty;
+        if (!m_sendQueue.push(timestamp, type, bytestream, len, wasEmpty)) {
             OSVR_DEV_VERBOSE("AsyncDeviceToken::m_sendData\t"
-                             "RTS request responded with not clear to send.");
+                             "Send queue full or closed, message dropped.");
+            return;
+        }
+        m_queued(wasEmpty);
+    }
+
+    bool AsyncDeviceToken::m_sendPackedReport(PackedReportFunction f,
+                                              void *userdata, const char *data,
+                                              size_t len) {
+        if (m_inSendTransaction()) {
+            /// As in m_sendData: the server thread is waiting on us.
+            m_sendQueued();
+            f(userdata, data, len, true);
+            m_signalAfterTransaction = true;
+            return true;
+        }
+        bool wasEmpty;
+        if (!m_sendQueue.pushReport(f, userdata, data, len, wasEmpty)) {
+            OSVR_DEV_VERBOSE("AsyncDeviceToken::m_sendPackedReport\t"
+                             "Send queue full or closed, report dropped.");
+            return false;
+        }
+        m_queued(wasEmpty);
+        return true;
+    }
+
+    void AsyncDeviceToken::m_queued(bool wasEmpty) {
+        if (!wasEmpty) {
+            /// Whoever queued the message ahead of ours woke the server
+            /// thread, which will send ours along with it.
             return;
         }
+        m_getConnection()->signalActivity();
+    }
+
+    void AsyncDeviceToken::m_sendTransactionEnded() {
+        /// Wake the server thread once for everything sent in the
+        /// transaction, so it gets flushed promptly.
+        if (m_signalAfterTransaction) {
+            m_signalAfterTransaction = false;
+            m_getConnection()->signalActivity();
+        }
+    }
 
-        OSVR_DEV_VERBOSE("AsyncDeviceToken::m_sendData\t"
-                         "Have CTS!");
-        m_getConnectionDevice()->sendData(timestamp, type, bytestream, len);
-        OSVR_DEV_VERBOSE("AsyncDeviceToken::m_sendData\t"
-                         "done!");
+    void AsyncDeviceToken::m_sendQueued() {
+        auto dev = m_getConnectionDevice();
+        m_sendQueue.drain([&](AsyncSendQueue::Message const &msg) {
+            if (msg.report) {
+                msg.report(msg.userdata, msg.data.data(), msg.data.size(),
+                           true);
+                return;
+            }
+            dev->sendData(msg.timestamp, msg.type, msg.data.data(),
+                          msg.data.size());
+        });
     }
 
     class AsyncSendGuard : public util::GuardInterface {
@@ -138,11 +208,34 @@ namespace connection {
         return ret;
     }
 
+    uint64_t AsyncDeviceToken::m_getDroppedMessageCount() const {
+        return m_sendQueue.getDroppedCount();
+    }
+
     void AsyncDeviceToken::m_connectionInteract() {
         m_ensureThreadStarted();
+        auto drops = m_sendQueue.getDroppedCount();
+        if (drops != m_reportedDrops) {
+            /// Don't warn more than once a second.
+            auto now = util::time::getNow();
+            if (m_reportedDrops == 0 ||
+                util::time::duration(now, m_lastDropWarning) >= 1.0) {
+                m_log->warn() << "Async device " << getName() << " dropped "
+                              << (drops - m_reportedDrops)
+                              << " message(s): send queue overflowed.";
+                m_reportedDrops = drops;
+                m_lastDropWarning = now;
+            }
+        }
         OSVR_DEV_VERBOSE("AsyncDeviceToken::m_connectionInteract\t"
                          "Going to send a CTS if waiting");
-        bool handled = m_accessControl.mainThreadCTS();
+        /// If the async thread is waiting to send through the guard, first
+        /// send what it queued before asking, so the two kinds of send stay in
+        /// order.
+        bool handled = m_accessControl.mainThreadCTS([&] { m_sendQueued(); });
+        /// Then whatever is left, including anything queued while it held
+        /// the guard.
+        m_sendQueued();
         if (handled) {
             OSVR_DEV_VERBOSE("AsyncDeviceToken::m_connectionInteract\t"
                              "Handled an RTS!");
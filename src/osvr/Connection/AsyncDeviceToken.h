@@ -29,6 +29,9 @@
 #include <osvr/Connection/DeviceToken.h>
 #include <osvr/Util/CallbackWrapper.h>
 #include "AsyncAccessControl.h"
+#include "AsyncSendQueue.h"
+#include <osvr/Util/AsyncSendOverflowPolicyC.h>
+#include <osvr/Util/Log.h>
 
 // Library/third-party includes
 #include <boost/thread.hpp>
@@ -41,7 +44,13 @@ namespace osvr {
 namespace connection {
     class AsyncDeviceToken : public OSVR_DeviceTokenObject {
       public:
-        AsyncDeviceToken(std::string const &name);
+        /// @param sendQueueCapacity Capacity of the queue for sendData(), or
+        /// 0 for the default.
+        /// @param overflowPolicy What to do when that queue is full.
+        AsyncDeviceToken(std::string const &name,
+                         uint32_t sendQueueCapacity = 0,
+                         OSVR_AsyncSendOverflowPolicy overflowPolicy =
+                             OSVR_ASYNC_SEND_DROP_NEWEST);
         virtual ~AsyncDeviceToken();
 
         void signalShutdown();
@@ -52,17 +61,36 @@ namespace connection {
         /// The thread will be launched as soon as the first connection
         /// interaction occurs.
         void m_setUpdateCallback(DeviceUpdateCallback const &cb) override;
-        /// Called from the async thread - only permitted to actually
-        /// send data when m_connectionInteract says so.
+        /// Called from the async thread - queues the data for the main
+        /// thread to send in m_connectionInteract, without waiting. Within a
+        /// send transaction, sends it directly, since the main thread is
+        /// then waiting on us.
         void m_sendData(util::time::TimeValue const &timestamp,
                         MessageType *type, const char *bytestream,
                         size_t len) override;
+        /// Called from the async thread - queues the packed report like
+        /// m_sendData, so interface reports don't wait on the send guard.
+        bool m_sendPackedReport(PackedReportFunction f, void *userdata,
+                                const char *data, size_t len) override;
+        /// Called from the async thread - the guard is only granted when
+        /// m_connectionInteract says so.
         util::GuardPtr m_getSendGuard() override;
+        void m_sendTransactionEnded() override;
+        uint64_t m_getDroppedMessageCount() const override;
 
-        /// Called from the main thread - services requests to send from
-        /// the async thread.
+        /// Called from the main thread - services requests to send from the
+        /// async thread, and sends queued data (in order with them).
         void m_connectionInteract() override;
 
+        /// Called from the main thread (or the async thread in a send
+        /// transaction, while the main thread waits) - sends everything
+        /// queued so far, messages and packed reports alike.
+        void m_sendQueued();
+
+        /// Called from the async thread after queueing something: wakes the
+        /// server thread if it went into an empty queue.
+        void m_queued(bool wasEmpty);
+
         void m_stopThreads() override;
 
         void m_ensureThreadStarted();
@@ -71,6 +99,15 @@ namespace connection {
 
         AsyncAccessControl m_accessControl;
 
+        AsyncSendQueue m_sendQueue;
+        /// @brief Set (by the async thread) when a message sent during a
+        /// send transaction needs the server thread woken at its end.
+        bool m_signalAfterTransaction = false;
+        /// @brief Drop count as of the last warning we logged.
+        uint64_t m_reportedDrops = 0;
+        util::time::TimeValue m_lastDropWarning;
+        util::log::LoggerPtr m_log;
+
         ::util::RunLoopManagerBoost m_run;
     };
 } // namespace connection
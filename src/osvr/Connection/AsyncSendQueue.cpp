@@ -0,0 +1,187 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "AsyncSendQueue.h"
+
+// Library/third-party includes
+#include <boost/thread/thread.hpp>
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace connection {
+    static inline AsyncSendQueue::size_type
+    roundUpToPowerOfTwo(AsyncSendQueue::size_type n) {
+        AsyncSendQueue::size_type ret = 2;
+        while (ret < n) {
+            ret <<= 1;
+        }
+        return ret;
+    }
+
+    AsyncSendQueue::AsyncSendQueue(size_type capacity,
+                                   OSVR_AsyncSendOverflowPolicy policy)
+        : m_policy(policy), m_enqueuePos(0), m_dequeuePos(0), m_dropped(0),
+          m_closed(false), m_blockedSenders(0) {
+        auto n = roundUpToPowerOfTwo(capacity);
+        m_slots.reset(new Slot[n]);
+        m_mask = n - 1;
+        for (size_type i = 0; i < n; ++i) {
+            m_slots[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool AsyncSendQueue::push(util::time::TimeValue const &timestamp,
+                              MessageType *type, const char *bytestream,
+                              size_t len) {
+        bool wasEmpty;
+        return push(timestamp, type, bytestream, len, wasEmpty);
+    }
+
+    AsyncSendQueue::~AsyncSendQueue() {
+        while (m_pop([](Message const &msg) { msg.discard(); })) {
+        }
+    }
+
+    bool AsyncSendQueue::push(util::time::TimeValue const &timestamp,
+                              MessageType *type, const char *bytestream,
+                              size_t len, bool &wasEmpty) {
+        return m_push(timestamp, type, nullptr, nullptr, bytestream, len,
+                      wasEmpty);
+    }
+
+    bool AsyncSendQueue::pushReport(PackedReportFunction report,
+                                    void *userdata, const char *data,
+                                    size_t len, bool &wasEmpty) {
+        if (m_push(util::time::TimeValue{}, nullptr, report, userdata, data,
+                   len, wasEmpty)) {
+            return true;
+        }
+        report(userdata, data, len, false);
+        return false;
+    }
+
+    bool AsyncSendQueue::m_push(util::time::TimeValue const &timestamp,
+                                MessageType *type, PackedReportFunction report,
+                                void *userdata, const char *bytestream,
+                                size_t len, bool &wasEmpty) {
+        wasEmpty = false;
+        while (!m_closed.load(std::memory_order_relaxed)) {
+            if (m_tryPush(timestamp, type, report, userdata, bytestream, len,
+                          wasEmpty)) {
+                return true;
+            }
+            switch (m_policy) {
+            case OSVR_ASYNC_SEND_DROP_OLDEST:
+                /// Make room and try again: if we lose the race for the slot
+                /// we freed, we'll just free another.
+                if (m_pop([](Message const &msg) { msg.discard(); })) {
+                    ++m_dropped;
+                }
+                break;
+            case OSVR_ASYNC_SEND_BLOCK: {
+                /// Sleep until the consumer drains something (or we're
+                /// closed), rather than spinning.
+                boost::unique_lock<boost::mutex> lock(m_spaceMutex);
+                ++m_blockedSenders;
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                bool pushed;
+                while (!(pushed = m_tryPush(timestamp, type, report, userdata,
+                                            bytestream, len, wasEmpty)) &&
+                       !m_closed.load()) {
+                    m_spaceCond.wait(lock);
+                }
+                --m_blockedSenders;
+                if (pushed) {
+                    return true;
+                }
+                break;
+            }
+            case OSVR_ASYNC_SEND_DROP_NEWEST:
+            default:
+                ++m_dropped;
+                return false;
+            }
+        }
+        ++m_dropped;
+        return false;
+    }
+
+    void AsyncSendQueue::close() {
+        m_closed.store(true);
+        boost::unique_lock<boost::mutex> lock(m_spaceMutex);
+        m_spaceCond.notify_all();
+    }
+
+    void AsyncSendQueue::m_notifySpaceAvailable() {
+        /// The fence at the end of m_pop orders this load after the slots
+        /// were freed, so a sender that just found the queue full is counted
+        /// here.
+        if (m_blockedSenders.load() > 0) {
+            boost::unique_lock<boost::mutex> lock(m_spaceMutex);
+            m_spaceCond.notify_all();
+        }
+    }
+
+    bool AsyncSendQueue::m_tryPush(util::time::TimeValue const &timestamp,
+                                   MessageType *type,
+                                   PackedReportFunction report, void *userdata,
+                                   const char *bytestream, size_t len,
+                                   bool &wasEmpty) {
+        size_type pos = m_enqueuePos.load(std::memory_order_relaxed);
+        Slot *slot;
+        for (;;) {
+            slot = &m_slots[pos & m_mask];
+            auto seq = slot->seq.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq) -
+                        static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (m_enqueuePos.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                /// Full.
+                return false;
+            } else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        slot->msg.timestamp = timestamp;
+        slot->msg.type = type;
+        slot->msg.report = report;
+        slot->msg.userdata = userdata;
+        slot->msg.data.assign(bytestream, bytestream + len);
+        slot->seq.store(pos + 1, std::memory_order_release);
+        /// Pairs with the fence in m_pop: if the consumer has already taken
+        /// everything before this message, it may have stopped at this slot
+        /// before we filled it, and has to be woken.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        wasEmpty = (m_dequeuePos.load(std::memory_order_relaxed) == pos);
+        return true;
+    }
+} // namespace connection
+} // namespace osvr
@@ -0,0 +1,206 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_AsyncSendQueue_h_GUID_8C2D5E47_1B3A_4F6E_A09D_7E4C1F2B6D38
+#define INCLUDED_AsyncSendQueue_h_GUID_8C2D5E47_1B3A_4F6E_A09D_7E4C1F2B6D38
+
+// Internal Includes
+#include <osvr/Connection/DeviceToken.h>
+#include <osvr/Connection/MessageTypePtr.h>
+#include <osvr/Util/AsyncSendOverflowPolicyC.h>
+#include <osvr/Util/StdInt.h>
+#include <osvr/Util/TimeValue.h>
+#include <osvr/Util/UniquePtr.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+
+// Standard includes
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace osvr {
+namespace connection {
+    /// @brief A bounded, lock-free queue of timestamped messages and packed
+    /// reports, filled by any number of (async device) threads and drained by
+    /// the main thread.
+    ///
+    /// Each slot keeps its data buffer between uses, so once the buffers have
+    /// grown to the message sizes in use, neither side allocates.
+    class AsyncSendQueue : boost::noncopyable {
+      public:
+        typedef std::size_t size_type;
+        static const size_type DEFAULT_CAPACITY = 256;
+
+        /// @brief Constructor
+        ///
+        /// @param capacity Maximum number of queued messages, rounded up to a
+        /// power of two.
+        /// @param policy What push() does when the queue is full.
+        explicit AsyncSendQueue(
+            size_type capacity = DEFAULT_CAPACITY,
+            OSVR_AsyncSendOverflowPolicy policy = OSVR_ASYNC_SEND_DROP_NEWEST);
+
+        /// @brief Destructor - releases any packed reports still queued.
+        ~AsyncSendQueue();
+
+        /// @brief Copies a message into the queue, applying the overflow
+        /// policy if it's full. Safe to call from any thread.
+        ///
+        /// @returns false if this message was dropped (because the queue was
+        /// full or has been closed).
+        bool push(util::time::TimeValue const &timestamp, MessageType *type,
+                  const char *bytestream, size_t len);
+
+        /// @overload
+        ///
+        /// @param[out] wasEmpty Set to whether this message went into an
+        /// empty queue, in which case the consumer may need waking: a message
+        /// pushed behind others will be drained along with them.
+        bool push(util::time::TimeValue const &timestamp, MessageType *type,
+                  const char *bytestream, size_t len, bool &wasEmpty);
+
+        /// @brief Copies a packed report (see
+        /// OSVR_DeviceTokenObject::sendPackedReport()) into the queue, like
+        /// push(). If it's dropped, by this call or later on overflow, report
+        /// is called with send set to false.
+        bool pushReport(PackedReportFunction report, void *userdata,
+                        const char *data, size_t len, bool &wasEmpty);
+
+        /// @brief A message taken from the queue: only valid in the callback
+        /// it is passed to.
+        struct Message {
+            util::time::TimeValue timestamp;
+            MessageType *type;
+            std::vector<char> data;
+            /// @brief Set if this is a packed report rather than a message to
+            /// send as-is: call it with the data (and userdata) instead.
+            PackedReportFunction report = nullptr;
+            void *userdata = nullptr;
+
+            /// @brief Releases a packed report without sending it.
+            void discard() const {
+                if (report) {
+                    report(userdata, data.data(), data.size(), false);
+                }
+            }
+        };
+
+        /// @brief Takes all messages currently queued, in order, passing each
+        /// to the given function.
+        ///
+        /// Only one thread may drain at a time.
+        ///
+        /// @returns the number of messages handled.
+        template <typename F> size_type drain(F &&f) {
+            size_type n = 0;
+            while (m_pop([&](Message const &msg) { f(msg); })) {
+                ++n;
+            }
+            if (n > 0) {
+                m_notifySpaceAvailable();
+            }
+            return n;
+        }
+
+        /// @brief Refuse any further messages, and release any thread blocked
+        /// in push(). Messages already queued may still be drained.
+        void close();
+
+        /// @brief Number of messages dropped so far due to overflow (or
+        /// sending after close()).
+        uint64_t getDroppedCount() const { return m_dropped.load(); }
+
+        size_type capacity() const { return m_mask + 1; }
+
+      private:
+        struct Slot {
+            std::atomic<size_type> seq;
+            Message msg;
+        };
+
+        bool m_push(util::time::TimeValue const &timestamp, MessageType *type,
+                    PackedReportFunction report, void *userdata,
+                    const char *bytestream, size_t len, bool &wasEmpty);
+
+        bool m_tryPush(util::time::TimeValue const &timestamp,
+                       MessageType *type, PackedReportFunction report,
+                       void *userdata, const char *bytestream, size_t len,
+                       bool &wasEmpty);
+
+        /// @brief Wakes any sender blocked waiting for room.
+        void m_notifySpaceAvailable();
+
+        /// @brief Takes the oldest message, if any, passing it to f.
+        template <typename F> bool m_pop(F &&f) {
+            size_type pos = m_dequeuePos.load(std::memory_order_relaxed);
+            Slot *slot;
+            for (;;) {
+                slot = &m_slots[pos & m_mask];
+                auto seq = slot->seq.load(std::memory_order_acquire);
+                auto diff = static_cast<std::ptrdiff_t>(seq) -
+                            static_cast<std::ptrdiff_t>(pos + 1);
+                if (diff == 0) {
+                    if (m_dequeuePos.compare_exchange_weak(
+                            pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    /// Empty (or the next message isn't finished yet: its
+                    /// sender will see this and know to wake us).
+                    return false;
+                } else {
+                    pos = m_dequeuePos.load(std::memory_order_relaxed);
+                }
+            }
+            f(slot->msg);
+            slot->seq.store(pos + m_mask + 1, std::memory_order_release);
+            /// Pairs with the fence in m_tryPush: either the next sender
+            /// sees we've caught up to it, or we see its message.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            return true;
+        }
+
+        unique_ptr<Slot[]> m_slots;
+        size_type m_mask;
+        OSVR_AsyncSendOverflowPolicy m_policy;
+        std::atomic<size_type> m_enqueuePos;
+        std::atomic<size_type> m_dequeuePos;
+        std::atomic<uint64_t> m_dropped;
+        std::atomic<bool> m_closed;
+
+        /// @name Blocking senders (OSVR_ASYNC_SEND_BLOCK)
+        /// @{
+        boost::mutex m_spaceMutex;
+        boost::condition_variable m_spaceCond;
+        std::atomic<std::size_t> m_blockedSenders;
+        /// @}
+    };
+} // namespace connection
+} // namespace osvr
+
+#endif // INCLUDED_AsyncSendQueue_h_GUID_8C2D5E47_1B3A_4F6E_A09D_7E4C1F2B6D38
@@ -36,6 +36,7 @@
 // Library/third-party includes
 #include <boost/range/algorithm.hpp>
 #include <boost/assert.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 
 // Standard includes
 // - none
@@ -149,6 +150,37 @@ namespace connection {
         }
     }
 
+    void Connection::signalActivity() {
+        {
+            boost::unique_lock<boost::mutex> lock(m_activityMutex);
+            m_activityPending = true;
+        }
+        m_activityCond.notify_all();
+        m_activitySignalled();
+    }
+
+    bool Connection::waitForActivity(int microseconds) {
+        boost::unique_lock<boost::mutex> lock(m_activityMutex);
+        if (!m_activityPending && microseconds > 0) {
+            m_activityCond.timed_wait(
+                lock, boost::posix_time::microseconds(microseconds),
+                [&] { return m_activityPending; });
+        }
+        auto ret = m_activityPending;
+        m_activityPending = false;
+        return ret;
+    }
+
+    bool Connection::waitForActivityOrMessages(int microseconds) {
+        return m_waitForActivityOrMessages(microseconds);
+    }
+
+    bool Connection::m_waitForActivityOrMessages(int microseconds) {
+        return waitForActivity(microseconds);
+    }
+
+    void Connection::m_activitySignalled() {}
+
     void Connection::registerConnectionHandler(std::function<void()> handler) {
         m_registerConnectionHandler(handler);
     }
@@ -162,6 +194,38 @@ namespace connection {
         }
     }
 
+    void Connection::setDirectReportDispatch(
+        common::DirectReportDispatchPtr const &dispatch) {
+        m_directDispatch = dispatch;
+    }
+
+    common::DirectReportDispatchPtr const &
+    Connection::getDirectReportDispatch() const {
+        return m_directDispatch;
+    }
+
+    void
+    Connection::setSharedPathTree(common::PathTreeOwnerPtr const &tree) {
+        m_sharedTree = tree;
+    }
+
+    common::PathTreeOwnerPtr const &Connection::getSharedPathTree() const {
+        return m_sharedTree;
+    }
+
+    void Connection::setReportRateLimits(ReportRateLimits const &limits) {
+        m_reportRateLimits = limits;
+    }
+
+    ReportRateLimit
+    Connection::getReportRateLimit(std::string const &deviceName) const {
+        auto it = m_reportRateLimits.find(deviceName);
+        if (it == m_reportRateLimits.end()) {
+            return ReportRateLimit();
+        }
+        return it->second;
+    }
+
     Connection::Connection()
         : m_log(util::log::make_logger(util::log::OSVR_SERVER_LOG)) {}
 
@@ -53,6 +53,12 @@ void OSVR_DeviceInitObject::setName(std::string const &n) {
     }
 }
 
+void OSVR_DeviceInitObject::setAsyncSendQueue(
+    uint32_t capacity, OSVR_AsyncSendOverflowPolicy policy) {
+    m_asyncSendQueueCapacity = capacity;
+    m_asyncSendOverflowPolicy = policy;
+}
+
 template <typename T>
 inline bool setOptional(OSVR_ChannelCount input, T ptr,
                         boost::optional<OSVR_ChannelCount> &dest) {
@@ -30,12 +30,14 @@
 #include <osvr/Connection/DeviceInitObject.h>
 #include <osvr/Connection/Connection.h>
 #include <osvr/Connection/ConnectionDevice.h>
+#include <osvr/Util/GuardInterfaceDummy.h>
 
 // Library/third-party includes
 // - none
 
 // Standard includes
 #include <stdexcept>
+#include <utility>
 
 using osvr::connection::DeviceTokenPtr;
 using osvr::connection::DeviceInitObject;
@@ -44,12 +46,15 @@ using osvr::connection::SyncDeviceToken;
 using osvr::connection::VirtualDeviceToken;
 using osvr::connection::ConnectionPtr;
 using osvr::connection::MessageType;
+using osvr::connection::PackedReportFunction;
 using osvr::connection::ConnectionDevicePtr;
 using osvr::util::GuardPtr;
 
 DeviceTokenPtr
 OSVR_DeviceTokenObject::createAsyncDevice(DeviceInitObject &init) {
-    DeviceTokenPtr ret(new AsyncDeviceToken(init.getQualifiedName()));
+    DeviceTokenPtr ret(new AsyncDeviceToken(
+        init.getQualifiedName(), init.getAsyncSendQueueCapacity(),
+        init.getAsyncSendOverflowPolicy()));
     ret->m_sharedInit(init);
     return ret;
 }
@@ -90,7 +95,62 @@ void OSVR_DeviceTokenObject::sendData(
     m_sendData(timestamp, type, bytestream, len);
 }
 
-GuardPtr OSVR_DeviceTokenObject::getSendGuard() { return m_getSendGuard(); }
+bool OSVR_DeviceTokenObject::sendPackedReport(PackedReportFunction f,
+                                              void *userdata, const char *data,
+                                              size_t len) {
+    return m_sendPackedReport(f, userdata, data, len);
+}
+
+bool OSVR_DeviceTokenObject::m_sendPackedReport(PackedReportFunction f,
+                                                void *userdata,
+                                                const char *data, size_t len) {
+    auto guard = getSendGuard();
+    if (!guard->lock()) {
+        f(userdata, data, len, false);
+        return false;
+    }
+    f(userdata, data, len, true);
+    return true;
+}
+
+GuardPtr OSVR_DeviceTokenObject::getSendGuard() {
+    if (m_inSendTransaction()) {
+        return osvr::util::DummyGuard::getShared();
+    }
+    return m_getSendGuard();
+}
+
+bool OSVR_DeviceTokenObject::beginSendTransaction() {
+    if (!m_inSendTransaction()) {
+        auto guard = m_getSendGuard();
+        if (!guard->lock()) {
+            return false;
+        }
+        m_transactionGuard = std::move(guard);
+    }
+    ++m_sendTransactionDepth;
+    return true;
+}
+
+bool OSVR_DeviceTokenObject::endSendTransaction() {
+    if (!m_inSendTransaction()) {
+        return false;
+    }
+    --m_sendTransactionDepth;
+    if (!m_inSendTransaction()) {
+        m_transactionGuard.reset();
+        m_sendTransactionEnded();
+    }
+    return true;
+}
+
+void OSVR_DeviceTokenObject::m_sendTransactionEnded() {}
+
+uint64_t OSVR_DeviceTokenObject::getDroppedMessageCount() const {
+    return m_getDroppedMessageCount();
+}
+
+uint64_t OSVR_DeviceTokenObject::m_getDroppedMessageCount() const { return 0; }
 
 void OSVR_DeviceTokenObject::setUpdateCallback(
     osvr::connection::DeviceUpdateCallback const &cb) {
@@ -0,0 +1,137 @@
+/** @file
+    @brief Header
+
+    Internal to osvrConnection.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_ReportCoalescer_h_GUID_3C8E1F07_9B2D_4A65_8E41_7D0F5B2A96C3
+#define INCLUDED_ReportCoalescer_h_GUID_3C8E1F07_9B2D_4A65_8E41_7D0F5B2A96C3
+
+// Internal Includes
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+#include <vector>
+
+namespace osvr {
+namespace connection {
+    /// @brief Limits the rate at which state reports (ones that each replace
+    /// the last, like poses) are sent, independently for each of a number of
+    /// slots (typically, sensors).
+    ///
+    /// A report offered when its slot has gone at least the minimum interval
+    /// without sending is sent right away. Otherwise it's held back, replacing
+    /// any report already held for the slot, until flush() finds the interval
+    /// has passed - so the latest state always goes out, just no more often
+    /// than the rate allows.
+    ///
+    /// Not thread-safe: a device's reports and its flushes are serialized by
+    /// the server loop anyway.
+    template <typename ReportType> class ReportCoalescer {
+      public:
+        /// @param maxRate Maximum reports per second per slot, or 0 (or less)
+        /// for no limit, in which case every report is sent right away.
+        explicit ReportCoalescer(double maxRate = 0)
+            : m_minInterval(maxRate > 0 ? 1. / maxRate : 0) {}
+
+        /// @brief Whether any reports might be held back.
+        bool isEnabled() const { return m_minInterval > 0; }
+
+        /// @brief Offers a report for a slot.
+        ///
+        /// @return true if it should be sent now, false if it's been held.
+        bool offer(std::size_t slot, ReportType const &report,
+                   util::time::TimeValue const &now) {
+            if (!isEnabled()) {
+                return true;
+            }
+            if (slot >= m_slots.size()) {
+                m_slots.resize(slot + 1);
+            }
+            auto &s = m_slots[slot];
+            if (m_isDue(s, now)) {
+                // Anything held is superseded by this report.
+                m_markSent(s, now);
+                return true;
+            }
+            if (!s.pending) {
+                s.pending = true;
+                ++m_numPending;
+            }
+            s.report = report;
+            return false;
+        }
+
+        /// @brief Calls `f(slot, report)` for each held report whose slot may
+        /// send again as of now, and forgets it.
+        template <typename F>
+        void flush(util::time::TimeValue const &now, F &&f) {
+            if (m_numPending == 0) {
+                return;
+            }
+            for (std::size_t i = 0, e = m_slots.size(); i < e; ++i) {
+                auto &s = m_slots[i];
+                if (s.pending && m_isDue(s, now)) {
+                    m_markSent(s, now);
+                    f(i, s.report);
+                }
+            }
+        }
+
+        /// @brief Number of reports currently held.
+        std::size_t numPending() const { return m_numPending; }
+
+      private:
+        struct Slot {
+            bool everSent = false;
+            bool pending = false;
+            util::time::TimeValue lastSent;
+            ReportType report;
+        };
+
+        bool m_isDue(Slot const &s, util::time::TimeValue const &now) const {
+            return !s.everSent ||
+                   util::time::duration(now, s.lastSent) >= m_minInterval;
+        }
+
+        void m_markSent(Slot &s, util::time::TimeValue const &now) {
+            s.everSent = true;
+            s.lastSent = now;
+            if (s.pending) {
+                s.pending = false;
+                --m_numPending;
+            }
+        }
+
+        double m_minInterval;
+        std::vector<Slot> m_slots;
+        std::size_t m_numPending = 0;
+    };
+} // namespace connection
+} // namespace osvr
+
+#endif // INCLUDED_ReportCoalescer_h_GUID_3C8E1F07_9B2D_4A65_8E41_7D0F5B2A96C3
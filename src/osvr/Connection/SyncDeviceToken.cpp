@@ -56,7 +56,7 @@ namespace connection {
     }
 
     util::GuardPtr SyncDeviceToken::m_getSendGuard() {
-        return util::GuardPtr(new util::DummyGuard);
+        return util::DummyGuard::getShared();
     }
 
     void SyncDeviceToken::m_connectionInteract() {
@@ -54,7 +54,7 @@ namespace connection {
     }
 
     util::GuardPtr VirtualDeviceToken::m_getSendGuard() {
-        return util::GuardPtr(new util::DummyGuard);
+        return util::DummyGuard::getShared();
     }
 
     void VirtualDeviceToken::m_connectionInteract() {}
@@ -27,9 +27,13 @@
 
 // Internal Includes
 #include "DeviceConstructionData.h"
+#include "ReportCoalescer.h"
+#include "VrpnBaseFlexServer.h"
+#include <osvr/Connection/Connection.h>
 #include <osvr/Connection/AnalogServerInterface.h>
 
 // Library/third-party includes
+#include <boost/assert.hpp>
 #include <vrpn_Analog.h>
 
 // Standard includes
@@ -48,6 +52,18 @@ namespace connection {
             memset(Base::channel, 0, sizeof(Base::channel));
             memset(Base::last, 0, sizeof(Base::last));
 
+            // Hold back value changes that would exceed the configured rate.
+            auto limit = init.obj.getConnection()->getReportRateLimit(
+                init.getQualifiedName());
+            m_changes = ChangeCoalescer(limit.analog);
+            if (m_changes.isEnabled()) {
+                BOOST_ASSERT_MSG(init.flexServer, "The base flex server "
+                                                  "should be constructed "
+                                                  "first!");
+                init.flexServer->registerMainloopCallback(
+                    [&] { m_sendHeldChanges(); });
+            }
+
             // Report interface out.
             init.obj.returnAnalogInterface(*this);
         }
@@ -81,11 +97,30 @@ namespace connection {
         void m_setNumChannels(OSVR_ChannelCount chans) {
             Base::num_channel = chans;
         }
+        /// All channels go in one report, so they share a single slot: the
+        /// held timestamp is that of the latest change, and the values are
+        /// just the current ones.
+        typedef ReportCoalescer<util::time::TimeValue> ChangeCoalescer;
+
         void m_reportChanges(util::time::TimeValue const &tv) {
+            if (m_changes.isEnabled() &&
+                !m_changes.offer(0, tv, util::time::getNow())) {
+                return;
+            }
+            m_sendChanges(tv);
+        }
+        void m_sendHeldChanges() {
+            m_changes.flush(util::time::getNow(),
+                            [&](std::size_t, util::time::TimeValue const &tv) {
+                                m_sendChanges(tv);
+                            });
+        }
+        void m_sendChanges(util::time::TimeValue const &tv) {
             struct timeval t;
             util::time::toStructTimeval(t, tv);
             Base::report_changes(CLASS_OF_SERVICE, t);
         }
+        ChangeCoalescer m_changes;
     };
 
 } // namespace connection
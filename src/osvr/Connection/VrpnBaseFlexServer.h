@@ -35,7 +35,8 @@
 #include <vrpn_BaseClass.h>
 
 // Standard includes
-// - none
+#include <functional>
+#include <vector>
 
 namespace osvr {
 namespace connection {
@@ -60,6 +61,10 @@ namespace connection {
             /// Service device components in the BaseDevice.
             update();
 
+            for (auto const &cb : m_mainloopCallbacks) {
+                cb();
+            }
+
             server_mainloop();
         }
         void sendData(util::time::TimeValue const &timestamp, vrpn_uint32 msgID,
@@ -70,11 +75,21 @@ namespace connection {
                                        vrpn_CONNECTION_LOW_LATENCY);
         }
 
+        /// @brief Registers a function to be called each time through
+        /// mainloop(), before servicing the connection - for instance, to
+        /// send reports that were held back.
+        void registerMainloopCallback(std::function<void()> const &cb) {
+            m_mainloopCallbacks.push_back(cb);
+        }
+
       protected:
         virtual int register_types() { return 0; }
         virtual void m_update() {
             // can be empty since we handle things in mainloop above.
         }
+
+      private:
+        std::vector<std::function<void()> > m_mainloopCallbacks;
     };
 } // namespace connection
 } // namespace osvr
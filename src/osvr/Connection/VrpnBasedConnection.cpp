@@ -33,7 +33,7 @@
 // - none
 
 // Standard includes
-// - none
+#include <string>
 
 namespace osvr {
 namespace connection {
@@ -77,8 +77,16 @@ namespace connection {
         if (0 == port) {
             port = vrpn_DEFAULT_LISTEN_PORT_NO;
         }
-        m_vrpnConnection = vrpn_ConnectionPtr::create_server_connection(
-            port, nullptr, nullptr, iface);
+        if (iface && std::string(iface) == "loopback:") {
+            m_vrpnConnection = vrpn_ConnectionPtr::create_server_connection(
+                port, nullptr, nullptr, iface);
+            return;
+        }
+        /// Our own subclass, so the server loop can block on its sockets.
+        m_serverConn =
+            new VrpnServerConnection(static_cast<unsigned short>(port), iface);
+        m_serverConn->setAutoDeleteStatus(true);
+        m_vrpnConnection = vrpn_ConnectionPtr(m_serverConn);
     }
 
     MessageTypePtr
@@ -122,9 +130,21 @@ namespace connection {
         }
         return 0;
     }
-    void VrpnBasedConnection::m_process() {
-        /// @todo there's an optional timeout here - see that we use it properly
-        m_vrpnConnection->mainloop();
+
+    void VrpnBasedConnection::m_process() { m_vrpnConnection->mainloop(); }
+
+    bool VrpnBasedConnection::m_waitForActivityOrMessages(int microseconds) {
+        if (!m_serverConn) {
+            return waitForActivity(microseconds);
+        }
+        return m_serverConn->waitForReadable(
+            microseconds, [&] { return waitForActivity(0); });
+    }
+
+    void VrpnBasedConnection::m_activitySignalled() {
+        if (m_serverConn) {
+            m_serverConn->wake();
+        }
     }
 
     VrpnBasedConnection::~VrpnBasedConnection() {
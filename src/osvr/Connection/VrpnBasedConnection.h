@@ -27,6 +27,7 @@
 
 // Internal Includes
 #include <osvr/Connection/Connection.h>
+#include "VrpnServerConnection.h"
 #include <osvr/Common/NetworkingSupport.h>
 
 // Library/third-party includes
@@ -73,6 +74,8 @@ namespace connection {
         m_createConnectionDevice(DeviceInitObject &init);
         virtual void m_registerConnectionHandler(std::function<void()> handler);
         virtual void m_process();
+        virtual bool m_waitForActivityOrMessages(int microseconds);
+        virtual void m_activitySignalled();
 
         static int VRPN_CALLBACK m_connectionHandler(void *userdata,
                                                      vrpn_HANDLERPARAM);
@@ -80,6 +83,10 @@ namespace connection {
         vrpn_ConnectionPtr m_vrpnConnection;
         std::vector<std::function<void()> > m_connectionHandlers;
         common::NetworkingSupport m_network;
+        /// @brief The same object as m_vrpnConnection, unless that is a
+        /// loopback connection (which has no sockets to wait on), in which
+        /// case this is null.
+        VrpnServerConnection *m_serverConn = nullptr;
     };
 
 } // namespace connection
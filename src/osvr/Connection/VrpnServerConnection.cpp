@@ -0,0 +1,205 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "VrpnServerConnection.h"
+#include <osvr/Util/Verbosity.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstring>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace osvr {
+namespace connection {
+    namespace {
+        inline void closeSocket(SOCKET s) {
+#ifdef _WIN32
+            closesocket(s);
+#else
+            close(s);
+#endif
+        }
+
+        inline bool setNonBlocking(SOCKET s) {
+#ifdef _WIN32
+            u_long nonBlocking = 1;
+            return 0 == ioctlsocket(s, FIONBIO, &nonBlocking);
+#else
+            int flags = fcntl(s, F_GETFL, 0);
+            return flags != -1 && 0 == fcntl(s, F_SETFL, flags | O_NONBLOCK);
+#endif
+        }
+
+        /// @brief Opens a non-blocking UDP socket bound to a loopback port
+        /// and connected to itself, so sending a datagram makes it readable.
+        SOCKET openWakeSocket() {
+            SOCKET s = socket(AF_INET, SOCK_DGRAM, 0);
+            if (INVALID_SOCKET == s) {
+                return s;
+            }
+            struct sockaddr_in addr;
+            std::memset(&addr, 0, sizeof(addr));
+            addr.sin_family = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            addr.sin_port = 0;
+#ifdef _WIN32
+            int len = sizeof(addr);
+#else
+            socklen_t len = sizeof(addr);
+#endif
+            bool ok =
+                0 == bind(s, reinterpret_cast<struct sockaddr *>(&addr),
+                          sizeof(addr)) &&
+                0 == getsockname(s, reinterpret_cast<struct sockaddr *>(&addr),
+                                 &len) &&
+                0 == connect(s, reinterpret_cast<struct sockaddr *>(&addr),
+                             sizeof(addr)) &&
+                setNonBlocking(s);
+            if (!ok) {
+                closeSocket(s);
+                return INVALID_SOCKET;
+            }
+            return s;
+        }
+    } // namespace
+
+    /// @brief A VRPN endpoint that keeps itself in its connection's set of
+    /// endpoints, so the connection can wait on its sockets.
+    class VrpnServerConnection::Endpoint : public vrpn_Endpoint_IP {
+      public:
+        Endpoint(vrpn_TypeDispatcher *dispatcher, vrpn_int32 *connectedEC,
+                 EndpointSetPtr const &endpoints)
+            : vrpn_Endpoint_IP(dispatcher, connectedEC),
+              m_endpoints(endpoints) {
+            m_endpoints->insert(this);
+        }
+        virtual ~Endpoint() { m_endpoints->erase(this); }
+
+        /// @brief Calls f with each socket this endpoint reads from (some
+        /// may be INVALID_SOCKET).
+        template <typename F> void forEachSocket(F &&f) const {
+            f(d_tcpSocket);
+            f(d_udpInboundSocket);
+        }
+
+      private:
+        EndpointSetPtr m_endpoints;
+    };
+
+    VrpnServerConnection::VrpnServerConnection(unsigned short port,
+                                               const char *NIC)
+        : vrpn_Connection_IP(port, nullptr, nullptr, NIC,
+                             &VrpnServerConnection::m_allocateEndpoint),
+          m_endpoints(std::make_shared<EndpointSet>()),
+          m_wakeSocket(openWakeSocket()), m_waiting(false) {
+        if (INVALID_SOCKET == m_wakeSocket) {
+            OSVR_DEV_VERBOSE("VrpnServerConnection: couldn't open the wake "
+                             "socket, waits won't be interrupted early");
+        }
+    }
+
+    VrpnServerConnection::~VrpnServerConnection() {
+        if (INVALID_SOCKET != m_wakeSocket) {
+            closeSocket(m_wakeSocket);
+        }
+    }
+
+    vrpn_Endpoint_IP *
+    VrpnServerConnection::m_allocateEndpoint(vrpn_Connection *conn,
+                                             vrpn_int32 *connectedEC) {
+        auto self = static_cast<VrpnServerConnection *>(conn);
+        return new Endpoint(self->d_dispatcher, connectedEC,
+                            self->m_endpoints);
+    }
+
+    bool VrpnServerConnection::waitForReadable(
+        int microseconds, std::function<bool()> const &ready) {
+        // Set before checking, so a wake() after the check sends its
+        // datagram.
+        m_waiting = true;
+        if (ready()) {
+            m_waiting = false;
+            return true;
+        }
+
+        fd_set readSet;
+        FD_ZERO(&readSet);
+        SOCKET maxSocket = 0;
+        auto add = [&](SOCKET s) {
+            if (INVALID_SOCKET == s) {
+                return;
+            }
+#ifndef _WIN32
+            if (s >= FD_SETSIZE) {
+                return;
+            }
+#endif
+            FD_SET(s, &readSet);
+            if (s > maxSocket) {
+                maxSocket = s;
+            }
+        };
+        add(m_wakeSocket);
+        add(listen_udp_sock);
+        add(listen_tcp_sock);
+        for (auto endpoint : *m_endpoints) {
+            endpoint->forEachSocket(add);
+        }
+
+        struct timeval timeout;
+        timeout.tv_sec = microseconds / 1000000;
+        timeout.tv_usec = microseconds % 1000000;
+        auto result = select(static_cast<int>(maxSocket + 1), &readSet,
+                             nullptr, nullptr, &timeout);
+        m_waiting = false;
+
+        if (result > 0 && INVALID_SOCKET != m_wakeSocket &&
+            FD_ISSET(m_wakeSocket, &readSet)) {
+            char buf[16];
+            while (recv(m_wakeSocket, buf, sizeof(buf), 0) > 0) {
+            }
+        }
+        return result != 0;
+    }
+
+    void VrpnServerConnection::wake() {
+        if (m_waiting && INVALID_SOCKET != m_wakeSocket) {
+            char byte = 0;
+            send(m_wakeSocket, &byte, 1, 0);
+        }
+    }
+
+} // namespace connection
+} // namespace osvr
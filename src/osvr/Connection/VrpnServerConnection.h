@@ -0,0 +1,97 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_VrpnServerConnection_h_GUID_2C7A95E1_64B3_4F0D_8E29_D1B5A7F3C846
+#define INCLUDED_VrpnServerConnection_h_GUID_2C7A95E1_64B3_4F0D_8E29_D1B5A7F3C846
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <vrpn_Connection.h>
+
+// Standard includes
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <set>
+
+namespace osvr {
+namespace connection {
+    /// @brief A VRPN server connection that can wait on all of its sockets at
+    /// once.
+    ///
+    /// VRPN's own mainloop(timeout) waits on one client endpoint's sockets at
+    /// a time, and nothing else can interrupt it. This instead keeps track of
+    /// the sockets of the listener and of every endpoint it creates, and
+    /// waits on those together with a socket of its own that wake() writes
+    /// to, so one blocking call covers the whole wait.
+    class VrpnServerConnection : public vrpn_Connection_IP {
+      public:
+        /// @param port Port to listen on (UDP and TCP).
+        /// @param NIC Interface to listen on, or nullptr for all.
+        VrpnServerConnection(unsigned short port, const char *NIC);
+        virtual ~VrpnServerConnection();
+
+        /// @brief Blocks until one of the connection's sockets has something
+        /// to read (which is left for mainloop() to handle), wake() is
+        /// called, or the given number of microseconds pass.
+        ///
+        /// Call from the thread calling mainloop().
+        ///
+        /// @param ready Checked once a wake() would interrupt the wait, and
+        /// before blocking: if it returns true, this returns at once. Lets a
+        /// caller check for whatever it calls wake() about without missing a
+        /// wake() made just before the wait.
+        ///
+        /// @returns true unless the time ran out.
+        bool waitForReadable(int microseconds,
+                             std::function<bool()> const &ready);
+
+        /// @brief Interrupts a waitForReadable() in progress, if any.
+        ///
+        /// Safe to call from any thread; cheap when nobody is waiting.
+        void wake();
+
+      private:
+        class Endpoint;
+        typedef std::set<Endpoint *> EndpointSet;
+        typedef std::shared_ptr<EndpointSet> EndpointSetPtr;
+
+        static vrpn_Endpoint_IP *m_allocateEndpoint(vrpn_Connection *conn,
+                                                    vrpn_int32 *connectedEC);
+
+        /// @brief The endpoints we created and that still exist: shared with
+        /// them, since VRPN deletes them after we're gone.
+        EndpointSetPtr m_endpoints;
+        /// @brief Bound to a loopback port: wake() sends it a datagram.
+        SOCKET m_wakeSocket;
+        /// @brief Set while in waitForReadable(), so wake() only sends a
+        /// datagram when someone is waiting for it.
+        std::atomic<bool> m_waiting;
+    };
+} // namespace connection
+} // namespace osvr
+
+#endif // INCLUDED_VrpnServerConnection_h_GUID_2C7A95E1_64B3_4F0D_8E29_D1B5A7F3C846
@@ -27,15 +27,21 @@
 
 // Internal Includes
 #include "DeviceConstructionData.h"
+#include "ReportCoalescer.h"
+#include "VrpnBaseFlexServer.h"
+#include <osvr/Common/DirectReportDispatch.h>
+#include <osvr/Connection/Connection.h>
 #include <osvr/Connection/TrackerServerInterface.h>
+#include <osvr/Util/Pose3C.h>
 #include <osvr/Util/QuatlibInteropC.h>
 
 // Library/third-party includes
+#include <boost/assert.hpp>
 #include <quat.h>
 #include <vrpn_Tracker.h>
 
 // Standard includes
-// - none
+#include <cstddef>
 
 namespace osvr {
 namespace connection {
@@ -52,6 +58,26 @@ namespace connection {
             m_resetVel();
             m_resetAccel();
 
+            // Deliver reports directly if there's an in-process client (and
+            // over the connection as well, if anything else listens there).
+            auto const &dispatch =
+                init.obj.getConnection()->getDirectReportDispatch();
+            if (dispatch) {
+                m_direct = dispatch->getTrackerChannel(init.getQualifiedName());
+            }
+
+            // Hold back poses that would exceed the configured rate.
+            auto limit = init.obj.getConnection()->getReportRateLimit(
+                init.getQualifiedName());
+            m_poses = PoseCoalescer(limit.tracker);
+            if (m_poses.isEnabled()) {
+                BOOST_ASSERT_MSG(init.flexServer, "The base flex server "
+                                                  "should be constructed "
+                                                  "first!");
+                init.flexServer->registerMainloopCallback(
+                    [&] { m_sendHeldPoses(); });
+            }
+
             // Report interface out.
             init.obj.returnTrackerInterface(*this);
         }
@@ -60,30 +86,60 @@ namespace connection {
         void sendReport(OSVR_PositionState const &val,
                                 OSVR_ChannelCount sensor,
                                 util::time::TimeValue const &tv) override {
-            m_resetQuat();
-            osvrVec3ToQuatlib(Base::pos, &val);
-            m_sendPose(sensor, tv);
+            if (m_direct) {
+                OSVR_PoseState pose;
+                osvrPose3SetIdentity(&pose);
+                pose.translation = val;
+                m_direct->sendPose(sensor, pose, tv);
+                if (!m_direct->isWireRequired()) {
+                    return;
+                }
+            }
+            OSVR_PoseState pose;
+            osvrPose3SetIdentity(&pose);
+            pose.translation = val;
+            m_offerPose(POSITION_SLOT, pose, sensor, tv);
         }
 
         void sendReport(OSVR_OrientationState const &val,
                                 OSVR_ChannelCount sensor,
                                 util::time::TimeValue const &tv) override {
-            m_resetPos();
-            osvrQuatToQuatlib(Base::d_quat, &val);
-            m_sendPose(sensor, tv);
+            if (m_direct) {
+                OSVR_PoseState pose;
+                osvrPose3SetIdentity(&pose);
+                pose.rotation = val;
+                m_direct->sendPose(sensor, pose, tv);
+                if (!m_direct->isWireRequired()) {
+                    return;
+                }
+            }
+            OSVR_PoseState pose;
+            osvrPose3SetIdentity(&pose);
+            pose.rotation = val;
+            m_offerPose(ORIENTATION_SLOT, pose, sensor, tv);
         }
 
         void sendReport(OSVR_PoseState const &val,
                                 OSVR_ChannelCount sensor,
                                 util::time::TimeValue const &tv) override {
-            osvrVec3ToQuatlib(Base::pos, &(val.translation));
-            osvrQuatToQuatlib(Base::d_quat, &(val.rotation));
-            m_sendPose(sensor, tv);
+            if (m_direct) {
+                m_direct->sendPose(sensor, val, tv);
+                if (!m_direct->isWireRequired()) {
+                    return;
+                }
+            }
+            m_offerPose(POSE_SLOT, val, sensor, tv);
         }
 
         void sendVelReport(OSVR_VelocityState const &val,
                            OSVR_ChannelCount sensor,
                            util::time::TimeValue const &tv) override {
+            if (m_direct) {
+                m_direct->sendVelocity(sensor, val, tv);
+                if (!m_direct->isWireRequired()) {
+                    return;
+                }
+            }
             osvrVec3ToQuatlib(Base::vel, &(val.linearVelocity));
             osvrQuatToQuatlib(Base::vel_quat,
                               &(val.angularVelocity.incrementalRotation));
@@ -93,6 +149,15 @@ namespace connection {
         void sendVelReport(OSVR_LinearVelocityState const &val,
                            OSVR_ChannelCount sensor,
                            util::time::TimeValue const &tv) override {
+            if (m_direct) {
+                auto state = m_zeroVelocity();
+                state.linearVelocity = val;
+                state.linearVelocityValid = true;
+                m_direct->sendVelocity(sensor, state, tv);
+                if (!m_direct->isWireRequired()) {
+                    return;
+                }
+            }
             m_resetVel();
 
             osvrVec3ToQuatlib(Base::vel, &val);
@@ -101,6 +166,15 @@ namespace connection {
         void sendVelReport(OSVR_AngularVelocityState const &val,
                            OSVR_ChannelCount sensor,
                            util::time::TimeValue const &tv) override {
+            if (m_direct) {
+                auto state = m_zeroVelocity();
+                state.angularVelocity = val;
+                state.angularVelocityValid = true;
+                m_direct->sendVelocity(sensor, state, tv);
+                if (!m_direct->isWireRequired()) {
+                    return;
+                }
+            }
             m_resetVel();
 
             osvrQuatToQuatlib(Base::vel_quat, &(val.incrementalRotation));
@@ -111,6 +185,12 @@ namespace connection {
         void sendAccelReport(OSVR_AccelerationState const &val,
                              OSVR_ChannelCount sensor,
                              util::time::TimeValue const &tv) override {
+            if (m_direct) {
+                m_direct->sendAcceleration(sensor, val, tv);
+                if (!m_direct->isWireRequired()) {
+                    return;
+                }
+            }
             osvrVec3ToQuatlib(Base::acc, &(val.linearAcceleration));
             osvrQuatToQuatlib(Base::acc_quat,
                               &(val.angularAcceleration.incrementalRotation));
@@ -120,6 +200,15 @@ namespace connection {
         void sendAccelReport(OSVR_LinearAccelerationState const &val,
                              OSVR_ChannelCount sensor,
                              util::time::TimeValue const &tv) override {
+            if (m_direct) {
+                auto state = m_zeroAcceleration();
+                state.linearAcceleration = val;
+                state.linearAccelerationValid = true;
+                m_direct->sendAcceleration(sensor, state, tv);
+                if (!m_direct->isWireRequired()) {
+                    return;
+                }
+            }
             m_resetAccel();
 
             osvrVec3ToQuatlib(Base::acc, &val);
@@ -128,6 +217,15 @@ namespace connection {
         void sendAccelReport(OSVR_AngularAccelerationState const &val,
                              OSVR_ChannelCount sensor,
                              util::time::TimeValue const &tv) override {
+            if (m_direct) {
+                auto state = m_zeroAcceleration();
+                state.angularAcceleration = val;
+                state.angularAccelerationValid = true;
+                m_direct->sendAcceleration(sensor, state, tv);
+                if (!m_direct->isWireRequired()) {
+                    return;
+                }
+            }
             m_resetVel();
 
             osvrQuatToQuatlib(Base::acc_quat, &(val.incrementalRotation));
@@ -136,6 +234,61 @@ namespace connection {
         }
 
       private:
+        /// @name Rate limiting of pose reports
+        ///
+        /// Position-only, orientation-only and full pose reports of a sensor
+        /// are rate limited separately, so one kind never stands in for
+        /// another.
+        /// @{
+        enum PoseSlot { POSE_SLOT, POSITION_SLOT, ORIENTATION_SLOT, NUM_SLOTS };
+        struct HeldPose {
+            OSVR_PoseState pose;
+            util::time::TimeValue timestamp;
+        };
+        typedef ReportCoalescer<HeldPose> PoseCoalescer;
+
+        void m_offerPose(PoseSlot slot, OSVR_PoseState const &pose,
+                         OSVR_ChannelCount sensor,
+                         util::time::TimeValue const &tv) {
+            if (m_poses.isEnabled()) {
+                HeldPose held = {pose, tv};
+                if (!m_poses.offer(std::size_t(sensor) * NUM_SLOTS + slot,
+                                   held, util::time::getNow())) {
+                    return;
+                }
+            }
+            m_sendPose(pose, sensor, tv);
+        }
+
+        void m_sendHeldPoses() {
+            auto send = [&](std::size_t slot, HeldPose const &held) {
+                auto sensor = static_cast<OSVR_ChannelCount>(slot / NUM_SLOTS);
+                m_sendPose(held.pose, sensor, held.timestamp);
+            };
+            m_poses.flush(util::time::getNow(), send);
+        }
+        /// @}
+
+        static OSVR_VelocityState m_zeroVelocity() {
+            OSVR_VelocityState ret;
+            osvrVec3Zero(&ret.linearVelocity);
+            ret.linearVelocityValid = false;
+            osvrQuatSetIdentity(&ret.angularVelocity.incrementalRotation);
+            ret.angularVelocity.dt = 0;
+            ret.angularVelocityValid = false;
+            return ret;
+        }
+
+        static OSVR_AccelerationState m_zeroAcceleration() {
+            OSVR_AccelerationState ret;
+            osvrVec3Zero(&ret.linearAcceleration);
+            ret.linearAccelerationValid = false;
+            osvrQuatSetIdentity(&ret.angularAcceleration.incrementalRotation);
+            ret.angularAcceleration.dt = 0;
+            ret.angularAccelerationValid = false;
+            return ret;
+        }
+
         void m_resetVec3(vrpn_float64 vec[3]) {
             vec[0] = 0;
             vec[1] = 0;
@@ -162,8 +315,10 @@ namespace connection {
             Base::acc_quat_dt = 0;
         }
 
-        void m_sendPose(OSVR_ChannelCount sensor,
+        void m_sendPose(OSVR_PoseState const &pose, OSVR_ChannelCount sensor,
                         util::time::TimeValue const &ts) {
+            osvrVec3ToQuatlib(Base::pos, &(pose.translation));
+            osvrQuatToQuatlib(Base::d_quat, &(pose.rotation));
 
             Base::d_sensor = sensor;
             util::time::toStructTimeval(Base::timestamp, ts);
@@ -197,6 +352,10 @@ namespace connection {
                                        Base::d_sender_id, msgbuf,
                                        CLASS_OF_SERVICE);
         }
+
+        /// Set if reports go directly to in-process handlers.
+        common::DirectTrackerChannelPtr m_direct;
+        PoseCoalescer m_poses;
     };
 
 } // namespace connection
@@ -27,6 +27,7 @@
 #include <osvr/Common/ClientInterface.h>
 #include <osvr/Common/CreateDevice.h>
 #include <osvr/Common/DeduplicatingFunctionWrapper.h>
+#include <osvr/Common/DirectReportDispatch.h>
 #include <osvr/Common/PathElementTools.h>
 #include <osvr/Common/PathElementTypes.h>
 #include <osvr/Common/PathTreeFull.h>
@@ -56,11 +57,16 @@ namespace client {
           m_ifaceMgr(m_pathTreeOwner, m_factory,
                      *static_cast<common::ClientContext *>(this)) {
 
+        /// Server and client share this process, so reports from devices
+        /// that support it can skip the (loopback) connection entirely.
+        m_direct = common::DirectReportDispatch::create();
+
         /// Create all the remote handler factories.
-        populateRemoteHandlerFactory(m_factory, m_vrpnConns);
+        populateRemoteHandlerFactory(m_factory, m_vrpnConns, m_direct, HOST);
 
         /// creates the OSVR connection with its nested VRPN connection
         auto conn = connection::Connection::createLoopbackConnection();
+        std::get<1>(conn)->setDirectReportDispatch(m_direct);
 
         /// Get the VRPN connection out and use it.
         m_mainConn = static_cast<vrpn_Connection *>(std::get<0>(conn));
@@ -99,6 +105,9 @@ namespace client {
         /// Run the server
         m_server->update();
 
+        /// Deliver the reports the server's devices sent directly.
+        m_direct->deliver();
+
         /// Mainloop connections
         m_vrpnConns.updateAll();
 
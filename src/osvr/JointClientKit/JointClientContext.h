@@ -32,6 +32,7 @@
 #include <osvr/Client/RemoteHandlerFactory.h>
 #include <osvr/Common/BaseDevicePtr.h>
 #include <osvr/Common/ClientContext.h>
+#include <osvr/Common/DirectReportDispatch_fwd.h>
 #include <osvr/Common/NetworkingSupport.h>
 #include <osvr/Common/PathTree.h>
 #include <osvr/Common/PathTreeOwner.h>
@@ -94,6 +95,10 @@ namespace client {
 
         server::ServerPtr m_server;
 
+        /// @brief Carries reports from the server's devices straight to our
+        /// handlers: delivered on each update, after running the server.
+        common::DirectReportDispatchPtr m_direct;
+
         /// @brief The "OSVR" system device for control messages
         common::BaseDevicePtr m_systemDevice;
 
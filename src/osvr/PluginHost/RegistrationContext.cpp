@@ -47,6 +47,7 @@
 // Standard includes
 #include <algorithm>
 #include <iterator>
+#include <mutex>
 
 namespace osvr {
 namespace pluginhost {
@@ -61,6 +62,11 @@ namespace pluginhost {
         Impl() : pluginPaths(pluginhost::getPluginSearchPath()) {}
 
         const std::vector<std::string> pluginPaths;
+
+        /// Guards detectRequestHandler, which requestHardwareDetect() may
+        /// call from any thread.
+        std::mutex detectRequestMutex;
+        std::function<void()> detectRequestHandler;
     };
 
     RegistrationContext::RegistrationContext()
@@ -221,6 +227,19 @@ namespace pluginhost {
         }
     }
 
+    void RegistrationContext::setHardwareDetectRequestHandler(
+        std::function<void()> const &handler) {
+        std::lock_guard<std::mutex> lock(m_impl->detectRequestMutex);
+        m_impl->detectRequestHandler = handler;
+    }
+
+    void RegistrationContext::requestHardwareDetect() {
+        std::lock_guard<std::mutex> lock(m_impl->detectRequestMutex);
+        if (m_impl->detectRequestHandler) {
+            m_impl->detectRequestHandler();
+        }
+    }
+
     void
     RegistrationContext::instantiateDriver(const std::string &pluginName,
                                            const std::string &driverName,
@@ -31,12 +31,13 @@
 #include <osvr/PluginHost/PluginSpecificRegistrationContext.h>
 #include <osvr/Util/PointerWrapper.h>
 #include "HandleNullContext.h"
+#include "SendPackedReport.h"
 
 // Library/third-party includes
 // - none
 
 // Standard includes
-// - none
+#include <cstddef>
 
 struct OSVR_AnalogDeviceInterfaceObject
     : public osvr::connection::DeviceInterfaceBase {
@@ -56,6 +57,29 @@ osvrDeviceAnalogConfigure(OSVR_INOUT_PTR OSVR_DeviceInitOptions opts,
     return OSVR_RETURN_SUCCESS;
 }
 
+using osvr::pluginkit::sendPackedReport;
+
+namespace {
+/// @brief A value and its channel - or, for an array of values following as
+/// extra data, the number of them - as copied for sending.
+struct AnalogReport {
+    OSVR_AnalogState val;
+    OSVR_ChannelCount chan;
+    OSVR_TimeValue timestamp;
+};
+
+void sendAnalogValue(OSVR_AnalogDeviceInterface iface, AnalogReport const &r) {
+    iface->analog->setValue(r.val, r.chan, r.timestamp);
+}
+
+void sendAnalogValues(OSVR_AnalogDeviceInterface iface, AnalogReport const &r,
+                      const char *extra, std::size_t) {
+    /// setValues() only reads the values, despite its signature.
+    auto vals = reinterpret_cast<OSVR_AnalogState *>(const_cast<char *>(extra));
+    iface->analog->setValues(vals, r.chan, r.timestamp);
+}
+} // namespace
+
 OSVR_ReturnCode
 osvrDeviceAnalogSetValue(OSVR_IN_PTR OSVR_DeviceToken dev,
                          OSVR_IN_PTR OSVR_AnalogDeviceInterface iface,
@@ -75,13 +99,8 @@ OSVR_ReturnCode osvrDeviceAnalogSetValueTimestamped(
     OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceAnalogSetValueTimestamped",
                                     timestamp);
 
-    auto guard = iface->getSendGuard();
-    if (guard->lock()) {
-        bool sendResult = iface->analog->setValue(val, chan, *timestamp);
-        return sendResult ? OSVR_RETURN_SUCCESS : OSVR_RETURN_FAILURE;
-    }
-
-    return OSVR_RETURN_FAILURE;
+    return sendPackedReport(iface, AnalogReport{val, chan, *timestamp},
+                            &sendAnalogValue);
 }
 
 OSVR_ReturnCode
@@ -103,10 +122,9 @@ OSVR_ReturnCode osvrDeviceAnalogSetValuesTimestamped(
     OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceAnalogSetValuesTimestamped",
                                     timestamp);
 
-    auto guard = iface->getSendGuard();
-    if (guard->lock()) {
-        iface->analog->setValues(val, chans, *timestamp);
-        return OSVR_RETURN_SUCCESS;
-    }
-    return OSVR_RETURN_FAILURE;
+    return sendPackedReport(
+        iface, AnalogReport{OSVR_AnalogState(), chans, *timestamp},
+        sizeof(OSVR_AnalogState) * chans,
+        [&](char *extra) { osvr::pluginkit::packArray(extra, val, chans); },
+        &sendAnalogValues);
 }
@@ -30,13 +30,14 @@
 #include <osvr/Connection/DeviceInterfaceBase.h>
 #include <osvr/PluginHost/PluginSpecificRegistrationContext.h>
 #include "HandleNullContext.h"
+#include "SendPackedReport.h"
 #include <osvr/Util/PointerWrapper.h>
 
 // Library/third-party includes
 // - none
 
 // Standard includes
-// - none
+#include <cstddef>
 
 struct OSVR_ButtonDeviceInterfaceObject : public osvr::connection::DeviceInterfaceBase {
     osvr::util::PointerWrapper<osvr::connection::ButtonServerInterface> button;
@@ -55,6 +56,29 @@ osvrDeviceButtonConfigure(OSVR_INOUT_PTR OSVR_DeviceInitOptions opts,
     return OSVR_RETURN_SUCCESS;
 }
 
+using osvr::pluginkit::sendPackedReport;
+
+namespace {
+/// @brief A value and its channel - or, for an array of values following as
+/// extra data, the number of them - as copied for sending.
+struct ButtonReport {
+    OSVR_ButtonState val;
+    OSVR_ChannelCount chan;
+    OSVR_TimeValue timestamp;
+};
+
+void sendButtonValue(OSVR_ButtonDeviceInterface iface, ButtonReport const &r) {
+    iface->button->setValue(r.val, r.chan, r.timestamp);
+}
+
+void sendButtonValues(OSVR_ButtonDeviceInterface iface, ButtonReport const &r,
+                      const char *extra, std::size_t) {
+    /// setValues() only reads the values, despite its signature.
+    auto vals = reinterpret_cast<OSVR_ButtonState *>(const_cast<char *>(extra));
+    iface->button->setValues(vals, r.chan, r.timestamp);
+}
+} // namespace
+
 OSVR_ReturnCode osvrDeviceButtonSetValue(OSVR_IN_PTR OSVR_DeviceToken dev,
                                          OSVR_IN_PTR OSVR_ButtonDeviceInterface
                                          iface,
@@ -74,13 +98,8 @@ OSVR_ReturnCode osvrDeviceButtonSetValueTimestamped(
     OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceButtonSetValueTimestamped",
                                     timestamp);
 
-    auto guard = iface->getSendGuard();
-    if (guard->lock()) {
-        bool sendResult = iface->button->setValue(val, chan, *timestamp);
-        return sendResult ? OSVR_RETURN_SUCCESS : OSVR_RETURN_FAILURE;
-    }
-
-    return OSVR_RETURN_FAILURE;
+    return sendPackedReport(iface, ButtonReport{val, chan, *timestamp},
+                            &sendButtonValue);
 }
 
 OSVR_ReturnCode osvrDeviceButtonSetValues(OSVR_INOUT_PTR OSVR_DeviceToken dev,
@@ -102,10 +121,9 @@ OSVR_ReturnCode osvrDeviceButtonSetValuesTimestamped(
     OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceButtonSetValuesTimestamped",
                                     timestamp);
 
-    auto guard = iface->getSendGuard();
-    if (guard->lock()) {
-        iface->button->setValues(val, chans, *timestamp);
-        return OSVR_RETURN_SUCCESS;
-    }
-    return OSVR_RETURN_FAILURE;
+    return sendPackedReport(
+        iface, ButtonReport{OSVR_ButtonState(), chans, *timestamp},
+        sizeof(OSVR_ButtonState) * chans,
+        [&](char *extra) { osvr::pluginkit::packArray(extra, val, chans); },
+        &sendButtonValues);
 }
@@ -73,6 +73,28 @@ OSVR_ReturnCode osvrDeviceSendTimestampedData(
     return OSVR_RETURN_SUCCESS;
 }
 
+OSVR_ReturnCode
+osvrDeviceBeginSendTransaction(OSVR_IN_PTR OSVR_DeviceToken dev) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceBeginSendTransaction", dev);
+    try {
+        if (dev->beginSendTransaction()) {
+            return OSVR_RETURN_SUCCESS;
+        }
+    } catch (std::exception &e) {
+        std::cerr << "Error in osvrDeviceBeginSendTransaction: " << e.what()
+                  << std::endl;
+    } catch (...) {
+    }
+    return OSVR_RETURN_FAILURE;
+}
+
+OSVR_ReturnCode
+osvrDeviceEndSendTransaction(OSVR_IN_PTR OSVR_DeviceToken dev) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceEndSendTransaction", dev);
+    return dev->endSendTransaction() ? OSVR_RETURN_SUCCESS
+                                     : OSVR_RETURN_FAILURE;
+}
+
 OSVR_ReturnCode osvrDeviceSendJsonDescriptor(OSVR_IN_PTR OSVR_DeviceToken dev,
                                              OSVR_IN_READS(len)
                                                  const char *json,
@@ -210,6 +232,29 @@ osvrDeviceAsyncInitWithOptions(OSVR_IN_PTR OSVR_PluginRegContext,
                                  OSVR_DeviceTokenObject::createAsyncDevice);
 }
 
+OSVR_ReturnCode
+osvrDeviceAsyncConfigureSendQueue(OSVR_INOUT_PTR OSVR_DeviceInitOptions options,
+                                  OSVR_IN uint32_t capacity,
+                                  OSVR_IN OSVR_AsyncSendOverflowPolicy policy) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceAsyncConfigureSendQueue",
+                                    options);
+    if (policy > OSVR_ASYNC_SEND_BLOCK) {
+        return OSVR_RETURN_FAILURE;
+    }
+    options->setAsyncSendQueue(capacity, policy);
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode
+osvrDeviceGetDroppedMessageCount(OSVR_IN_PTR OSVR_DeviceToken dev,
+                                 OSVR_OUT_PTR uint64_t *count) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceGetDroppedMessageCount", dev);
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceGetDroppedMessageCount count",
+                                    count);
+    *count = dev->getDroppedMessageCount();
+    return OSVR_RETURN_SUCCESS;
+}
+
 OSVR_ReturnCode osvrDeviceMicrosleep(OSVR_IN uint64_t microseconds) {
     boost::this_thread::sleep(boost::posix_time::microseconds(microseconds));
     return OSVR_RETURN_SUCCESS;
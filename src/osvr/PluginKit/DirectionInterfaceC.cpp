@@ -31,6 +31,7 @@
 #include <osvr/PluginHost/PluginSpecificRegistrationContext.h>
 #include <osvr/Common/DirectionComponent.h>
 #include "HandleNullContext.h"
+#include "SendPackedReport.h"
 #include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
@@ -61,16 +62,26 @@ osvrDeviceDirectionConfigure(OSVR_INOUT_PTR OSVR_DeviceInitOptions opts,
     return OSVR_RETURN_SUCCESS;
 }
 
+namespace {
+/// @brief A direction report, as copied for sending.
+struct DirectionReport {
+    OSVR_DirectionState data;
+    OSVR_ChannelCount sensor;
+    OSVR_TimeValue timestamp;
+};
+
+void sendDirection(OSVR_DirectionDeviceInterface iface,
+                   DirectionReport const &r) {
+    iface->direction->sendDirectionData(r.data, r.sensor, r.timestamp);
+}
+} // namespace
+
 OSVR_ReturnCode
 osvrDeviceDirectionReportData(OSVR_IN_PTR OSVR_DirectionDeviceInterface iface,
                               OSVR_IN_PTR OSVR_DirectionState directionData,
                               OSVR_IN OSVR_ChannelCount sensor,
                               OSVR_IN_PTR OSVR_TimeValue const *timestamp) {
-    auto guard = iface->getSendGuard();
-    if (guard->lock()) {
-        iface->direction->sendDirectionData(directionData, sensor, *timestamp);
-        return OSVR_RETURN_SUCCESS;
-    }
-
-    return OSVR_RETURN_FAILURE;
+    return osvr::pluginkit::sendPackedReport(
+        iface, DirectionReport{directionData, sensor, *timestamp},
+        &sendDirection);
 }
\ No newline at end of file
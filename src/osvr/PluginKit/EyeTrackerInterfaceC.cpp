@@ -30,6 +30,7 @@
 #include <osvr/PluginHost/PluginSpecificRegistrationContext.h>
 #include <osvr/Util/PointerWrapper.h>
 #include "HandleNullContext.h"
+#include "SendPackedReport.h"
 #include <osvr/Util/Verbosity.h>
 #include <osvr/Common/EyeTrackerComponent.h>
 #include <osvr/Common/Location2DComponent.h>
@@ -84,20 +85,65 @@ OSVR_ReturnCode osvrDeviceEyeTrackerConfigure(
     return OSVR_RETURN_SUCCESS;
 }
 
+namespace {
+/// @brief An eye tracker report, as copied for sending: which fields are
+/// used depends on the kind of report.
+struct EyeReport {
+    OSVR_EyeGazePosition2DState position;
+    OSVR_EyeGazeDirectionState direction;
+    OSVR_EyeGazeBasePoint3DState basePoint;
+    OSVR_EyeTrackerBlinkState blink;
+    OSVR_ChannelCount sensor;
+    OSVR_TimeValue timestamp;
+};
+
+void send2DGaze(OSVR_EyeTrackerDeviceInterface iface, EyeReport const &r) {
+    iface->location->sendLocationData(r.position, r.sensor, r.timestamp);
+    iface->eyetracker->sendNotification(r.sensor, r.timestamp);
+}
+
+void send3DGaze(OSVR_EyeTrackerDeviceInterface iface, EyeReport const &r) {
+    iface->direction->sendDirectionData(r.direction, r.sensor, r.timestamp);
+    iface->tracker->sendReport(r.basePoint, r.sensor, r.timestamp);
+    iface->eyetracker->sendNotification(r.sensor, r.timestamp);
+}
+
+void send3DGazeDirection(OSVR_EyeTrackerDeviceInterface iface,
+                         EyeReport const &r) {
+    iface->direction->sendDirectionData(r.direction, r.sensor, r.timestamp);
+    iface->eyetracker->sendNotification(r.sensor, r.timestamp);
+}
+
+void sendGaze(OSVR_EyeTrackerDeviceInterface iface, EyeReport const &r) {
+    iface->location->sendLocationData(r.position, r.sensor, r.timestamp);
+    iface->tracker->sendReport(r.basePoint, r.sensor, r.timestamp);
+    iface->direction->sendDirectionData(r.direction, r.sensor, r.timestamp);
+    iface->eyetracker->sendNotification(r.sensor, r.timestamp);
+}
+
+void sendBlink(OSVR_EyeTrackerDeviceInterface iface, EyeReport const &r) {
+    iface->button->setValue(r.blink, r.sensor, r.timestamp);
+    iface->eyetracker->sendNotification(r.sensor, r.timestamp);
+}
+
+inline EyeReport makeEyeReport(OSVR_ChannelCount sensor,
+                               OSVR_TimeValue const &timestamp) {
+    EyeReport report = {};
+    report.sensor = sensor;
+    report.timestamp = timestamp;
+    return report;
+}
+} // namespace
+
 OSVR_ReturnCode osvrDeviceEyeTrackerReport2DGaze(
     OSVR_IN_PTR OSVR_EyeTrackerDeviceInterface iface,
     OSVR_IN OSVR_EyeGazePosition2DState gazePosition,
     OSVR_IN OSVR_ChannelCount sensor,
     OSVR_IN_PTR OSVR_TimeValue const *timestamp) {
 
-    auto guard = iface->getSendGuard();
-    if (guard->lock()) {
-        iface->location->sendLocationData(gazePosition, sensor, *timestamp);
-        iface->eyetracker->sendNotification(sensor, *timestamp);
-        return OSVR_RETURN_SUCCESS;
-    }
-
-    return OSVR_RETURN_FAILURE;
+    auto report = makeEyeReport(sensor, *timestamp);
+    report.position = gazePosition;
+    return osvr::pluginkit::sendPackedReport(iface, report, &send2DGaze);
 }
 
 OSVR_ReturnCode osvrDeviceEyeTrackerReport3DGaze(
@@ -106,15 +152,10 @@ OSVR_ReturnCode osvrDeviceEyeTrackerReport3DGaze(
     OSVR_IN OSVR_EyeGazeBasePoint3DState gazeBasePoint,
     OSVR_IN OSVR_ChannelCount sensor,
     OSVR_IN_PTR OSVR_TimeValue const *timestamp) {
-    auto guard = iface->getSendGuard();
-    if (guard->lock()) {
-        iface->direction->sendDirectionData(gazeDirection, sensor, *timestamp);
-        iface->tracker->sendReport(gazeBasePoint, sensor, *timestamp);
-        iface->eyetracker->sendNotification(sensor, *timestamp);
-        return OSVR_RETURN_SUCCESS;
-    }
-
-    return OSVR_RETURN_FAILURE;
+    auto report = makeEyeReport(sensor, *timestamp);
+    report.direction = gazeDirection;
+    report.basePoint = gazeBasePoint;
+    return osvr::pluginkit::sendPackedReport(iface, report, &send3DGaze);
 }
 
 OSVR_ReturnCode osvrDeviceEyeTrackerReport3DGazeDirection(
@@ -123,14 +164,10 @@ OSVR_ReturnCode osvrDeviceEyeTrackerReport3DGazeDirection(
     OSVR_IN OSVR_ChannelCount sensor,
     OSVR_IN_PTR OSVR_TimeValue const *timestamp) {
 
-    auto guard = iface->getSendGuard();
-    if (guard->lock()) {
-        iface->direction->sendDirectionData(gazeDirection, sensor, *timestamp);
-        iface->eyetracker->sendNotification(sensor, *timestamp);
-        return OSVR_RETURN_SUCCESS;
-    }
-
-    return OSVR_RETURN_FAILURE;
+    auto report = makeEyeReport(sensor, *timestamp);
+    report.direction = gazeDirection;
+    return osvr::pluginkit::sendPackedReport(iface, report,
+                                             &send3DGazeDirection);
 }
 
 OSVR_ReturnCode
@@ -142,16 +179,11 @@ osvrDeviceEyeTrackerReportGaze(OSVR_IN_PTR OSVR_EyeTrackerDeviceInterface iface,
                                OSVR_IN OSVR_ChannelCount sensor,
                                OSVR_IN_PTR OSVR_TimeValue const *timestamp) {
 
-    auto guard = iface->getSendGuard();
-    if (guard->lock()) {
-        iface->location->sendLocationData(gazePosition, sensor, *timestamp);
-        iface->tracker->sendReport(gazeBasePoint, sensor, *timestamp);
-        iface->direction->sendDirectionData(gazeDirection, sensor, *timestamp);
-        iface->eyetracker->sendNotification(sensor, *timestamp);
-        return OSVR_RETURN_SUCCESS;
-    }
-
-    return OSVR_RETURN_FAILURE;
+    auto report = makeEyeReport(sensor, *timestamp);
+    report.position = gazePosition;
+    report.direction = gazeDirection;
+    report.basePoint = gazeBasePoint;
+    return osvr::pluginkit::sendPackedReport(iface, report, &sendGaze);
 }
 
 OSVR_ReturnCode osvrDeviceEyeTrackerReportBlink(
@@ -159,11 +191,7 @@ OSVR_ReturnCode osvrDeviceEyeTrackerReportBlink(
     OSVR_IN OSVR_EyeTrackerBlinkState blink, OSVR_IN OSVR_ChannelCount sensor,
     OSVR_IN_PTR OSVR_TimeValue const *timestamp) {
 
-    auto guard = iface->getSendGuard();
-    if (guard->lock()) {
-        iface->button->setValue(blink, sensor, *timestamp);
-        iface->eyetracker->sendNotification(sensor, *timestamp);
-        return OSVR_RETURN_SUCCESS;
-    }
-    return OSVR_RETURN_FAILURE;
+    auto report = makeEyeReport(sensor, *timestamp);
+    report.blink = blink;
+    return osvr::pluginkit::sendPackedReport(iface, report, &sendBlink);
 }
@@ -31,13 +31,14 @@
 #include <osvr/PluginHost/PluginSpecificRegistrationContext.h>
 #include <osvr/Common/ImagingComponent.h>
 #include "HandleNullContext.h"
+#include "SendPackedReport.h"
 #include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
 // - none
 
 // Standard includes
-// - none
+#include <cstddef>
 
 // @todo This is a hack. expect this to be moved to a separate osvrJniBridge
 // library and encapsulated behind a proper API.
@@ -97,6 +98,30 @@ osvrDeviceImagingConfigure(OSVR_INOUT_PTR OSVR_DeviceInitOptions opts,
     return OSVR_RETURN_SUCCESS;
 }
 
+using osvr::pluginkit::sendPackedReport;
+
+namespace {
+/// @brief A frame (whose image follows as extra data) or a commit, as copied
+/// for sending.
+struct FrameReport {
+    OSVR_ImagingMetadata metadata;
+    OSVR_ChannelCount sensor;
+    OSVR_TimeValue timestamp;
+};
+
+void sendFrame(OSVR_ImagingDeviceInterface iface, FrameReport const &r,
+               const char *extra, std::size_t) {
+    /// sendImageData() only reads the image, despite its signature.
+    auto image = reinterpret_cast<OSVR_ImageBufferElement *>(
+        const_cast<char *>(extra));
+    iface->imaging->sendImageData(r.metadata, image, r.sensor, r.timestamp);
+}
+
+void sendCommit(OSVR_ImagingDeviceInterface iface, FrameReport const &r) {
+    iface->imaging->commitImageFrame(r.sensor, r.timestamp);
+}
+} // namespace
+
 OSVR_ReturnCode
 osvrDeviceImagingReportFrame(OSVR_IN_PTR OSVR_DeviceToken,
                              OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
@@ -104,11 +129,65 @@ osvrDeviceImagingReportFrame(OSVR_IN_PTR OSVR_DeviceToken,
                              OSVR_IN_PTR OSVR_ImageBufferElement *imageData,
                              OSVR_IN OSVR_ChannelCount sensor,
                              OSVR_IN_PTR OSVR_TimeValue const *timestamp) {
-    auto guard = iface->getSendGuard();
-    if (guard->lock()) {
-        iface->imaging->sendImageData(metadata, imageData, sensor, *timestamp);
-        return OSVR_RETURN_SUCCESS;
+    /// The image is copied along with the report, so the plugin doesn't
+    /// wait for the server thread (reserving and committing a frame avoids
+    /// the copy).
+    std::size_t size = std::size_t(metadata.height) * metadata.width *
+                       metadata.depth * metadata.channels;
+    return sendPackedReport(
+        iface, FrameReport{metadata, sensor, *timestamp}, size,
+        [&](char *extra) {
+            osvr::pluginkit::packArray(extra, imageData, size);
+        },
+        &sendFrame);
+}
+
+OSVR_ReturnCode
+osvrDeviceImagingReserveFrame(OSVR_IN_PTR OSVR_DeviceToken,
+                              OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
+                              OSVR_IN OSVR_ImagingMetadata metadata,
+                              OSVR_IN OSVR_ChannelCount sensor,
+                              OSVR_OUT_PTR OSVR_ImageBufferElement **buffer) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceImagingReserveFrame", iface);
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceImagingReserveFrame", buffer);
+    *buffer = nullptr;
+    {
+        // Only claiming the slot needs the guard (it may replace the shared
+        // memory): filling it happens without blocking the server.
+        auto guard = iface->getSendGuard();
+        if (!guard->lock()) {
+            return OSVR_RETURN_FAILURE;
+        }
+        *buffer = iface->imaging->reserveImageFrame(metadata, sensor);
+    }
+    if (nullptr == *buffer) {
+        return OSVR_RETURN_FAILURE;
+    }
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode
+osvrDeviceImagingCommitFrame(OSVR_IN_PTR OSVR_DeviceToken,
+                             OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
+                             OSVR_IN OSVR_ChannelCount sensor,
+                             OSVR_IN_PTR OSVR_TimeValue const *timestamp) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceImagingCommitFrame", iface);
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceImagingCommitFrame", timestamp);
+    auto ret = sendPackedReport(
+        iface, FrameReport{OSVR_ImagingMetadata(), sensor, *timestamp},
+        &sendCommit);
+    if (OSVR_RETURN_SUCCESS != ret) {
+        // Couldn't send: don't hold the slot forever.
+        iface->imaging->cancelImageFrame(sensor);
     }
+    return ret;
+}
 
-    return OSVR_RETURN_FAILURE;
+OSVR_ReturnCode
+osvrDeviceImagingCancelFrame(OSVR_IN_PTR OSVR_DeviceToken,
+                             OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
+                             OSVR_IN OSVR_ChannelCount sensor) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceImagingCancelFrame", iface);
+    iface->imaging->cancelImageFrame(sensor);
+    return OSVR_RETURN_SUCCESS;
 }
@@ -30,6 +30,7 @@
 #include <osvr/PluginHost/PluginSpecificRegistrationContext.h>
 #include <osvr/Common/Location2DComponent.h>
 #include "HandleNullContext.h"
+#include "SendPackedReport.h"
 #include <osvr/Util/Verbosity.h>
 #include <osvr/Connection/DeviceInterfaceBase.h>
 
@@ -60,16 +61,26 @@ OSVR_ReturnCode osvrDeviceLocation2DConfigure(
     return OSVR_RETURN_SUCCESS;
 }
 
+namespace {
+/// @brief A location report, as copied for sending.
+struct LocationReport {
+    OSVR_Location2DState data;
+    OSVR_ChannelCount sensor;
+    OSVR_TimeValue timestamp;
+};
+
+void sendLocation(OSVR_Location2D_DeviceInterface iface,
+                  LocationReport const &r) {
+    iface->location->sendLocationData(r.data, r.sensor, r.timestamp);
+}
+} // namespace
+
 OSVR_ReturnCode osvrDeviceLocation2DReportData(
     OSVR_IN_PTR OSVR_Location2D_DeviceInterface iface,
     OSVR_IN_PTR OSVR_Location2DState locationData,
     OSVR_IN OSVR_ChannelCount sensor,
     OSVR_IN_PTR OSVR_TimeValue const *timestamp) {
-    auto guard = iface->getSendGuard();
-    if (guard->lock()) {
-        iface->location->sendLocationData(locationData, sensor, *timestamp);
-        return OSVR_RETURN_SUCCESS;
-    }
-
-    return OSVR_RETURN_FAILURE;
+    return osvr::pluginkit::sendPackedReport(
+        iface, LocationReport{locationData, sensor, *timestamp},
+        &sendLocation);
 }
\ No newline at end of file
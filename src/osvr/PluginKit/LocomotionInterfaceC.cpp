@@ -29,6 +29,7 @@
 #include <osvr/Connection/DeviceInitObject.h>
 #include <osvr/PluginHost/PluginSpecificRegistrationContext.h>
 #include "HandleNullContext.h"
+#include "SendPackedReport.h"
 #include <osvr/Util/PointerWrapper.h>
 #include <osvr/Common/LocomotionComponent.h>
 #include <osvr/Util/Verbosity.h>
@@ -60,19 +61,34 @@ OSVR_ReturnCode osvrDeviceLocomotionConfigure(
     return OSVR_RETURN_SUCCESS;
 }
 
+namespace {
+/// @brief A navigation velocity or position report, as copied for sending.
+template <typename StateType> struct NaviReport {
+    StateType data;
+    OSVR_ChannelCount sensor;
+    OSVR_TimeValue timestamp;
+};
+
+void sendNaviVelocity(OSVR_LocomotionDeviceInterface iface,
+                      NaviReport<OSVR_NaviVelocityState> const &r) {
+    iface->locomotion->sendNaviVelocityData(r.data, r.sensor, r.timestamp);
+}
+
+void sendNaviPosition(OSVR_LocomotionDeviceInterface iface,
+                      NaviReport<OSVR_NaviPositionState> const &r) {
+    iface->locomotion->sendNaviPositionData(r.data, r.sensor, r.timestamp);
+}
+} // namespace
+
 OSVR_ReturnCode osvrDeviceLocomotionReportNaviVelocity(
     OSVR_IN_PTR OSVR_LocomotionDeviceInterface iface,
     OSVR_IN OSVR_NaviVelocityState naviVelocity,
     OSVR_IN OSVR_ChannelCount sensor,
     OSVR_IN_PTR OSVR_TimeValue const *timestamp) {
-    auto guard = iface->getSendGuard();
-    if (guard->lock()) {
-        iface->locomotion->sendNaviVelocityData(naviVelocity, sensor,
-                                                *timestamp);
-        return OSVR_RETURN_SUCCESS;
-    }
-
-    return OSVR_RETURN_FAILURE;
+    return osvr::pluginkit::sendPackedReport(
+        iface,
+        NaviReport<OSVR_NaviVelocityState>{naviVelocity, sensor, *timestamp},
+        &sendNaviVelocity);
 }
 
 OSVR_ReturnCode osvrDeviceLocomotionReportNaviPosition(
@@ -80,12 +96,8 @@ OSVR_ReturnCode osvrDeviceLocomotionReportNaviPosition(
     OSVR_IN OSVR_NaviPositionState naviPosition,
     OSVR_IN OSVR_ChannelCount sensor,
     OSVR_IN_PTR OSVR_TimeValue const *timestamp) {
-    auto guard = iface->getSendGuard();
-    if (guard->lock()) {
-        iface->locomotion->sendNaviPositionData(naviPosition, sensor,
-                                                *timestamp);
-        return OSVR_RETURN_SUCCESS;
-    }
-
-    return OSVR_RETURN_FAILURE;
+    return osvr::pluginkit::sendPackedReport(
+        iface,
+        NaviReport<OSVR_NaviPositionState>{naviPosition, sensor, *timestamp},
+        &sendNaviPosition);
 }
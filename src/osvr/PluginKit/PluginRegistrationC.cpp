@@ -28,6 +28,7 @@
 #include "HandleNullContext.h"
 #include <osvr/Util/Verbosity.h>
 #include <osvr/PluginHost/PluginSpecificRegistrationContext.h>
+#include <osvr/PluginHost/RegistrationContext.h>
 
 // Library/third-party includes
 // - none
@@ -53,6 +54,22 @@ OSVR_ReturnCode osvrPluginRegisterHardwareDetectCallback(
     return OSVR_RETURN_SUCCESS;
 }
 
+OSVR_ReturnCode
+osvrPluginRequestHardwareDetect(OSVR_INOUT_PTR OSVR_PluginRegContext ctx) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrPluginRequestHardwareDetect", ctx);
+
+    try {
+        osvr::pluginhost::PluginSpecificRegistrationContext::get(ctx)
+            .getParent()
+            .requestHardwareDetect();
+    } catch (std::exception &e) {
+        std::cerr << "Error in osvrPluginRequestHardwareDetect - "
+                     "caught exception reporting: " << e.what() << std::endl;
+        return OSVR_RETURN_FAILURE;
+    }
+    return OSVR_RETURN_SUCCESS;
+}
+
 OSVR_ReturnCode osvrRegisterDriverInstantiationCallback(
     OSVR_INOUT_PTR OSVR_PluginRegContext ctx, OSVR_IN_STRZ const char *name,
     OSVR_IN_PTR OSVR_DriverInstantiationCallback cb,
@@ -0,0 +1,167 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_SendPackedReport_h_GUID_7E3B9C52_0A4D_4F81_B6E2_95D1C8A7F043
+#define INCLUDED_SendPackedReport_h_GUID_7E3B9C52_0A4D_4F81_B6E2_95D1C8A7F043
+
+// Internal Includes
+#include <osvr/Connection/DeviceInterfaceBase.h>
+#include <osvr/Util/ReturnCodesC.h>
+#include <osvr/Util/Verbosity.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <type_traits>
+#include <vector>
+
+namespace osvr {
+namespace pluginkit {
+    namespace detail {
+        /// @brief Header of a report packed for
+        /// OSVR_DeviceTokenObject::sendPackedReport(), followed in the packed
+        /// bytes by any extra data, starting at extraOffset().
+        template <typename InterfaceType, typename Report> struct PackedReport {
+            typedef void (*SendFunction)(InterfaceType, Report const &,
+                                         const char *, std::size_t);
+            SendFunction send;
+            Report report;
+
+            /// @brief Aligned for any type, as is the start of the packed
+            /// bytes, so the extra data can be read in place.
+            static std::size_t extraOffset() {
+                return (sizeof(PackedReport) + alignof(std::max_align_t) - 1) /
+                       alignof(std::max_align_t) * alignof(std::max_align_t);
+            }
+
+            /// @brief The PackedReportFunction: nothing to release when
+            /// dropped, since everything was copied.
+            static void unpackAndSend(void *userdata, const char *data,
+                                      std::size_t len, bool send) {
+                if (!send) {
+                    return;
+                }
+                PackedReport packed;
+                std::memcpy(&packed, data, sizeof(packed));
+                packed.send(static_cast<InterfaceType>(userdata),
+                            packed.report, data + extraOffset(),
+                            len - extraOffset());
+            }
+        };
+
+        /// @brief Reused (per thread) for packing reports, so sending
+        /// doesn't allocate once it has grown to the sizes in use.
+        inline std::vector<char> &packingBuffer() {
+            static thread_local std::vector<char> buffer;
+            return buffer;
+        }
+
+        template <typename InterfaceType, typename Report>
+        struct SingleReport {
+            typedef void (*SendFunction)(InterfaceType, Report const &);
+            SendFunction send;
+            Report report;
+
+            static void sendIt(InterfaceType iface, SingleReport const &r,
+                               const char *, std::size_t) {
+                r.send(iface, r.report);
+            }
+        };
+    } // namespace detail
+
+    /// @brief Sends a report from a device interface without waiting on the
+    /// send guard: the report is copied, along with extraLen bytes written
+    /// by writeExtra(char *), and send(iface, report, extra, extraLen) is
+    /// called with the copies on the thread allowed to send the device's
+    /// messages - later, for an asynchronous device. See
+    /// OSVR_DeviceTokenObject::sendPackedReport().
+    ///
+    /// The report must be plain data, since it's copied bytewise. The extra
+    /// data is suitably aligned for any type.
+    ///
+    /// @return OSVR_RETURN_FAILURE if the report was dropped.
+    template <typename InterfaceType, typename Report, typename WriteExtra>
+    inline OSVR_ReturnCode
+    sendPackedReport(InterfaceType iface, Report const &report,
+                     std::size_t extraLen, WriteExtra &&writeExtra,
+                     void (*send)(InterfaceType, Report const &, const char *,
+                                  std::size_t)) {
+        static_assert(std::is_pod<Report>::value,
+                      "Reports are copied bytewise, so must be plain data.");
+        typedef detail::PackedReport<InterfaceType, Report> Packed;
+        try {
+            Packed packed;
+            packed.send = send;
+            packed.report = report;
+            auto offset = Packed::extraOffset();
+            auto len = offset + extraLen;
+            auto &buffer = detail::packingBuffer();
+            buffer.resize(len);
+            std::memcpy(buffer.data(), &packed, sizeof(packed));
+            writeExtra(buffer.data() + offset);
+            if (iface->sendPackedReport(&Packed::unpackAndSend,
+                                        static_cast<void *>(iface),
+                                        buffer.data(), len)) {
+                return OSVR_RETURN_SUCCESS;
+            }
+        } catch (std::exception const &e) {
+            OSVR_DEV_VERBOSE("Caught exception: " << e.what());
+        } catch (...) {
+            OSVR_DEV_VERBOSE("Caught non-standard exception!");
+        }
+        return OSVR_RETURN_FAILURE;
+    }
+
+    /// @overload
+    ///
+    /// For a report with no extra data.
+    template <typename InterfaceType, typename Report>
+    inline OSVR_ReturnCode
+    sendPackedReport(InterfaceType iface, Report const &report,
+                     void (*send)(InterfaceType, Report const &)) {
+        typedef detail::SingleReport<InterfaceType, Report> Single;
+        Single single;
+        single.send = send;
+        single.report = report;
+        return sendPackedReport(iface, single, 0, [](char *) {},
+                                &Single::sendIt);
+    }
+
+    /// @brief Writes an array as extra data for sendPackedReport().
+    template <typename T> inline void packArray(char *dest, T const *arr,
+                                                std::size_t count) {
+        static_assert(std::is_pod<T>::value,
+                      "Arrays are copied bytewise, so must be plain data.");
+        if (count) {
+            std::memcpy(dest, arr, sizeof(T) * count);
+        }
+    }
+} // namespace pluginkit
+} // namespace osvr
+
+#endif // INCLUDED_SendPackedReport_h_GUID_7E3B9C52_0A4D_4F81_B6E2_95D1C8A7F043
@@ -24,6 +24,7 @@
 
 // Internal Includes
 #include "HandleNullContext.h"
+#include "SendPackedReport.h"
 #include <osvr/Common/SkeletonComponent.h>
 #include <osvr/Connection/DeviceInitObject.h>
 #include <osvr/Connection/DeviceInterfaceBase.h>
@@ -37,7 +38,9 @@
 // - none
 
 // Standard includes
-// - none
+#include <cstddef>
+#include <cstring>
+#include <string>
 
 struct OSVR_SkeletonDeviceInterfaceObject
     : public osvr::connection::DeviceInterfaceBase {
@@ -60,28 +63,42 @@ osvrDeviceSkeletonConfigure(OSVR_INOUT_PTR OSVR_DeviceInitOptions opts,
     return OSVR_RETURN_SUCCESS;
 }
 
+namespace {
+/// @brief A skeleton notification, as copied for sending.
+struct SkeletonReport {
+    OSVR_ChannelCount sensor;
+    OSVR_TimeValue timestamp;
+};
+
+void sendSkeletonComplete(OSVR_SkeletonDeviceInterface iface,
+                          SkeletonReport const &r) {
+    iface->skeleton->sendNotification(r.sensor, r.timestamp);
+}
+
+/// @brief An articulation spec, whose characters follow as extra data.
+struct SpecReport {};
+
+void sendSpec(OSVR_SkeletonDeviceInterface iface, SpecReport const &,
+              const char *extra, std::size_t len) {
+    iface->skeleton->sendArticulationSpec(std::string(extra, len));
+}
+} // namespace
+
 OSVR_ReturnCode
 osvrDeviceSkeletonComplete(OSVR_IN_PTR OSVR_SkeletonDeviceInterface iface,
                            OSVR_IN OSVR_ChannelCount sensor,
                            OSVR_IN_PTR OSVR_TimeValue const *timestamp) {
-    auto guard = iface->getSendGuard();
-    if (guard->lock()) {
-        iface->skeleton->sendNotification(sensor, *timestamp);
-        return OSVR_RETURN_SUCCESS;
-    }
-
-    return OSVR_RETURN_FAILURE;
+    return osvr::pluginkit::sendPackedReport(
+        iface, SkeletonReport{sensor, *timestamp}, &sendSkeletonComplete);
 }
 
 OSVR_ReturnCode
 osvrDeviceSkeletonUpdateSpec(OSVR_IN_PTR OSVR_SkeletonDeviceInterface iface,
                              OSVR_IN_READS(len) const char *spec) {
 
-    auto guard = iface->getSendGuard();
-    if (guard->lock()) {
-        iface->skeleton->sendArticulationSpec(spec);
-        return OSVR_RETURN_SUCCESS;
-    }
-
-    return OSVR_RETURN_FAILURE;
+    std::size_t len = std::strlen(spec);
+    return osvr::pluginkit::sendPackedReport(
+        iface, SpecReport{}, len,
+        [&](char *extra) { osvr::pluginkit::packArray(extra, spec, len); },
+        &sendSpec);
 }
@@ -28,21 +28,23 @@
 #include <osvr/Connection/DeviceToken.h>
 #include <osvr/Connection/DeviceInitObject.h>
 #include <osvr/Connection/DeviceInterfaceBase.h>
+#include <osvr/Common/TrackerBatchComponent.h>
 #include <osvr/PluginHost/PluginSpecificRegistrationContext.h>
 #include "HandleNullContext.h"
 #include <osvr/Util/PointerWrapper.h>
-#include "UseSendGuard.h"
+#include "SendPackedReport.h"
 
 // Library/third-party includes
 // - none
 
 // Standard includes
-// - none
+#include <cstddef>
 
 struct OSVR_TrackerDeviceInterfaceObject
     : public osvr::connection::DeviceInterfaceBase {
     osvr::util::PointerWrapper<osvr::connection::TrackerServerInterface>
         tracker;
+    osvr::common::TrackerBatchComponent *batch;
 };
 
 OSVR_ReturnCode
@@ -54,9 +56,60 @@ osvrDeviceTrackerConfigure(OSVR_INOUT_PTR OSVR_DeviceInitOptions opts,
         opts->makeInterfaceObject<OSVR_TrackerDeviceInterfaceObject>();
     *iface = ifaceObj;
     opts->setTracker(ifaceObj->tracker);
+    auto batch = osvr::common::TrackerBatchComponent::create();
+    ifaceObj->batch = batch.get();
+    opts->addComponent(batch);
     return OSVR_RETURN_SUCCESS;
 }
 
+using osvr::pluginkit::sendPackedReport;
+
+namespace {
+/// @brief A tracker report, as copied for sending.
+template <typename StateType> struct TrackerReport {
+    StateType val;
+    OSVR_ChannelCount sensor;
+    OSVR_TimeValue timestamp;
+};
+
+template <typename StateType>
+void sendTrackerReport(OSVR_TrackerDeviceInterface iface,
+                       TrackerReport<StateType> const &r) {
+    iface->tracker->sendReport(r.val, r.sensor, r.timestamp);
+}
+
+template <typename StateType>
+void sendTrackerVelReport(OSVR_TrackerDeviceInterface iface,
+                          TrackerReport<StateType> const &r) {
+    iface->tracker->sendVelReport(r.val, r.sensor, r.timestamp);
+}
+
+template <typename StateType>
+void sendTrackerAccelReport(OSVR_TrackerDeviceInterface iface,
+                            TrackerReport<StateType> const &r) {
+    iface->tracker->sendAccelReport(r.val, r.sensor, r.timestamp);
+}
+
+/// @brief A pose batch, as copied for sending: the poses, then the sensors
+/// (if any), follow as extra data.
+struct PoseBatchReport {
+    OSVR_ChannelCount count;
+    bool hasSensors;
+    OSVR_TimeValue timestamp;
+};
+
+void sendPoseBatch(OSVR_TrackerDeviceInterface iface,
+                   PoseBatchReport const &r, const char *extra,
+                   std::size_t) {
+    auto poses = reinterpret_cast<OSVR_PoseState const *>(extra);
+    auto sensors = r.hasSensors
+                       ? reinterpret_cast<OSVR_ChannelCount const *>(
+                             extra + sizeof(OSVR_PoseState) * r.count)
+                       : nullptr;
+    iface->batch->sendPoses(poses, sensors, r.count, r.timestamp);
+}
+} // namespace
+
 template <typename StateType>
 static inline OSVR_ReturnCode
 osvrTrackerSend(const char method[], OSVR_DeviceToken,
@@ -64,8 +117,9 @@ osvrTrackerSend(const char method[], OSVR_DeviceToken,
                 OSVR_ChannelCount sensor, OSVR_TimeValue const *timestamp) {
     OSVR_PLUGIN_HANDLE_NULL_CONTEXT(method, iface);
     OSVR_PLUGIN_HANDLE_NULL_CONTEXT(method, timestamp);
-    return useSendGuardVoid(
-        iface, [&]() { iface->tracker->sendReport(*val, sensor, *timestamp); });
+    return sendPackedReport(
+        iface, TrackerReport<StateType>{*val, sensor, *timestamp},
+        &sendTrackerReport<StateType>);
 }
 
 template <typename StateType>
@@ -75,9 +129,9 @@ osvrTrackerSendVel(const char method[], OSVR_DeviceToken,
                    OSVR_ChannelCount sensor, OSVR_TimeValue const *timestamp) {
     OSVR_PLUGIN_HANDLE_NULL_CONTEXT(method, iface);
     OSVR_PLUGIN_HANDLE_NULL_CONTEXT(method, timestamp);
-    return useSendGuardVoid(iface, [&]() {
-        iface->tracker->sendVelReport(*val, sensor, *timestamp);
-    });
+    return sendPackedReport(
+        iface, TrackerReport<StateType>{*val, sensor, *timestamp},
+        &sendTrackerVelReport<StateType>);
 }
 
 template <typename StateType>
@@ -89,9 +143,9 @@ osvrTrackerSendAccel(const char method[], OSVR_DeviceToken,
     OSVR_PLUGIN_HANDLE_NULL_CONTEXT(method, iface);
     OSVR_PLUGIN_HANDLE_NULL_CONTEXT(method, timestamp);
 
-    return useSendGuardVoid(iface, [&]() {
-        iface->tracker->sendAccelReport(*val, sensor, *timestamp);
-    });
+    return sendPackedReport(
+        iface, TrackerReport<StateType>{*val, sensor, *timestamp},
+        &sendTrackerAccelReport<StateType>);
 }
 
 OSVR_ReturnCode
@@ -114,6 +168,31 @@ OSVR_ReturnCode osvrDeviceTrackerSendPoseTimestamped(
                            val, sensor, timestamp);
 }
 
+OSVR_ReturnCode osvrDeviceTrackerSendPoseBatchTimestamped(
+    OSVR_IN_PTR OSVR_DeviceToken, OSVR_IN_PTR OSVR_TrackerDeviceInterface iface,
+    OSVR_IN_READS(count) OSVR_PoseState const *poses,
+    OSVR_IN_OPT OSVR_ChannelCount const *sensors,
+    OSVR_IN OSVR_ChannelCount count,
+    OSVR_IN_PTR OSVR_TimeValue const *timestamp) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceTrackerSendPoseBatchTimestamped",
+                                    iface);
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceTrackerSendPoseBatchTimestamped",
+                                    poses);
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceTrackerSendPoseBatchTimestamped",
+                                    timestamp);
+    auto posesLen = sizeof(OSVR_PoseState) * count;
+    auto sensorsLen = sensors ? sizeof(OSVR_ChannelCount) * count : 0;
+    return sendPackedReport(
+        iface, PoseBatchReport{count, sensors != nullptr, *timestamp},
+        posesLen + sensorsLen,
+        [&](char *extra) {
+            osvr::pluginkit::packArray(extra, poses, count);
+            osvr::pluginkit::packArray(extra + posesLen, sensors,
+                                       sensors ? count : 0);
+        },
+        &sendPoseBatch);
+}
+
 OSVR_ReturnCode
 osvrDeviceTrackerSendPosition(OSVR_IN_PTR OSVR_DeviceToken dev,
                               OSVR_IN_PTR OSVR_TrackerDeviceInterface iface,
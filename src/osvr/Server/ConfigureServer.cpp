@@ -25,6 +25,8 @@
 // Internal Includes
 #include <osvr/Server/ConfigureServer.h>
 #include <osvr/Server/Server.h>
+#include <osvr/Common/ThreadScheduling.h>
+#include <osvr/Common/Tracing.h>
 #include <osvr/Connection/Connection.h>
 #include <osvr/PluginHost/SearchPath.h>
 #include <osvr/Util/Verbosity.h>
@@ -104,6 +106,47 @@ namespace server {
     static const char LOCAL_KEY[] = "local";
     static const char PORT_KEY[] = "port"; // not the triwizard cup.
     static const char SLEEP_KEY[] = "sleep";
+    static const char EVENT_DRIVEN_KEY[] = "eventDriven";
+    static const char REALTIME_KEY[] = "realtime";
+    static const char LOCK_MEMORY_KEY[] = "lockMemory";
+    static const char TRACE_FILE_KEY[] = "traceFile";
+    static const char REPORT_RATES_KEY[] = "reportRates";
+    static const char TRACKER_KEY[] = "tracker";
+    static const char ANALOG_KEY[] = "analog";
+
+    /// @brief Parses the report rate limits: an object whose members are
+    /// device paths, each with either a rate (in reports per second) for all
+    /// its interfaces that support limiting, or an object of rates by
+    /// interface, e.g. `{"tracker": 120, "analog": 30}`.
+    static connection::ReportRateLimits
+    parseReportRateLimits(Json::Value const &rates) {
+        connection::ReportRateLimits ret;
+        if (!rates.isObject()) {
+            return ret;
+        }
+        for (auto const &path : rates.getMemberNames()) {
+            Json::Value const &rate = rates[path];
+            connection::ReportRateLimit limit;
+            if (rate.isNumeric()) {
+                limit.tracker = limit.analog = rate.asDouble();
+            } else if (rate.isObject()) {
+                limit.tracker = rate.get(TRACKER_KEY, 0).asDouble();
+                limit.analog = rate.get(ANALOG_KEY, 0).asDouble();
+            } else {
+                OSVR_DEV_VERBOSE("Ignoring report rate for "
+                                 << path << ": not a number or an object: "
+                                 << rate.toStyledString());
+                continue;
+            }
+            // Device names don't have the leading slash of their paths.
+            auto name = path;
+            if (!name.empty() && name[0] == '/') {
+                name.erase(0, 1);
+            }
+            ret[name] = limit;
+        }
+        return ret;
+    }
 
     ServerPtr ConfigureServer::constructServer() {
         Json::Value const &root(m_data->root);
@@ -115,6 +158,10 @@ namespace server {
 #else
         int sleepTime = 1000; // microseconds
 #endif
+        bool eventDriven = false;
+        common::ThreadSchedulingOptions threadScheduling;
+        bool lockMemory = false;
+        std::string traceFile;
 
         /// Extract data from the JSON structure.
         if (root.isMember(SERVER_KEY)) {
@@ -146,6 +193,25 @@ namespace server {
                 // Convert to microseconds for internal use.
                 sleepTime = static_cast<int>(jsonSleepTime.asDouble() * 1000.0);
             }
+
+            eventDriven = jsonServer.get(EVENT_DRIVEN_KEY, false).asBool();
+
+            Json::Value const &jsonRealtime = jsonServer[REALTIME_KEY];
+            threadScheduling =
+                common::parseThreadSchedulingOptions(jsonRealtime);
+            if (jsonRealtime.isObject()) {
+                lockMemory =
+                    jsonRealtime.get(LOCK_MEMORY_KEY, false).asBool();
+            }
+
+            traceFile = jsonServer.get(TRACE_FILE_KEY, "").asString();
+        }
+
+        if (!traceFile.empty() &&
+            !common::tracing::startTraceRecording(traceFile)) {
+            OSVR_DEV_VERBOSE("Ignoring " << TRACE_FILE_KEY
+                                         << ": this build has no in-process "
+                                            "tracing support.");
         }
 
         /// Construct a server, or a connection then a server, based on the
@@ -165,6 +231,13 @@ namespace server {
         if (sleepTime > 0.0) {
             m_server->setSleepTime(sleepTime);
         }
+        m_server->setEventDriven(eventDriven);
+        m_server->setThreadScheduling(threadScheduling);
+        m_server->setReportRateLimits(
+            parseReportRateLimits(root[REPORT_RATES_KEY]));
+        if (lockMemory) {
+            common::lockProcessMemory();
+        }
 
         m_server->setHardwareDetectOnConnection();
 
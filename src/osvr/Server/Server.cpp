@@ -132,6 +132,20 @@ namespace server {
     void Server::setSleepTime(int microseconds) {
         m_impl->setSleepTime(microseconds);
     }
+
+    void Server::setEventDriven(bool eventDriven) {
+        m_impl->setEventDriven(eventDriven);
+    }
+
+    void Server::setThreadScheduling(
+        common::ThreadSchedulingOptions const &opts) {
+        m_impl->setThreadScheduling(opts);
+    }
+
+    void Server::setReportRateLimits(
+        connection::ReportRateLimits const &limits) {
+        m_impl->setReportRateLimits(limits);
+    }
 #if 0
     int Server::getSleepTime() const { return m_impl->getSleepTime(); }
 #endif
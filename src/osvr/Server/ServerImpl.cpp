@@ -28,6 +28,8 @@
 #include <osvr/Common/AliasProcessor.h>
 #include <osvr/Common/CommonComponent.h>
 #include <osvr/Common/PathTreeFull.h>
+#include <osvr/Common/PathTreeOwner.h>
+#include <osvr/Common/PathTreeSerialization.h>
 #include <osvr/Common/ProcessDeviceDescriptor.h>
 #include <osvr/Common/SystemComponent.h>
 #include <osvr/Common/Tracing.h>
@@ -78,6 +80,15 @@ namespace server {
                 "Can't pass a null ConnectionPtr into Server constructor!");
         }
         osvr::connection::Connection::storeConnection(*m_ctx, m_conn);
+        // Plugins probing for hardware on their own threads ask for another
+        // detection pass this way: just a flag and a wake-up, since the main
+        // mutex may be held by a thread waiting for them to finish.
+        m_ctx->setHardwareDetectRequestHandler([&] {
+            m_detectRequested = true;
+            m_conn->signalActivity();
+        });
+        m_sharedTree = make_shared<common::PathTreeOwner>();
+        m_conn->setSharedPathTree(m_sharedTree);
 
         // Get the underlying VRPN connection, and make sure it's OK.
         auto vrpnConn = getVRPNConnection(m_conn);
@@ -101,6 +112,14 @@ namespace server {
         m_commonComponent =
             m_systemDevice->addComponent(common::CommonComponent::create());
         m_commonComponent->registerPingHandler([&] { m_queueTreeSend(); });
+        m_systemComponent->registerTreeDeltaSupportHandler(
+            [&](uint32_t epoch, bool needKeyframe, uint32_t clientId) {
+                m_treeDeltaClients.handleReply(epoch, clientId);
+                if (needKeyframe) {
+                    m_treeKeyframeRequested = true;
+                    m_treeDirty.set();
+                }
+            });
 
         // Set up the default display descriptor.
         m_tree.getNodeByPath("/display").value() =
@@ -118,6 +137,12 @@ namespace server {
         vrpnConn->register_handler(
             vrpnConn->register_message_type(vrpn_dropped_last_connection),
             &ServerImpl::m_enterIdle, this);
+        vrpnConn->register_handler(
+            vrpnConn->register_message_type(vrpn_got_connection),
+            &ServerImpl::m_handleGotConnection, this);
+        vrpnConn->register_handler(
+            vrpnConn->register_message_type(vrpn_dropped_connection),
+            &ServerImpl::m_handleDroppedConnection, this);
     }
 
     ServerImpl::~ServerImpl() {
@@ -140,6 +165,9 @@ namespace server {
         m_thread = boost::thread([&] {
             bool keepRunning = true;
             m_mainThreadId = m_thread.get_id();
+            if (!m_threadScheduling.isDefault()) {
+                common::applyThreadScheduling(m_threadScheduling, "server");
+            }
             ::util::LoopGuard guard(m_run);
             do {
                 keepRunning = this->m_loop();
@@ -217,7 +245,7 @@ namespace server {
         for (auto &f : m_mainloopMethods) {
             f();
         }
-        if (m_triggeredDetect) {
+        if (m_detectRequested.exchange(false) || m_triggeredDetect) {
             m_log->info() << "Performing hardware auto-detection.";
             common::tracing::markHardwareDetect();
             m_ctx->triggerHardwareDetect();
@@ -228,6 +256,12 @@ namespace server {
             m_sendTree();
             m_treeDirty.reset();
         }
+        uint32_t epoch;
+        if (m_treeDeltaClients.startQueryIfNeeded(epoch)) {
+            // After any keyframe, so a new client is in sync by the time it
+            // answers.
+            m_systemComponent->sendTreeDeltaQuery(epoch);
+        }
     }
 
     bool ServerImpl::m_loop() {
@@ -241,11 +275,22 @@ namespace server {
         }
 
         if (m_currentSleepTime > 0) {
-            osvr::util::time::microsleep(m_currentSleepTime);
+            if (m_eventDriven) {
+                m_waitForActivity(m_currentSleepTime);
+            } else {
+                osvr::util::time::microsleep(m_currentSleepTime);
+            }
         }
         return shouldContinue;
     }
 
+    void ServerImpl::m_waitForActivity(int microseconds) {
+        /// One blocking wait on the connection's sockets and on activity
+        /// signalled by other threads. No handlers run here (so no mutex is
+        /// needed): whatever arrived is handled by the next m_update().
+        m_conn->waitForActivityOrMessages(microseconds);
+    }
+
     bool ServerImpl::addRoute(std::string const &routingDirective) {
         bool wasNew;
         m_callControlled([&] { wasNew = m_addRoute(routingDirective); });
@@ -315,6 +360,9 @@ namespace server {
     }
 
     void ServerImpl::m_orderedDestruction() {
+        if (m_ctx) {
+            m_ctx->setHardwareDetectRequestHandler(std::function<void()>());
+        }
         m_ctx.reset();
         m_systemComponent = nullptr; // non-owning pointer
         m_systemDevice.reset();
@@ -359,18 +407,64 @@ namespace server {
         return change;
     }
     void ServerImpl::m_queueTreeSend() {
-        m_callControlled([&] { m_treeDirty += true; });
+        m_callControlled([&] {
+            m_treeKeyframeRequested = true;
+            m_treeDirty += true;
+            m_treeDeltaClients.requestQuery();
+        });
     }
     void ServerImpl::m_sendTree() {
-
-        common::tracing::markPathTreeBroadcast();
-        m_systemComponent->sendReplacementTree(m_tree);
-        m_log->info() << "Sent path tree to clients.";
+        auto nodes = common::pathTreeToJson(m_tree);
+        const bool changed = (nodes != m_lastSentTree);
+        if (!*m_sharedTree || changed) {
+            /// In-process contexts copy this, rather than each parsing the
+            /// tree after a round trip through the connection.
+            m_sharedTree->replaceTree(nodes);
+        }
+        if (m_treeKeyframeRequested) {
+            common::tracing::markPathTreeBroadcast();
+            m_systemComponent->sendTreeDelta(
+                common::pathTreeDelta(Json::arrayValue, nodes),
+                ++m_treeGeneration, true);
+        } else {
+            auto delta = common::pathTreeDelta(m_lastSentTree, nodes);
+            if (common::isPathTreeDeltaEmpty(delta)) {
+                m_log->debug() << "Path tree unchanged, not sending.";
+                return;
+            }
+            common::tracing::markPathTreeBroadcast();
+            m_systemComponent->sendTreeDelta(delta, ++m_treeGeneration, false);
+        }
+        if (!m_treeDeltaClients.allClientsSupportDeltas() &&
+            (changed || m_treeKeyframeRequested)) {
+            /// Some client (a new one that hasn't answered a query yet, or
+            /// an older one that never will) may only understand the whole
+            /// thing.
+            m_systemComponent->sendReplacementTree(nodes);
+        }
+        m_lastSentTree = std::move(nodes);
+        m_treeKeyframeRequested = false;
+        m_log->info() << "Sent path tree generation " << m_treeGeneration
+                      << " to clients.";
     }
 
     void ServerImpl::setSleepTime(int microseconds) {
         m_sleepTime = microseconds;
     }
+
+    void ServerImpl::setEventDriven(bool eventDriven) {
+        m_eventDriven = eventDriven;
+    }
+
+    void ServerImpl::setThreadScheduling(
+        common::ThreadSchedulingOptions const &opts) {
+        m_threadScheduling = opts;
+    }
+
+    void ServerImpl::setReportRateLimits(
+        connection::ReportRateLimits const &limits) {
+        m_conn->setReportRateLimits(limits);
+    }
 #if 0
     int ServerImpl::getSleepTime() const { return m_sleepTime; }
 #endif
@@ -387,6 +481,19 @@ namespace server {
         }
     }
 
+    int ServerImpl::m_handleGotConnection(void *userdata, vrpn_HANDLERPARAM) {
+        auto self = static_cast<ServerImpl *>(userdata);
+        self->m_treeDeltaClients.clientConnected();
+        return 0;
+    }
+
+    int ServerImpl::m_handleDroppedConnection(void *userdata,
+                                              vrpn_HANDLERPARAM) {
+        auto self = static_cast<ServerImpl *>(userdata);
+        self->m_treeDeltaClients.clientDropped();
+        return 0;
+    }
+
     int ServerImpl::m_exitIdle(void *userdata, vrpn_HANDLERPARAM) {
         auto self = static_cast<ServerImpl *>(userdata);
         /// Conditional ensures that we don't "idle" faster than we run: Make
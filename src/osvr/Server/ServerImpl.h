@@ -26,11 +26,15 @@
 #define INCLUDED_ServerImpl_h_GUID_BA15589C_D1AD_4BBE_4F93_8AC87043A982
 
 // Internal Includes
+#include "TreeDeltaClients.h"
 #include <osvr/Common/CommonComponent_fwd.h>
 #include <osvr/Common/CreateDevice.h>
 #include <osvr/Common/LowLatency.h>
 #include <osvr/Common/PathTree.h>
+#include <osvr/Common/PathTreeOwnerPtr.h>
 #include <osvr/Common/SystemComponent_fwd.h>
+#include <osvr/Common/ThreadScheduling.h>
+#include <osvr/Connection/Connection.h>
 #include <osvr/Connection/ConnectionPtr.h>
 #include <osvr/Connection/DeviceToken.h>
 #include <osvr/Connection/MessageTypePtr.h>
@@ -51,6 +55,7 @@
 #include <vrpn_Connection.h>
 
 // Standard includes
+#include <atomic>
 #include <string>
 
 namespace osvr {
@@ -121,6 +126,15 @@ namespace server {
 
         /// @copydoc Server::setSleepTime()
         void setSleepTime(int microseconds);
+
+        /// @copydoc Server::setEventDriven()
+        void setEventDriven(bool eventDriven);
+
+        /// @copydoc Server::setThreadScheduling()
+        void setThreadScheduling(common::ThreadSchedulingOptions const &opts);
+
+        /// @copydoc Server::setReportRateLimits()
+        void setReportRateLimits(connection::ReportRateLimits const &limits);
 #if 0
         /// @copydoc Server::getSleepTime()
         int getSleepTime() const;
@@ -148,6 +162,12 @@ namespace server {
         /// @overload
         template <typename Callable> void m_callControlled(Callable f) const;
 
+        /// @brief Event-driven replacement for sleeping after a loop
+        /// iteration: returns once messages arrive from clients, an async
+        /// device or another thread signals activity, or the given number of
+        /// microseconds pass.
+        void m_waitForActivity(int microseconds);
+
         /// @brief Destroy the context, connection, and nested device in a safe
         /// order.
         void m_orderedDestruction();
@@ -155,7 +175,10 @@ namespace server {
         /// @brief Queues up a tree transmission for next time around
         void m_queueTreeSend();
 
-        /// @brief sends full path tree contents
+        /// @brief sends path tree changes (or, if requested, a keyframe) to
+        /// delta-aware clients, followed by the full path tree contents if
+        /// any client might not be delta-aware, after updating the shared path
+        /// tree if it changed.
         void m_sendTree();
 
         /// @brief handles updated route message from client
@@ -185,6 +208,13 @@ namespace server {
         /// or effectively so)
         bool m_inServerThread() const;
 
+        /// @brief Callbacks on each client connecting/disconnecting, to keep
+        /// track of which understand path tree deltas.
+        static int VRPN_CALLBACK m_handleGotConnection(void *userdata,
+                                                       vrpn_HANDLERPARAM);
+        static int VRPN_CALLBACK m_handleDroppedConnection(void *userdata,
+                                                           vrpn_HANDLERPARAM);
+
         /// @brief Callback on getting first connection, to exit idle state.
         static int VRPN_CALLBACK m_exitIdle(void *userdata, vrpn_HANDLERPARAM);
         /// @brief Callback on dropping last connection, to enter idle state.
@@ -212,10 +242,32 @@ namespace server {
         /// detection.
         bool m_triggeredDetect = false;
 
+        /// @brief Set from any thread when a plugin asks for another hardware
+        /// detection (see RegistrationContext::requestHardwareDetect())
+        std::atomic<bool> m_detectRequested{false};
+
         /// @brief Path tree
         common::PathTree m_tree;
         util::Flag m_treeDirty;
 
+        /// @brief Whether a client may need the whole tree (connection
+        /// detected), rather than just changes.
+        bool m_treeKeyframeRequested = true;
+
+        /// @brief Copy of the path tree shared (through the connection) with
+        /// in-process client contexts, updated once per change.
+        common::PathTreeOwnerPtr m_sharedTree;
+
+        /// @brief Path tree contents as last sent, for computing deltas.
+        Json::Value m_lastSentTree;
+
+        /// @brief Generation number of the last path tree sent.
+        uint32_t m_treeGeneration = 0;
+
+        /// @brief Whether all clients understand deltas, so can go without
+        /// the full path tree.
+        TreeDeltaClients m_treeDeltaClients;
+
         /// @brief Mutex held by anything executing in the main thread.
         mutable boost::mutex m_mainThreadMutex;
 
@@ -248,6 +300,14 @@ namespace server {
         /// right now. 0 = no sleeping.
         int m_currentSleepTime = IDLE_SLEEP_TIME;
 
+        /// @brief Whether to wait for activity (up to the current sleep time)
+        /// rather than sleeping unconditionally after each loop iteration.
+        /// With no sleep time, there's no waiting either way.
+        bool m_eventDriven = false;
+
+        /// @brief Scheduling options applied to the server thread on start.
+        common::ThreadSchedulingOptions m_threadScheduling;
+
         /// The host/interface we're listening on, if any.
         std::string m_host;
 
@@ -288,6 +348,7 @@ namespace server {
             boost::unique_lock<boost::mutex> innerLock(m_mainThreadMutex);
             TemporaryThreadIDChanger changer(m_mainThreadId);
             f();
+            m_conn->signalActivity();
         } else {
             f();
         }
@@ -300,6 +361,7 @@ namespace server {
             boost::unique_lock<boost::mutex> innerLock(m_mainThreadMutex);
             TemporaryThreadIDChanger changer(m_mainThreadId);
             f();
+            m_conn->signalActivity();
         } else {
             f();
         }
@@ -0,0 +1,127 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_TreeDeltaClients_h_GUID_6E0B3A52_1F7C_4D89_A2E4_C95B18D3F067
+#define INCLUDED_TreeDeltaClients_h_GUID_6E0B3A52_1F7C_4D89_A2E4_C95B18D3F067
+
+// Internal Includes
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+#include <set>
+
+namespace osvr {
+namespace server {
+    /// @brief Keeps track of whether every connected client understands path
+    /// tree deltas, so the full path tree only has to be sent when one might
+    /// not.
+    ///
+    /// Whenever the set of clients may have changed, the server asks them all
+    /// (with a new "epoch" number). Each client answers with an ID it picked
+    /// at random, and support is recorded per ID: a client answering twice
+    /// counts once. Older clients never answer, so while one is connected
+    /// there are fewer supporting clients than connections, and the full
+    /// tree keeps being sent.
+    ///
+    /// The connection doesn't say which client a message came from, or which
+    /// one disconnected, so a disconnect clears what every client said, and
+    /// they're all asked again. Only network connections are counted, so
+    /// in-process contexts (which read the server's shared tree) must not
+    /// answer.
+    ///
+    /// Not thread-safe: used only from the server loop.
+    class TreeDeltaClients {
+      public:
+        /// @brief A client connected: it doesn't count as understanding deltas
+        /// until it replies to a query.
+        void clientConnected() {
+            ++m_clients;
+            m_queryNeeded = true;
+        }
+
+        /// @brief A client disconnected: since we don't know which, what all
+        /// of them said is forgotten, and they're asked again.
+        void clientDropped() {
+            if (m_clients > 0) {
+                --m_clients;
+            }
+            m_supporting.clear();
+            m_queryNeeded = true;
+        }
+
+        /// @brief Asks for a new query even if the client count hasn't changed
+        /// (e.g. when a client pings, so it's surely ready for one).
+        void requestQuery() { m_queryNeeded = true; }
+
+        /// @brief If a query is due, starts collecting replies afresh.
+        ///
+        /// @param[out] epoch Set to the epoch to send in the query, if one is
+        /// due. Never 0, which clients use in unsolicited messages.
+        /// @return true if a query should be sent.
+        bool startQueryIfNeeded(uint32_t &epoch) {
+            if (!m_queryNeeded) {
+                return false;
+            }
+            m_queryNeeded = false;
+            ++m_epoch;
+            if (0 == m_epoch) {
+                ++m_epoch;
+            }
+            m_supporting.clear();
+            epoch = m_epoch;
+            return true;
+        }
+
+        /// @brief Handles a client's reply, which names the epoch of the query
+        /// it answers and the client's ID: replies to older queries, and
+        /// replies without an ID, are ignored.
+        void handleReply(uint32_t epoch, uint32_t clientId) {
+            if (0 != epoch && epoch == m_epoch && 0 != clientId) {
+                m_supporting.insert(clientId);
+            }
+        }
+
+        /// @brief Whether every connected client is known to understand
+        /// deltas, so doesn't need the full tree.
+        bool allClientsSupportDeltas() const {
+            return m_supporting.size() >= m_clients;
+        }
+
+        std::size_t numClients() const { return m_clients; }
+
+      private:
+        std::size_t m_clients = 0;
+        /// @brief IDs of the clients that answered the current query.
+        std::set<uint32_t> m_supporting;
+        uint32_t m_epoch = 0;
+        bool m_queryNeeded = false;
+    };
+} // namespace server
+} // namespace osvr
+
+#endif // INCLUDED_TreeDeltaClients_h_GUID_6E0B3A52_1F7C_4D89_A2E4_C95B18D3F067
@@ -36,5 +36,11 @@ namespace osvr {
 namespace util {
     GuardInterface::~GuardInterface() {}
     DummyGuard::~DummyGuard() {}
+
+    static DummyGuard s_sharedDummyGuard;
+
+    GuardPtr DummyGuard::getShared() {
+        return GuardPtr(&s_sharedDummyGuard, GuardDeleter::nonOwning());
+    }
 } // namespace util
 } // namespace osvr
@@ -0,0 +1,175 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Client/PosePrediction.h>
+#include "../../../src/osvr/Client/IncrementalRotation.h"
+#include <osvr/Util/EigenInterop.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <cmath>
+
+using osvr::client::getPredictionVelocity;
+using osvr::client::incRotToAngVelVec;
+using osvr::client::predictPose;
+using osvr::util::time::TimeValue;
+namespace ei = osvr::util::eigen_interop;
+
+static const double PI = 3.14159265358979323846;
+
+inline TimeValue ms(int milliseconds) {
+    TimeValue tv = {1000, milliseconds * 1000};
+    return tv;
+}
+
+/// @brief Incremental rotation of the given angle about the z axis.
+inline OSVR_IncrementalQuaternion incRotZ(double angle, double dt) {
+    OSVR_IncrementalQuaternion ret;
+    ei::map(ret.incrementalRotation) =
+        Eigen::Quaterniond(Eigen::AngleAxisd(angle, Eigen::Vector3d::UnitZ()));
+    ret.dt = dt;
+    return ret;
+}
+
+inline OSVR_PoseState identityPose() {
+    OSVR_PoseState ret;
+    ei::map(ret.translation) = Eigen::Vector3d::Zero();
+    ei::map(ret.rotation) = Eigen::Quaterniond::Identity();
+    return ret;
+}
+
+inline OSVR_VelocityState noVelocity() {
+    OSVR_VelocityState ret = {};
+    ret.linearVelocityValid = OSVR_FALSE;
+    ret.angularVelocityValid = OSVR_FALSE;
+    return ret;
+}
+
+TEST(IncRotToAngVelVec, ZeroDtMeansNoVelocity) {
+    ASSERT_TRUE(incRotToAngVelVec(incRotZ(0.5, 0)).isZero());
+}
+
+TEST(IncRotToAngVelVec, RotationOverTime) {
+    auto vec = incRotToAngVelVec(incRotZ(0.1, 0.01));
+    ASSERT_NEAR(0, vec.x(), 1e-9);
+    ASSERT_NEAR(0, vec.y(), 1e-9);
+    ASSERT_NEAR(10., vec.z(), 1e-9);
+}
+
+TEST(IncRotToAngVelVec, TakesShortWayAround) {
+    auto incRot = incRotZ(-0.1, 0.01);
+    // Same rotation, opposite sign.
+    ei::map(incRot.incrementalRotation) =
+        Eigen::Quaterniond(-ei::map(incRot.incrementalRotation).quat().coeffs());
+    ASSERT_LT(ei::map(incRot.incrementalRotation).w(), 0);
+    auto vec = incRotToAngVelVec(incRot);
+    ASSERT_NEAR(-10., vec.z(), 1e-9);
+}
+
+TEST(PredictPose, UnchangedWithoutVelocity) {
+    auto pose = identityPose();
+    pose.translation.data[0] = 1;
+    auto out = predictPose(pose, ms(0), noVelocity(), ms(100));
+    ASSERT_EQ(1, out.translation.data[0]);
+    ASSERT_TRUE(ei::map(out.rotation).quat().isApprox(
+        Eigen::Quaterniond::Identity()));
+}
+
+TEST(PredictPose, UnchangedAtPoseTime) {
+    auto vel = noVelocity();
+    vel.linearVelocityValid = OSVR_TRUE;
+    vel.linearVelocity.data[0] = 5;
+    auto out = predictPose(identityPose(), ms(10), vel, ms(10));
+    ASSERT_EQ(0, out.translation.data[0]);
+}
+
+TEST(PredictPose, LinearVelocity) {
+    auto vel = noVelocity();
+    vel.linearVelocityValid = OSVR_TRUE;
+    ei::map(vel.linearVelocity) = Eigen::Vector3d(2, 0, -1);
+    auto out = predictPose(identityPose(), ms(0), vel, ms(500));
+    ASSERT_TRUE(ei::map(out.translation).isApprox(Eigen::Vector3d(1, 0, -0.5)));
+    ASSERT_TRUE(ei::map(out.rotation).quat().isApprox(
+        Eigen::Quaterniond::Identity()));
+}
+
+TEST(PredictPose, AngularVelocity) {
+    // A quarter turn per second about z, for half a second.
+    auto vel = noVelocity();
+    vel.angularVelocityValid = OSVR_TRUE;
+    vel.angularVelocity = incRotZ(PI / 2 * 0.01, 0.01);
+    auto out = predictPose(identityPose(), ms(0), vel, ms(500));
+    Eigen::Quaterniond expected(
+        Eigen::AngleAxisd(PI / 4, Eigen::Vector3d::UnitZ()));
+    ASSERT_TRUE(ei::map(out.rotation).quat().isApprox(expected, 1e-9));
+    ASSERT_TRUE(ei::map(out.translation).isZero());
+}
+
+inline osvr::common::PoseVelocityState
+linearPoseVelocity(TimeValue const &poseTime, TimeValue const &velocityTime) {
+    osvr::common::PoseVelocityState ret = {};
+    ret.hasPose = true;
+    ret.pose = identityPose();
+    ret.poseTime = poseTime;
+    ret.hasVelocity = true;
+    ret.velocity = noVelocity();
+    ret.velocity.linearVelocityValid = OSVR_TRUE;
+    ret.velocity.linearVelocity.data[0] = 5;
+    ret.velocityTime = velocityTime;
+    return ret;
+}
+
+TEST(PredictionVelocity, NoVelocity) {
+    auto state = linearPoseVelocity(ms(100), ms(100));
+    state.hasVelocity = false;
+    auto vel = getPredictionVelocity(state);
+    ASSERT_FALSE(vel.linearVelocityValid);
+    ASSERT_FALSE(vel.angularVelocityValid);
+}
+
+TEST(PredictionVelocity, RecentVelocity) {
+    auto vel = getPredictionVelocity(linearPoseVelocity(ms(100), ms(90)));
+    ASSERT_TRUE(vel.linearVelocityValid);
+    ASSERT_EQ(5, vel.linearVelocity.data[0]);
+}
+
+TEST(PredictionVelocity, VelocityAfterPose) {
+    auto vel = getPredictionVelocity(linearPoseVelocity(ms(100), ms(110)));
+    ASSERT_TRUE(vel.linearVelocityValid);
+}
+
+TEST(PredictionVelocity, StaleVelocityIgnored) {
+    TimeValue poseTime = {1002, 0};
+    auto state = linearPoseVelocity(poseTime, ms(0));
+    auto vel = getPredictionVelocity(state);
+    ASSERT_FALSE(vel.linearVelocityValid);
+    ASSERT_FALSE(vel.angularVelocityValid);
+    auto out = predictPose(state.pose, state.poseTime, vel, {1003, 0});
+    ASSERT_EQ(0, out.translation.data[0])
+        << "Velocity from two seconds before the pose shouldn't move it";
+}
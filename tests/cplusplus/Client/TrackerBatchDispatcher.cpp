@@ -0,0 +1,124 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "../../../src/osvr/Client/TrackerBatchDispatcher.h"
+#include <osvr/Common/Buffer.h>
+#include <osvr/Common/Serialization.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <vector>
+
+using osvr::client::TrackerBatchDispatcher;
+using osvr::common::TrackerPoseBatch;
+using osvr::common::TrackerPoseData;
+using osvr::util::time::TimeValue;
+namespace serialization = osvr::common::serialization;
+
+inline TrackerPoseData poseData(OSVR_ChannelCount sensor, double x) {
+    TrackerPoseData ret = {};
+    ret.sensor = sensor;
+    ret.pose.translation.data[0] = x;
+    ret.pose.rotation.data[0] = 1;
+    return ret;
+}
+
+TEST(TrackerPoseBatch, DecodesIntoReusedBatch) {
+    TrackerPoseBatch in = {poseData(0, 1.5), poseData(7, -2)};
+    osvr::common::Buffer<> buf;
+    serialization::serializeRaw(buf, in);
+
+    // Decoding reuses a batch that previously held more poses.
+    TrackerPoseBatch out = {poseData(1, 0), poseData(2, 0), poseData(3, 0)};
+    auto reader = buf.startReading();
+    serialization::deserializeRaw(reader, out);
+    ASSERT_EQ(0u, reader.bytesRemaining());
+    ASSERT_EQ(2u, out.size());
+    ASSERT_EQ(0u, out[0].sensor);
+    ASSERT_EQ(1.5, out[0].pose.translation.data[0]);
+    ASSERT_EQ(7u, out[1].sensor);
+    ASSERT_EQ(-2, out[1].pose.translation.data[0]);
+    ASSERT_EQ(1, out[1].pose.rotation.data[0]);
+}
+
+TEST(TrackerBatchDispatcher, EachHandlerGetsEachBatchOnce) {
+    TrackerBatchDispatcher dispatcher;
+    std::vector<int> calls(3, 0);
+    TrackerPoseBatch const *seen = nullptr;
+    for (int i = 0; i < 3; ++i) {
+        dispatcher.addHandler(
+            [&calls, &seen, i](TrackerPoseBatch const &batch,
+                               TimeValue const &) {
+                ++calls[i];
+                seen = &batch;
+            });
+    }
+    TrackerPoseBatch batch = {poseData(0, 1), poseData(1, 2)};
+    TimeValue tv = {};
+    dispatcher.dispatch(batch, tv);
+    ASSERT_EQ((std::vector<int>{1, 1, 1}), calls);
+    ASSERT_EQ(&batch, seen) << "Handlers share the one decoded batch";
+}
+
+TEST(TrackerBatchDispatcher, RemovedHandlerNotCalled) {
+    TrackerBatchDispatcher dispatcher;
+    int first = 0;
+    int second = 0;
+    auto id = dispatcher.addHandler(
+        [&](TrackerPoseBatch const &, TimeValue const &) { ++first; });
+    dispatcher.addHandler(
+        [&](TrackerPoseBatch const &, TimeValue const &) { ++second; });
+    ASSERT_EQ(2u, dispatcher.numHandlers());
+    dispatcher.removeHandler(id);
+    ASSERT_EQ(1u, dispatcher.numHandlers());
+
+    TimeValue tv = {};
+    dispatcher.dispatch(TrackerPoseBatch{poseData(0, 1)}, tv);
+    ASSERT_EQ(0, first);
+    ASSERT_EQ(1, second);
+}
+
+TEST(TrackerBatchDispatcher, FirstHandlerIsEarliestRemaining) {
+    TrackerBatchDispatcher dispatcher;
+    auto noop = [](TrackerPoseBatch const &, TimeValue const &) {};
+    auto first = dispatcher.addHandler(noop);
+    auto second = dispatcher.addHandler(noop);
+    auto third = dispatcher.addHandler(noop);
+    ASSERT_TRUE(dispatcher.isFirstHandler(first));
+    ASSERT_FALSE(dispatcher.isFirstHandler(second));
+    ASSERT_FALSE(dispatcher.isFirstHandler(third));
+
+    dispatcher.removeHandler(first);
+    ASSERT_FALSE(dispatcher.isFirstHandler(first));
+    ASSERT_TRUE(dispatcher.isFirstHandler(second))
+        << "Another handler takes over updating the shared source";
+
+    dispatcher.removeHandler(second);
+    dispatcher.removeHandler(third);
+    ASSERT_FALSE(dispatcher.isFirstHandler(third));
+}
@@ -0,0 +1,180 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/DirectReportDispatch.h>
+#include <osvr/Util/Pose3C.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+
+using osvr::common::DirectReportDispatch;
+using osvr::common::DirectTrackerChannelPtr;
+using osvr::common::TrackerReportSink;
+using osvr::util::time::TimeValue;
+
+/// Records what it's handed as "kind:sensor" strings, and runs an optional
+/// action after each.
+class RecordingSink : public TrackerReportSink {
+  public:
+    RecordingSink(std::vector<std::string> &log, std::string const &name)
+        : m_log(log), m_name(name) {}
+    void handleDirectPose(OSVR_ChannelCount sensor, OSVR_PoseState const &,
+                          TimeValue const &) override {
+        m_record("pose", sensor);
+    }
+    void handleDirectVelocity(OSVR_ChannelCount sensor,
+                              OSVR_VelocityState const &,
+                              TimeValue const &) override {
+        m_record("vel", sensor);
+    }
+    void handleDirectAcceleration(OSVR_ChannelCount sensor,
+                                  OSVR_AccelerationState const &,
+                                  TimeValue const &) override {
+        m_record("acc", sensor);
+    }
+    std::function<void()> afterReport;
+
+  private:
+    void m_record(const char *kind, OSVR_ChannelCount sensor) {
+        m_log.push_back(m_name + kind + ":" + std::to_string(sensor));
+        if (afterReport) {
+            afterReport();
+        }
+    }
+    std::vector<std::string> &m_log;
+    std::string m_name;
+};
+
+typedef std::vector<std::string> Log;
+
+inline OSVR_PoseState identityPose() {
+    OSVR_PoseState pose;
+    osvrPose3SetIdentity(&pose);
+    return pose;
+}
+
+class DirectReportDispatchTest : public ::testing::Test {
+  protected:
+    DirectReportDispatchTest()
+        : dispatch(DirectReportDispatch::create()),
+          tracker(dispatch->getTrackerChannel("dev/tracker")),
+          other(dispatch->getTrackerChannel("dev/other")) {
+        tv.seconds = 1;
+        tv.microseconds = 0;
+    }
+    osvr::common::DirectReportDispatchPtr dispatch;
+    DirectTrackerChannelPtr tracker;
+    DirectTrackerChannelPtr other;
+    TimeValue tv;
+    Log log;
+};
+
+TEST_F(DirectReportDispatchTest, SameNameSameChannel) {
+    ASSERT_EQ(tracker, dispatch->getTrackerChannel("dev/tracker"));
+    ASSERT_NE(tracker, other);
+}
+
+TEST_F(DirectReportDispatchTest, QueuedUntilDelivered) {
+    RecordingSink sink(log, "");
+    tracker->addSink(sink);
+    tracker->sendPose(0, identityPose(), tv);
+    tracker->sendVelocity(1, OSVR_VelocityState(), tv);
+    ASSERT_TRUE(log.empty()) << "Nothing delivered while sending";
+    ASSERT_EQ(2u, dispatch->numQueued());
+
+    dispatch->deliver();
+    ASSERT_EQ((Log{"pose:0", "vel:1"}), log);
+    ASSERT_EQ(0u, dispatch->numQueued());
+    dispatch->deliver();
+    ASSERT_EQ(2u, log.size()) << "Each report delivered once";
+}
+
+TEST_F(DirectReportDispatchTest, DeliveredInSendOrderAcrossDevices) {
+    RecordingSink trackerSink(log, "t-");
+    RecordingSink otherSink(log, "o-");
+    tracker->addSink(trackerSink);
+    other->addSink(otherSink);
+    tracker->sendPose(0, identityPose(), tv);
+    other->sendAcceleration(2, OSVR_AccelerationState(), tv);
+    tracker->sendVelocity(0, OSVR_VelocityState(), tv);
+    dispatch->deliver();
+    ASSERT_EQ((Log{"t-pose:0", "o-acc:2", "t-vel:0"}), log);
+}
+
+TEST_F(DirectReportDispatchTest, GoesToSinksRegisteredAtDelivery) {
+    RecordingSink early(log, "early-");
+    RecordingSink late(log, "late-");
+    tracker->addSink(early);
+    tracker->sendPose(0, identityPose(), tv);
+    tracker->removeSink(early);
+    tracker->addSink(late);
+    dispatch->deliver();
+    ASSERT_EQ((Log{"late-pose:0"}), log);
+}
+
+TEST_F(DirectReportDispatchTest, SinkMayRemoveItselfWhileDelivering) {
+    RecordingSink first(log, "a-");
+    RecordingSink second(log, "b-");
+    first.afterReport = [&] { tracker->removeSink(first); };
+    tracker->addSink(first);
+    tracker->addSink(second);
+    tracker->sendPose(0, identityPose(), tv);
+    tracker->sendPose(1, identityPose(), tv);
+    dispatch->deliver();
+    ASSERT_EQ("a-pose:0", log.front());
+    ASSERT_EQ("b-pose:1", log.back());
+    ASSERT_EQ(1, std::count(log.begin(), log.end(), "a-pose:0"));
+}
+
+TEST_F(DirectReportDispatchTest, ReportsSentWhileDeliveringWaitForNextTime) {
+    RecordingSink sink(log, "");
+    sink.afterReport = [&] {
+        if (log.size() == 1) {
+            tracker->sendPose(5, identityPose(), tv);
+        }
+    };
+    tracker->addSink(sink);
+    tracker->sendPose(0, identityPose(), tv);
+    dispatch->deliver();
+    ASSERT_EQ((Log{"pose:0"}), log);
+    ASSERT_EQ(1u, dispatch->numQueued());
+    dispatch->deliver();
+    ASSERT_EQ((Log{"pose:0", "pose:5"}), log);
+}
+
+TEST_F(DirectReportDispatchTest, WireRequirementAppliesToAllChannels) {
+    ASSERT_FALSE(tracker->isWireRequired());
+    dispatch->requireWire();
+    ASSERT_TRUE(tracker->isWireRequired());
+    ASSERT_TRUE(other->isWireRequired());
+    ASSERT_TRUE(dispatch->getTrackerChannel("dev/new")->isWireRequired());
+}
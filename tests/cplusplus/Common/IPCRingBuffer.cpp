@@ -0,0 +1,209 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/IPCRingBuffer.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+
+using osvr::common::IPCRingBuffer;
+using osvr::common::IPCRingBufferPtr;
+
+static const IPCRingBuffer::entry_size_type ENTRY_SIZE = 4096;
+
+static IPCRingBuffer::Options makeOptions(std::string const &name,
+                                          bool lockFree) {
+    IPCRingBuffer::Options opts(name);
+    opts.setEntries(4).setEntrySize(ENTRY_SIZE).setLockFree(lockFree);
+    return opts;
+}
+
+/// Each entry is filled with the low byte of its sequence number, so a torn
+/// read shows up as a mix of values.
+static bool isConsistent(IPCRingBuffer::BufferReadProxy const &proxy) {
+    auto expected =
+        static_cast<IPCRingBuffer::value_type>(proxy.getSequenceNumber());
+    auto buf = proxy.get();
+    for (IPCRingBuffer::entry_size_type i = 0; i < ENTRY_SIZE; ++i) {
+        if (buf[i] != expected) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST(IPCRingBufferABI, MutexLevelIsTheLegacyLevel) {
+    ASSERT_EQ(IPCRingBuffer::getABILevel(), IPCRingBuffer::getABILevel(false));
+    bool lockFree = true;
+    ASSERT_TRUE(IPCRingBuffer::isABILevelSupported(
+        IPCRingBuffer::getABILevel(), lockFree));
+    ASSERT_FALSE(lockFree);
+}
+
+TEST(IPCRingBufferABI, LockFreeLevelDeclinedByOlderClients) {
+    auto level = IPCRingBuffer::getABILevel(true);
+    // Older clients only accept exactly their own level.
+    ASSERT_NE(IPCRingBuffer::getABILevel(), level);
+    bool lockFree = false;
+    ASSERT_TRUE(IPCRingBuffer::isABILevelSupported(level, lockFree));
+    ASSERT_TRUE(lockFree);
+}
+
+TEST(IPCRingBufferABI, UnknownLevelRejected) {
+    bool lockFree = false;
+    ASSERT_FALSE(IPCRingBuffer::isABILevelSupported(
+        IPCRingBuffer::getABILevel() + 1, lockFree));
+}
+
+TEST(IPCRingBufferABI, MixedLayoutsDontFindEachOther) {
+    auto lockFreeBuf = IPCRingBuffer::create(
+        makeOptions("osvr-test-ipc-mixed-lockfree", true));
+    ASSERT_TRUE(bool(lockFreeBuf));
+    ASSERT_EQ(IPCRingBuffer::getABILevel(true),
+              lockFreeBuf->getSegmentABILevel());
+    // A client that only knows the mutex layout can't open it...
+    ASSERT_FALSE(bool(IPCRingBuffer::find(
+        makeOptions("osvr-test-ipc-mixed-lockfree", false))));
+    // ...while one that negotiated the lock-free layout can.
+    auto found = IPCRingBuffer::find(
+        makeOptions("osvr-test-ipc-mixed-lockfree", true));
+    ASSERT_TRUE(bool(found));
+    ASSERT_TRUE(found->getLockFree());
+
+    auto mutexBuf = IPCRingBuffer::create(
+        makeOptions("osvr-test-ipc-mixed-mutex", false));
+    ASSERT_TRUE(bool(mutexBuf));
+    ASSERT_EQ(IPCRingBuffer::getABILevel(), mutexBuf->getSegmentABILevel());
+    ASSERT_FALSE(bool(
+        IPCRingBuffer::find(makeOptions("osvr-test-ipc-mixed-mutex", true))));
+    found =
+        IPCRingBuffer::find(makeOptions("osvr-test-ipc-mixed-mutex", false));
+    ASSERT_TRUE(bool(found));
+    ASSERT_FALSE(found->getLockFree());
+}
+
+TEST(IPCRingBufferABI, NoEntriesMeansNoBuffer) {
+    for (bool lockFree : {false, true}) {
+        IPCRingBuffer::Options opts("osvr-test-ipc-no-entries");
+        opts.setEntries(0).setEntrySize(ENTRY_SIZE).setLockFree(lockFree);
+        ASSERT_FALSE(bool(IPCRingBuffer::create(opts)));
+    }
+}
+
+class IPCRingBufferPut : public ::testing::TestWithParam<bool> {};
+
+TEST_P(IPCRingBufferPut, UnfinishedPutStaysInvisibleToReaders) {
+    auto name = std::string("osvr-test-ipc-put-") +
+                (GetParam() ? "lockfree" : "mutex");
+    auto writer = IPCRingBuffer::create(makeOptions(name, GetParam()));
+    ASSERT_TRUE(bool(writer));
+    auto reader = IPCRingBuffer::find(makeOptions(name, GetParam()));
+    ASSERT_TRUE(bool(reader));
+
+    // Fill the ring, so the next put has to evict the oldest entry.
+    for (int i = 0; i < 4; ++i) {
+        auto proxy = writer->put();
+        std::memset(proxy.get(), i, ENTRY_SIZE);
+    }
+    {
+        auto proxy = writer->put();
+        ASSERT_EQ(IPCRingBuffer::sequence_type(4), proxy.getSequenceNumber());
+        std::memset(proxy.get(), 4, ENTRY_SIZE / 2);
+
+        // While the put is outstanding, readers neither wait on it nor see
+        // it: they get the previous entry, and the evicted one is gone.
+        auto latest = reader->getLatest();
+        ASSERT_TRUE(bool(latest));
+        ASSERT_EQ(IPCRingBuffer::sequence_type(3), latest.getSequenceNumber());
+        ASSERT_TRUE(isConsistent(latest));
+        ASSERT_FALSE(bool(reader->get(4)));
+        ASSERT_FALSE(bool(reader->get(0)));
+        std::memset(proxy.get(), 4, ENTRY_SIZE);
+    }
+    auto latest = reader->getLatest();
+    ASSERT_TRUE(bool(latest));
+    ASSERT_EQ(IPCRingBuffer::sequence_type(4), latest.getSequenceNumber());
+    ASSERT_TRUE(isConsistent(latest));
+    ASSERT_FALSE(bool(reader->get(0)));
+    ASSERT_TRUE(bool(reader->get(1)));
+}
+
+INSTANTIATE_TEST_CASE_P(Layouts, IPCRingBufferPut,
+                        ::testing::Values(false, true));
+
+class IPCRingBufferReadWrite : public ::testing::TestWithParam<bool> {};
+
+TEST_P(IPCRingBufferReadWrite, ReadersNeverSeeTornEntries) {
+    auto name = std::string("osvr-test-ipc-rw-") +
+                (GetParam() ? "lockfree" : "mutex");
+    auto writer = IPCRingBuffer::create(makeOptions(name, GetParam()));
+    ASSERT_TRUE(bool(writer));
+    auto reader = IPCRingBuffer::find(makeOptions(name, GetParam()));
+    ASSERT_TRUE(bool(reader));
+
+    static const int NUM_PUTS = 5000;
+    std::atomic<bool> done(false);
+    std::thread writerThread([&] {
+        for (int i = 0; i < NUM_PUTS; ++i) {
+            auto proxy = writer->put();
+            std::memset(proxy.get(),
+                        static_cast<IPCRingBuffer::value_type>(
+                            proxy.getSequenceNumber()),
+                        ENTRY_SIZE);
+        }
+        done = true;
+    });
+
+    int tornReads = 0;
+    while (!done) {
+        auto proxy = reader->getLatest();
+        if (!proxy) {
+            // Lock-free mode: overwritten while copying, and correctly
+            // reported as such.
+            continue;
+        }
+        if (!isConsistent(proxy)) {
+            ++tornReads;
+        }
+    }
+    writerThread.join();
+
+    ASSERT_EQ(0, tornReads);
+    auto last = reader->getLatest();
+    ASSERT_TRUE(bool(last));
+    ASSERT_TRUE(isConsistent(last));
+    ASSERT_EQ(IPCRingBuffer::sequence_type(NUM_PUTS - 1),
+              last.getSequenceNumber());
+}
+
+INSTANTIATE_TEST_CASE_P(Layouts, IPCRingBufferReadWrite,
+                        ::testing::Values(false, true));
@@ -0,0 +1,89 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "ImageBufferPool.h"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+// - none
+
+using osvr::common::ImageBufferPool;
+using osvr::common::ImageBufferPtr;
+
+TEST(ImageBufferPool, ReusesReleasedBuffer) {
+    ImageBufferPool pool;
+    auto first = pool.acquire(1000);
+    ASSERT_TRUE(bool(first));
+    auto addr = first.get();
+    first.reset();
+    ASSERT_EQ(addr, pool.acquire(1000).get());
+}
+
+TEST(ImageBufferPool, DoesNotReuseBufferInUse) {
+    ImageBufferPool pool;
+    auto first = pool.acquire(1000);
+    auto second = pool.acquire(1000);
+    ASSERT_NE(first.get(), second.get());
+}
+
+TEST(ImageBufferPool, ReplacesBufferWhenSizeChanges) {
+    ImageBufferPool pool(1);
+    pool.acquire(1000);
+    auto bigger = pool.acquire(4000);
+    ASSERT_TRUE(bool(bigger));
+    // The bigger one took over the only slot.
+    auto addr = bigger.get();
+    bigger.reset();
+    ASSERT_EQ(addr, pool.acquire(4000).get());
+}
+
+TEST(ImageBufferPool, OverflowsWhenFull) {
+    ImageBufferPool pool(2);
+    auto a = pool.acquire(1000);
+    auto b = pool.acquire(1000);
+    auto c = pool.acquire(1000);
+    ASSERT_TRUE(bool(c));
+    ASSERT_NE(a.get(), c.get());
+    ASSERT_NE(b.get(), c.get());
+    // Only the pooled buffers get reused.
+    c.reset();
+    auto d = pool.acquire(1000);
+    ASSERT_TRUE(bool(d));
+    ASSERT_NE(a.get(), d.get());
+    ASSERT_NE(b.get(), d.get());
+}
+
+TEST(ImageBufferPool, BuffersOutliveThePool) {
+    ImageBufferPtr buf;
+    {
+        ImageBufferPool pool;
+        buf = pool.acquire(1000);
+    }
+    ASSERT_EQ(1, buf.use_count());
+    buf.get()[999] = 1;
+}
@@ -0,0 +1,401 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "ImageBufferPool.h"
+#include "ImageWireTransport.h"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <algorithm>
+#include <vector>
+
+using osvr::common::ImageBufferPool;
+using osvr::common::ImageData;
+using osvr::common::ImageWireEncoding;
+using osvr::common::NetworkImageStreamOptions;
+namespace image_wire = osvr::common::image_wire;
+
+typedef std::vector<OSVR_ImageBufferElement> Image;
+
+static OSVR_ImagingMetadata makeMetadata(uint32_t width, uint32_t height,
+                                         uint8_t channels = 1) {
+    OSVR_ImagingMetadata meta;
+    meta.width = width;
+    meta.height = height;
+    meta.channels = channels;
+    meta.depth = 1;
+    meta.type = OSVR_IVT_UNSIGNED_INT;
+    return meta;
+}
+
+/// Mostly-dark frame with a few bright blobs, like a tracking camera's.
+static Image makeTrackingFrame(OSVR_ImagingMetadata const &meta) {
+    Image img(image_wire::getImageBufferSize(meta), 3);
+    for (uint32_t y = 20; y < 30 && y < meta.height; ++y) {
+        for (uint32_t x = 40; x < 50 && x < meta.width; ++x) {
+            img[y * meta.width + x] = static_cast<OSVR_ImageBufferElement>(
+                200 + x - y);
+        }
+    }
+    return img;
+}
+
+static Image makeNoise(std::size_t bytes) {
+    Image img(bytes);
+    uint32_t state = 12345;
+    for (auto &px : img) {
+        state = state * 1664525u + 1013904223u;
+        px = static_cast<OSVR_ImageBufferElement>(state >> 24);
+    }
+    return img;
+}
+
+static Image roundTrip(ImageWireEncoding requested,
+                       OSVR_ImagingMetadata const &meta, Image const &img,
+                       ImageWireEncoding *used = nullptr) {
+    std::vector<char> encoded;
+    auto encoding =
+        image_wire::encodeImage(requested, meta, img.data(), encoded);
+    if (used) {
+        *used = encoding;
+    }
+    Image decoded(img.size());
+    EXPECT_TRUE(image_wire::decodeImage(encoding, meta, encoded.data(),
+                                        encoded.size(), decoded.data()));
+    return decoded;
+}
+
+TEST(ImageWireEncoding, RawRoundTrip) {
+    auto meta = makeMetadata(64, 48);
+    auto img = makeTrackingFrame(meta);
+    ASSERT_EQ(img, roundTrip(ImageWireEncoding::Raw, meta, img));
+}
+
+TEST(ImageWireEncoding, RowDeltaRoundTripAndCompresses) {
+    auto meta = makeMetadata(640, 480);
+    auto img = makeTrackingFrame(meta);
+    std::vector<char> encoded;
+    ASSERT_EQ(ImageWireEncoding::RowDelta,
+              image_wire::encodeImage(ImageWireEncoding::RowDelta, meta,
+                                      img.data(), encoded));
+    ASSERT_LT(encoded.size(), img.size() / 50);
+    ASSERT_EQ(img, roundTrip(ImageWireEncoding::RowDelta, meta, img));
+}
+
+TEST(ImageWireEncoding, RowDeltaMultiChannel) {
+    auto meta = makeMetadata(33, 17, 3);
+    auto img = makeNoise(image_wire::getImageBufferSize(meta));
+    // Flatten some of it so there's something to compress.
+    std::fill(img.begin(), img.begin() + img.size() / 2, 9);
+    ASSERT_EQ(img, roundTrip(ImageWireEncoding::RowDelta, meta, img));
+}
+
+TEST(ImageWireEncoding, FallsBackToRawForNoise) {
+    auto meta = makeMetadata(64, 48);
+    auto img = makeNoise(image_wire::getImageBufferSize(meta));
+    ImageWireEncoding used = ImageWireEncoding::RowDelta;
+    ASSERT_EQ(img, roundTrip(ImageWireEncoding::RowDelta, meta, img, &used));
+    ASSERT_EQ(ImageWireEncoding::Raw, used);
+}
+
+TEST(ImageWireEncoding, RejectsTruncatedInput) {
+    auto meta = makeMetadata(640, 480);
+    auto img = makeTrackingFrame(meta);
+    std::vector<char> encoded;
+    image_wire::encodeImage(ImageWireEncoding::RowDelta, meta, img.data(),
+                            encoded);
+    Image decoded(img.size());
+    ASSERT_FALSE(image_wire::decodeImage(ImageWireEncoding::RowDelta, meta,
+                                         encoded.data(), encoded.size() - 1,
+                                         decoded.data()));
+}
+
+TEST(ImageWireReduce, DefaultOptionsLeaveImageAlone) {
+    auto meta = makeMetadata(64, 48);
+    auto img = makeTrackingFrame(meta);
+    Image scratch;
+    ASSERT_EQ(img.data(), image_wire::reduceImage(meta, img.data(),
+                                                  NetworkImageStreamOptions(),
+                                                  scratch));
+    ASSERT_EQ(64u, meta.width);
+    ASSERT_EQ(48u, meta.height);
+}
+
+TEST(ImageWireReduce, RegionAndDownscale) {
+    auto meta = makeMetadata(10, 8);
+    Image img(80);
+    for (std::size_t i = 0; i < img.size(); ++i) {
+        img[i] = static_cast<OSVR_ImageBufferElement>(i);
+    }
+    NetworkImageStreamOptions opts;
+    opts.roiX = 1;
+    opts.roiY = 2;
+    opts.roiWidth = 5;
+    opts.downscale = 2;
+    Image scratch;
+    auto out = image_wire::reduceImage(meta, img.data(), opts, scratch);
+    // Columns 1, 3, 5 of rows 2, 4, 6.
+    ASSERT_EQ(3u, meta.width);
+    ASSERT_EQ(3u, meta.height);
+    Image expected = {21, 23, 25, 41, 43, 45, 61, 63, 65};
+    ASSERT_EQ(expected, Image(out, out + 9));
+}
+
+/// Splits an encoded frame into chunks, as the server does.
+static std::vector<image_wire::ChunkHeader>
+makeChunks(OSVR_ChannelCount sensor, uint32_t frameSeq,
+           OSVR_ImagingMetadata const &meta, std::size_t encodedSize,
+           uint32_t chunkSize) {
+    std::vector<image_wire::ChunkHeader> ret;
+    image_wire::ChunkHeader header;
+    header.sensor = sensor;
+    header.frameSeq = frameSeq;
+    header.metadata = meta;
+    header.encoding = ImageWireEncoding::Raw;
+    header.encodedSize = static_cast<uint32_t>(encodedSize);
+    for (header.offset = 0; header.offset < header.encodedSize;
+         header.offset += header.length) {
+        header.length =
+            std::min(header.encodedSize - header.offset, chunkSize);
+        ret.push_back(header);
+    }
+    return ret;
+}
+
+TEST(ImageFrameReassembler, ReassemblesOutOfOrderChunks) {
+    auto meta = makeMetadata(64, 48);
+    auto img = makeNoise(image_wire::getImageBufferSize(meta));
+    auto chunks = makeChunks(0, 1, meta, img.size(), 1000);
+    std::reverse(chunks.begin(), chunks.end());
+    ImageBufferPool pool;
+    image_wire::FrameReassembler reassembler(pool);
+    ImageData data;
+    for (std::size_t i = 0; i < chunks.size(); ++i) {
+        auto payload =
+            reinterpret_cast<char const *>(img.data()) + chunks[i].offset;
+        bool done = reassembler.addChunk(chunks[i], payload, data);
+        ASSERT_EQ(i + 1 == chunks.size(), done);
+    }
+    ASSERT_EQ(0u, data.sensor);
+    ASSERT_EQ(img, Image(data.buffer.get(), data.buffer.get() + img.size()));
+    ASSERT_EQ(0u, reassembler.getDroppedFrames());
+}
+
+TEST(ImageFrameReassembler, NewerFrameDropsStalePartialFrame) {
+    auto meta = makeMetadata(64, 48);
+    auto img = makeNoise(image_wire::getImageBufferSize(meta));
+    auto bytes = reinterpret_cast<char const *>(img.data());
+    auto first = makeChunks(0, 1, meta, img.size(), 1000);
+    auto second = makeChunks(0, 2, meta, img.size(), 1000);
+    ImageBufferPool pool;
+    image_wire::FrameReassembler reassembler(pool);
+    ImageData data;
+    ASSERT_FALSE(reassembler.addChunk(first[0], bytes, data));
+    for (auto const &chunk : second) {
+        reassembler.addChunk(chunk, bytes + chunk.offset, data);
+    }
+    ASSERT_TRUE(bool(data.buffer));
+    ASSERT_EQ(1u, reassembler.getDroppedFrames());
+    // The rest of the stale frame is never completed.
+    ImageData stale;
+    for (std::size_t i = 1; i < first.size(); ++i) {
+        ASSERT_FALSE(
+            reassembler.addChunk(first[i], bytes + first[i].offset, stale));
+    }
+}
+
+TEST(ImageFrameReassembler, BoundedNumberOfPartialFrames) {
+    auto meta = makeMetadata(64, 48);
+    auto img = makeNoise(image_wire::getImageBufferSize(meta));
+    auto bytes = reinterpret_cast<char const *>(img.data());
+    ImageBufferPool pool;
+    image_wire::FrameReassembler reassembler(pool, 2);
+    ImageData data;
+    // Start frames on three sensors: the first one gets evicted.
+    for (OSVR_ChannelCount sensor = 0; sensor < 3; ++sensor) {
+        auto chunks = makeChunks(sensor, 1, meta, img.size(), 1000);
+        ASSERT_FALSE(reassembler.addChunk(chunks[0], bytes, data));
+    }
+    ASSERT_EQ(1u, reassembler.getDroppedFrames());
+}
+
+TEST(ImageFrameReassembler, RejectsChunkOutsideFrame) {
+    auto meta = makeMetadata(64, 48);
+    auto img = makeNoise(image_wire::getImageBufferSize(meta));
+    auto chunks = makeChunks(0, 1, meta, img.size(), 1000);
+    chunks[0].offset = chunks[0].encodedSize - 10;
+    ImageBufferPool pool;
+    image_wire::FrameReassembler reassembler(pool);
+    ImageData data;
+    ASSERT_FALSE(reassembler.addChunk(
+        chunks[0], reinterpret_cast<char const *>(img.data()), data));
+}
+
+TEST(ImageFrameReassembler, DuplicateChunksDontCompleteFrame) {
+    auto meta = makeMetadata(64, 48);
+    auto img = makeNoise(image_wire::getImageBufferSize(meta));
+    auto bytes = reinterpret_cast<char const *>(img.data());
+    auto chunks = makeChunks(0, 1, meta, img.size(), 1000);
+    ImageBufferPool pool;
+    image_wire::FrameReassembler reassembler(pool);
+    ImageData data;
+    // As many chunks as the frame has, but never the last one.
+    for (std::size_t i = 0; i < chunks.size(); ++i) {
+        auto const &chunk = chunks[i == 0 ? 0 : i - 1];
+        ASSERT_FALSE(reassembler.addChunk(chunk, bytes + chunk.offset, data));
+    }
+    auto const &last = chunks.back();
+    ASSERT_TRUE(reassembler.addChunk(last, bytes + last.offset, data));
+    ASSERT_EQ(img, Image(data.buffer.get(), data.buffer.get() + img.size()));
+}
+
+TEST(ImageFrameReassembler, RejectsChunkDisagreeingWithFrame) {
+    auto meta = makeMetadata(64, 48);
+    auto img = makeTrackingFrame(meta);
+    std::vector<char> encoded;
+    ASSERT_EQ(ImageWireEncoding::RowDelta,
+              image_wire::encodeImage(ImageWireEncoding::RowDelta, meta,
+                                      img.data(), encoded));
+    auto half = static_cast<uint32_t>(encoded.size() / 2 + 1);
+    auto chunks = makeChunks(0, 1, meta, encoded.size(), half);
+    for (auto &chunk : chunks) {
+        chunk.encoding = ImageWireEncoding::RowDelta;
+    }
+    ASSERT_EQ(2u, chunks.size());
+    ImageBufferPool pool;
+    image_wire::FrameReassembler reassembler(pool);
+    ImageData data;
+    ASSERT_FALSE(reassembler.addChunk(chunks[0], encoded.data(), data));
+
+    // A chunk of the same frame claiming it's the full image size, at an
+    // offset past the end of the buffer sized from the first chunk.
+    Image junk(img.size());
+    auto bigger = chunks[1];
+    bigger.encodedSize = static_cast<uint32_t>(img.size());
+    bigger.offset = bigger.encodedSize - 1000;
+    bigger.length = 1000;
+    ASSERT_FALSE(reassembler.addChunk(
+        bigger, reinterpret_cast<char const *>(junk.data()), data));
+
+    auto otherMeta = chunks[1];
+    otherMeta.metadata.channels = 3;
+    ASSERT_FALSE(reassembler.addChunk(
+        otherMeta, encoded.data() + otherMeta.offset, data));
+    auto otherEncoding = chunks[1];
+    otherEncoding.encoding = ImageWireEncoding::Raw;
+    ASSERT_FALSE(reassembler.addChunk(
+        otherEncoding, encoded.data() + otherEncoding.offset, data));
+    ASSERT_FALSE(bool(data.buffer));
+
+    // The frame can still be finished by a chunk that agrees with it.
+    ASSERT_TRUE(reassembler.addChunk(
+        chunks[1], encoded.data() + chunks[1].offset, data));
+    ASSERT_EQ(img, Image(data.buffer.get(), data.buffer.get() + img.size()));
+    ASSERT_EQ(0u, reassembler.getDroppedFrames());
+}
+
+static image_wire::ChunkHeader makeFrameHeader(uint32_t frameSeq,
+                                               OSVR_ImagingMetadata const &m) {
+    image_wire::ChunkHeader header;
+    header.sensor = 0;
+    header.frameSeq = frameSeq;
+    header.metadata = m;
+    header.encoding = ImageWireEncoding::Raw;
+    return header;
+}
+
+TEST(ImageFrameChunker, ChunksCoverFrameAndReassemble) {
+    auto meta = makeMetadata(64, 48);
+    auto img = makeNoise(image_wire::getImageBufferSize(meta));
+    image_wire::FrameChunker chunker;
+    ASSERT_FALSE(chunker.inFlight());
+    auto &encoded = chunker.getEncodeBuffer();
+    encoded.assign(img.begin(), img.end());
+    chunker.startFrame(makeFrameHeader(1, meta));
+    ASSERT_TRUE(chunker.inFlight());
+
+    ImageBufferPool pool;
+    image_wire::FrameReassembler reassembler(pool);
+    ImageData data;
+    image_wire::ChunkHeader header;
+    char const *bytes = nullptr;
+    std::size_t chunks = 0;
+    bool done = false;
+    while (chunker.nextChunk(1000, header, bytes)) {
+        ASSERT_GE(1000u, header.length);
+        ASSERT_EQ(img.size(), header.encodedSize);
+        done = reassembler.addChunk(header, bytes, data);
+        ++chunks;
+    }
+    ASSERT_FALSE(chunker.inFlight());
+    ASSERT_EQ((img.size() + 999) / 1000, chunks);
+    ASSERT_TRUE(done);
+    ASSERT_EQ(img, Image(data.buffer.get(), data.buffer.get() + img.size()));
+}
+
+TEST(ImageFrameChunker, NewFrameAbandonsRestOfPrevious) {
+    auto meta = makeMetadata(64, 48);
+    auto img = makeNoise(image_wire::getImageBufferSize(meta));
+    image_wire::FrameChunker chunker;
+    chunker.getEncodeBuffer().assign(img.begin(), img.end());
+    chunker.startFrame(makeFrameHeader(1, meta));
+
+    ImageBufferPool pool;
+    image_wire::FrameReassembler reassembler(pool);
+    ImageData data;
+    image_wire::ChunkHeader header;
+    char const *bytes = nullptr;
+    // Only part of the first frame gets out before the next one is ready.
+    ASSERT_TRUE(chunker.nextChunk(1000, header, bytes));
+    ASSERT_FALSE(reassembler.addChunk(header, bytes, data));
+
+    chunker.getEncodeBuffer().assign(img.begin(), img.end());
+    chunker.startFrame(makeFrameHeader(2, meta));
+    ASSERT_EQ(1u, chunker.getAbandonedFrames());
+    ASSERT_TRUE(chunker.nextChunk(1000, header, bytes));
+    ASSERT_EQ(2u, header.frameSeq);
+    ASSERT_EQ(0u, header.offset) << "New frame starts from the beginning";
+    bool done = reassembler.addChunk(header, bytes, data);
+    while (chunker.nextChunk(1000, header, bytes)) {
+        done = reassembler.addChunk(header, bytes, data);
+    }
+    ASSERT_TRUE(done);
+    ASSERT_EQ(1u, reassembler.getDroppedFrames());
+}
+
+TEST(ImageFrameChunker, EmptyFrameIsOneEmptyChunk) {
+    auto meta = makeMetadata(0, 0);
+    image_wire::FrameChunker chunker;
+    chunker.getEncodeBuffer().clear();
+    chunker.startFrame(makeFrameHeader(1, meta));
+    image_wire::ChunkHeader header;
+    char const *bytes = nullptr;
+    ASSERT_TRUE(chunker.nextChunk(1000, header, bytes));
+    ASSERT_EQ(0u, header.length);
+    ASSERT_FALSE(chunker.nextChunk(1000, header, bytes));
+}
@@ -0,0 +1,120 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/InterfaceState.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <atomic>
+#include <thread>
+
+using osvr::common::InterfaceState;
+using osvr::common::PoseVelocityState;
+using osvr::util::time::TimeValue;
+
+inline TimeValue seconds(int s) {
+    TimeValue tv = {s, 0};
+    return tv;
+}
+
+inline OSVR_PoseReport poseReport(double x) {
+    OSVR_PoseReport report = {};
+    report.pose.translation.data[0] = x;
+    report.pose.rotation.data[0] = 1;
+    return report;
+}
+
+inline OSVR_VelocityReport velocityReport(double x) {
+    OSVR_VelocityReport report = {};
+    report.state.linearVelocityValid = OSVR_TRUE;
+    report.state.linearVelocity.data[0] = x;
+    return report;
+}
+
+TEST(InterfaceState, PoseVelocityInitiallyEmpty) {
+    InterfaceState state;
+    PoseVelocityState pv;
+    ASSERT_FALSE(state.getPoseVelocityState(pv));
+    state.setStateFromReport(seconds(1), OSVR_ButtonReport{});
+    ASSERT_FALSE(state.getPoseVelocityState(pv))
+        << "Other report types don't count";
+}
+
+TEST(InterfaceState, PoseVelocityTracksBoth) {
+    InterfaceState state;
+    PoseVelocityState pv;
+    state.setStateFromReport(seconds(1), poseReport(2));
+    ASSERT_TRUE(state.getPoseVelocityState(pv));
+    ASSERT_TRUE(pv.hasPose);
+    ASSERT_FALSE(pv.hasVelocity);
+    ASSERT_EQ(2, pv.pose.translation.data[0]);
+    ASSERT_EQ(1, pv.poseTime.seconds);
+
+    state.setStateFromReport(seconds(3), velocityReport(4));
+    ASSERT_TRUE(state.getPoseVelocityState(pv));
+    ASSERT_TRUE(pv.hasPose);
+    ASSERT_TRUE(pv.hasVelocity);
+    ASSERT_EQ(2, pv.pose.translation.data[0]) << "Pose kept";
+    ASSERT_EQ(4, pv.velocity.linearVelocity.data[0]);
+    ASSERT_EQ(3, pv.velocityTime.seconds);
+
+    // Agrees with the per-report-type state.
+    TimeValue tv;
+    OSVR_PoseState pose;
+    ASSERT_TRUE(state.getState<OSVR_PoseReport>(tv, pose));
+    ASSERT_EQ(2, pose.translation.data[0]);
+}
+
+TEST(InterfaceState, PoseVelocityReadAsPair) {
+    // The writer sends pose i then velocity i: a reader must only ever see
+    // velocity i-1 or i alongside pose i.
+    static const int UPDATES = 100000;
+    InterfaceState state;
+    std::atomic<bool> done(false);
+    std::thread writer([&] {
+        for (int i = 1; i <= UPDATES; ++i) {
+            state.setStateFromReport(seconds(i), poseReport(i));
+            state.setStateFromReport(seconds(i), velocityReport(i));
+        }
+        done = true;
+    });
+    int mismatches = 0;
+    while (!done) {
+        PoseVelocityState pv;
+        if (!state.getPoseVelocityState(pv) || !pv.hasVelocity) {
+            continue;
+        }
+        auto diff =
+            pv.pose.translation.data[0] - pv.velocity.linearVelocity.data[0];
+        if (diff != 0 && diff != 1) {
+            ++mismatches;
+        }
+    }
+    writer.join();
+    ASSERT_EQ(0, mismatches);
+}
@@ -34,7 +34,7 @@
 #include "json/reader.h"
 
 // Standard includes
-// - none
+#include <stdexcept>
 
 namespace common = osvr::common;
 using osvr::common::PathTree;
@@ -84,3 +84,81 @@ TEST(PathTreeJSON, SerializedTreeToJsonWithRoundtrip) {
 
     ASSERT_EQ(common::pathTreeToJson(tree), val);
 }
+
+TEST(PathTreeJSON, DeltaRoundtrip) {
+    PathTree deviceOnly;
+    dummy::setupDummyDevice(deviceOnly);
+    auto oldJson = common::pathTreeToJson(deviceOnly);
+
+    PathTree full;
+    setupDummyTree(full);
+    auto newJson = common::pathTreeToJson(full);
+
+    auto delta = common::pathTreeDelta(oldJson, newJson);
+    ASSERT_FALSE(common::isPathTreeDeltaEmpty(delta));
+    ASSERT_EQ(delta["added"].size(), 1u);
+    ASSERT_EQ(delta["changed"].size(), 0u);
+    ASSERT_EQ(delta["removed"].size(), 0u);
+
+    ASSERT_NO_THROW(common::applyPathTreeDelta(deviceOnly, delta));
+    ASSERT_EQ(newJson, common::pathTreeToJson(deviceOnly));
+
+    /// And back again, by removal.
+    auto reverse = common::pathTreeDelta(newJson, oldJson);
+    ASSERT_EQ(reverse["added"].size(), 0u);
+    ASSERT_EQ(reverse["removed"].size(), 1u);
+    ASSERT_NO_THROW(common::applyPathTreeDelta(deviceOnly, reverse));
+    ASSERT_EQ(oldJson, common::pathTreeToJson(deviceOnly));
+    PathTree const &constTree = deviceOnly;
+    ASSERT_THROW(constTree.getNodeByPath(dummy::getAlias()),
+                 osvr::util::tree::NoSuchChild)
+        << "Removed nodes don't linger as nulls";
+    ASSERT_THROW(constTree.getNodeByPath("/me"), osvr::util::tree::NoSuchChild)
+        << "Nor do the null nodes that only led to them";
+
+    ASSERT_TRUE(
+        common::isPathTreeDeltaEmpty(common::pathTreeDelta(newJson, newJson)));
+}
+
+TEST(PathTreeJSON, DeltaChangedNode) {
+    PathTree tree;
+    setupDummyTree(tree);
+    auto oldJson = common::pathTreeToJson(tree);
+
+    tree.getNodeByPath(dummy::getAlias()).value() =
+        dummy::AliasElement(dummy::getInterfacePath() + "/0");
+    auto newJson = common::pathTreeToJson(tree);
+
+    auto delta = common::pathTreeDelta(oldJson, newJson);
+    ASSERT_EQ(delta["added"].size(), 0u);
+    ASSERT_EQ(delta["changed"].size(), 1u);
+    ASSERT_EQ(delta["removed"].size(), 0u);
+
+    PathTree tree2;
+    ASSERT_NO_THROW(common::jsonToPathTree(tree2, oldJson));
+    ASSERT_NO_THROW(common::applyPathTreeDelta(tree2, delta));
+    ASSERT_EQ(newJson, common::pathTreeToJson(tree2));
+}
+
+TEST(PathTreeJSON, CompactDeltaRoundtrip) {
+    PathTree full;
+    setupDummyTree(full);
+    auto newJson = common::pathTreeToJson(full);
+
+    /// A keyframe: everything is added.
+    auto delta = common::pathTreeDelta(Json::Value(Json::arrayValue), newJson);
+    auto compact = common::compactPathTreeDelta(delta);
+    ASSERT_FALSE(compact.strings.empty());
+    ASSERT_EQ(delta, common::expandPathTreeDelta(compact));
+
+    /// Removal only carries the path.
+    auto reverse = common::pathTreeDelta(newJson, Json::arrayValue);
+    compact = common::compactPathTreeDelta(reverse);
+    ASSERT_TRUE(compact.added.empty());
+    ASSERT_EQ(compact.removed.size(), newJson.size());
+    ASSERT_EQ(reverse, common::expandPathTreeDelta(compact));
+
+    /// Malformed input is rejected rather than misread.
+    compact.removed.push_back(static_cast<uint32_t>(compact.strings.size()));
+    ASSERT_THROW(common::expandPathTreeDelta(compact), std::runtime_error);
+}
@@ -0,0 +1,102 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "DummyTree.h"
+#include <osvr/Common/PathTreeObserver.h>
+#include <osvr/Common/PathTreeOwner.h>
+#include <osvr/Common/PathTreeSerialization.h>
+#include <osvr/Common/ResolveTreeNode.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <json/value.h>
+
+// Standard includes
+// - none
+
+namespace common = osvr::common;
+using osvr::common::PathTree;
+using osvr::common::PathTreeEvents;
+using osvr::common::PathTreeOwner;
+
+/// A server-side shared tree, and an in-process context's copy of it, as
+/// set up by AnalysisClientContext.
+class PathTreeOwnerCopy : public ::testing::Test {
+  public:
+    PathTreeOwnerCopy() : observer(shared.makeObserver()) {
+        observer->setEventCallback(PathTreeEvents::AfterUpdate,
+                                   [&](PathTree &tree) {
+                                       ++sharedUpdates;
+                                       copy.copyTree(tree);
+                                   });
+        copyObserver = copy.makeObserver();
+        copyObserver->setEventCallback(PathTreeEvents::AfterUpdate,
+                                       [&](PathTree &) { ++copyUpdates; });
+    }
+
+    void publish() {
+        PathTree tree;
+        dummy::setupDummyTree(tree);
+        shared.replaceTree(common::pathTreeToJson(tree));
+    }
+
+    PathTreeOwner shared;
+    PathTreeOwner copy;
+    common::PathTreeObserverPtr observer;
+    common::PathTreeObserverPtr copyObserver;
+    int sharedUpdates = 0;
+    int copyUpdates = 0;
+};
+
+TEST_F(PathTreeOwnerCopy, CopyFollowsShared) {
+    ASSERT_FALSE(bool(copy));
+    publish();
+    ASSERT_EQ(1, sharedUpdates);
+    ASSERT_EQ(1, copyUpdates);
+    ASSERT_TRUE(bool(copy));
+    ASSERT_EQ(common::pathTreeToJson(shared.get()),
+              common::pathTreeToJson(copy.get()));
+    publish();
+    ASSERT_EQ(2, copyUpdates);
+}
+
+TEST_F(PathTreeOwnerCopy, ResolvingInCopyLeavesSharedAlone) {
+    publish();
+    auto before = common::pathTreeToJson(shared.get());
+    auto source = common::resolveTreeNode(copy.get(), dummy::getAlias());
+    ASSERT_TRUE(source.is_initialized());
+    ASSERT_EQ(dummy::getInterface(), source->getInterfaceName());
+    ASSERT_NE(before, common::pathTreeToJson(copy.get()))
+        << "Resolution adds nodes, which is why the copy is needed";
+    ASSERT_EQ(before, common::pathTreeToJson(shared.get()));
+}
+
+TEST_F(PathTreeOwnerCopy, ObserverGoneStopsCopying) {
+    publish();
+    observer.reset();
+    publish();
+    ASSERT_EQ(1, copyUpdates);
+}
@@ -274,6 +274,24 @@ TEST(StringVectorSerialization, RoundTrip) {
     ASSERT_EQ(reader.bytesRemaining(), 0);
 }
 
+TEST(PoseSerialization, RoundTrip) {
+    Buffer<> buf;
+    OSVR_Pose3 inVal = {{{1., 2., 3.}}, {{0.5, -0.5, 0.5, -0.5}}};
+    osvr::common::serialization::serializeRaw(buf, inVal);
+    ASSERT_EQ(buf.size(), 7 * sizeof(double));
+
+    auto reader = buf.startReading();
+    OSVR_Pose3 outVal = {};
+    osvr::common::serialization::deserializeRaw(reader, outVal);
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_EQ(inVal.translation.data[i], outVal.translation.data[i]);
+    }
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_EQ(inVal.rotation.data[i], outVal.rotation.data[i]);
+    }
+    ASSERT_EQ(reader.bytesRemaining(), 0);
+}
+
 class SerializationAlignment : public ::testing::Test {
   public:
     virtual void SetUp() {
@@ -359,3 +377,72 @@ TEST(Serialization, SelfDescriptive) {
         ASSERT_EQ(data.c, 3);
     }
 }
+
+/// A message with a mix of sizes, alignments, and variable-length fields.
+class MixedMessage {
+  public:
+    enum Kind { KindA, KindB };
+    template <typename T> void processMessage(T &process) {
+        process(flag);
+        process(wide);
+        process(kind, osvr::common::serialization::EnumAsIntegerTag<
+                          Kind, uint8_t>());
+        process(name);
+        process(pose);
+        process(values);
+    }
+    bool flag = true;
+    double wide = 1.5;
+    Kind kind = KindB;
+    std::string name = "abc";
+    OSVR_Pose3 pose = {{{1, 2, 3}}, {{1, 0, 0, 0}}};
+    std::vector<int16_t> values = {1, 2, 3};
+};
+
+TEST(Serialization, SpaceRequiredMatchesSerializedSize) {
+    MixedMessage msg;
+    Buffer<> buf;
+    osvr::common::serialize(buf, msg);
+    ASSERT_EQ(buf.size(), osvr::common::getBufferSpaceRequired(msg));
+
+    MyClass simple;
+    Buffer<> simpleBuf;
+    osvr::common::serialize(simpleBuf, simple);
+    ASSERT_EQ(simpleBuf.size(), osvr::common::getBufferSpaceRequired(simple));
+}
+
+TEST(Serialization, ReusingBufferGivesSameBytes) {
+    MixedMessage msg;
+    Buffer<> fresh;
+    osvr::common::serialize(fresh, msg);
+
+    Buffer<> reused;
+    /// Leave some junk behind from a different message first.
+    MyClass simple;
+    osvr::common::serializeReusing(reused, simple);
+    osvr::common::serializeReusing(reused, msg);
+    ASSERT_EQ(fresh.getContents(), reused.getContents());
+
+    /// Once the buffer has held a message this size, doing it again
+    /// shouldn't need new storage.
+    auto storage = reused.data();
+    osvr::common::serializeReusing(reused, msg);
+    ASSERT_EQ(storage, reused.data());
+    ASSERT_EQ(fresh.getContents(), reused.getContents());
+}
+
+TEST(Buffer, ClearAndTrimKeepsOnlySmallStorage) {
+    Buffer<> buf;
+    buf.reserve(100);
+    buf.appendPadding(10);
+    auto storage = buf.data();
+    buf.clearAndTrim(100);
+    ASSERT_EQ(0u, buf.size());
+    ASSERT_EQ(storage, buf.data()) << "Small enough to keep";
+
+    buf.reserve(1000);
+    buf.appendPadding(1000);
+    buf.clearAndTrim(100);
+    ASSERT_EQ(0u, buf.size());
+    ASSERT_GE(100u, buf.capacity()) << "Oversize storage released";
+}
@@ -0,0 +1,129 @@
+/** @file
+    @brief Microbenchmark comparing serializing each message into a fresh
+    buffer with serializing into a reused, presized one.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/Buffer.h>
+#include <osvr/Common/Serialization.h>
+#include <osvr/Util/ChannelCountC.h>
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+/// Same layout as the direction report an eye tracker sends with each gaze
+/// sample.
+class DirectionMessage {
+  public:
+    template <typename T> void processMessage(T &p) {
+        p(direction);
+        p(sensor);
+    }
+    OSVR_Vec3 direction = {{0.1, 0.2, 0.9}};
+    OSVR_ChannelCount sensor = 1;
+};
+
+struct PoseEntry {
+    OSVR_ChannelCount sensor;
+    OSVR_Pose3 pose;
+};
+
+namespace osvr {
+namespace common {
+    namespace serialization {
+        template <>
+        struct SimpleStructSerialization<PoseEntry>
+            : SimpleStructSerializationBase {
+            template <typename F, typename T> static void apply(F &f, T &val) {
+                f(val.sensor);
+                f(val.pose);
+            }
+        };
+    } // namespace serialization
+} // namespace common
+} // namespace osvr
+
+/// Same layout as a tracker pose batch.
+class PoseBatchMessage {
+  public:
+    explicit PoseBatchMessage(std::size_t n) : poses(n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            poses[i].sensor = static_cast<OSVR_ChannelCount>(i);
+            poses[i].pose = {{{1, 2, 3}}, {{1, 0, 0, 0}}};
+        }
+    }
+    template <typename T> void processMessage(T &p) { p(poses); }
+    std::vector<PoseEntry> poses;
+};
+
+static const std::size_t ITERATIONS = 1000000;
+
+/// Keeps the compiler from discarding the serialized bytes.
+static std::size_t g_sink = 0;
+
+template <typename F>
+static void benchmark(const char *label, F &&serializeOne) {
+    auto begin = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < ITERATIONS; ++i) {
+        serializeOne();
+    }
+    auto end = std::chrono::steady_clock::now();
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin)
+                  .count();
+    std::cout << std::setw(32) << std::left << label << std::setw(10)
+              << std::right << std::fixed << std::setprecision(1)
+              << double(ns) / ITERATIONS << " ns/msg" << std::endl;
+}
+
+template <typename Message>
+static void compare(const char *name, Message &msg) {
+    using osvr::common::Buffer;
+    std::cout << name << " ("
+              << osvr::common::getBufferSpaceRequired(msg) << " bytes)"
+              << std::endl;
+    benchmark("  fresh Buffer<> + serialize", [&] {
+        Buffer<> buf;
+        osvr::common::serialize(buf, msg);
+        g_sink += buf.size();
+    });
+    Buffer<> reused;
+    benchmark("  reused Buffer<> + presized", [&] {
+        osvr::common::serializeReusing(reused, msg);
+        g_sink += reused.size();
+    });
+}
+
+int main() {
+    DirectionMessage direction;
+    compare("Direction report", direction);
+    PoseBatchMessage batch(16);
+    compare("Pose batch, 16 sensors", batch);
+    return g_sink == 0;
+}
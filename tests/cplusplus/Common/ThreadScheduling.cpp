@@ -0,0 +1,91 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/ThreadScheduling.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <json/reader.h>
+#include <json/value.h>
+
+// Standard includes
+#include <stdexcept>
+#include <string>
+
+using osvr::common::ThreadSchedulingOptions;
+using osvr::common::applyThreadScheduling;
+using osvr::common::parseThreadSchedulingOptions;
+typedef ThreadSchedulingOptions::Policy Policy;
+
+inline Json::Value parse(std::string const &json) {
+    Json::Value ret;
+    Json::Reader reader;
+    if (!reader.parse(json, ret)) {
+        throw std::runtime_error("Bad JSON in test: " + json);
+    }
+    return ret;
+}
+
+TEST(ThreadScheduling, NullGivesDefaults) {
+    auto opts = parseThreadSchedulingOptions(Json::Value());
+    ASSERT_TRUE(opts.isDefault());
+    opts = parseThreadSchedulingOptions(parse("{}"));
+    ASSERT_TRUE(opts.isDefault());
+    ASSERT_TRUE(applyThreadScheduling(opts, "test"))
+        << "Nothing to apply, so nothing fails";
+}
+
+TEST(ThreadScheduling, ParsesEverything) {
+    auto opts = parseThreadSchedulingOptions(parse(
+        R"({"policy": "fifo", "priority": 50, "cpus": [1, 3],
+            "timerSlackNs": 1000})"));
+    ASSERT_FALSE(opts.isDefault());
+    ASSERT_EQ(Policy::Fifo, opts.policy);
+    ASSERT_EQ(50, opts.priority);
+    ASSERT_EQ((std::vector<int>{1, 3}), opts.cpus);
+    ASSERT_EQ(1000, opts.timerSlackNs);
+
+    opts = parseThreadSchedulingOptions(parse(R"({"policy": "rr"})"));
+    ASSERT_EQ(Policy::RoundRobin, opts.policy);
+    ASSERT_EQ(1, opts.priority) << "Default priority";
+    ASSERT_TRUE(opts.cpus.empty());
+    ASSERT_GT(0, opts.timerSlackNs) << "Timer slack left alone";
+}
+
+TEST(ThreadScheduling, RejectsBadValues) {
+    ASSERT_THROW(parseThreadSchedulingOptions(parse(R"({"policy": "idle"})")),
+                 std::invalid_argument);
+    ASSERT_THROW(parseThreadSchedulingOptions(parse(R"({"cpus": [-1]})")),
+                 std::invalid_argument);
+    ASSERT_THROW(parseThreadSchedulingOptions(parse(R"({"cpus": ["0"]})")),
+                 std::invalid_argument);
+}
+
+TEST(ThreadScheduling, OutOfRangeCpuSkipped) {
+    ThreadSchedulingOptions opts;
+    opts.cpus.push_back(1 << 20);
+    ASSERT_FALSE(applyThreadScheduling(opts, "test"));
+}
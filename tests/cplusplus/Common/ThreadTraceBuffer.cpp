@@ -0,0 +1,99 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "../../../src/osvr/Common/ThreadTraceBuffer.h"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using osvr::common::tracing::ThreadTraceBuffer;
+using osvr::common::tracing::TraceEvent;
+
+/// Pushes events numbered from @p begin to @p end, using the number as both
+/// timestamp and name.
+inline void pushRange(ThreadTraceBuffer &buf, int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+        buf.push('i', 'm', std::to_string(i).c_str(), i);
+    }
+}
+
+inline std::vector<std::int64_t> timestamps(ThreadTraceBuffer const &buf) {
+    std::vector<TraceEvent> events;
+    buf.copyEvents(events);
+    std::vector<std::int64_t> ret;
+    for (auto const &ev : events) {
+        EXPECT_EQ(std::to_string(ev.timestamp), std::string(ev.name));
+        ret.push_back(ev.timestamp);
+    }
+    return ret;
+}
+
+typedef std::vector<std::int64_t> Timestamps;
+
+TEST(ThreadTraceBuffer, EmptyCopiesNothing) {
+    ThreadTraceBuffer buf(4, 1);
+    ASSERT_TRUE(timestamps(buf).empty());
+}
+
+TEST(ThreadTraceBuffer, PartlyFilledCopiesAllInOrder) {
+    ThreadTraceBuffer buf(4, 1);
+    pushRange(buf, 0, 3);
+    ASSERT_EQ((Timestamps{0, 1, 2}), timestamps(buf));
+}
+
+TEST(ThreadTraceBuffer, FullSkipsSlotOwnerMayBeWriting) {
+    ThreadTraceBuffer buf(4, 1);
+    pushRange(buf, 0, 4);
+    // The next push overwrites the oldest slot, so it's not reported intact.
+    ASSERT_EQ((Timestamps{1, 2, 3}), timestamps(buf));
+}
+
+TEST(ThreadTraceBuffer, WrappedAroundCopiesNewestOldestFirst) {
+    ThreadTraceBuffer buf(4, 1);
+    pushRange(buf, 0, 10);
+    ASSERT_EQ((Timestamps{7, 8, 9}), timestamps(buf));
+    pushRange(buf, 10, 13);
+    ASSERT_EQ((Timestamps{10, 11, 12}), timestamps(buf));
+}
+
+TEST(ThreadTraceBuffer, CopyAppendsAndTruncatesNames) {
+    ThreadTraceBuffer buf(4, 7);
+    ASSERT_EQ(7u, buf.getThreadId());
+    std::string longName(100, 'x');
+    buf.push('B', 'w', longName.c_str(), 5);
+    std::vector<TraceEvent> events(1);
+    buf.copyEvents(events);
+    ASSERT_EQ(2u, events.size()) << "Appends to what's already there";
+    ASSERT_EQ('B', events[1].phase);
+    ASSERT_EQ('w', events[1].category);
+    ASSERT_EQ(longName.substr(0, sizeof(events[1].name) - 1),
+              std::string(events[1].name));
+}
@@ -159,3 +159,63 @@ TEST(AsyncAccessControl, recursive) {
     ASSERT_FALSE(control.mainThreadCTS())
         << "CTS should have no tasks waiting.";
 }
+
+TEST(AsyncAccessControl, requestNotifier) {
+    AsyncAccessControl control;
+    boost::mutex mut;
+    boost::condition_variable cond;
+    bool notified = false;
+    volatile bool sent = false;
+    control.setRequestNotifier([&] {
+        boost::unique_lock<boost::mutex> lock(mut);
+        notified = true;
+        cond.notify_all();
+    });
+
+    ScopedThread asyncThread(new boost::thread([&] {
+        RequestToSend rts(control);
+        ASSERT_TRUE(rts.request()) << "Request should be approved";
+        sent = true;
+    }));
+
+    {
+        /// Sleep until woken, as an event-driven main loop would.
+        boost::unique_lock<boost::mutex> lock(mut);
+        while (!notified) {
+            cond.wait(lock);
+        }
+    }
+    ASSERT_TRUE(control.mainThreadCTS())
+        << "Request should already be posted when we're notified.";
+    ASSERT_TRUE(sent) << "Should have sent";
+}
+
+TEST(AsyncAccessControl, beforeGrantRunsWhileRequesterWaits) {
+    AsyncAccessControl control;
+    bool called = false;
+    ASSERT_FALSE(control.mainThreadCTS([&] { called = true; }));
+    ASSERT_FALSE(called) << "Nothing to do without a request to send.";
+
+    volatile bool requested = false;
+    volatile bool sent = false;
+    volatile bool sentBeforeGrant = true;
+    ScopedThread asyncThread(new boost::thread([&] {
+        RequestToSend rts(control);
+        requested = true;
+        ASSERT_TRUE(rts.request()) << "Request should be approved";
+        sent = true;
+    }));
+    while (!requested) {
+        pleaseYield();
+    }
+    while (!control.mainThreadCTS([&] {
+        called = true;
+        sentBeforeGrant = sent;
+    })) {
+        pleaseYield();
+    }
+    ASSERT_TRUE(called);
+    ASSERT_FALSE(sentBeforeGrant)
+        << "Requester shouldn't get through before beforeGrant runs.";
+    ASSERT_TRUE(sent);
+}
@@ -0,0 +1,242 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "../../../src/osvr/Connection/AsyncSendQueue.h"
+#include "../../../src/osvr/Connection/AsyncSendQueue.cpp"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <boost/thread/thread.hpp>
+
+// Standard includes
+#include <string>
+#include <vector>
+
+using namespace osvr::connection;
+using osvr::util::time::TimeValue;
+
+/// @brief Message types are only passed through, so any address will do.
+static MessageType *const dummyType = reinterpret_cast<MessageType *>(0x10);
+
+inline bool pushString(AsyncSendQueue &queue, std::string const &str) {
+    TimeValue tv = {};
+    return queue.push(tv, dummyType, str.data(), str.size());
+}
+
+inline std::vector<std::string> drainStrings(AsyncSendQueue &queue) {
+    std::vector<std::string> ret;
+    queue.drain([&](AsyncSendQueue::Message const &msg) {
+        EXPECT_EQ(dummyType, msg.type);
+        ret.emplace_back(msg.data.begin(), msg.data.end());
+    });
+    return ret;
+}
+
+TEST(AsyncSendQueue, CapacityRoundedUp) {
+    AsyncSendQueue queue(5);
+    ASSERT_EQ(8u, queue.capacity());
+}
+
+TEST(AsyncSendQueue, InOrder) {
+    AsyncSendQueue queue(4);
+    ASSERT_TRUE(drainStrings(queue).empty());
+    ASSERT_TRUE(pushString(queue, "a"));
+    ASSERT_TRUE(pushString(queue, "bb"));
+    ASSERT_TRUE(pushString(queue, ""));
+    auto out = drainStrings(queue);
+    ASSERT_EQ(3u, out.size());
+    ASSERT_EQ("a", out[0]);
+    ASSERT_EQ("bb", out[1]);
+    ASSERT_EQ("", out[2]);
+    ASSERT_EQ(0u, queue.getDroppedCount());
+}
+
+TEST(AsyncSendQueue, DropNewest) {
+    AsyncSendQueue queue(2, OSVR_ASYNC_SEND_DROP_NEWEST);
+    ASSERT_TRUE(pushString(queue, "1"));
+    ASSERT_TRUE(pushString(queue, "2"));
+    ASSERT_FALSE(pushString(queue, "3"));
+    ASSERT_EQ(1u, queue.getDroppedCount());
+    auto out = drainStrings(queue);
+    ASSERT_EQ((std::vector<std::string>{"1", "2"}), out);
+
+    /// Wraps around fine once drained.
+    ASSERT_TRUE(pushString(queue, "4"));
+    ASSERT_EQ(std::vector<std::string>{"4"}, drainStrings(queue));
+}
+
+TEST(AsyncSendQueue, DropOldest) {
+    AsyncSendQueue queue(2, OSVR_ASYNC_SEND_DROP_OLDEST);
+    ASSERT_TRUE(pushString(queue, "1"));
+    ASSERT_TRUE(pushString(queue, "2"));
+    ASSERT_TRUE(pushString(queue, "3"));
+    ASSERT_EQ(1u, queue.getDroppedCount());
+    ASSERT_EQ((std::vector<std::string>{"2", "3"}), drainStrings(queue));
+}
+
+/// @brief Records the packed reports it's called with.
+struct ReportLog {
+    std::vector<std::string> sent;
+    std::vector<std::string> discarded;
+
+    static void record(void *userdata, const char *data, size_t len,
+                       bool send) {
+        auto log = static_cast<ReportLog *>(userdata);
+        (send ? log->sent : log->discarded).emplace_back(data, len);
+    }
+
+    bool push(AsyncSendQueue &queue, std::string const &str) {
+        bool wasEmpty;
+        return queue.pushReport(&ReportLog::record, this, str.data(),
+                                str.size(), wasEmpty);
+    }
+};
+
+inline void drainReports(AsyncSendQueue &queue) {
+    queue.drain([](AsyncSendQueue::Message const &msg) {
+        ASSERT_TRUE(msg.report != nullptr);
+        msg.report(msg.userdata, msg.data.data(), msg.data.size(), true);
+    });
+}
+
+TEST(AsyncSendQueue, PackedReportsInOrderWithMessages) {
+    AsyncSendQueue queue(4);
+    ReportLog log;
+    ASSERT_TRUE(pushString(queue, "msg"));
+    ASSERT_TRUE(log.push(queue, "report"));
+    std::vector<std::string> order;
+    queue.drain([&](AsyncSendQueue::Message const &msg) {
+        if (msg.report) {
+            msg.report(msg.userdata, msg.data.data(), msg.data.size(), true);
+            order.push_back("report");
+        } else {
+            order.emplace_back(msg.data.begin(), msg.data.end());
+        }
+    });
+    ASSERT_EQ((std::vector<std::string>{"msg", "report"}), order);
+    ASSERT_EQ(std::vector<std::string>{"report"}, log.sent);
+    ASSERT_TRUE(log.discarded.empty());
+}
+
+TEST(AsyncSendQueue, DroppedReportsAreDiscarded) {
+    ReportLog log;
+    {
+        AsyncSendQueue queue(2, OSVR_ASYNC_SEND_DROP_NEWEST);
+        ASSERT_TRUE(log.push(queue, "1"));
+        ASSERT_TRUE(log.push(queue, "2"));
+        ASSERT_FALSE(log.push(queue, "3"));
+        ASSERT_EQ(std::vector<std::string>{"3"}, log.discarded);
+    }
+    /// The queue discards what's left when it goes away.
+    ASSERT_EQ((std::vector<std::string>{"3", "1", "2"}), log.discarded);
+    ASSERT_TRUE(log.sent.empty());
+
+    log = ReportLog{};
+    AsyncSendQueue queue(2, OSVR_ASYNC_SEND_DROP_OLDEST);
+    ASSERT_TRUE(log.push(queue, "1"));
+    ASSERT_TRUE(log.push(queue, "2"));
+    ASSERT_TRUE(log.push(queue, "3"));
+    ASSERT_EQ(std::vector<std::string>{"1"}, log.discarded);
+    drainReports(queue);
+    ASSERT_EQ((std::vector<std::string>{"2", "3"}), log.sent);
+}
+
+TEST(AsyncSendQueue, WasEmptyOnlyForFirstMessage) {
+    AsyncSendQueue queue(4);
+    TimeValue tv = {};
+    bool wasEmpty = false;
+    ASSERT_TRUE(queue.push(tv, dummyType, "a", 1, wasEmpty));
+    ASSERT_TRUE(wasEmpty) << "First message needs the consumer woken";
+    ASSERT_TRUE(queue.push(tv, dummyType, "b", 1, wasEmpty));
+    ASSERT_FALSE(wasEmpty) << "Later ones go along with the first";
+    ASSERT_EQ(2u, drainStrings(queue).size());
+    ASSERT_TRUE(queue.push(tv, dummyType, "c", 1, wasEmpty));
+    ASSERT_TRUE(wasEmpty) << "Empty again once drained";
+}
+
+TEST(AsyncSendQueue, DrainReleasesBlockedSender) {
+    AsyncSendQueue queue(2, OSVR_ASYNC_SEND_BLOCK);
+    ASSERT_TRUE(pushString(queue, "1"));
+    ASSERT_TRUE(pushString(queue, "2"));
+    volatile bool pushed = false;
+    boost::thread sender([&] { pushed = pushString(queue, "3"); });
+    boost::this_thread::sleep(boost::posix_time::milliseconds(50));
+    ASSERT_FALSE(pushed) << "Should be blocked while the queue is full";
+    ASSERT_EQ((std::vector<std::string>{"1", "2"}), drainStrings(queue));
+    sender.join();
+    ASSERT_TRUE(pushed);
+    ASSERT_EQ(0u, queue.getDroppedCount());
+    ASSERT_EQ(std::vector<std::string>{"3"}, drainStrings(queue));
+}
+
+TEST(AsyncSendQueue, CloseReleasesBlockedSender) {
+    AsyncSendQueue queue(2, OSVR_ASYNC_SEND_BLOCK);
+    ASSERT_TRUE(pushString(queue, "1"));
+    ASSERT_TRUE(pushString(queue, "2"));
+    volatile bool pushed = true;
+    boost::thread sender([&] { pushed = pushString(queue, "3"); });
+    boost::this_thread::sleep(boost::posix_time::milliseconds(50));
+    queue.close();
+    sender.join();
+    ASSERT_FALSE(pushed);
+    ASSERT_EQ(1u, queue.getDroppedCount());
+    ASSERT_EQ(2u, drainStrings(queue).size());
+}
+
+TEST(AsyncSendQueue, MultipleProducers) {
+    static const int PRODUCERS = 4;
+    static const int MESSAGES = 10000;
+    AsyncSendQueue queue(64, OSVR_ASYNC_SEND_BLOCK);
+    std::vector<int> lastSeen(PRODUCERS, -1);
+    int received = 0;
+    std::vector<boost::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&queue, p] {
+            for (int i = 0; i < MESSAGES; ++i) {
+                int payload[] = {p, i};
+                TimeValue tv = {};
+                queue.push(tv, dummyType,
+                           reinterpret_cast<const char *>(payload),
+                           sizeof(payload));
+            }
+        });
+    }
+    while (received < PRODUCERS * MESSAGES) {
+        received += static_cast<int>(
+            queue.drain([&](AsyncSendQueue::Message const &msg) {
+                ASSERT_EQ(sizeof(int) * 2, msg.data.size());
+                auto payload = reinterpret_cast<const int *>(msg.data.data());
+                /// Each producer's messages arrive in order.
+                ASSERT_EQ(lastSeen[payload[0]] + 1, payload[1]);
+                lastSeen[payload[0]] = payload[1];
+            }));
+    }
+    for (auto &t : producers) {
+        t.join();
+    }
+    ASSERT_EQ(0u, queue.getDroppedCount());
+    ASSERT_EQ(PRODUCERS * MESSAGES, received);
+}
@@ -0,0 +1,91 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Connection/Connection.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <boost/thread/thread.hpp>
+
+// Standard includes
+#include <tuple>
+
+using osvr::connection::Connection;
+using osvr::connection::ConnectionPtr;
+using osvr::util::time::TimeValue;
+using osvr::util::time::getNow;
+
+inline ConnectionPtr makeConnection() {
+    return std::get<1>(Connection::createLoopbackConnection());
+}
+
+inline double secondsSince(TimeValue const &start) {
+    return osvr::util::time::duration(getNow(), start);
+}
+
+TEST(ConnectionActivity, ZeroWaitDoesntBlock) {
+    auto conn = makeConnection();
+    auto start = getNow();
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_FALSE(conn->waitForActivity(0));
+    }
+    ASSERT_LT(secondsSince(start), 0.5)
+        << "A thousand zero-length waits shouldn't take a millisecond each";
+}
+
+TEST(ConnectionActivity, PendingActivityReturnsAtOnce) {
+    auto conn = makeConnection();
+    conn->signalActivity();
+    auto start = getNow();
+    ASSERT_TRUE(conn->waitForActivity(10000000));
+    ASSERT_LT(secondsSince(start), 1.);
+    ASSERT_FALSE(conn->waitForActivity(0)) << "Activity is consumed";
+}
+
+TEST(ConnectionActivity, SignalWakesWaiter) {
+    auto conn = makeConnection();
+    boost::thread signaller([&] {
+        boost::this_thread::sleep(boost::posix_time::milliseconds(50));
+        conn->signalActivity();
+    });
+    auto start = getNow();
+    ASSERT_TRUE(conn->waitForActivity(10000000));
+    ASSERT_LT(secondsSince(start), 5.) << "Should wake well before timeout";
+    signaller.join();
+}
+
+TEST(ConnectionActivity, TimesOutWithoutActivity) {
+    auto conn = makeConnection();
+    ASSERT_FALSE(conn->waitForActivity(1000));
+}
+
+TEST(ConnectionActivity, NoMessagesToWaitFor) {
+    auto conn = makeConnection();
+    ASSERT_FALSE(conn->waitForActivityOrMessages(1000))
+        << "Nothing's sending on a loopback connection with no client";
+    ASSERT_FALSE(conn->waitForActivity(0));
+}
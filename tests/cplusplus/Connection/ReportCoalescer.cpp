@@ -0,0 +1,121 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "../../../src/osvr/Connection/ReportCoalescer.h"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+using osvr::connection::ReportCoalescer;
+using osvr::util::time::TimeValue;
+
+/// @brief Time in milliseconds since an arbitrary start.
+inline TimeValue ms(int milliseconds) {
+    TimeValue tv;
+    tv.seconds = 1000 + milliseconds / 1000;
+    tv.microseconds = (milliseconds % 1000) * 1000;
+    return tv;
+}
+
+typedef std::vector<std::pair<std::size_t, int> > Flushed;
+
+inline Flushed flush(ReportCoalescer<int> &coalescer, TimeValue const &now) {
+    Flushed ret;
+    coalescer.flush(now, [&](std::size_t slot, int const &report) {
+        ret.emplace_back(slot, report);
+    });
+    return ret;
+}
+
+TEST(ReportCoalescer, DisabledSendsEverything) {
+    ReportCoalescer<int> coalescer;
+    ASSERT_FALSE(coalescer.isEnabled());
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(coalescer.offer(0, i, ms(0)));
+    }
+    ASSERT_EQ(0u, coalescer.numPending());
+}
+
+TEST(ReportCoalescer, HoldsLatestUntilIntervalPasses) {
+    // 100 Hz: 10 ms between reports.
+    ReportCoalescer<int> coalescer(100);
+    ASSERT_TRUE(coalescer.offer(0, 1, ms(0))) << "First report goes at once";
+    ASSERT_FALSE(coalescer.offer(0, 2, ms(1)));
+    ASSERT_FALSE(coalescer.offer(0, 3, ms(2)));
+    ASSERT_EQ(1u, coalescer.numPending());
+    ASSERT_TRUE(flush(coalescer, ms(5)).empty()) << "Not due yet";
+
+    auto flushed = flush(coalescer, ms(10));
+    ASSERT_EQ(1u, flushed.size());
+    ASSERT_EQ(0u, flushed[0].first);
+    ASSERT_EQ(3, flushed[0].second) << "Only the latest report is sent";
+    ASSERT_EQ(0u, coalescer.numPending());
+    ASSERT_TRUE(flush(coalescer, ms(30)).empty()) << "Nothing left to send";
+}
+
+TEST(ReportCoalescer, DueReportSupersedesHeldOne) {
+    ReportCoalescer<int> coalescer(100);
+    ASSERT_TRUE(coalescer.offer(0, 1, ms(0)));
+    ASSERT_FALSE(coalescer.offer(0, 2, ms(5)));
+    ASSERT_TRUE(coalescer.offer(0, 3, ms(10)));
+    ASSERT_EQ(0u, coalescer.numPending());
+    ASSERT_TRUE(flush(coalescer, ms(20)).empty());
+}
+
+TEST(ReportCoalescer, SlotsAreIndependent) {
+    ReportCoalescer<int> coalescer(100);
+    ASSERT_TRUE(coalescer.offer(0, 1, ms(0)));
+    ASSERT_TRUE(coalescer.offer(3, 10, ms(1))) << "Other slot unaffected";
+    ASSERT_FALSE(coalescer.offer(0, 2, ms(2)));
+    ASSERT_FALSE(coalescer.offer(3, 11, ms(3)));
+    ASSERT_EQ(2u, coalescer.numPending());
+
+    auto flushed = flush(coalescer, ms(10));
+    ASSERT_EQ(1u, flushed.size()) << "Slot 3 not due until 11 ms";
+    ASSERT_EQ(Flushed::value_type(0, 2), flushed[0]);
+    flushed = flush(coalescer, ms(11));
+    ASSERT_EQ(1u, flushed.size());
+    ASSERT_EQ(Flushed::value_type(3, 11), flushed[0]);
+}
+
+TEST(ReportCoalescer, LimitsRateOfSteadyStream) {
+    // A 1 kHz stream limited to 100 Hz, flushed each millisecond as the
+    // server loop would.
+    ReportCoalescer<int> coalescer(100);
+    int sent = 0;
+    for (int t = 0; t < 1000; ++t) {
+        if (coalescer.offer(0, t, ms(t))) {
+            ++sent;
+        }
+        sent += static_cast<int>(flush(coalescer, ms(t)).size());
+    }
+    ASSERT_EQ(100, sent);
+}
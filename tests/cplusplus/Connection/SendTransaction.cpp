@@ -0,0 +1,131 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Connection/Connection.h>
+#include <osvr/Connection/DeviceInitObject.h>
+#include <osvr/Connection/DeviceToken.h>
+#include <osvr/Connection/MessageType.h>
+#include <osvr/Util/AsyncSendOverflowPolicyC.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <boost/thread/thread.hpp>
+
+// Standard includes
+#include <atomic>
+#include <string>
+#include <tuple>
+
+using osvr::connection::Connection;
+using osvr::connection::ConnectionPtr;
+using osvr::connection::DeviceInitObject;
+using osvr::connection::DeviceToken;
+using osvr::connection::DeviceTokenPtr;
+
+inline ConnectionPtr makeConnection() {
+    return std::get<1>(Connection::createLoopbackConnection());
+}
+
+TEST(SendTransaction, GuardInsideTransactionIsSharedAndGranted) {
+    auto conn = makeConnection();
+    DeviceInitObject init(conn);
+    init.setName("SendTransactionSync");
+    DeviceTokenPtr dev = DeviceToken::createSyncDevice(init);
+
+    ASSERT_TRUE(dev->beginSendTransaction());
+    auto first = dev->getSendGuard();
+    auto second = dev->getSendGuard();
+    ASSERT_EQ(first.get(), second.get()) << "No allocation per report";
+    ASSERT_TRUE(first->lock());
+    ASSERT_TRUE(second->lock());
+    ASSERT_TRUE(dev->endSendTransaction());
+}
+
+TEST(SendTransaction, Nesting) {
+    auto conn = makeConnection();
+    DeviceInitObject init(conn);
+    init.setName("SendTransactionNesting");
+    DeviceTokenPtr dev = DeviceToken::createSyncDevice(init);
+
+    ASSERT_FALSE(dev->endSendTransaction()) << "Nothing to end";
+    ASSERT_TRUE(dev->beginSendTransaction());
+    ASSERT_TRUE(dev->beginSendTransaction());
+    ASSERT_TRUE(dev->endSendTransaction());
+    ASSERT_TRUE(dev->endSendTransaction());
+    ASSERT_FALSE(dev->endSendTransaction());
+}
+
+TEST(SendTransaction, AsyncBlockingOverCapacityDoesntDeadlock) {
+    auto conn = makeConnection();
+    DeviceInitObject init(conn);
+    init.setName("SendTransactionAsync");
+    /// Default capacity (256 messages), waiting rather than dropping when
+    /// full.
+    init.setAsyncSendQueue(0, OSVR_ASYNC_SEND_BLOCK);
+    DeviceTokenPtr dev = DeviceToken::createAsyncDevice(init);
+    auto type = conn->registerMessageType("com_osvr_test_SendTransaction");
+
+    static const int NUM_MESSAGES = 1000;
+    std::atomic<int> transactions(0);
+    std::atomic<bool> failed(false);
+    dev->setUpdateCallback([&] {
+        if (transactions > 0) {
+            boost::this_thread::sleep(boost::posix_time::milliseconds(1));
+            return OSVR_RETURN_SUCCESS;
+        }
+        if (!dev->beginSendTransaction()) {
+            failed = true;
+            return OSVR_RETURN_FAILURE;
+        }
+        for (int i = 0; i < NUM_MESSAGES; ++i) {
+            auto guard = dev->getSendGuard();
+            if (!guard->lock()) {
+                failed = true;
+                break;
+            }
+            dev->sendData(type.get(), reinterpret_cast<const char *>(&i),
+                          sizeof(i));
+        }
+        dev->endSendTransaction();
+        ++transactions;
+        return OSVR_RETURN_SUCCESS;
+    });
+
+    /// Play the server loop. Messages sent in the transaction used to be
+    /// queued for this thread to send, while it was held up waiting for the
+    /// transaction to end: past the queue's capacity, both waited forever.
+    osvr::util::time::TimeValue start;
+    osvr::util::time::getNow(start);
+    while (transactions == 0 && !failed &&
+           osvr::util::time::duration(osvr::util::time::getNow(), start) <
+               10.) {
+        conn->process();
+    }
+    ASSERT_FALSE(failed);
+    ASSERT_EQ(1, transactions);
+    ASSERT_EQ(0u, dev->getDroppedMessageCount());
+}
@@ -0,0 +1,123 @@
+/** @file
+    @brief Checks that the block-structured covariance computations give the
+    same results as the dense ones they replace.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Kalman/AbsoluteOrientationMeasurement.h>
+#include <osvr/Kalman/AbsolutePositionMeasurement.h>
+#include <osvr/Kalman/AngularVelocityMeasurement.h>
+#include <osvr/Kalman/FlexibleKalmanFilter.h>
+#include <osvr/Kalman/PoseConstantVelocity.h>
+#include <osvr/Kalman/PoseDampedConstantVelocity.h>
+#include <osvr/Kalman/PoseSeparatelyDampedConstantVelocity.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+// - none
+
+using namespace osvr::kalman;
+using State = pose_externalized_rotation::State;
+using StateSquareMatrix = pose_externalized_rotation::StateSquareMatrix;
+
+static const double TOLERANCE = 1e-12;
+
+/// A state with an arbitrary (but symmetric, positive-definite) error
+/// covariance, so no structure in it hides mistakes.
+inline State makeState() {
+    StateSquareMatrix L = StateSquareMatrix::Random();
+    StateSquareMatrix P =
+        L * L.transpose() + StateSquareMatrix::Identity() * 0.1;
+    State state;
+    state.setStateVector(pose_externalized_rotation::StateVector::Random());
+    state.setErrorCovariance(P);
+    return state;
+}
+
+template <typename ProcessModel>
+class BlockStructurePredict : public ::testing::Test {
+  public:
+    ProcessModel model;
+};
+using ProcessModelTypes =
+    ::testing::Types<PoseConstantVelocityProcessModel,
+                     PoseDampedConstantVelocityProcessModel,
+                     PoseSeparatelyDampedConstantVelocityProcessModel>;
+TYPED_TEST_CASE(BlockStructurePredict, ProcessModelTypes);
+
+TYPED_TEST(BlockStructurePredict, MatchesDensePrediction) {
+    for (double dt : {0.001, 0.016, 0.1, 1.}) {
+        auto state = makeState();
+        StateSquareMatrix expected =
+            predictErrorCovariance(state, this->model, dt);
+        this->model.predictState(state, dt);
+        ASSERT_TRUE(state.errorCovariance().isApprox(expected, TOLERANCE))
+            << "dt = " << dt << "\nexpected:\n"
+            << expected << "\ngot:\n"
+            << state.errorCovariance();
+    }
+}
+
+/// Does the dense version of what beginCorrection does, and compares.
+template <typename Measurement>
+inline void checkCorrection(Measurement &meas) {
+    PoseConstantVelocityProcessModel model;
+    auto state = makeState();
+    StateSquareMatrix P = state.errorCovariance();
+    auto H = meas.getJacobian(state);
+    auto PHt = (P * H.transpose()).eval();
+    types::SquareMatrix<3> R = meas.getCovariance(state);
+    auto S = (H * PHt + R).eval();
+
+    auto correction = beginCorrection(state, model, meas);
+    ASSERT_TRUE(correction.PHt.isApprox(PHt, TOLERANCE))
+        << "expected:\n"
+        << PHt << "\ngot:\n"
+        << correction.PHt;
+    auto expectedStateCorrection = (PHt * S.ldlt().solve(
+                                              meas.getResidual(state)))
+                                       .eval();
+    ASSERT_TRUE(correction.stateCorrection.isApprox(expectedStateCorrection,
+                                                    TOLERANCE));
+}
+
+TEST(BlockStructureCorrect, AbsolutePosition) {
+    AbsolutePositionMeasurement<State> meas{Eigen::Vector3d(1, 2, 3),
+                                            Eigen::Vector3d::Constant(0.1)};
+    checkCorrection(meas);
+}
+
+TEST(BlockStructureCorrect, AbsoluteOrientation) {
+    AbsoluteOrientationMeasurement<State> meas{
+        Eigen::Quaterniond(Eigen::AngleAxisd(0.5, Eigen::Vector3d::UnitY())),
+        Eigen::Vector3d::Constant(0.1)};
+    checkCorrection(meas);
+}
+
+TEST(BlockStructureCorrect, AngularVelocity) {
+    AngularVelocityMeasurement<State> meas{Eigen::Vector3d(0.1, 0.2, 0.3),
+                                           Eigen::Vector3d::Constant(0.1)};
+    checkCorrection(meas);
+}
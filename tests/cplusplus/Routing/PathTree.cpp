@@ -25,6 +25,7 @@
 
 // Internal Includes
 #include <osvr/Common/PathTreeFull.h>
+#include <osvr/Common/PathElementTools.h>
 #include <osvr/Common/PathElementTypes.h>
 #include <osvr/Common/PathNode.h>
 #include <osvr/Common/RoutingExceptions.h>
@@ -103,3 +104,23 @@ TEST(PathTree, getPathTwoLevel) {
     ASSERT_EQ(tree.getNodeByPath("/test1/test2"), *test2)
         << "Identity should be preserved";
 }
+
+TEST(PathTree, removeNodeByPath) {
+    PathTree tree;
+    tree.getNodeByPath("/a/b/c").value() = elements::PluginElement();
+    tree.getNodeByPath("/a/d").value() = elements::PluginElement();
+    tree.getNodeByPath("/a").value() = elements::PluginElement();
+
+    ASSERT_FALSE(tree.removeNodeByPath("/a/x")) << "Nothing to remove";
+
+    PathTree const &constTree = tree;
+    ASSERT_TRUE(tree.removeNodeByPath("/a/b/c"));
+    ASSERT_THROW(constTree.getNodeByPath("/a/b"), osvr::util::tree::NoSuchChild)
+        << "Null ancestor left childless is removed too";
+    ASSERT_NO_THROW(constTree.getNodeByPath("/a/d"));
+
+    ASSERT_TRUE(tree.removeNodeByPath("/a"));
+    ASSERT_NO_THROW(constTree.getNodeByPath("/a/d"))
+        << "A node with children stays, to hold them";
+    ASSERT_TRUE(elements::isNull(constTree.getNodeByPath("/a").value()));
+}
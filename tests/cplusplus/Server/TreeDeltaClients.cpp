@@ -0,0 +1,137 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "../../../src/osvr/Server/TreeDeltaClients.h"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+// - none
+
+using osvr::server::TreeDeltaClients;
+
+/// @brief Starts a query round, as the server loop does when one is due.
+inline uint32_t query(TreeDeltaClients &clients) {
+    uint32_t epoch = 0;
+    EXPECT_TRUE(clients.startQueryIfNeeded(epoch));
+    EXPECT_NE(0u, epoch);
+    return epoch;
+}
+
+TEST(TreeDeltaClients, NoClientsNeedNoFullTree) {
+    TreeDeltaClients clients;
+    ASSERT_TRUE(clients.allClientsSupportDeltas());
+    uint32_t epoch;
+    ASSERT_FALSE(clients.startQueryIfNeeded(epoch)) << "Nobody to ask";
+}
+
+TEST(TreeDeltaClients, NewClientGetsFullTreeUntilItAnswers) {
+    TreeDeltaClients clients;
+    clients.clientConnected();
+    ASSERT_FALSE(clients.allClientsSupportDeltas());
+    auto epoch = query(clients);
+    ASSERT_FALSE(clients.allClientsSupportDeltas());
+    clients.handleReply(epoch, 11);
+    ASSERT_TRUE(clients.allClientsSupportDeltas());
+}
+
+TEST(TreeDeltaClients, OldClientKeepsGettingFullTree) {
+    TreeDeltaClients clients;
+    clients.clientConnected(); // understands deltas
+    clients.clientConnected(); // older client: never answers
+    auto epoch = query(clients);
+    clients.handleReply(epoch, 11);
+    ASSERT_FALSE(clients.allClientsSupportDeltas());
+
+    // Another query (e.g. on a ping) doesn't change that.
+    clients.requestQuery();
+    epoch = query(clients);
+    clients.handleReply(epoch, 11);
+    ASSERT_FALSE(clients.allClientsSupportDeltas());
+
+    // Once the older client leaves, everyone left answers the re-query.
+    clients.clientDropped();
+    ASSERT_EQ(1u, clients.numClients());
+    epoch = query(clients);
+    ASSERT_FALSE(clients.allClientsSupportDeltas())
+        << "Not known until the re-query is answered";
+    clients.handleReply(epoch, 11);
+    ASSERT_TRUE(clients.allClientsSupportDeltas());
+}
+
+TEST(TreeDeltaClients, StaleUnsolicitedAndAnonymousRepliesDontCount) {
+    TreeDeltaClients clients;
+    clients.clientConnected();
+    auto oldEpoch = query(clients);
+    clients.clientConnected();
+    auto epoch = query(clients);
+    ASSERT_NE(oldEpoch, epoch);
+
+    clients.handleReply(oldEpoch, 11);
+    clients.handleReply(0, 11);
+    clients.handleReply(epoch, 0);
+    ASSERT_FALSE(clients.allClientsSupportDeltas());
+    clients.handleReply(epoch, 11);
+    ASSERT_FALSE(clients.allClientsSupportDeltas());
+    clients.handleReply(epoch, 22);
+    ASSERT_TRUE(clients.allClientsSupportDeltas());
+}
+
+TEST(TreeDeltaClients, RepeatedRepliesDontCoverForOldClient) {
+    TreeDeltaClients clients;
+    clients.clientConnected(); // understands deltas
+    clients.clientConnected(); // older client: never answers
+    auto epoch = query(clients);
+    clients.handleReply(epoch, 11);
+    clients.handleReply(epoch, 11);
+    clients.handleReply(epoch, 11);
+    ASSERT_FALSE(clients.allClientsSupportDeltas())
+        << "One client answering three times is still one client";
+}
+
+TEST(TreeDeltaClients, DropAsksEveryoneAgain) {
+    TreeDeltaClients clients;
+    clients.clientConnected();
+    clients.clientConnected();
+    auto epoch = query(clients);
+    clients.handleReply(epoch, 11);
+    clients.handleReply(epoch, 22);
+    ASSERT_TRUE(clients.allClientsSupportDeltas());
+
+    // We can't tell which client left, so what they said is forgotten at
+    // once, not just once the re-query goes out.
+    clients.clientDropped();
+    ASSERT_FALSE(clients.allClientsSupportDeltas());
+    clients.clientConnected();
+    epoch = query(clients);
+    ASSERT_FALSE(clients.allClientsSupportDeltas());
+    clients.handleReply(epoch, 22);
+    ASSERT_FALSE(clients.allClientsSupportDeltas())
+        << "The new client hasn't answered";
+    clients.handleReply(epoch, 33);
+    ASSERT_TRUE(clients.allClientsSupportDeltas());
+}
@@ -0,0 +1,87 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Util/KeyedOwnershipContainer.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <vector>
+
+using osvr::shared_ptr;
+using container = osvr::util::KeyedRefCountContainer<int>;
+
+TEST(KeyedRefCountContainer, holdsUntilLastRelease) {
+    container c;
+    shared_ptr<int> ptr(new int(5));
+    void *key = c.acquire(ptr, 2);
+    ASSERT_EQ(ptr.get(), key);
+    ASSERT_EQ(2, ptr.use_count());
+
+    ASSERT_TRUE(c.release(key));
+    ASSERT_EQ(2, ptr.use_count());
+    ASSERT_TRUE(c.release(key));
+    ASSERT_EQ(1, ptr.use_count());
+    ASSERT_FALSE(c.release(key));
+}
+
+TEST(KeyedRefCountContainer, releaseUnknown) {
+    container c;
+    int notOwned = 0;
+    ASSERT_FALSE(c.release(&notOwned));
+    ASSERT_FALSE(c.release(nullptr));
+}
+
+TEST(KeyedRefCountContainer, addsToExistingReferences) {
+    container c;
+    shared_ptr<int> ptr(new int(5));
+    c.acquire(ptr);
+    c.acquire(ptr, 2);
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(c.release(ptr.get()));
+    }
+    ASSERT_EQ(1, ptr.use_count());
+    ASSERT_FALSE(c.release(ptr.get()));
+}
+
+TEST(KeyedRefCountContainer, reacquireAfterRelease) {
+    container c;
+    std::vector<shared_ptr<int> > ptrs;
+    for (int i = 0; i < 100; ++i) {
+        ptrs.emplace_back(new int(i));
+    }
+    for (int round = 0; round < 3; ++round) {
+        for (auto &ptr : ptrs) {
+            c.acquire(ptr);
+        }
+        for (auto &ptr : ptrs) {
+            ASSERT_EQ(2, ptr.use_count());
+            ASSERT_TRUE(c.release(ptr.get()));
+            ASSERT_EQ(1, ptr.use_count());
+        }
+    }
+}
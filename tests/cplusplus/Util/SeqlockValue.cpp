@@ -0,0 +1,97 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Util/SeqlockValue.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using osvr::util::SeqlockValue;
+
+namespace {
+/// @brief A value whose fields must always agree, to spot torn reads.
+struct Triple {
+    uint64_t a;
+    uint64_t b;
+    uint64_t c;
+};
+} // namespace
+
+TEST(SeqlockValue, initiallyEmpty) {
+    SeqlockValue<Triple> val;
+    ASSERT_FALSE(val.hasValue());
+    Triple t = {1, 2, 3};
+    ASSERT_FALSE(val.load(t));
+    ASSERT_EQ(1u, t.a);
+    ASSERT_EQ(0u, val.getGeneration());
+}
+
+TEST(SeqlockValue, storeAndLoad) {
+    SeqlockValue<Triple> val;
+    Triple in = {4, 5, 6};
+    val.store(in);
+    ASSERT_TRUE(val.hasValue());
+    ASSERT_EQ(1u, val.getGeneration());
+    Triple out = {};
+    ASSERT_TRUE(val.load(out));
+    ASSERT_EQ(4u, out.a);
+    ASSERT_EQ(5u, out.b);
+    ASSERT_EQ(6u, out.c);
+}
+
+TEST(SeqlockValue, concurrentReadersSeeConsistentValues) {
+    SeqlockValue<Triple> val;
+    std::atomic<bool> done(false);
+    std::atomic<int> torn(0);
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 3; ++i) {
+        readers.emplace_back([&] {
+            Triple t;
+            while (!done) {
+                if (val.load(t) && (t.a != t.b || t.b != t.c)) {
+                    ++torn;
+                }
+            }
+        });
+    }
+    for (uint64_t i = 0; i < 200000; ++i) {
+        Triple t = {i, i, i};
+        val.store(t);
+    }
+    done = true;
+    for (auto &reader : readers) {
+        reader.join();
+    }
+    ASSERT_EQ(0, torn.load());
+    Triple last;
+    ASSERT_TRUE(val.load(last));
+    ASSERT_EQ(199999u, last.a);
+}
@@ -31,6 +31,7 @@
 
 // Standard includes
 #include <string>
+#include <vector>
 
 using std::string;
 using osvr::util::TreeNode;
@@ -314,3 +315,65 @@ TEST(TreeNode, ParentPointers) {
     ParentCheckerVisitor visitor;
     visitor(*tree);
 }
+
+TEST(TreeNode, ManyChildrenStableReferences) {
+    IntTreePtr tree = IntTree::createRoot();
+    std::vector<IntTree *> children;
+    for (int i = 0; i < 1000; ++i) {
+        auto &child =
+            tree->getOrCreateChildByName("child" + std::to_string(i));
+        child.value() = i;
+        children.push_back(&child);
+    }
+    ASSERT_EQ(tree->numChildren(), 1000u);
+    for (int i = 0; i < 1000; ++i) {
+        auto name = "child" + std::to_string(i);
+        ASSERT_EQ(&(tree->getOrCreateChildByName(name)), children[i])
+            << "Lookup should find the existing node, which should not "
+               "have moved";
+        ASSERT_EQ(tree->getChildByName(name).value(), i);
+    }
+    ASSERT_EQ(tree->numChildren(), 1000u);
+    ASSERT_THROW(tree->getChildByName("nonexistent"),
+                 osvr::util::tree::NoSuchChild);
+}
+
+TEST(TreeNode, Descendants) {
+    IntTreePtr tree = IntTree::createRoot();
+    std::vector<string> path = {"a", "b", "c"};
+    IntTree *leaf = nullptr;
+    ASSERT_NO_THROW(leaf =
+                        &(tree->getOrCreateDescendant(begin(path), end(path))));
+    ASSERT_EQ(leaf->getName(), "c");
+    ASSERT_EQ(&(tree->getChildByName("a").getChildByName("b").getChildByName(
+                  "c")),
+              leaf);
+    ASSERT_EQ(&(tree->getOrCreateDescendant(begin(path), end(path))), leaf);
+
+    IntTree const &constTree = *tree;
+    ASSERT_EQ(&(constTree.getDescendant(begin(path), end(path))), leaf);
+    std::vector<string> missing = {"a", "x"};
+    ASSERT_THROW(constTree.getDescendant(begin(missing), end(missing)),
+                 osvr::util::tree::NoSuchChild);
+    ASSERT_EQ(&(constTree.getDescendant(begin(path), begin(path))), tree.get())
+        << "Empty range gives the starting node";
+}
+
+TEST(TreeNode, RemoveChildByName) {
+    IntTreePtr tree = IntTree::createRoot();
+    std::vector<string> path = {"a", "b"};
+    tree->getOrCreateDescendant(begin(path), end(path)).value() = 2;
+    IntTree &c = IntTree::create(*tree, "c", 3);
+
+    ASSERT_FALSE(tree->removeChildByName("x")) << "No such child";
+    ASSERT_TRUE(tree->removeChildByName("a"));
+    ASSERT_EQ(tree->numChildren(), 1u);
+    ASSERT_THROW(tree->getChildByName("a"), osvr::util::tree::NoSuchChild)
+        << "Gone, along with its descendants";
+    ASSERT_EQ(&(tree->getChildByName("c")), &c)
+        << "Other children are untouched";
+
+    IntTree &a = tree->getOrCreateChildByName("a");
+    ASSERT_FALSE(a.hasChildren()) << "A new child, not the old one";
+    ASSERT_EQ(a.value(), 0);
+}